@@ -66,6 +66,15 @@
 
 #  ifndef CONFIG_EXECFUNCS_NSYMBOLS_VAR
 #    error "CONFIG_EXECFUNCS_NSYMBOLS_VAR must be defined"
+#  endif
+
+  /* The generated system symbol table comes with a hash index */
+
+#  if defined(CONFIG_SYMTAB_HASHED) && defined(CONFIG_EXECFUNCS_SYSTEM_SYMTAB)
+#    define EXEC_HAVE_SYMHASH 1
+#    define __EXEC_SYMHASH(t)   t##_hash
+#    define _EXEC_SYMHASH(t)    __EXEC_SYMHASH(t)
+#    define EXEC_SYMHASH        _EXEC_SYMHASH(CONFIG_EXECFUNCS_SYMTAB_ARRAY)
 #  endif
 #endif
 
@@ -78,6 +87,10 @@ extern const struct symtab_s CONFIG_EXECFUNCS_SYMTAB_ARRAY[];
 extern int CONFIG_EXECFUNCS_NSYMBOLS_VAR;
 #endif
 
+#ifdef EXEC_HAVE_SYMHASH
+extern const struct symtab_hash_s EXEC_SYMHASH;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -167,4 +180,38 @@ void exec_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   leave_critical_section(flags);
 }
 
+#ifdef CONFIG_SYMTAB_HASHED
+/****************************************************************************
+ * Name: exec_getsymhash
+ *
+ * Description:
+ *   Get the precomputed hash index of a symbol table.  Only the system
+ *   symbol table that is generated with CONFIG_EXECFUNCS_SYSTEM_SYMTAB
+ *   comes with one.
+ *
+ * Input Parameters:
+ *   symtab - The symbol table.
+ *   nsymbols - The number of symbols in the symbol table.
+ *
+ * Returned Value:
+ *   The hash index of the symbol table or NULL if it has no precomputed
+ *   index.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_hash_s *
+exec_getsymhash(FAR const struct symtab_s *symtab, int nsymbols)
+{
+#ifdef EXEC_HAVE_SYMHASH
+  if (symtab == CONFIG_EXECFUNCS_SYMTAB_ARRAY &&
+      nsymbols == CONFIG_EXECFUNCS_NSYMBOLS_VAR)
+    {
+      return &EXEC_SYMHASH;
+    }
+#endif
+
+  return NULL;
+}
+#endif
+
 #endif /* CONFIG_LIBC_EXECFUNCS */
@@ -46,6 +46,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/binfmt/elf.h>
+#include <nuttx/symtab.h>
 
 /****************************************************************************
  * Public Function Prototypes
@@ -164,6 +165,7 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
  *   sym      - Symbol table entry (value might be undefined)
  *   exports  - The symbol table to use for resolving undefined symbols.
  *   nexports - Number of symbols in the symbol table.
+ *   hash     - The hash index of the symbol table or NULL.
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -178,7 +180,8 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
  ****************************************************************************/
 
 int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
-                 FAR const struct symtab_s *exports, int nexports);
+                 FAR const struct symtab_s *exports, int nexports,
+                 FAR const struct symtab_hash_s *hash);
 
 /****************************************************************************
  * Name: elf_freebuffers
@@ -70,19 +70,47 @@
 # define elf_dumpbuffer(m,b,n)
 #endif
 
+/* Number of hash chains of the symbol cache (must be a power of two) */
+
+#define ELF_SYMCACHE_NHASH   64
+#define ELF_SYMCACHE_HASH(i) ((unsigned int)(i) & (ELF_SYMCACHE_NHASH - 1))
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
 struct elf_symcache_s
 {
-  dq_entry_t    entry;
-  Elf_Sym       sym;
-  int           idx;
+  dq_entry_t    entry;                 /* LRU list, most recent first */
+  FAR struct elf_symcache_s *hnext;    /* Next entry in the same hash chain */
+  Elf_Sym       sym;                   /* The symbol and its value */
+  int           idx;                   /* The symbol table index */
 };
 
 typedef struct elf_symcache_s elf_symcache_t;
 
+/* The state shared by all of the relocation sections of a program.  Each
+ * symbol is read and looked up only once, no matter how often it is
+ * referenced:  Cached symbols are found by their symbol table index through
+ * a small hash table and are recycled in LRU order once
+ * CONFIG_ELF_SYMBOL_CACHECOUNT symbols are cached.  With
+ * CONFIG_SYMTAB_HASHED, the exported symbols are looked up through a hash
+ * index built once for the program.
+ */
+
+struct elf_bindstate_s
+{
+  FAR const struct symtab_s *exports;      /* Symbols exported by the OS */
+  FAR const struct symtab_hash_s *hash;    /* Hash index of exports or NULL */
+  int           nexports;                  /* Number of exported symbols */
+  int           count;                     /* Number of cached symbols */
+  dq_queue_t    lru;                       /* All cached symbols */
+  FAR elf_symcache_t *chain[ELF_SYMCACHE_NHASH]; /* Chains by symbol index */
+#ifdef CONFIG_SYMTAB_HASHED
+  struct symtab_hash_s exphash;            /* Hash index built for exports */
+#endif
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -91,6 +119,169 @@ typedef struct elf_symcache_s elf_symcache_t;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: elf_symcache_find
+ *
+ * Description:
+ *   Find a symbol in the symbol cache and make it the most recently used
+ *   one.
+ *
+ * Returned Value:
+ *   The cached symbol or NULL if the symbol is not in the cache.
+ *
+ ****************************************************************************/
+
+static FAR Elf_Sym *elf_symcache_find(FAR struct elf_bindstate_s *state,
+                                      int symidx)
+{
+  FAR elf_symcache_t *cache;
+
+  for (cache = state->chain[ELF_SYMCACHE_HASH(symidx)];
+       cache != NULL;
+       cache = cache->hnext)
+    {
+      if (cache->idx == symidx)
+        {
+          dq_rem(&cache->entry, &state->lru);
+          dq_addfirst(&cache->entry, &state->lru);
+          return &cache->sym;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: elf_symcache_load
+ *
+ * Description:
+ *   Read a symbol from the file, get its value and add it to the symbol
+ *   cache, recycling the least recently used symbol if the cache is full.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ESRCH means that the symbol has no name; the symbol is
+ *   still returned and cached in that case.
+ *
+ ****************************************************************************/
+
+static int elf_symcache_load(FAR struct elf_loadinfo_s *loadinfo,
+                             FAR struct elf_bindstate_s *state,
+                             int symidx, FAR Elf_Sym **sym)
+{
+  FAR elf_symcache_t **prev;
+  FAR elf_symcache_t *cache;
+  int ret;
+
+  if (state->count < CONFIG_ELF_SYMBOL_CACHECOUNT)
+    {
+      cache = kmm_malloc(sizeof(elf_symcache_t));
+      if (!cache)
+        {
+          berr("Failed to allocate memory for elf symbols\n");
+          return -ENOMEM;
+        }
+
+      state->count++;
+    }
+  else
+    {
+      /* Recycle the least recently used symbol */
+
+      cache = (FAR elf_symcache_t *)dq_remlast(&state->lru);
+      for (prev = &state->chain[ELF_SYMCACHE_HASH(cache->idx)];
+           *prev != cache;
+           prev = &(*prev)->hnext);
+
+      *prev = cache->hnext;
+    }
+
+  /* Read the symbol table entry into memory and get the value of the
+   * symbol (in sym.st_value)
+   */
+
+  ret = elf_readsym(loadinfo, symidx, &cache->sym);
+  if (ret >= 0)
+    {
+      ret = elf_symvalue(loadinfo, &cache->sym, state->exports,
+                         state->nexports, state->hash);
+    }
+
+  if (ret < 0 && ret != -ESRCH)
+    {
+      kmm_free(cache);
+      state->count--;
+      return ret;
+    }
+
+  cache->idx   = symidx;
+  cache->hnext = state->chain[ELF_SYMCACHE_HASH(symidx)];
+  state->chain[ELF_SYMCACHE_HASH(symidx)] = cache;
+  dq_addfirst(&cache->entry, &state->lru);
+
+  *sym = &cache->sym;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: elf_bindstate_alloc and elf_bindstate_free
+ *
+ * Description:
+ *   Allocate and free the state shared by all relocation sections.
+ *
+ ****************************************************************************/
+
+static FAR struct elf_bindstate_s *
+elf_bindstate_alloc(FAR const struct symtab_s *exports, int nexports)
+{
+  FAR struct elf_bindstate_s *state;
+
+  state = kmm_zalloc(sizeof(struct elf_bindstate_s));
+  if (state == NULL)
+    {
+      return NULL;
+    }
+
+  state->exports  = exports;
+  state->nexports = nexports;
+  dq_init(&state->lru);
+
+#ifdef CONFIG_SYMTAB_HASHED
+  /* Use the precomputed index of the exported symbols if they come with
+   * one.  Otherwise index them now and fall back to searching the symbol
+   * table if the index cannot be allocated.
+   */
+
+#ifdef CONFIG_LIBC_EXECFUNCS
+  state->hash = exec_getsymhash(exports, nexports);
+#endif
+
+  if (state->hash == NULL && exports != NULL &&
+      symtab_hashinit(&state->exphash, exports, nexports) >= 0)
+    {
+      state->hash = &state->exphash;
+    }
+#endif
+
+  return state;
+}
+
+static void elf_bindstate_free(FAR struct elf_bindstate_s *state)
+{
+  FAR dq_entry_t *e;
+
+  while ((e = dq_remfirst(&state->lru)) != NULL)
+    {
+      kmm_free(e);
+    }
+
+#ifdef CONFIG_SYMTAB_HASHED
+  symtab_hashuninit(&state->exphash);
+#endif
+
+  kmm_free(state);
+}
+
 /****************************************************************************
  * Name: elf_readrels
  *
@@ -184,21 +375,17 @@ static inline int elf_readrelas(FAR struct elf_loadinfo_s *loadinfo,
  ****************************************************************************/
 
 static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
-                        FAR const struct symtab_s *exports, int nexports)
+                        FAR struct elf_bindstate_s *state)
 {
   FAR Elf_Shdr         *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr         *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rel          *rels;
   FAR Elf_Rel          *rel;
-  FAR elf_symcache_t   *cache;
   FAR Elf_Sym          *sym;
-  FAR dq_entry_t       *e;
-  dq_queue_t            q;
   uintptr_t             addr;
   int                   symidx;
   int                   ret;
   int                   i;
-  int                   j;
 
   rels = kmm_malloc(CONFIG_ELF_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rel));
   if (rels == NULL)
@@ -207,8 +394,6 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -216,7 +401,7 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -241,61 +426,15 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
       symidx = ELF_R_SYM(rel->r_info);
 
-      /* First try the cache */
-
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
-        {
-          cache = (FAR elf_symcache_t *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
+      /* First try the cache.  If the symbol was not found in the cache,
+       * we will need to read the symbol from the file and get its value.
        */
 
+      sym = elf_symcache_find(state, symidx);
       if (sym == NULL)
         {
-          if (j < CONFIG_ELF_SYMBOL_CACHECOUNT)
-            {
-              cache = kmm_malloc(sizeof(elf_symcache_t));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR elf_symcache_t *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = elf_readsym(loadinfo, symidx, sym);
-          if (ret < 0)
-            {
-              berr("Section %d reloc %d: Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              kmm_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = elf_symvalue(loadinfo, sym, exports, nexports);
-          if (ret < 0)
+          ret = elf_symcache_load(loadinfo, state, symidx, &sym);
+          if (ret == -ESRCH)
             {
               /* The special error -ESRCH is returned only in one condition:
                * The symbol has no name.
@@ -307,24 +446,17 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
                * is best.
                */
 
-              if (ret == -ESRCH)
-                {
-                  berr("Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  kmm_free(cache);
-                  break;
-                }
+              berr("Section %d reloc %d: "
+                   "Undefined symbol[%d] has no name: %d\n",
+                   relidx, i, symidx, ret);
+            }
+          else if (ret < 0)
+            {
+              berr("Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
             }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -358,31 +490,21 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
     }
 
   kmm_free(rels);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      kmm_free(e);
-    }
-
   return ret;
 }
 
 static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
-                           FAR const struct symtab_s *exports, int nexports)
+                           FAR struct elf_bindstate_s *state)
 {
   FAR Elf_Shdr         *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr         *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rela         *relas;
   FAR Elf_Rela         *rela;
-  FAR elf_symcache_t   *cache;
   FAR Elf_Sym          *sym;
-  FAR dq_entry_t       *e;
-  dq_queue_t            q;
   uintptr_t             addr;
   int                   symidx;
   int                   ret;
   int                   i;
-  int                   j;
 
   relas = kmm_malloc(CONFIG_ELF_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rela));
   if (relas == NULL)
@@ -391,8 +513,6 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -400,7 +520,7 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -425,61 +545,15 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
       symidx = ELF_R_SYM(rela->r_info);
 
-      /* First try the cache */
-
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
-        {
-          cache = (FAR elf_symcache_t *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
+      /* First try the cache.  If the symbol was not found in the cache,
+       * we will need to read the symbol from the file and get its value.
        */
 
+      sym = elf_symcache_find(state, symidx);
       if (sym == NULL)
         {
-          if (j < CONFIG_ELF_SYMBOL_CACHECOUNT)
-            {
-              cache = kmm_malloc(sizeof(elf_symcache_t));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR elf_symcache_t *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = elf_readsym(loadinfo, symidx, sym);
-          if (ret < 0)
-            {
-              berr("Section %d reloc %d: Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              kmm_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = elf_symvalue(loadinfo, sym, exports, nexports);
-          if (ret < 0)
+          ret = elf_symcache_load(loadinfo, state, symidx, &sym);
+          if (ret == -ESRCH)
             {
               /* The special error -ESRCH is returned only in one condition:
                * The symbol has no name.
@@ -491,24 +565,17 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
                * is best.
                */
 
-              if (ret == -ESRCH)
-                {
-                  berr("Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  kmm_free(cache);
-                  break;
-                }
+              berr("Section %d reloc %d: "
+                   "Undefined symbol[%d] has no name: %d\n",
+                   relidx, i, symidx, ret);
+            }
+          else if (ret < 0)
+            {
+              berr("Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
             }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -542,12 +609,6 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
     }
 
   kmm_free(relas);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      kmm_free(e);
-    }
-
   return ret;
 }
 
@@ -571,6 +632,7 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
              FAR const struct symtab_s *exports, int nexports)
 {
+  FAR struct elf_bindstate_s *state;
 #ifdef CONFIG_ARCH_ADDRENV
   int status;
 #endif
@@ -596,6 +658,15 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
       return ret;
     }
 
+  /* Allocate the state shared by all relocation sections */
+
+  state = elf_bindstate_alloc(exports, nexports);
+  if (state == NULL)
+    {
+      berr("Failed to allocate memory for the symbol cache\n");
+      return -ENOMEM;
+    }
+
 #ifdef CONFIG_ARCH_ADDRENV
   /* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
    * space that may not be in place now.  elf_addrenv_select() will
@@ -606,6 +677,7 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
   if (ret < 0)
     {
       berr("ERROR: elf_addrenv_select() failed: %d\n", ret);
+      elf_bindstate_free(state);
       return ret;
     }
 #endif
@@ -635,11 +707,11 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
 
       if (loadinfo->shdr[i].sh_type == SHT_REL)
         {
-          ret = elf_relocate(loadinfo, i, exports, nexports);
+          ret = elf_relocate(loadinfo, i, state);
         }
       else if (loadinfo->shdr[i].sh_type == SHT_RELA)
         {
-          ret = elf_relocateadd(loadinfo, i, exports, nexports);
+          ret = elf_relocateadd(loadinfo, i, state);
         }
 
       if (ret < 0)
@@ -648,6 +720,8 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
         }
     }
 
+  elf_bindstate_free(state);
+
 #if defined(CONFIG_ARCH_ADDRENV)
   /* Ensure that the I and D caches are coherent before starting the newly
    * loaded module by cleaning the D cache (i.e., flushing the D cache
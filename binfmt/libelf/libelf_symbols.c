@@ -247,6 +247,9 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
  * Input Parameters:
  *   loadinfo - Load state information
  *   sym      - Symbol table entry (value might be undefined)
+ *   exports  - The symbol table to use for resolving undefined symbols.
+ *   nexports - Number of symbols in the symbol table.
+ *   hash     - The hash index of the symbol table or NULL.
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -261,7 +264,8 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
  ****************************************************************************/
 
 int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
-                 FAR const struct symtab_s *exports, int nexports)
+                 FAR const struct symtab_s *exports, int nexports,
+                 FAR const struct symtab_hash_s *hash)
 {
   FAR const struct symtab_s *symbol;
   uintptr_t secbase;
@@ -304,14 +308,23 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
 
         /* Check if the base code exports a symbol of this name */
 
+        if (hash != NULL)
+          {
+            symbol = symtab_findbyhash(exports, hash,
+                                       (FAR char *)loadinfo->iobuffer);
+          }
+        else
+          {
 #ifdef CONFIG_SYMTAB_ORDEREDBYNAME
-        symbol = symtab_findorderedbyname(exports,
-                                          (FAR char *)loadinfo->iobuffer,
-                                          nexports);
+            symbol = symtab_findorderedbyname(exports,
+                                              (FAR char *)loadinfo->iobuffer,
+                                              nexports);
 #else
-        symbol = symtab_findbyname(exports, (FAR char *)loadinfo->iobuffer,
-                                   nexports);
+            symbol = symtab_findbyname(exports,
+                                       (FAR char *)loadinfo->iobuffer,
+                                       nexports);
 #endif
+          }
         if (!symbol)
           {
             berr("SHN_UNDEF: Exported symbol \"%s\" not found\n",
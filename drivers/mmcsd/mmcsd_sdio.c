@@ -85,6 +85,16 @@
 
 #define IS_EMPTY(priv) (priv->type == MMCSD_CARDTYPE_UNKNOWN)
 
+/* Read-ahead and write buffer sizes (in 512 byte blocks) */
+
+#ifndef CONFIG_MMCSD_NWRBLOCKS
+#  define CONFIG_MMCSD_NWRBLOCKS 16
+#endif
+
+#ifndef CONFIG_MMCSD_NRDBLOCKS
+#  define CONFIG_MMCSD_NRDBLOCKS 8
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -148,6 +158,19 @@ static int    mmcsd_takesem(FAR struct mmcsd_state_s *priv);
 #  define mmcsd_givesem(p) nxsem_post(&priv->sem);
 #endif
 
+/* The buffer callouts may run on the write-back worker thread without the
+ * driver semaphore.  Other accesses to the card outside of the callouts
+ * must also hold the buffer's device lock.
+ */
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+#  define mmcsd_lockdev(p)   rwb_lock(&(p)->rwbuffer)
+#  define mmcsd_unlockdev(p) rwb_unlock(&(p)->rwbuffer)
+#else
+#  define mmcsd_lockdev(p)
+#  define mmcsd_unlockdev(p)
+#endif
+
 /* Command/response helpers *************************************************/
 
 static int     mmcsd_sendcmdpoll(FAR struct mmcsd_state_s *priv,
@@ -189,7 +212,7 @@ static ssize_t mmcsd_readsingle(FAR struct mmcsd_state_s *priv,
 static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
                  FAR uint8_t *buffer, off_t startblock, size_t nblocks);
 #endif
-#ifdef CONFIG_DRVR_READAHEAD
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
 static ssize_t mmcsd_reload(FAR void *dev, FAR uint8_t *buffer,
                  off_t startblock, size_t nblocks);
 #endif
@@ -200,7 +223,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
                  FAR const uint8_t *buffer, off_t startblock,
                  size_t nblocks);
 #endif
-#ifdef CONFIG_DRVR_WRITEBUFFER
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
 static ssize_t mmcsd_flush(FAR void *dev, FAR const uint8_t *buffer,
                  off_t startblock, size_t nblocks);
 #endif
@@ -1644,7 +1667,7 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_DRVR_READAHEAD
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
 static ssize_t mmcsd_reload(FAR void *dev, FAR uint8_t *buffer,
                             off_t startblock, size_t nblocks)
 {
@@ -2089,7 +2112,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
  *
  ****************************************************************************/
 
-#if defined(CONFIG_DRVR_WRITEBUFFER)
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
 static ssize_t mmcsd_flush(FAR void *dev, FAR const uint8_t *buffer,
                            off_t startblock, size_t nblocks)
 {
@@ -2216,7 +2239,8 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
                           size_t startsector, unsigned int nsectors)
 {
   FAR struct mmcsd_state_s *priv;
-#if !defined(CONFIG_DRVR_READAHEAD) && defined(CONFIG_MMCSD_MULTIBLOCK_DISABLE)
+#if !defined(CONFIG_DRVR_WRITEBUFFER) && !defined(CONFIG_DRVR_READAHEAD) && \
+    defined(CONFIG_MMCSD_MULTIBLOCK_DISABLE)
   size_t sector;
   size_t endsector;
 #endif
@@ -2235,8 +2259,10 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
           return (ssize_t)ret;
         }
 
-#if defined(CONFIG_DRVR_READAHEAD)
-      /* Get the data from the read-ahead buffer */
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+      /* Get the data from the write buffer, the read-ahead buffer or the
+       * card.
+       */
 
       ret = rwb_read(&priv->rwbuffer, startsector, nsectors, buffer);
 
@@ -2295,7 +2321,8 @@ static ssize_t mmcsd_write(FAR struct inode *inode,
                            size_t startsector, unsigned int nsectors)
 {
   FAR struct mmcsd_state_s *priv;
-#if defined(CONFIG_MMCSD_MULTIBLOCK_DISABLE)
+#if !defined(CONFIG_DRVR_WRITEBUFFER) && !defined(CONFIG_DRVR_READAHEAD) && \
+    defined(CONFIG_MMCSD_MULTIBLOCK_DISABLE)
   size_t sector;
   size_t endsector;
 #endif
@@ -2313,8 +2340,10 @@ static ssize_t mmcsd_write(FAR struct inode *inode,
       return (ssize_t)ret;
     }
 
-#if defined(CONFIG_DRVR_WRITEBUFFER)
-  /* Write the data to the write buffer */
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+  /* Write the data to the write buffer.  Without a write buffer, this
+   * writes the card directly and discards stale read-ahead data.
+   */
 
   ret = rwb_write(&priv->rwbuffer, startsector, nsectors, buffer);
 
@@ -2448,9 +2477,17 @@ static int mmcsd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       {
         finfo("BIOC_PROBE\n");
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+        /* Write back the data buffered for the card in the slot first */
+
+        rwb_flush(&priv->rwbuffer);
+#endif
+
         /* Probe the MMC/SD slot for media */
 
+        mmcsd_lockdev(priv);
         ret = mmcsd_probe(priv);
+        mmcsd_unlockdev(priv);
         if (ret != OK)
           {
             ferr("ERROR: mmcsd_probe failed: %d\n", ret);
@@ -2462,9 +2499,22 @@ static int mmcsd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       {
         finfo("BIOC_EJECT\n");
 
+#if defined(CONFIG_DRVR_REMOVABLE) && \
+    (defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD))
+        /* Discard the buffered data of the card.  This cancels pending
+         * write-back; a write that is in progress completes before the
+         * device lock is granted.
+         */
+
+        rwb_mediaremoved(&priv->rwbuffer);
+#endif
+
         /* Process the removal of the card */
 
+        mmcsd_lockdev(priv);
         ret = mmcsd_removed(priv);
+        mmcsd_unlockdev(priv);
+
         if (ret != OK)
           {
             ferr("ERROR: mmcsd_removed failed: %d\n", ret);
@@ -2476,6 +2526,25 @@ static int mmcsd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       }
       break;
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+    case BIOC_FLUSH: /* Write back the write buffer */
+      {
+        finfo("BIOC_FLUSH\n");
+        ret = rwb_flush(&priv->rwbuffer);
+      }
+      break;
+
+    case BIOC_RWBSTATS: /* Return the write buffer statistics */
+      {
+        FAR struct rwb_stats_s *stats =
+          (FAR struct rwb_stats_s *)((uintptr_t)arg);
+
+        finfo("BIOC_RWBSTATS\n");
+        ret = rwb_getstats(&priv->rwbuffer, stats);
+      }
+      break;
+#endif
+
     default:
       ret = -ENOTTY;
       break;
@@ -2527,17 +2596,26 @@ static void mmcsd_mediachange(FAR void *arg)
        * appropriately.
        */
 
+      mmcsd_lockdev(priv);
       mmcsd_probe(priv);
+      mmcsd_unlockdev(priv);
     }
   else
     {
       /* No... process the card removal.  This could have very bad
        * implications for any mounted file systems!  NOTE that
        * mmcsd_removed() does NOT re-enable callbacks so we will need to
-       * do that here.
+       * do that here.  Pending write-back is discarded first.
        */
 
+#if defined(CONFIG_DRVR_REMOVABLE) && \
+    (defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD))
+      rwb_mediaremoved(&priv->rwbuffer);
+#endif
+
+      mmcsd_lockdev(priv);
       mmcsd_removed(priv);
+      mmcsd_unlockdev(priv);
 
       /* Enable logic to detect if a card is re-inserted */
 
@@ -3479,6 +3557,12 @@ static int mmcsd_probe(FAR struct mmcsd_state_s *priv)
               finfo("Capacity: %lu Kbytes\n",
                     (unsigned long)(priv->capacity / 1024));
               priv->mediachanged = true;
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+              /* Reads through the buffers stop at the end of the card */
+
+              priv->rwbuffer.nblocks = priv->nblocks;
+#endif
             }
         }
 
@@ -3713,6 +3797,32 @@ int mmcsd_slotinitialize(int minor, FAR struct sdio_dev_s *dev)
 
       priv->dev = dev;
 
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+      /* Initialize buffering.  The number of blocks is updated whenever a
+       * card is probed.  This must be done before the hardware is set up:
+       * the media change callback uses the buffer's device lock.
+       */
+
+      priv->rwbuffer.blocksize   = 512;
+      priv->rwbuffer.nblocks     = 1;
+      priv->rwbuffer.dev         = priv;
+      priv->rwbuffer.wrflush     = mmcsd_flush;
+      priv->rwbuffer.rhreload    = mmcsd_reload;
+#ifdef CONFIG_DRVR_WRITEBUFFER
+      priv->rwbuffer.wrmaxblocks = CONFIG_MMCSD_NWRBLOCKS;
+#endif
+#ifdef CONFIG_DRVR_READAHEAD
+      priv->rwbuffer.rhmaxblocks = CONFIG_MMCSD_NRDBLOCKS;
+#endif
+
+      ret = rwb_initialize(&priv->rwbuffer);
+      if (ret < 0)
+        {
+          ferr("ERROR: Buffer setup failed: %d\n", ret);
+          goto errout_with_alloc;
+        }
+#endif
+
       /* Initialize the hardware associated with the slot */
 
       ret = mmcsd_hwinitialize(priv);
@@ -3742,22 +3852,10 @@ int mmcsd_slotinitialize(int minor, FAR struct sdio_dev_s *dev)
               /* Some other non-recoverable bad thing happened */
 
               ferr("ERROR: Failed to initialize MMC/SD slot: %d\n", ret);
-              goto errout_with_alloc;
+              goto errout_with_buffers;
             }
         }
 
-#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
-      /* Initialize buffering */
-
-#warning "Missing setup of rwbuffer"
-      ret = rwb_initialize(&priv->rwbuffer);
-      if (ret < 0)
-        {
-          ferr("ERROR: Buffer setup failed: %d\n", ret);
-          goto errout_with_hwinit;
-        }
-#endif
-
       /* Create a MMCSD device name */
 
       snprintf(devname, 16, "/dev/mmcsd%d", minor);
@@ -3768,21 +3866,25 @@ int mmcsd_slotinitialize(int minor, FAR struct sdio_dev_s *dev)
       if (ret < 0)
         {
           ferr("ERROR: register_blockdriver failed: %d\n", ret);
-          goto errout_with_buffers;
+          goto errout_with_hwinit;
         }
     }
 
   return OK;
 
-errout_with_buffers:
+errout_with_hwinit:
 #if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
   rwb_uninitialize(&priv->rwbuffer);
-errout_with_hwinit:
 #endif
   mmcsd_hwuninitialize(priv);  /* This will free the private data structure */
   return ret;
 
+errout_with_buffers:
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
+  rwb_uninitialize(&priv->rwbuffer);
+
 errout_with_alloc:
+#endif
   kmm_free(priv);
   return ret;
 }
@@ -528,6 +528,11 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     {
       return rwb_flush(&dev->rwb);
     }
+  else if (cmd == BIOC_RWBSTATS)
+    {
+      return rwb_getstats(&dev->rwb,
+                          (FAR struct rwb_stats_s *)((uintptr_t)arg));
+    }
 #endif
 
   /* No other block driver ioctl commands are not recognized by this
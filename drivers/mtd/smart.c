@@ -59,6 +59,8 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -109,9 +111,17 @@
 #define SMART_FMT_SIG3            'R'
 #define SMART_FMT_SIG4            'T'
 
+/* A volume with a checkpoint area has a signature of its own.  Drivers
+ * without checkpoint support do not recognize it and so never modify the
+ * volume without invalidating the checkpoint.
+ */
+
+#define SMART_FMT_SIG4_CHECKPOINT 'C'
+
 #define SMART_FMT_VERSION_POS     (SMART_FMT_POS1 + 4)
 #define SMART_FMT_NAMESIZE_POS    (SMART_FMT_POS1 + 5)
 #define SMART_FMT_ROOTDIRS_POS    (SMART_FMT_POS1 + 6)
+#define SMART_FMT_CPBLOCKS_POS    (SMART_FMT_POS1 + 7) /* Checkpoint blocks */
 #define SMARTFS_FMT_WEAR_POS      36
 #define SMART_WEAR_LEVEL_FORMAT_SIG 32
 #define SMART_PARTNAME_SIZE         4
@@ -135,6 +145,49 @@
 #  define CONFIG_MTD_SMART_SECTOR_SIZE 1024
 #endif
 
+/* Garbage collection thresholds.  A writer must collect when the free
+ * sectors are down to the minimum needed to relocate an erase block.  With
+ * background collection, the worker collects while the free sectors are
+ * below the reserve.
+ */
+
+#define SMART_GC_MINFREE(d)     ((d)->sectorsperblk + 4)
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+#  ifndef CONFIG_MTD_SMART_GC_RESERVE
+#    define CONFIG_MTD_SMART_GC_RESERVE 4
+#  endif
+#  define SMART_GC_RESERVE(d)   (CONFIG_MTD_SMART_GC_RESERVE * \
+                                 (d)->availsectperblk + 4)
+#endif
+
+/* The device must be locked while the garbage collection worker may run */
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+#  define smart_lock(d)         nxsem_wait_uninterruptible(&(d)->exclsem)
+#  define smart_unlock(d)       nxsem_post(&(d)->exclsem)
+#else
+#  define smart_lock(d)         OK
+#  define smart_unlock(d)
+#endif
+
+/* Size of the packed sector map.  Two bytes of padding allow every entry
+ * to be accessed as three bytes.
+ */
+
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+#  define SMART_PMAP_SIZE(d)    ((((uint32_t)(d)->totalsectors * \
+                                   (d)->mapbits + 7) >> 3) + 2)
+#endif
+
+/* The checkpoint holds the complete sector map */
+
+#if defined(CONFIG_MTD_SMART_CHECKPOINT) && \
+    defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && \
+    !defined(CONFIG_MTD_SMART_PACKED_MAP)
+#  error "CONFIG_MTD_SMART_CHECKPOINT needs a complete sector map"
+#endif
+
 #ifndef offsetof
 #define offsetof(type, member) ( (size_t) &( ( (type *) 0)->member))
 #endif
@@ -158,6 +211,34 @@
 #define SMART_WEARFLAGS_FORCE_REORG         0x01
 #define SMART_WEARFLAGS_WRITE_NEEDED        0x02
 
+/* Checkpoint of the sector map.  The checkpoint is kept in the last erase
+ * blocks of the volume in sectors with a logical sector number that is
+ * never assigned.  It is valid only until the volume is next modified.
+ */
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+#  define SMART_CP_SECTOR       0xfffe
+#  define SMART_CP_VERSION      1
+#  define SMART_CP_VALID        (CONFIG_SMARTFS_ERASEDSTATE ^ 0x01)
+#  define SMART_CP_INVALID      (CONFIG_SMARTFS_ERASEDSTATE ^ 0xff)
+#  define SMART_CP_SIG          "SMCP"
+#  define SMART_CP_DATASIZE(d)  ((d)->sectorsize - \
+                                 sizeof(struct smart_sect_header_s))
+#  ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#    define SMART_CP_BITMAPSIZE(d) (((d)->totalsectors + 7) >> 3)
+#  else
+#    define SMART_CP_BITMAPSIZE(d) 0
+#  endif
+
+#  define SMART_CPFLAGS_AREA    0x01        /* Checkpoint area reserved */
+#  define SMART_CPFLAGS_VALID   0x02        /* Checkpoint on media is valid */
+
+#  define smart_cp_block(d, b)  (((d)->cpflags & SMART_CPFLAGS_AREA) != 0 && \
+                                 (b) >= (d)->cpblock)
+#else
+#  define smart_cp_block(d, b)  false
+#endif
+
 #define SET_BITMAP(m, n) do { (m)[(n) / 8] |= 1 << ((n) % 8); } while (0)
 #define CLR_BITMAP(m, n) do { (m)[(n) / 8] &= ~(1 << ((n) % 8)); } while (0)
 #define ISSET_BITMAP(m, n) ((m)[(n) / 8] & (1 << ((n) % 8)))
@@ -207,7 +288,8 @@ static const uint8_t g_wearbit_to_levelmap4[] =
  * Private Types
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && \
+    !defined(CONFIG_MTD_SMART_PACKED_MAP)
 struct smart_cache_s
 {
   uint16_t              logical;          /* Logical sector number */
@@ -278,12 +360,30 @@ struct smart_struct_s
   FAR uint16_t         *smap;             /* Virtual to physical sector map */
 #else
   FAR uint8_t          *sbitmap;          /* Virtual sector used bit-map */
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  FAR uint8_t          *pmap;             /* Packed logical to physical map */
+  uint8_t               mapbits;          /* Number of bits per map entry */
+#else
   FAR struct smart_cache_s *scache;       /* Sector cache */
   uint16_t              cache_entries;    /* Number of valid entries in the cache */
   uint16_t              cache_lastlog;    /* Keep track of the last sector accessed */
   uint16_t              cache_lastphys;   /* Keep the physical sector number also */
   uint16_t              cache_nextbirth;  /* Sector cache aging value */
 #endif
+#endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  sem_t                 exclsem;          /* Exclusive access to the device */
+  struct work_s         gcwork;           /* Garbage collection work */
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  FAR uint8_t          *wearpending;      /* Blocks waiting for static data */
+#endif
+#endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  uint32_t              cpmapsize;        /* Size of the map and the counts */
+  uint16_t              cpblock;          /* First block of checkpoint area */
+  uint8_t               cpflags;          /* Checkpoint area status */
+  uint8_t               crefs;            /* Number of open references */
+#endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
   FAR uint8_t          *erasecounts;      /* Number of erases for each erase block */
 #endif
@@ -400,6 +500,28 @@ struct smart_entry_header_s
   uint32_t          utc;           /* Time stamp */
 };
 
+/* Header at the start of the data of the first checkpoint sector.  It is
+ * followed by the sector map and the free and release counts (and the
+ * logical sector bitmap with CONFIG_MTD_SMART_MINIMIZE_RAM).  The CRC
+ * covers everything after the state byte.
+ */
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+struct smart_cp_header_s
+{
+  uint8_t           sig[4];        /* Signature "SMCP" */
+  uint8_t           state;         /* SMART_CP_VALID or SMART_CP_INVALID */
+  uint8_t           version;       /* Checkpoint version */
+  uint16_t          sectorsize;    /* Geometry the checkpoint was made for */
+  uint16_t          totalsectors;
+  uint16_t          neraseblocks;
+  uint16_t          freesectors;   /* Free and released sector totals */
+  uint16_t          releasesectors;
+  uint32_t          size;          /* Size of the data after the header */
+  uint32_t          crc;           /* CRC-32 of the checkpoint */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -435,11 +557,25 @@ static int     smart_validate_crc(FAR struct smart_struct_s *dev);
 static int     smart_read_wearstatus(FAR struct smart_struct_s *dev);
 static int     smart_relocate_static_data(FAR struct smart_struct_s *dev,
                  uint16_t block);
+static void    smart_wear_relocate(FAR struct smart_struct_s *dev,
+                 uint16_t block);
+#endif
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void    smart_gcschedule(FAR struct smart_struct_s *dev);
+static void    smart_gcworker(FAR void *arg);
 #endif
 
 static int     smart_relocate_sector(FAR struct smart_struct_s *dev,
                  uint16_t oldsector, uint16_t newsector);
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void    smart_cp_reserve(FAR struct smart_struct_s *dev);
+static int     smart_cp_load(FAR struct smart_struct_s *dev);
+static int     smart_cp_invalidate(FAR struct smart_struct_s *dev);
+static int     smart_cp_write(FAR struct smart_struct_s *dev);
+#endif
+
 #ifdef CONFIG_MTD_SMART_FSCK
 static int     smart_fsck(FAR struct smart_struct_s *dev);
 #endif
@@ -493,8 +629,40 @@ static const struct file_operations g_fops =
 
 static int smart_open(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  FAR struct smart_struct_s *dev;
+  int ret;
+
+  finfo("Entry\n");
+
+  DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+  ret = smart_lock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (dev->crefs == UINT8_MAX)
+    {
+      ret = -EMFILE;
+    }
+  else
+    {
+      dev->crefs++;
+    }
+
+  smart_unlock(dev);
+  return ret;
+#else
   finfo("Entry\n");
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -506,8 +674,41 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  FAR struct smart_struct_s *dev;
+  int ret;
+
+  finfo("Entry\n");
+
+  DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+  ret = smart_lock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Checkpoint the sector map on the last close, so that the next mount
+   * needs no scan.
+   */
+
+  ret = OK;
+  if (dev->crefs > 0 && --dev->crefs == 0)
+    {
+      ret = smart_cp_write(dev);
+    }
+
+  smart_unlock(dev);
+  return ret;
+#else
   finfo("Entry\n");
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -893,6 +1094,7 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
                           size_t start_sector, unsigned int nsectors)
 {
   FAR struct smart_struct_s *dev;
+  ssize_t ret;
 
   finfo("SMART: sector: %d nsectors: %d\n", start_sector, nsectors);
 
@@ -902,7 +1104,16 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
 #else
   dev = (struct smart_struct_s *)inode->i_private;
 #endif
-  return smart_reload(dev, buffer, start_sector, nsectors);
+
+  ret = smart_lock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = smart_reload(dev, buffer, start_sector, nsectors);
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -939,7 +1150,19 @@ static ssize_t smart_write(FAR struct inode *inode,
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-  /* I think maybe we need to lock on a mutex here */
+  ret = smart_lock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  ret = smart_cp_invalidate(dev);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+#endif
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
@@ -978,10 +1201,7 @@ static ssize_t smart_write(FAR struct inode *inode,
           if (ret < 0)
             {
               ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
-
-              /* Unlock the mutex if we add one */
-
-              return ret;
+              goto errout;
             }
         }
 
@@ -1007,10 +1227,8 @@ static ssize_t smart_write(FAR struct inode *inode,
           /* The block is not empty!!  What to do? */
 
           ferr("ERROR: Write block %d failed: %d.\n", nextblock, nxfrd);
-
-          /* Unlock the mutex if we add one */
-
-          return -EIO;
+          ret = -EIO;
+          goto errout;
         }
 
       /* Then update for amount written */
@@ -1021,7 +1239,11 @@ static ssize_t smart_write(FAR struct inode *inode,
       alignedblock += mtdblkspererase;
     }
 
-  return nsectors;
+  ret = nsectors;
+
+errout:
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -1079,6 +1301,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
   uint32_t  erasesize;
   uint32_t  totalsectors;
   uint32_t  allocsize;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  uint32_t  cpsectors;
+#endif
 
   /* Validate the size isn't zero so we don't divide by zero below */
 
@@ -1152,9 +1377,19 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
       dev->sbitmap = NULL;
     }
 
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  /* The size of the map depends on the number of sectors */
+
+  if (dev->pmap != NULL)
+    {
+      smart_free(dev, dev->pmap);
+      dev->pmap = NULL;
+    }
+#else
   dev->cache_entries = 0;
   dev->cache_lastlog = 0xffff;
   dev->cache_nextbirth = 0;
+#endif
 #endif
 
   if (dev->rwbuffer != NULL)
@@ -1209,6 +1444,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
   dev->releasecount = (FAR uint8_t *) dev->smap +
                       (totalsectors * sizeof(uint16_t));
   dev->freecount = dev->releasecount + dev->neraseblocks;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  dev->cpmapsize = totalsectors * sizeof(uint16_t) + allocsize;
+#endif
 #else
   dev->sbitmap = (FAR uint8_t *)
     smart_malloc(dev, (totalsectors + 7) >> 3, "Sector Bitmap");
@@ -1238,6 +1476,31 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
   allocsize = dev->neraseblocks << 1;
 #endif
 
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  /* Allocate the packed sector map.  An entry holds any physical sector
+   * number plus the all-ones pattern for an unmapped logical sector.
+   */
+
+  dev->mapbits = 1;
+  while ((1ul << dev->mapbits) <= totalsectors)
+    {
+      dev->mapbits++;
+    }
+
+  dev->pmap = (FAR uint8_t *)
+    smart_malloc(dev, SMART_PMAP_SIZE(dev) + allocsize, "Sector Map");
+  if (!dev->pmap)
+    {
+      ferr("ERROR: Error allocating SMART sector map\n");
+      goto errexit;
+    }
+
+  memset(dev->pmap, 0xff, SMART_PMAP_SIZE(dev));
+  dev->releasecount = dev->pmap + SMART_PMAP_SIZE(dev);
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  dev->cpmapsize = SMART_PMAP_SIZE(dev) + allocsize;
+#endif
+#else
   /* Allocate the sector cache */
 
   if (dev->scache == NULL)
@@ -1255,6 +1518,7 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
   dev->releasecount = (FAR uint8_t *)dev->scache +
     (CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s));
+#endif
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
   if (dev->sectorsperblk > 16)
@@ -1277,6 +1541,36 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 #endif /* CONFIG_MTD_SMART_MINIMIZE_RAM */
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* Size the checkpoint area at the end of the volume.  The last two
+   * sectors of a 65536 sector device can't be used.  There is no area if
+   * it would take more than half of the volume.  A volume that was
+   * formatted with an area of another size keeps it (smart_readformat()).
+   */
+
+  cpsectors = sizeof(struct smart_cp_header_s) + dev->cpmapsize +
+              SMART_CP_BITMAPSIZE(dev);
+  cpsectors = (cpsectors + SMART_CP_DATASIZE(dev) - 1) /
+              SMART_CP_DATASIZE(dev);
+  if (totalsectors == 65534)
+    {
+      cpsectors += 2;
+    }
+
+  cpsectors = (cpsectors + dev->availsectperblk - 1) /
+              dev->availsectperblk;
+  if ((cpsectors << 1) <= dev->neraseblocks && cpsectors <= UINT8_MAX)
+    {
+      dev->cpblock = dev->neraseblocks - cpsectors;
+    }
+  else
+    {
+      dev->cpblock = dev->neraseblocks;
+    }
+
+  dev->cpflags = 0;
+#endif
+
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
   /* Allocate a buffer to hold the erase counts */
 
@@ -1296,10 +1590,19 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 #endif
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-  /* Allocate the wear leveling status array */
+  /* Allocate the wear leveling status array.  With background garbage
+   * collection, the bitmap of the worn blocks waiting for static data
+   * follows it.
+   */
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  dev->wearstatus = (FAR uint8_t *) smart_malloc(dev, (dev->neraseblocks >>
+      SMART_WEAR_BIT_DIVIDE) + ((dev->neraseblocks + 7) >> 3),
+      "Wear status");
+#else
   dev->wearstatus = (FAR uint8_t *) smart_malloc(dev, dev->neraseblocks >>
       SMART_WEAR_BIT_DIVIDE, "Wear status");
+#endif
   if (!dev->wearstatus)
     {
       ferr("ERROR: Error allocating wear level status array\n");
@@ -1308,6 +1611,11 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
   memset(dev->wearstatus, CONFIG_SMARTFS_ERASEDSTATE, dev->neraseblocks >>
          SMART_WEAR_BIT_DIVIDE);
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  dev->wearpending = dev->wearstatus +
+                     (dev->neraseblocks >> SMART_WEAR_BIT_DIVIDE);
+  memset(dev->wearpending, 0, (dev->neraseblocks + 7) >> 3);
+#endif
   dev->wearflags = 0;
   dev->uneven_wearcount = 0;
 #endif
@@ -1343,12 +1651,20 @@ errexit:
       dev->sbitmap = NULL;
     }
 
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  if (dev->pmap)
+    {
+      smart_free(dev, dev->pmap);
+      dev->pmap = NULL;
+    }
+#else
   if (dev->scache)
     {
       smart_free(dev, dev->scache);
       dev->scache = NULL;
     }
 #endif
+#endif
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
   if (dev->wearstatus)
@@ -1455,7 +1771,8 @@ errout:
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && \
+    !defined(CONFIG_MTD_SMART_PACKED_MAP)
 static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
             uint16_t logical, uint16_t physical, int line)
 {
@@ -1535,7 +1852,8 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && \
+    !defined(CONFIG_MTD_SMART_PACKED_MAP)
 static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev,
                                    uint16_t logical)
 {
@@ -1672,7 +1990,8 @@ err_out:
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && \
+    !defined(CONFIG_MTD_SMART_PACKED_MAP)
 static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t
     logical, uint16_t physical)
 {
@@ -1718,6 +2037,107 @@ static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_add_sector_to_cache
+ *
+ * Description: Adds a logical to physical sector mapping to the packed
+ *              sector map.  The packed map holds the mapping of every
+ *              logical sector using only as many bits per entry as needed
+ *              to address the physical sectors of the volume, so no media
+ *              scan is ever needed to resolve a mapping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
+            uint16_t logical, uint16_t physical, int line)
+{
+  FAR uint8_t *ptr;
+  uint32_t     bit;
+  uint32_t     mask;
+  uint32_t     value;
+
+  if (logical >= dev->totalsectors)
+    {
+      return -EINVAL;
+    }
+
+  if (dev->debuglevel > 1)
+    {
+      _err("Add Map sector:  Log=%d, Phys=%d from line %d\n",
+          logical, physical, line);
+    }
+
+  /* An entry spans at most three bytes.  The unused value (all ones)
+   * marks an unmapped logical sector.
+   */
+
+  mask  = (1ul << dev->mapbits) - 1;
+  bit   = (uint32_t)logical * dev->mapbits;
+  ptr   = &dev->pmap[bit >> 3];
+  bit  &= 7;
+
+  value = ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16);
+  value = (value & ~(mask << bit)) | (((uint32_t)physical & mask) << bit);
+
+  ptr[0] = (uint8_t)value;
+  ptr[1] = (uint8_t)(value >> 8);
+  ptr[2] = (uint8_t)(value >> 16);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cache_lookup
+ *
+ * Description: Return the physical sector mapped to the requested logical
+ *              sector from the packed sector map, or 0xffff if the logical
+ *              sector is not mapped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev,
+                                   uint16_t logical)
+{
+  FAR const uint8_t *ptr;
+  uint32_t           bit;
+  uint32_t           mask;
+  uint32_t           value;
+
+  if (logical >= dev->totalsectors)
+    {
+      return 0xffff;
+    }
+
+  mask  = (1ul << dev->mapbits) - 1;
+  bit   = (uint32_t)logical * dev->mapbits;
+  ptr   = &dev->pmap[bit >> 3];
+
+  value = ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16);
+  value = (value >> (bit & 7)) & mask;
+
+  return value == mask ? 0xffff : (uint16_t)value;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_update_cache
+ *
+ * Description: Replaces the logical sector's physical sector mapping in
+ *              the packed sector map.  A physical sector of 0xffff removes
+ *              the mapping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t
+    logical, uint16_t physical)
+{
+  smart_add_sector_to_cache(dev, logical, physical, __LINE__);
+}
+#endif
+
 /****************************************************************************
  * Name: smart_get_wear_level
  *
@@ -1777,6 +2197,13 @@ static void smart_find_wear_minmax(FAR struct smart_struct_s *dev)
 
   for (x = 0; x < dev->geo.neraseblocks; x++)
     {
+      /* The checkpoint area is not wear leveled */
+
+      if (smart_cp_block(dev, x))
+        {
+          continue;
+        }
+
       /* Find wear level of the minimum worn block */
 
       level = smart_get_wear_level(dev, x);
@@ -1908,50 +2335,169 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev,
 #endif
 
 /****************************************************************************
- * Name: smart_scan
+ * Name: smart_readformat
  *
- * Description: Performs a scan of the MTD device searching for format
- *              information and fills in logical sector mapping, freesector
- *              count, etc.
+ * Description: Reads the format information from the logical sector zero
+ *              at the given address.  Additional block devices are
+ *              registered for a volume with several root directories.
  *
  ****************************************************************************/
 
-static int smart_scan(FAR struct smart_struct_s *dev)
+static int smart_readformat(FAR struct smart_struct_s *dev,
+                            uint32_t readaddress)
 {
-  int       sector;
   int       ret;
-  uint16_t  totalsectors;
-  uint16_t  sectorsize;
-  uint16_t  prerelease;
-  uint16_t  logicalsector;
-  uint16_t  winner;
-  uint16_t  loser;
-  uint32_t  readaddress;
-  uint32_t  offset;
-  uint16_t  seq1;
-  uint16_t  seq2;
-  uint16_t  seqwrap;
-  struct    smart_sect_header_s header;
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
-  int       dupsector;
-  uint16_t  duplogsector;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  uint16_t  cpblocks;
 #endif
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
   int       x;
   char      devname[22];
   FAR struct smart_multiroot_device_s *rootdirdev;
 #endif
-  static const short sizetbl[8] =
-  {
-    CONFIG_MTD_SMART_SECTOR_SIZE,
-    512, 1024, 4096, 2048, 8192, 16384, 32768
-  };
 
-  finfo("Entry\n");
+  /* Read the sector data */
 
-  /* Find the sector size on the volume by reading headers from
-   * sectors of decreasing size.  On a formatted volume, the sector
-   * size is saved in the header status byte of search sector, so
+  ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 32)
+    {
+      ferr("ERROR: Error reading physical sector %d.\n",
+           readaddress / (dev->mtdblkspersector * dev->geo.blocksize));
+      return -EIO;
+    }
+
+  /* Validate the format signature */
+
+  if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
+      dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
+      dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* Take the checkpoint area of the volume as it was formatted */
+
+  if (dev->rwbuffer[SMART_FMT_POS4] == SMART_FMT_SIG4_CHECKPOINT)
+    {
+      cpblocks = dev->rwbuffer[SMART_FMT_CPBLOCKS_POS];
+      if (cpblocks == 0 || (cpblocks << 1) > dev->neraseblocks)
+        {
+          return -EINVAL;
+        }
+
+      dev->cpblock  = dev->neraseblocks - cpblocks;
+      dev->cpflags |= SMART_CPFLAGS_AREA;
+    }
+  else
+#endif
+  if (dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+    {
+      return -EINVAL;
+    }
+
+  /* Mark the volume as formatted and set the sector size */
+
+  dev->formatstatus = SMART_FMT_STAT_FORMATTED;
+  dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
+  dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
+
+  /* If rootdirentries is greater than 1, then we need to register
+   * additional block devices.
+   */
+
+  for (x = 1; x < dev->rootdirentries; x++)
+    {
+      if (dev->partname[0] != '\0')
+        {
+          snprintf(dev->rwbuffer, sizeof(devname),
+                   "/dev/smart%d%sd%d",
+                   dev->minor, dev->partname, x + 1);
+        }
+      else
+        {
+          snprintf(devname, sizeof(devname), "/dev/smart%dd%d",
+                   dev->minor, x + 1);
+        }
+
+      /* Inode private data is a reference to a struct containing
+       * the SMART device structure and the root directory number.
+       */
+
+      rootdirdev = (struct smart_multiroot_device_s *)
+        smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
+      if (rootdirdev == NULL)
+        {
+          ferr("ERROR: Memory alloc failed\n");
+          return -ENOMEM;
+        }
+
+      /* Populate the rootdirdev */
+
+      rootdirdev->dev = dev;
+      rootdirdev->rootdirnum = x;
+      ret = register_blockdriver(dev->rwbuffer, &g_bops, 0,
+                                 rootdirdev);
+
+      /* Inode private data is a reference to the SMART device
+       * structure.
+       */
+
+      ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smart_scan
+ *
+ * Description: Performs a scan of the MTD device searching for format
+ *              information and fills in logical sector mapping, freesector
+ *              count, etc.
+ *
+ ****************************************************************************/
+
+static int smart_scan(FAR struct smart_struct_s *dev)
+{
+  int       sector;
+  int       ret;
+  uint16_t  totalsectors;
+  uint16_t  sectorsize;
+  uint16_t  prerelease;
+  uint16_t  logicalsector;
+  uint16_t  winner;
+  uint16_t  loser;
+  uint32_t  readaddress;
+  uint32_t  offset;
+  uint16_t  seq1;
+  uint16_t  seq2;
+  uint16_t  seqwrap;
+  struct    smart_sect_header_s header;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  int       lastblock = -1;
+#endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+  int       dupsector;
+#ifndef CONFIG_MTD_SMART_PACKED_MAP
+  uint16_t  duplogsector;
+#endif
+#endif
+  static const short sizetbl[8] =
+  {
+    CONFIG_MTD_SMART_SECTOR_SIZE,
+    512, 1024, 4096, 2048, 8192, 16384, 32768
+  };
+
+  finfo("Entry\n");
+
+  /* Find the sector size on the volume by reading headers from
+   * sectors of decreasing size.  On a formatted volume, the sector
+   * size is saved in the header status byte of search sector, so
    * by starting with the largest supported sector size and
    * decreasing from there, we will be sure to find data that is
    * a header and not sector data.
@@ -2010,6 +2556,19 @@ static int smart_scan(FAR struct smart_struct_s *dev)
       goto err_out;
     }
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* The volume need not be scanned if the checkpoint of the sector map is
+   * still valid.
+   */
+
+  if (smart_cp_load(dev) == OK)
+    {
+      goto scan_done;
+    }
+
+  dev->cpflags = 0;
+#endif
+
   /* Initialize the device variables */
 
   totalsectors        = dev->totalsectors;
@@ -2051,6 +2610,12 @@ static int smart_scan(FAR struct smart_struct_s *dev)
   /* Clear all logical sector used bits */
 
   memset(dev->sbitmap, 0, (dev->totalsectors + 7) >> 3);
+
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  /* Mark all logical sectors as unmapped */
+
+  memset(dev->pmap, 0xff, SMART_PMAP_SIZE(dev));
+#endif
 #endif
 
   /* Now scan the MTD device */
@@ -2134,6 +2699,15 @@ static int smart_scan(FAR struct smart_struct_s *dev)
           continue;
         }
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+      /* Checkpoint sectors are used, but hold no logical sector */
+
+      if (logicalsector == SMART_CP_SECTOR)
+        {
+          continue;
+        }
+#endif
+
       /* Validate the logical sector number is in bounds */
 
       if (logicalsector >= totalsectors)
@@ -2151,22 +2725,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
       if (logicalsector == 0)
         {
-          /* Read the sector data */
-
-          ret = MTD_READ(dev->mtd, readaddress, 32,
-                         (FAR uint8_t *)dev->rwbuffer);
-          if (ret != 32)
-            {
-              ferr("ERROR: Error reading physical sector %d.\n", sector);
-              goto err_out;
-            }
-
-          /* Validate the format signature */
-
-          if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
-              dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
-              dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
-              dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+          ret = smart_readformat(dev, readaddress);
+          if (ret == -EINVAL)
             {
               /* Invalid signature on a sector claiming to be sector 0!
                * What should we do?  Release it?
@@ -2174,61 +2734,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
               continue;
             }
-
-          /* Mark the volume as formatted and set the sector size */
-
-          dev->formatstatus = SMART_FMT_STAT_FORMATTED;
-          dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
-          dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
-
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-          dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
-
-          /* If rootdirentries is greater than 1, then we need to register
-           * additional block devices.
-           */
-
-          for (x = 1; x < dev->rootdirentries; x++)
+          else if (ret < 0)
             {
-              if (dev->partname[0] != '\0')
-                {
-                  snprintf(dev->rwbuffer, sizeof(devname),
-                           "/dev/smart%d%sd%d",
-                           dev->minor, dev->partname, x + 1);
-                }
-              else
-                {
-                  snprintf(devname, sizeof(devname), "/dev/smart%dd%d",
-                           dev->minor, x + 1);
-                }
-
-              /* Inode private data is a reference to a struct containing
-               * the SMART device structure and the root directory number.
-               */
-
-              rootdirdev = (struct smart_multiroot_device_s *)
-                smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
-              if (rootdirdev == NULL)
-                {
-                  ferr("ERROR: Memory alloc failed\n");
-                  ret = -ENOMEM;
-                  goto err_out;
-                }
-
-              /* Populate the rootdirdev */
-
-              rootdirdev->dev = dev;
-              rootdirdev->rootdirnum = x;
-              ret = register_blockdriver(dev->rwbuffer, &g_bops, 0,
-                                         rootdirdev);
-
-              /* Inode private data is a reference to the SMART device
-               * structure.
-               */
-
-              ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+              goto err_out;
             }
-#endif
         }
 
       /* Test for duplicate logical sectors on the device */
@@ -2263,6 +2772,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
           readaddress = dev->smap[logicalsector] * dev->mtdblkspersector *
                         dev->geo.blocksize;
+#elif defined(CONFIG_MTD_SMART_PACKED_MAP)
+          dupsector = smart_cache_lookup(dev, logicalsector);
+          readaddress = dupsector * dev->mtdblkspersector *
+                        dev->geo.blocksize;
 #else
           /* For minimize RAM, we have to rescan to find the 1st sector
            * claiming to be this logical sector.
@@ -2455,6 +2968,15 @@ static int smart_scan(FAR struct smart_struct_s *dev)
           continue;
         }
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+      /* The checkpoint area is only known after logical sector zero */
+
+      if ((int)(winner / dev->sectorsperblk) > lastblock)
+        {
+          lastblock = winner / dev->sectorsperblk;
+        }
+#endif
+
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
       /* Update the logical to physical sector map */
 
@@ -2464,12 +2986,37 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
       dev->sbitmap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
 
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+      /* The packed map holds every logical sector */
+
+      smart_add_sector_to_cache(dev, logicalsector, winner, __LINE__);
+#else
       if (logicalsector < SMART_FIRST_ALLOC_SECTOR)
         {
           smart_add_sector_to_cache(dev, logicalsector, winner, __LINE__);
         }
 #endif
+#endif
+    }
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* Take the checkpoint area out of the free and released sectors.  The
+   * area is not used if it holds logical sectors.
+   */
+
+  if ((dev->cpflags & SMART_CPFLAGS_AREA) != 0)
+    {
+      if (lastblock >= (int)dev->cpblock)
+        {
+          ferr("ERROR: Data found in the checkpoint area\n");
+          dev->cpflags = 0;
+        }
+      else
+        {
+          smart_cp_reserve(dev);
+        }
     }
+#endif
 
 #if defined (CONFIG_MTD_SMART_WEAR_LEVEL) && (SMART_STATUS_VERSION == 1)
 #ifdef CONFIG_MTD_SMART_CONVERT_WEAR_FORMAT
@@ -2551,6 +3098,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #ifdef CONFIG_MTD_SMART_FSCK
   smart_fsck(dev);
 #endif
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+scan_done:
+#endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
   /* Read the wear leveling status bits */
 
@@ -2746,7 +3297,7 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev,
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
       if (!forceerase)
         {
-          smart_relocate_static_data(dev, block);
+          smart_wear_relocate(dev, block);
         }
 #endif
 
@@ -2812,7 +3363,8 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev,
       mincount = 0;
       for (x = 0; x < dev->geo.neraseblocks; x++)
         {
-          if (smart_get_wear_level(dev, x) == dev->minwearlevel)
+          if (smart_get_wear_level(dev, x) == dev->minwearlevel &&
+              !smart_cp_block(dev, x))
             {
               /* Don't allow the format sector or directory sector to
                * be moved into a worn block.  First get the format and
@@ -3000,6 +3552,31 @@ errout:
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_wear_relocate
+ *
+ * Description:  Relocates static data to a block that was just erased if
+ *               it has reached the wear threshold.  With background garbage
+ *               collection, the block is queued for the worker.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+static void smart_wear_relocate(FAR struct smart_struct_s *dev,
+                                uint16_t block)
+{
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  if (smart_get_wear_level(dev, block) >= SMART_WEAR_FULL_RELOCATE_THRESHOLD)
+    {
+      SET_BITMAP(dev->wearpending, block);
+      smart_gcschedule(dev);
+    }
+#else
+  smart_relocate_static_data(dev, block);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: smart_calc_sector_crc
  *
@@ -3190,6 +3767,17 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev,
   dev->rwbuffer[SMART_FMT_POS3] = SMART_FMT_SIG3;
   dev->rwbuffer[SMART_FMT_POS4] = SMART_FMT_SIG4;
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* Record the checkpoint area if the volume is large enough for one */
+
+  if (dev->cpblock < dev->neraseblocks)
+    {
+      dev->rwbuffer[SMART_FMT_POS4]         = SMART_FMT_SIG4_CHECKPOINT;
+      dev->rwbuffer[SMART_FMT_CPBLOCKS_POS] = (uint8_t)
+        (dev->neraseblocks - dev->cpblock);
+    }
+#endif
+
   dev->rwbuffer[SMART_FMT_VERSION_POS] = SMART_FMT_VERSION;
   dev->rwbuffer[SMART_FMT_NAMESIZE_POS] = CONFIG_SMARTFS_MAXNAMLEN;
 
@@ -3270,6 +3858,17 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev,
   dev->freecount[0]--;
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* Reserve the checkpoint area */
+
+  dev->cpflags = 0;
+  if (dev->cpblock < dev->neraseblocks)
+    {
+      dev->cpflags = SMART_CPFLAGS_AREA;
+      smart_cp_reserve(dev);
+    }
+#endif
+
   /* Now initialize the logical to physical sector map */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
@@ -3280,6 +3879,9 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev,
 
       dev->smap[x] = -1;
     }
+#elif defined(CONFIG_MTD_SMART_PACKED_MAP)
+  memset(dev->pmap, 0xff, SMART_PMAP_SIZE(dev));
+  smart_add_sector_to_cache(dev, 0, 0, __LINE__);
 #endif
 
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
@@ -3675,7 +4277,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev,
    */
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-  smart_relocate_static_data(dev, block);
+  smart_wear_relocate(dev, block);
 #endif
 
   return OK;
@@ -3815,7 +4417,8 @@ retry:
           for (i = 0; i < 8; )
             {
               if (smart_get_wear_level(dev, block) <
-                  SMART_WEAR_FORCE_REORG_THRESHOLD)
+                  SMART_WEAR_FORCE_REORG_THRESHOLD &&
+                  !smart_cp_block(dev, block))
                 {
                   if (smart_relocate_block(dev, block) < 0)
                     {
@@ -3971,135 +4574,182 @@ retry:
 }
 
 /****************************************************************************
- * Name: smart_garbagecollect
+ * Name: smart_gcneeded
  *
- * Description:  Performs garbage collection if needed.  This is determined
+ * Description:  Tests if garbage collection is needed.  This is determined
  *               by the count of released sectors relative to free and
  *               total sectors.
  *
  ****************************************************************************/
 
-static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+static bool smart_gcneeded(FAR struct smart_struct_s *dev)
+{
+  /* Test if the released sectors count is greater than the
+   * free sectors.  If it is, then we will do garbage collection.
+   */
+
+  if (dev->releasesectors > dev->freesectors && dev->freesectors <
+      (dev->totalsectors >> 5))
+    {
+      return true;
+    }
+
+  /* Test if we have more reached our reserved free sector limit */
+
+  if (dev->freesectors <= SMART_GC_MINFREE(dev))
+    {
+      return true;
+    }
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  /* Keep the free sector reserve for the writers, but only once at least
+   * an erase block worth of sectors can be reclaimed.
+   */
+
+  if (dev->releasesectors >= dev->availsectperblk &&
+      dev->freesectors < SMART_GC_RESERVE(dev))
+    {
+      return true;
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: smart_collectblock
+ *
+ * Description:  Relocates the active data of the erase block with the
+ *               most released sectors and erases it.
+ *
+ ****************************************************************************/
+
+static int smart_collectblock(FAR struct smart_struct_s *dev)
 {
   uint16_t  collectblock;
   uint16_t  releasemax;
-  bool      collect = TRUE;
   int       x;
   int       ret;
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
   uint8_t   count;
 #endif
 
-  while (collect)
-    {
-      collect = FALSE;
+  /* Find the block with the most released sectors */
 
-      /* Test if the released sectors count is greater than the
-       * free sectors.  If it is, then we will do garbage collection.
-       */
+  collectblock = 0xffff;
+  releasemax = 0;
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
 
-      if (dev->releasesectors > dev->freesectors && dev->freesectors <
-          (dev->totalsectors >> 5))
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
         {
-          collect = TRUE;
+          continue;
         }
+#endif
 
-      /* Test if we have more reached our reserved free sector limit */
-
-      if (dev->freesectors <= (dev->sectorsperblk << 0) + 4)
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      count = smart_get_count(dev, dev->releasecount, x);
+      if (count > releasemax)
+        {
+          releasemax = count;
+          collectblock = x;
+        }
+#else
+      if (dev->releasecount[x] > releasemax)
         {
-          collect = TRUE;
+          releasemax = dev->releasecount[x];
+          collectblock = x;
         }
+#endif
+    }
 
-      /* Test if we need to garbage collect */
+#if 0
+  releasemax = smart_get_count(dev, dev->releasecount, collectblock);
+#endif
 
-      if (collect)
-        {
-          /* Find the block with the most released sectors */
+  if (collectblock == 0xffff)
+    {
+      /* Need to collect, but no sectors with released blocks! */
 
-          collectblock = 0xffff;
-          releasemax = 0;
-          for (x = 0; x < dev->neraseblocks; x++)
-            {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-              /* Don't collect blocks that have been worn completely */
+      return -ENOSPC;
+    }
 
-              if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
-                {
-                  continue;
-                }
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+  if (smart_checkfree(dev, __LINE__) != OK)
+    {
+      fwarn("   ...before collecting block %d\n", collectblock);
+    }
 #endif
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
-              count = smart_get_count(dev, dev->releasecount, x);
-              if (count > releasemax)
-                {
-                  releasemax = count;
-                  collectblock = x;
-                }
+  finfo("Collecting block %d, free=%d released=%d, "
+        "totalfree=%d, totalrelease=%d\n",
+        collectblock,
+        smart_get_count(dev, dev->freecount, collectblock),
+        smart_get_count(dev, dev->releasecount, collectblock),
+        dev->freesectors, dev->releasesectors);
 #else
-              if (dev->releasecount[x] > releasemax)
-                {
-                  releasemax = dev->releasecount[x];
-                  collectblock = x;
-                }
+  finfo("Collecting block %d, free=%d released=%d\n",
+        collectblock, dev->freecount[collectblock],
+        dev->releasecount[collectblock]);
 #endif
-            }
 
-#if 0
-          releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-#endif
-
-          if (collectblock == 0xffff)
-            {
-              /* Need to collect, but no sectors with released blocks! */
+  /* Relocate the active data in the collection block */
 
-              ret = -ENOSPC;
-              goto errout;
-            }
+  ret = smart_relocate_block(dev, collectblock);
 
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
-          if (smart_checkfree(dev, __LINE__) != OK)
-            {
-              fwarn("   ...before collecting block %d\n", collectblock);
-            }
+  if (smart_checkfree(dev, __LINE__) != OK)
+    {
+      fwarn("   ...while collecting block %d\n", collectblock);
+    }
 #endif
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-          finfo("Collecting block %d, free=%d released=%d, "
-                "totalfree=%d, totalrelease=%d\n",
-                collectblock,
-                smart_get_count(dev, dev->freecount, collectblock),
-                smart_get_count(dev, dev->releasecount, collectblock),
-                dev->freesectors, dev->releasesectors);
-#else
-          finfo("Collecting block %d, free=%d released=%d\n",
-                collectblock, dev->freecount[collectblock],
-                dev->releasecount[collectblock]);
-#endif
+  return ret;
+}
 
-          /* Relocate the active data in the collection block */
+/****************************************************************************
+ * Name: smart_garbagecollect
+ *
+ * Description:  Performs garbage collection if needed.  With background
+ *               garbage collection, the caller only collects if the free
+ *               sectors would otherwise run out, and the rest is left to
+ *               the worker.
+ *
+ ****************************************************************************/
 
-          ret = smart_relocate_block(dev, collectblock);
+static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+{
+  int ret;
 
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-          if (smart_checkfree(dev, __LINE__) != OK)
-            {
-              fwarn("   ...while collecting block %d\n", collectblock);
-            }
-#endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  while (dev->freesectors <= SMART_GC_MINFREE(dev))
+    {
+      ret = smart_collectblock(dev);
+      if (ret != OK)
+        {
+          return ret;
+        }
+    }
 
-          if (ret != OK)
-            {
-              goto errout;
-            }
+  if (smart_gcneeded(dev))
+    {
+      smart_gcschedule(dev);
+    }
+#else
+  while (smart_gcneeded(dev))
+    {
+      ret = smart_collectblock(dev);
+      if (ret != OK)
+        {
+          return ret;
         }
     }
+#endif
 
   return OK;
-
-errout:
-  return ret;
 }
 
 /****************************************************************************
@@ -4151,224 +4801,836 @@ static int smart_write_wearstatus(struct smart_struct_s *dev)
       req.count = sizeof(buffer);
       req.buffer = buffer;
 
-      ret = smart_writesector(dev, (unsigned long) &req);
-      if (ret != OK)
-        {
-          goto errout;
-        }
+      ret = smart_writesector(dev, (unsigned long) &req);
+      if (ret != OK)
+        {
+          goto errout;
+        }
+    }
+
+  /* Write all wear level bits to logical sector zero, one, two */
+
+  while (remaining)
+    {
+      /* Calculate the number of bytes to write to this sector */
+
+      towrite = remaining;
+      if (towrite >
+          dev->sectorsize - (SMARTFS_FMT_WEAR_POS +
+          sizeof(struct smart_sect_header_s)))
+        {
+          towrite = dev->sectorsize -
+                    (SMARTFS_FMT_WEAR_POS +
+                     sizeof(struct smart_sect_header_s));
+        }
+
+      /* Setup the sector write request (we are our own client) */
+
+      req.logsector = sector;
+      req.offset    = SMARTFS_FMT_WEAR_POS;
+      req.count     = towrite;
+      req.buffer    =
+        &dev->wearstatus[(dev->geo.neraseblocks >> SMART_WEAR_BIT_DIVIDE) -
+                         remaining];
+
+      /* Write the sector */
+
+      ret = smart_writesector(dev, (unsigned long) &req);
+      if (ret != OK)
+        {
+          goto errout;
+        }
+
+      /* Decrement the remaining count */
+
+      remaining -= towrite;
+      if (remaining)
+        {
+          /* Data doesn't fit in a single sector.  Use the reserved sectors */
+
+          sector++;
+          if (sector >= SMART_FIRST_DIR_SECTOR)
+            {
+              /* Error, wear status bit too large! */
+
+              ferr("ERROR: Invalid geometry "
+                   "- wear level status too large\n");
+              ret = -EINVAL;
+              goto errout;
+            }
+        }
+    }
+
+  /* Now clear the NEEDS_WRITE wear status bit */
+
+  dev->wearflags &= ~SMART_WEARFLAGS_WRITE_NEEDED;
+  ret = OK;
+
+errout:
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_gcschedule
+ *
+ * Description:  Schedules the garbage collection worker if it is not
+ *               already pending.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void smart_gcschedule(FAR struct smart_struct_s *dev)
+{
+  if (work_available(&dev->gcwork))
+    {
+      work_queue(LPWORK, &dev->gcwork, smart_gcworker, dev, 0);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_gcworker
+ *
+ * Description:  Collects one erase block on the low priority work queue and
+ *               reschedules itself until the free sector reserve is
+ *               restored.  Queued static data relocations are done here
+ *               as well, one block at a time.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void smart_gcworker(FAR void *arg)
+{
+  FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+  int ret = OK;
+  bool pending = false;
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  uint16_t wornblock;
+  uint16_t block;
+  uint16_t freecount;
+#endif
+
+  if (smart_lock(dev) < 0)
+    {
+      return;
+    }
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  if (smart_cp_invalidate(dev) < 0)
+    {
+      smart_unlock(dev);
+      return;
+    }
+#endif
+
+  /* Collect one erase block at a time so that the writers are not held
+   * off for long.
+   */
+
+  if (smart_gcneeded(dev))
+    {
+      ret = smart_collectblock(dev);
+    }
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  /* Take the first worn block off the queue and move static data into
+   * it, but only if nothing has been written to the block since it was
+   * erased.
+   */
+
+  wornblock = 0xffff;
+  for (block = 0; block < dev->neraseblocks; block++)
+    {
+      if (ISSET_BITMAP(dev->wearpending, block))
+        {
+          if (wornblock != 0xffff)
+            {
+              pending = true;
+              break;
+            }
+
+          CLR_BITMAP(dev->wearpending, block);
+          wornblock = block;
+        }
+    }
+
+  if (wornblock != 0xffff)
+    {
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      freecount = smart_get_count(dev, dev->freecount, wornblock);
+#else
+      freecount = dev->freecount[wornblock];
+#endif
+      if (freecount == dev->availsectperblk)
+        {
+          smart_relocate_static_data(dev, wornblock);
+        }
+    }
+
+  if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED)
+    {
+      /* Write new wear status bits to the device */
+
+      smart_write_wearstatus(dev);
+    }
+#endif
+
+  if (ret == OK && (pending || smart_gcneeded(dev)))
+    {
+      smart_gcschedule(dev);
+    }
+
+  smart_unlock(dev);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_read_wearstatus
+ *
+ * Description:  Reads the wear leveling status bits from sector zero (and
+ *               possibly others if it doesn't fit) such that is is persisted
+ *               across OS reboots.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+static inline int smart_read_wearstatus(FAR struct smart_struct_s *dev)
+{
+  struct smart_read_write_s req;
+  uint16_t sector, physsector;
+  uint16_t remaining, toread;
+  uint8_t buffer[8];
+  int ret;
+
+  /* Prepare to read the total block erases and uneven wearcount values */
+
+  sector        = 0;
+  req.logsector = sector;
+  req.offset    = SMARTFS_FMT_WEAR_POS - 8;
+  req.count     = sizeof(buffer);
+  req.buffer    = buffer;
+
+  ret = smart_readsector(dev, (unsigned long) &req);
+  if (ret != sizeof(buffer))
+    {
+      goto errout;
+    }
+
+  /* Get the uneven wearcount value */
+
+  dev->uneven_wearcount = *((uint32_t *) &buffer[4]);
+
+  /* Check for erased state */
+
+#if ( CONFIG_SMARTFS_ERASEDSTATE == 0xff )
+  if (dev->uneven_wearcount == 0xffffffff)
+    {
+      dev->uneven_wearcount = 0;
+    }
+#endif
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+  /* Get the block erases count */
+
+  dev->blockerases = *((uint32_t *) buffer);
+#if ( CONFIG_SMARTFS_ERASEDSTATE == 0xff )
+  if (dev->blockerases == 0xffffffff)
+    {
+      dev->blockerases = 0;
+    }
+#endif
+#endif
+
+  /* Read all wear level bits from the flash */
+
+  remaining = dev->geo.neraseblocks >> 1;
+  while (remaining)
+    {
+      /* Calculate number of bytes to read from this sector */
+
+      toread = remaining;
+      if (toread > dev->sectorsize -
+          (SMARTFS_FMT_WEAR_POS + sizeof(struct smart_sect_header_s)))
+        {
+          toread = dev->sectorsize -
+                   (SMARTFS_FMT_WEAR_POS +
+                    sizeof(struct smart_sect_header_s));
+        }
+
+      /* Setup the sector read request (we are our own client) */
+
+      req.logsector = sector;
+      req.offset    = SMARTFS_FMT_WEAR_POS;
+      req.count     = toread;
+      req.buffer    =
+        &dev->wearstatus[(dev->geo.neraseblocks >> SMART_WEAR_BIT_DIVIDE) -
+                         remaining];
+
+      /* Validate wear status sector has been allocated */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+      physsector = dev->smap[req.logsector];
+#else
+      physsector = smart_cache_lookup(dev, req.logsector);
+#endif
+      if ((sector != 0) && (physsector == 0xffff))
+        {
+          /* This logical sector does not exist yet.  We must allocate it */
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+          ret = smart_cp_invalidate(dev);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+#endif
+
+          ret = smart_allocsector(dev, sector);
+          if (ret != sector)
+            {
+              ferr("ERROR: Unable to allocate wear level status sector %d\n",
+                   sector);
+              ret = -EINVAL;
+              goto errout;
+            }
+        }
+
+      /* Read the sector */
+
+      ret = smart_readsector(dev, (unsigned long) &req);
+      if (ret != toread)
+        {
+          goto errout;
+        }
+
+      /* Decrement the remaining count */
+
+      remaining -= toread;
+      if (remaining)
+        {
+          /* Data doesn't fit in a single sector.  Use the reserved sectors */
+
+          sector++;
+          if (sector >= SMART_FIRST_DIR_SECTOR)
+            {
+              /* Error, wear status bit too large! */
+
+              ferr("ERROR: Invalid geometry "
+                   "- wear level status too large\n");
+              ret = -EINVAL;
+              goto errout;
+            }
+        }
+    }
+
+  /* Now interrogate the status bits */
+
+  smart_find_wear_minmax(dev);
+
+#ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
+  /* Set the erase counts equal to the wear levels */
+
+  for (sector = 0; sector < dev->geo.neraseblocks; sector++)
+    {
+      dev->erasecounts[sector] = smart_get_wear_level(dev, sector);
+    }
+#endif
+
+  ret = OK;
+
+errout:
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_nextsector
+ *
+ * Description:  Returns the physical sector of the checkpoint area that
+ *               follows the given one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_cp_nextsector(FAR struct smart_struct_s *dev, int sector)
+{
+  sector++;
+  if (sector % dev->sectorsperblk >= dev->availsectperblk)
+    {
+      sector += dev->sectorsperblk - sector % dev->sectorsperblk;
+    }
+
+  return sector;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_copy
+ *
+ * Description:  Copies part of the checkpoint data between a buffer and the
+ *               checkpoint header, the sector map and the counts.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_cp_copy(FAR struct smart_struct_s *dev,
+                          FAR struct smart_cp_header_s *cphdr,
+                          uint32_t offset, FAR uint8_t *buffer,
+                          uint32_t nbytes, bool load)
+{
+  FAR uint8_t *data[3];
+  uint32_t     size[3];
+  uint32_t     count;
+  int          x;
+
+  data[0] = (FAR uint8_t *)cphdr;
+  size[0] = sizeof(struct smart_cp_header_s);
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+  data[1] = (FAR uint8_t *)dev->smap;
+  size[1] = dev->cpmapsize;
+  data[2] = NULL;
+  size[2] = 0;
+#else
+  data[1] = dev->pmap;
+  size[1] = dev->cpmapsize;
+  data[2] = dev->sbitmap;
+  size[2] = SMART_CP_BITMAPSIZE(dev);
+#endif
+
+  for (x = 0; x < 3 && nbytes > 0; x++)
+    {
+      if (offset >= size[x])
+        {
+          offset -= size[x];
+          continue;
+        }
+
+      count = size[x] - offset;
+      if (count > nbytes)
+        {
+          count = nbytes;
+        }
+
+      if (load)
+        {
+          memcpy(&data[x][offset], buffer, count);
+        }
+      else
+        {
+          memcpy(buffer, &data[x][offset], count);
+        }
+
+      buffer += count;
+      nbytes -= count;
+      offset  = 0;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_crc
+ *
+ * Description:  Calculates the CRC of the checkpoint.  Everything after the
+ *               state byte of the header is covered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static uint32_t smart_cp_crc(FAR struct smart_struct_s *dev,
+                             FAR struct smart_cp_header_s *cphdr)
+{
+  uint32_t crc;
+
+  crc = crc32part(&cphdr->version,
+                  offsetof(struct smart_cp_header_s, crc) -
+                  offsetof(struct smart_cp_header_s, version), 0);
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+  crc = crc32part((FAR const uint8_t *)dev->smap, dev->cpmapsize, crc);
+#else
+  crc = crc32part(dev->pmap, dev->cpmapsize, crc);
+  crc = crc32part(dev->sbitmap, SMART_CP_BITMAPSIZE(dev), crc);
+#endif
+
+  return crc;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_writesector
+ *
+ * Description:  Writes the checkpoint data at the given offset to a sector
+ *               of the checkpoint area.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_cp_writesector(FAR struct smart_struct_s *dev, int sector,
+                                FAR struct smart_cp_header_s *cphdr,
+                                uint32_t offset)
+{
+  FAR struct smart_sect_header_s *header;
+  uint8_t  sectsize;
+  size_t   wrcount;
+
+  memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->sectorsize);
+  header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
+  *((FAR uint16_t *)header->logicalsector) = SMART_CP_SECTOR;
+
+  sectsize = dev->sectorsize < 4096  ? (dev->sectorsize >> 9) :
+             dev->sectorsize == 4096 ? 3 : 5 + (dev->sectorsize >> 14);
+  sectsize <<= 2;
+
+  /* The sector is committed, but has no sector CRC */
+
+#if CONFIG_SMARTFS_ERASEDSTATE == 0xff
+  header->status = (uint8_t)~(SMART_STATUS_COMMITTED |
+                              SMART_STATUS_VERBITS |
+                              SMART_STATUS_SIZEBITS) |
+                              SMART_STATUS_VERSION |
+                              sectsize;
+#else
+  header->status = (uint8_t)(SMART_STATUS_COMMITTED |
+                             SMART_STATUS_VERSION |
+                             sectsize);
+#endif
+
+  smart_cp_copy(dev, cphdr, offset,
+                (FAR uint8_t *)&dev->rwbuffer[sizeof(*header)],
+                SMART_CP_DATASIZE(dev), false);
+
+  wrcount = MTD_BWRITE(dev->mtd, sector * dev->mtdblkspersector,
+                       dev->mtdblkspersector, (FAR uint8_t *)dev->rwbuffer);
+  if (wrcount != dev->mtdblkspersector)
+    {
+      ferr("ERROR: Write checkpoint sector %d failed: %d\n",
+           sector, wrcount);
+      return -EIO;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_reserve
+ *
+ * Description:  Takes the blocks of the checkpoint area out of the free and
+ *               released sectors so that they are never allocated from or
+ *               collected.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_cp_reserve(FAR struct smart_struct_s *dev)
+{
+  uint16_t  block;
+  uint16_t  freecount;
+  uint16_t  releasecount;
+
+  for (block = dev->cpblock; block < dev->neraseblocks; block++)
+    {
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      freecount = smart_get_count(dev, dev->freecount, block);
+      releasecount = smart_get_count(dev, dev->releasecount, block);
+      smart_set_count(dev, dev->freecount, block, 0);
+      smart_set_count(dev, dev->releasecount, block, 0);
+#else
+      freecount = dev->freecount[block];
+      releasecount = dev->releasecount[block];
+      dev->freecount[block] = 0;
+      dev->releasecount[block] = 0;
+#endif
+
+      /* The two unused sectors of a device with 65536 sectors are counted
+       * as released in the last block only.
+       */
+
+      if (block == dev->neraseblocks - 1 && dev->totalsectors == 65534 &&
+          releasecount >= 2)
+        {
+          releasecount -= 2;
+        }
+
+      dev->freesectors -= freecount;
+      dev->releasesectors -= releasecount;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_load
+ *
+ * Description:  Loads the sector map, the free and release counts from the
+ *               checkpoint area if it holds a valid checkpoint.  Otherwise
+ *               the volume must be scanned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_cp_load(FAR struct smart_struct_s *dev)
+{
+  FAR struct smart_sect_header_s *header;
+  struct    smart_cp_header_s cphdr;
+  uint32_t  offset;
+  uint32_t  size;
+  uint16_t  physical;
+  uint16_t  cpblock;
+  int       sector;
+  int       ret;
+
+  dev->cpflags = 0;
+  if (dev->cpblock >= dev->neraseblocks)
+    {
+      return -ENOENT;
     }
 
-  /* Write all wear level bits to logical sector zero, one, two */
+  header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
+  size   = sizeof(cphdr) + dev->cpmapsize + SMART_CP_BITMAPSIZE(dev);
+  sector = dev->cpblock * dev->sectorsperblk;
 
-  while (remaining)
+  for (offset = 0; offset < size; offset += SMART_CP_DATASIZE(dev))
     {
-      /* Calculate the number of bytes to write to this sector */
-
-      towrite = remaining;
-      if (towrite >
-          dev->sectorsize - (SMARTFS_FMT_WEAR_POS +
-          sizeof(struct smart_sect_header_s)))
+      if (sector >= dev->totalsectors)
         {
-          towrite = dev->sectorsize -
-                    (SMARTFS_FMT_WEAR_POS +
-                     sizeof(struct smart_sect_header_s));
+          return -EINVAL;
         }
 
-      /* Setup the sector write request (we are our own client) */
-
-      req.logsector = sector;
-      req.offset    = SMARTFS_FMT_WEAR_POS;
-      req.count     = towrite;
-      req.buffer    =
-        &dev->wearstatus[(dev->geo.neraseblocks >> SMART_WEAR_BIT_DIVIDE) -
-                         remaining];
-
-      /* Write the sector */
+      ret = MTD_BREAD(dev->mtd, sector * dev->mtdblkspersector,
+                      dev->mtdblkspersector, (FAR uint8_t *)dev->rwbuffer);
+      if (ret != dev->mtdblkspersector)
+        {
+          ferr("ERROR: Error reading checkpoint sector %d\n", sector);
+          return -EIO;
+        }
 
-      ret = smart_writesector(dev, (unsigned long) &req);
-      if (ret != OK)
+      if (*((FAR uint16_t *)header->logicalsector) != SMART_CP_SECTOR ||
+          (header->status & SMART_STATUS_COMMITTED) ==
+          (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED))
         {
-          goto errout;
+          return -ENOENT;
         }
 
-      /* Decrement the remaining count */
+      /* Validate the header before anything is loaded */
 
-      remaining -= towrite;
-      if (remaining)
+      if (offset == 0)
         {
-          /* Data doesn't fit in a single sector.  Use the reserved sectors */
-
-          sector++;
-          if (sector >= SMART_FIRST_DIR_SECTOR)
+          memcpy(&cphdr, &dev->rwbuffer[sizeof(*header)], sizeof(cphdr));
+          if (memcmp(cphdr.sig, SMART_CP_SIG, sizeof(cphdr.sig)) != 0 ||
+              cphdr.state != SMART_CP_VALID ||
+              cphdr.version != SMART_CP_VERSION ||
+              cphdr.sectorsize != dev->sectorsize ||
+              cphdr.totalsectors != dev->totalsectors ||
+              cphdr.neraseblocks != dev->neraseblocks ||
+              cphdr.size != size - sizeof(cphdr))
             {
-              /* Error, wear status bit too large! */
-
-              ferr("ERROR: Invalid geometry "
-                   "- wear level status too large\n");
-              ret = -EINVAL;
-              goto errout;
+              return -ENOENT;
             }
         }
+
+      smart_cp_copy(dev, &cphdr, offset,
+                    (FAR uint8_t *)&dev->rwbuffer[sizeof(*header)],
+                    SMART_CP_DATASIZE(dev), true);
+      sector = smart_cp_nextsector(dev, sector);
     }
 
-  /* Now clear the NEEDS_WRITE wear status bit */
+  if (cphdr.crc != smart_cp_crc(dev, &cphdr))
+    {
+      ferr("ERROR: Checkpoint CRC mismatch\n");
+      return -EINVAL;
+    }
 
-  dev->wearflags &= ~SMART_WEARFLAGS_WRITE_NEEDED;
-  ret = OK;
+  dev->freesectors    = cphdr.freesectors;
+  dev->releasesectors = cphdr.releasesectors;
 
-errout:
-  return ret;
+  /* Read the format information from the logical sector zero */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+  physical = dev->smap[0];
+#else
+  physical = smart_cache_lookup(dev, 0);
+#endif
+
+  if (physical >= dev->totalsectors)
+    {
+      return -EINVAL;
+    }
+
+  cpblock = dev->cpblock;
+  ret = smart_readformat(dev, (uint32_t)physical * dev->mtdblkspersector *
+                         dev->geo.blocksize);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The checkpoint must be in the area that the volume was formatted with */
+
+  if ((dev->cpflags & SMART_CPFLAGS_AREA) == 0 || dev->cpblock != cpblock)
+    {
+      return -EINVAL;
+    }
+
+  dev->cpflags |= SMART_CPFLAGS_VALID;
+  finfo("Sector map loaded from the checkpoint\n");
+  return OK;
 }
 #endif
 
 /****************************************************************************
- * Name: smart_read_wearstatus
+ * Name: smart_cp_invalidate
  *
- * Description:  Reads the wear leveling status bits from sector zero (and
- *               possibly others if it doesn't fit) such that is is persisted
- *               across OS reboots.
+ * Description:  Marks the checkpoint on the device as stale.  This must be
+ *               done before the volume is modified.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-static inline int smart_read_wearstatus(FAR struct smart_struct_s *dev)
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_cp_invalidate(FAR struct smart_struct_s *dev)
 {
-  struct smart_read_write_s req;
-  uint16_t sector, physsector;
-  uint16_t remaining, toread;
-  uint8_t buffer[8];
-  int ret;
+  uint8_t   state = SMART_CP_INVALID;
+  size_t    offset;
+  ssize_t   ret;
 
-  /* Prepare to read the total block erases and uneven wearcount values */
+  if ((dev->cpflags & SMART_CPFLAGS_VALID) == 0)
+    {
+      return OK;
+    }
 
-  sector        = 0;
-  req.logsector = sector;
-  req.offset    = SMARTFS_FMT_WEAR_POS - 8;
-  req.count     = sizeof(buffer);
-  req.buffer    = buffer;
+  offset = (size_t)dev->cpblock * dev->sectorsperblk *
+           dev->mtdblkspersector * dev->geo.blocksize +
+           sizeof(struct smart_sect_header_s) +
+           offsetof(struct smart_cp_header_s, state);
 
-  ret = smart_readsector(dev, (unsigned long) &req);
-  if (ret != sizeof(buffer))
+  ret = smart_bytewrite(dev, offset, 1, &state);
+  if (ret != 1)
     {
-      goto errout;
+      ferr("ERROR: Error %d invalidating the checkpoint\n", (int)ret);
+      return ret < 0 ? (int)ret : -EIO;
     }
 
-  /* Get the uneven wearcount value */
+  dev->cpflags &= ~SMART_CPFLAGS_VALID;
+  return OK;
+}
+#endif
 
-  dev->uneven_wearcount = *((uint32_t *) &buffer[4]);
+/****************************************************************************
+ * Name: smart_cp_write
+ *
+ * Description:  Writes a checkpoint of the sector map, the free and release
+ *               counts if the volume has a checkpoint area and was modified
+ *               since the last one.
+ *
+ ****************************************************************************/
 
-  /* Check for erased state */
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_cp_write(FAR struct smart_struct_s *dev)
+{
+  struct    smart_cp_header_s cphdr;
+  uint32_t  offset;
+  uint32_t  avail;
+  uint32_t  size;
+  uint16_t  block;
+  int       sector;
+  int       ret;
 
-#if ( CONFIG_SMARTFS_ERASEDSTATE == 0xff )
-  if (dev->uneven_wearcount == 0xffffffff)
+  if (dev->formatstatus != SMART_FMT_STAT_FORMATTED ||
+      (dev->cpflags & (SMART_CPFLAGS_AREA | SMART_CPFLAGS_VALID)) !=
+      SMART_CPFLAGS_AREA)
     {
-      dev->uneven_wearcount = 0;
+      return OK;
     }
-#endif
 
-#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
-  /* Get the block erases count */
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+  /* Sectors that are allocated, but not written yet, are not on the
+   * device.  Leave it to the next close.
+   */
 
-  dev->blockerases = *((uint32_t *) buffer);
-#if ( CONFIG_SMARTFS_ERASEDSTATE == 0xff )
-  if (dev->blockerases == 0xffffffff)
+  if (dev->allocsector != NULL)
     {
-      dev->blockerases = 0;
+      return OK;
     }
 #endif
-#endif
-
-  /* Read all wear level bits from the flash */
 
-  remaining = dev->geo.neraseblocks >> 1;
-  while (remaining)
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED)
     {
-      /* Calculate number of bytes to read from this sector */
-
-      toread = remaining;
-      if (toread > dev->sectorsize -
-          (SMARTFS_FMT_WEAR_POS + sizeof(struct smart_sect_header_s)))
+      ret = smart_write_wearstatus(dev);
+      if (ret < 0)
         {
-          toread = dev->sectorsize -
-                   (SMARTFS_FMT_WEAR_POS +
-                    sizeof(struct smart_sect_header_s));
+          return ret;
         }
+    }
+#endif
 
-      /* Setup the sector read request (we are our own client) */
+  /* A volume formatted with a smaller area has no room for a checkpoint
+   * of this configuration.
+   */
 
-      req.logsector = sector;
-      req.offset    = SMARTFS_FMT_WEAR_POS;
-      req.count     = toread;
-      req.buffer    =
-        &dev->wearstatus[(dev->geo.neraseblocks >> SMART_WEAR_BIT_DIVIDE) -
-                         remaining];
+  size = sizeof(cphdr) + dev->cpmapsize + SMART_CP_BITMAPSIZE(dev);
+  avail = (uint32_t)(dev->neraseblocks - dev->cpblock) *
+          dev->availsectperblk;
+  if (dev->totalsectors == 65534)
+    {
+      avail -= 2;
+    }
 
-      /* Validate wear status sector has been allocated */
+  if ((size + SMART_CP_DATASIZE(dev) - 1) / SMART_CP_DATASIZE(dev) > avail)
+    {
+      return OK;
+    }
 
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-      physsector = dev->smap[req.logsector];
-#else
-      physsector = smart_cache_lookup(dev, req.logsector);
-#endif
-      if ((sector != 0) && (physsector == 0xffff))
-        {
-          /* This logical sector does not exist yet.  We must allocate it */
+  /* Erase the area.  The first sector is written last, so that a
+   * checkpoint that was interrupted is never taken as valid.
+   */
 
-          ret = smart_allocsector(dev, sector);
-          if (ret != sector)
-            {
-              ferr("ERROR: Unable to allocate wear level status sector %d\n",
-                   sector);
-              ret = -EINVAL;
-              goto errout;
-            }
+  for (block = dev->cpblock; block < dev->neraseblocks; block++)
+    {
+      ret = MTD_ERASE(dev->mtd, block, 1);
+      if (ret < 0)
+        {
+          ferr("ERROR: Erase checkpoint block %d failed: %d\n", block, ret);
+          return ret;
         }
+    }
 
-      /* Read the sector */
+  memcpy(cphdr.sig, SMART_CP_SIG, sizeof(cphdr.sig));
+  cphdr.state          = SMART_CP_VALID;
+  cphdr.version        = SMART_CP_VERSION;
+  cphdr.sectorsize     = dev->sectorsize;
+  cphdr.totalsectors   = dev->totalsectors;
+  cphdr.neraseblocks   = dev->neraseblocks;
+  cphdr.freesectors    = dev->freesectors;
+  cphdr.releasesectors = dev->releasesectors;
+  cphdr.size           = size - sizeof(cphdr);
+  cphdr.crc            = smart_cp_crc(dev, &cphdr);
 
-      ret = smart_readsector(dev, (unsigned long) &req);
-      if (ret != toread)
+  sector = dev->cpblock * dev->sectorsperblk;
+  for (offset = SMART_CP_DATASIZE(dev); offset < size;
+       offset += SMART_CP_DATASIZE(dev))
+    {
+      sector = smart_cp_nextsector(dev, sector);
+      if (sector >= dev->totalsectors)
         {
-          goto errout;
+          return -ENOSPC;
         }
 
-      /* Decrement the remaining count */
-
-      remaining -= toread;
-      if (remaining)
+      ret = smart_cp_writesector(dev, sector, &cphdr, offset);
+      if (ret < 0)
         {
-          /* Data doesn't fit in a single sector.  Use the reserved sectors */
-
-          sector++;
-          if (sector >= SMART_FIRST_DIR_SECTOR)
-            {
-              /* Error, wear status bit too large! */
-
-              ferr("ERROR: Invalid geometry "
-                   "- wear level status too large\n");
-              ret = -EINVAL;
-              goto errout;
-            }
+          return ret;
         }
     }
 
-  /* Now interrogate the status bits */
-
-  smart_find_wear_minmax(dev);
-
-#ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
-  /* Set the erase counts equal to the wear levels */
-
-  for (sector = 0; sector < dev->geo.neraseblocks; sector++)
+  ret = smart_cp_writesector(dev, dev->cpblock * dev->sectorsperblk,
+                             &cphdr, 0);
+  if (ret < 0)
     {
-      dev->erasecounts[sector] = smart_get_wear_level(dev, sector);
+      return ret;
     }
-#endif
-
-  ret = OK;
 
-errout:
-  return ret;
+  dev->cpflags |= SMART_CPFLAGS_VALID;
+  return OK;
 }
 #endif
 
@@ -4564,8 +5826,11 @@ static int smart_writesector(FAR struct smart_struct_s *dev,
 
       for (x = 0; x < dev->geo.neraseblocks; x++)
         {
-          smart_set_wear_level(dev, x,
-                               smart_get_wear_level(dev, x) - offset);
+          if (!smart_cp_block(dev, x))
+            {
+              smart_set_wear_level(dev, x,
+                                   smart_get_wear_level(dev, x) - offset);
+            }
         }
 
       dev->minwearlevel -= offset;
@@ -5458,6 +6723,26 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+  ret = smart_lock(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+  /* The checkpoint on the device is stale once the volume is modified */
+
+  if (cmd == BIOC_LLFORMAT || cmd == BIOC_ALLOCSECT ||
+      cmd == BIOC_FREESECT || cmd == BIOC_WRITESECT)
+    {
+      ret = smart_cp_invalidate(dev);
+      if (ret < 0)
+        {
+          goto ok_out;
+        }
+    }
+#endif
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
@@ -5474,7 +6759,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       if (arg == 0)
         {
           ferr("ERROR: BIOC_XIPBASE argument is NULL\n");
-          return -EINVAL;
+          ret = -EINVAL;
+          goto ok_out;
         }
 #endif
 
@@ -5548,6 +6834,15 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 
       goto ok_out;
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+    case BIOC_FLUSH:
+
+      /* Checkpoint the sector map */
+
+      ret = smart_cp_write(dev);
+      goto ok_out;
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
     case BIOC_GETPROCFSD:
 
@@ -5616,6 +6911,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     }
 
 ok_out:
+  smart_unlock(dev);
   return ret;
 }
 
@@ -6152,6 +7448,10 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
 
       dev->mtd = mtd;
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+      nxsem_init(&dev->exclsem, 0, 1);
+#endif
+
       /* Get the device geometry. (casting to uintptr_t first eliminates
        * complaints on some architectures where the sizeof long is different
        * from the size of a pointer).
@@ -6286,7 +7586,11 @@ errout:
   smart_free(dev, dev->smap);
 #else
   smart_free(dev, dev->sbitmap);
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+  smart_free(dev, dev->pmap);
+#else
   smart_free(dev, dev->scache);
+#endif
 #endif
   smart_free(dev, dev->rwbuffer);
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
@@ -6302,6 +7606,11 @@ errout:
     }
 #endif
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+  work_cancel(LPWORK, &dev->gcwork);
+  nxsem_destroy(&dev->exclsem);
+#endif
+
   kmm_free(dev);
   return ret;
 }
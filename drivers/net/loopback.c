@@ -54,6 +54,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -79,6 +80,16 @@
 
 #define LO_WDDELAY   (1*CLK_TCK)
 
+/* With CONFIG_NET_IOB_RX, packets are looped back in an I/O buffer so that
+ * TCP and UDP can adopt the payload rather than copy it.  The whole packet
+ * must fit in one I/O buffer.
+ */
+
+#if defined(CONFIG_NET_IOB_RX) && \
+    CONFIG_IOB_BUFSIZE >= NET_LO_PKTSIZE + CONFIG_NET_GUARDSIZE
+#  define LO_HAVE_IOB 1
+#endif
+
 /* This is a helper pointer for accessing the contents of the IP header */
 
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)priv->lo_dev.d_buf)
@@ -109,7 +120,9 @@ struct lo_driver_s
  ****************************************************************************/
 
 static struct lo_driver_s g_loopback;
+#ifndef LO_HAVE_IOB
 static uint8_t g_iobuffer[NET_LO_PKTSIZE + CONFIG_NET_GUARDSIZE];
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
@@ -171,6 +184,15 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
        NETDEV_TXPACKETS(&priv->lo_dev);
        NETDEV_RXPACKETS(&priv->lo_dev);
 
+#ifdef LO_HAVE_IOB
+      /* The packet was built in d_iob.  If its payload is adopted, the
+       * network replaces d_iob and d_buf with a new I/O buffer.
+       */
+
+      priv->lo_dev.d_iob->io_len    = priv->lo_dev.d_len;
+      priv->lo_dev.d_iob->io_pktlen = priv->lo_dev.d_len;
+#endif
+
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the packet tap */
 
@@ -520,7 +542,12 @@ int localhost_initialize(void)
   priv->lo_dev.d_addmac  = lo_addmac;    /* Add multicast MAC address */
   priv->lo_dev.d_rmmac   = lo_rmmac;     /* Remove multicast MAC address */
 #endif
+#ifdef LO_HAVE_IOB
+  priv->lo_dev.d_iob     = iob_alloc(false, IOBUSER_GLOBAL);
+  priv->lo_dev.d_buf     = priv->lo_dev.d_iob->io_data;
+#else
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
+#endif
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
   /* Create a watchdog for timing polling for and timing of transmissions */
@@ -37,13 +37,14 @@
 #include <assert.h>
 #include <debug.h>
 
-#ifdef CONFIG_DEBUG_FEATURES
-#  include <nuttx/arch.h>
-#endif
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/drivers/drivers.h>
 
 #include "pipe_common.h"
 
@@ -63,6 +64,20 @@
 #  define pipe_dumpbuffer(m,a,n)
 #endif
 
+/* The reader and the writer exchange data through d_buffer without a
+ * common lock.  The data must be copied before the index that hands it to
+ * the other side is updated, and the index must be read before the data
+ * it covers.  On SMP, the other side runs concurrently and a full barrier
+ * is needed.  On a single CPU, the volatile indices and the memcpy() calls
+ * already keep that order.
+ */
+
+#ifdef CONFIG_SMP
+#  define pipecommon_barrier() SP_DSB()
+#else
+#  define pipecommon_barrier()
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -83,6 +98,7 @@ static int pipecommon_semtake(FAR sem_t *sem)
 static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
                                   pollevent_t eventset)
 {
+  irqstate_t flags;
   int i;
 
   if (eventset & POLLERR)
@@ -90,6 +106,11 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
       eventset &= ~(POLLOUT | POLLIN);
     }
 
+  /* read() and write() notify without holding d_bfsem.  The poll slots are
+   * only changed with interrupts disabled.
+   */
+
+  flags = enter_critical_section();
   for (i = 0; i < CONFIG_DEV_PIPE_NPOLLWAITERS; i++)
     {
       FAR struct pollfd *fds = dev->d_fds[i];
@@ -108,10 +129,367 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: pipecommon_wakeup
+ *
+ * Description:
+ *   Wake up all threads waiting on 'sem'.  Waiters test their wait
+ *   condition and go to sleep with interrupts disabled, so the wakeup
+ *   cannot get lost between the two.
+ *
+ ****************************************************************************/
+
+static void pipecommon_wakeup(FAR sem_t *sem)
+{
+  irqstate_t flags;
+  int sval;
+
+  flags = enter_critical_section();
+  while (nxsem_getvalue(sem, &sval) == 0 && sval < 0)
+    {
+      nxsem_post(sem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: pipecommon_nbytes and pipecommon_nspace
+ *
+ * Description:
+ *   Return the number of bytes in the buffer and the free space in the
+ *   buffer for the given indices.  One byte of the buffer is never used so
+ *   that a full buffer can be told from an empty one.
+ *
+ ****************************************************************************/
+
+static inline size_t pipecommon_nbytes(FAR struct pipe_dev_s *dev,
+                                       pipe_ndx_t wrndx, pipe_ndx_t rdndx)
+{
+  return wrndx >= rdndx ? (size_t)wrndx - rdndx :
+                          (size_t)dev->d_bufsize - rdndx + wrndx;
+}
+
+static inline size_t pipecommon_nspace(FAR struct pipe_dev_s *dev,
+                                       pipe_ndx_t wrndx, pipe_ndx_t rdndx)
+{
+  return dev->d_bufsize - 1 - pipecommon_nbytes(dev, wrndx, rdndx);
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdwait
+ *
+ * Description:
+ *   Wait until the buffer holds data.  The caller holds d_rdlock.
+ *
+ * Returned Value:
+ *   The number of bytes in the buffer, with d_rdlock still held.  Zero at
+ *   end of file or a negated errno value on failure; d_rdlock has then been
+ *   released.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_rdwait(FAR struct pipe_dev_s *dev, bool nonblock)
+{
+  irqstate_t flags;
+  pipe_ndx_t wrndx;
+  pipe_ndx_t rdndx;
+  int ret = OK;
+
+  for (; ; )
+    {
+      rdndx = dev->d_rdndx;
+      wrndx = dev->d_wrndx;
+      if (wrndx != rdndx)
+        {
+          break;
+        }
+
+      /* If O_NONBLOCK was set, then return EGAIN */
+
+      if (nonblock)
+        {
+          nxsem_post(&dev->d_rdlock);
+          return -EAGAIN;
+        }
+
+      /* If there are no writers on the pipe, then return end of file */
+
+      if (dev->d_nwriters <= 0)
+        {
+          nxsem_post(&dev->d_rdlock);
+          return 0;
+        }
+
+      /* Otherwise, wait for something to be written to the pipe.  The test
+       * is repeated with interrupts disabled so that the wakeup by the
+       * writer cannot be missed.
+       */
+
+      nxsem_post(&dev->d_rdlock);
+
+      flags = enter_critical_section();
+      if (dev->d_wrndx == dev->d_rdndx && dev->d_nwriters > 0)
+        {
+          ret = nxsem_wait(&dev->d_rdsem);
+        }
+
+      leave_critical_section(flags);
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_rdlock)) < 0)
+        {
+          /* May fail because a signal was received or if the task was
+           * canceled.
+           */
+
+          return ret;
+        }
+    }
+
+  /* Do not look at the data before the index that covers it */
+
+  pipecommon_barrier();
+  return pipecommon_nbytes(dev, wrndx, rdndx);
+}
+
+/****************************************************************************
+ * Name: pipecommon_wrwait
+ *
+ * Description:
+ *   Wait until the buffer has free space.  The caller holds d_wrlock.
+ *
+ * Returned Value:
+ *   The free space in the buffer, with d_wrlock still held, or a negated
+ *   errno value on failure; d_wrlock has then been released.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_wrwait(FAR struct pipe_dev_s *dev, bool nonblock)
+{
+  irqstate_t flags;
+  size_t nspace;
+  int ret = OK;
+
+  for (; ; )
+    {
+      nspace = pipecommon_nspace(dev, dev->d_wrndx, dev->d_rdndx);
+      if (nspace > 0)
+        {
+          break;
+        }
+
+      /* There is no room in the buffer.  If O_NONBLOCK was set, then
+       * return EGAIN.
+       */
+
+      if (nonblock)
+        {
+          nxsem_post(&dev->d_wrlock);
+          return -EAGAIN;
+        }
+
+      /* Wait for data to be removed from the pipe.  The test is repeated
+       * with interrupts disabled so that the wakeup by the reader cannot be
+       * missed.
+       */
+
+      nxsem_post(&dev->d_wrlock);
+
+      flags = enter_critical_section();
+      if (pipecommon_nspace(dev, dev->d_wrndx, dev->d_rdndx) == 0)
+        {
+          ret = nxsem_wait(&dev->d_wrsem);
+        }
+
+      leave_critical_section(flags);
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_wrlock)) < 0)
+        {
+          /* Either call nxsem_wait may fail because a signal was
+           * received or if the task was canceled.
+           */
+
+          return ret;
+        }
+    }
+
+  /* Do not touch the free space before the reader is done with it */
+
+  pipecommon_barrier();
+  return nspace;
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdadvance
+ *
+ * Description:
+ *   Remove 'nbytes' bytes at 'rdndx' from the buffer after they have been
+ *   copied out and wake up the writers.  The caller holds d_rdlock.
+ *
+ ****************************************************************************/
+
+static void pipecommon_rdadvance(FAR struct pipe_dev_s *dev,
+                                 pipe_ndx_t rdndx, size_t nbytes)
+{
+  size_t newndx;
+
+  newndx = rdndx + nbytes;
+  if (newndx >= dev->d_bufsize)
+    {
+      newndx -= dev->d_bufsize;
+    }
+
+  /* Release the space to the writer only after the data was copied */
+
+  pipecommon_barrier();
+  dev->d_rdndx = newndx;
+
+  /* Notify all waiting writers and poll/select waiters that bytes have been
+   * removed from the buffer.  On a single CPU, a writer can only be
+   * waiting if the buffer was full before this read.  Checking that
+   * requires ordering guarantees that are too expensive on SMP.
+   */
+
+#ifndef CONFIG_SMP
+  if (pipecommon_nspace(dev, dev->d_wrndx, rdndx) == 0)
+#endif
+    {
+      pipecommon_wakeup(&dev->d_wrsem);
+      pipecommon_pollnotify(dev, POLLOUT);
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_wradvance
+ *
+ * Description:
+ *   Add the 'nbytes' bytes stored at 'wrndx' to the buffer and wake up the
+ *   readers.  The caller holds d_wrlock.
+ *
+ ****************************************************************************/
+
+static void pipecommon_wradvance(FAR struct pipe_dev_s *dev,
+                                 pipe_ndx_t wrndx, size_t nbytes)
+{
+  size_t newndx;
+
+  newndx = wrndx + nbytes;
+  if (newndx >= dev->d_bufsize)
+    {
+      newndx -= dev->d_bufsize;
+    }
+
+  /* Hand the data to the reader only after it was copied */
+
+  pipecommon_barrier();
+  dev->d_wrndx = newndx;
+
+  /* Notify all waiting readers and poll/select waiters that more data is
+   * available.  On a single CPU, a reader can only be waiting if the
+   * buffer was empty before this write.
+   */
+
+#ifndef CONFIG_SMP
+  if (dev->d_rdndx == wrndx)
+#endif
+    {
+      pipecommon_wakeup(&dev->d_rdsem);
+      pipecommon_pollnotify(dev, POLLIN);
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_resize
+ *
+ * Description:
+ *   Replace the buffer with one of 'size' bytes, keeping the buffered data.
+ *   The caller holds d_bfsem.
+ *
+ ****************************************************************************/
+
+static int pipecommon_resize(FAR struct pipe_dev_s *dev, size_t size)
+{
+  FAR uint8_t *buffer;
+  size_t nbytes;
+  size_t chunk;
+  int ret;
+
+  if (size < 2 || size > CONFIG_DEV_PIPE_MAXSIZE)
+    {
+      return -EINVAL;
+    }
+
+  /* Keep all readers and writers out while the buffer is replaced */
+
+  ret = nxsem_wait(&dev->d_wrlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxsem_wait(&dev->d_rdlock);
+  if (ret < 0)
+    {
+      nxsem_post(&dev->d_wrlock);
+      return ret;
+    }
+
+  /* If the buffer has not been allocated yet, just change its size */
+
+  if (dev->d_buffer == NULL)
+    {
+      dev->d_bufsize = size;
+      goto errout;
+    }
+
+  nbytes = pipecommon_nbytes(dev, dev->d_wrndx, dev->d_rdndx);
+  if (nbytes >= size)
+    {
+      ret = -EBUSY;
+      goto errout;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(size);
+  if (buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  /* Copy the buffered data to the start of the new buffer */
+
+  chunk = dev->d_bufsize - dev->d_rdndx;
+  if (chunk > nbytes)
+    {
+      chunk = nbytes;
+    }
+
+  memcpy(buffer, &dev->d_buffer[dev->d_rdndx], chunk);
+  memcpy(&buffer[chunk], dev->d_buffer, nbytes - chunk);
+
+  kmm_free(dev->d_buffer);
+  dev->d_buffer  = buffer;
+  dev->d_bufsize = size;
+  dev->d_rdndx   = 0;
+  dev->d_wrndx   = nbytes;
+
+  /* The buffer may have grown.  Let the writers try again. */
+
+  pipecommon_wakeup(&dev->d_wrsem);
+  pipecommon_pollnotify(dev, POLLOUT);
+
+errout:
+  nxsem_post(&dev->d_rdlock);
+  nxsem_post(&dev->d_wrlock);
+  return ret;
 }
 
 /****************************************************************************
@@ -137,6 +515,8 @@ FAR struct pipe_dev_s *pipecommon_allocdev(size_t bufsize)
 
       memset(dev, 0, sizeof(struct pipe_dev_s));
       nxsem_init(&dev->d_bfsem, 0, 1);
+      nxsem_init(&dev->d_rdlock, 0, 1);
+      nxsem_init(&dev->d_wrlock, 0, 1);
       nxsem_init(&dev->d_rdsem, 0, 0);
       nxsem_init(&dev->d_wrsem, 0, 0);
 
@@ -160,6 +540,8 @@ FAR struct pipe_dev_s *pipecommon_allocdev(size_t bufsize)
 void pipecommon_freedev(FAR struct pipe_dev_s *dev)
 {
   nxsem_destroy(&dev->d_bfsem);
+  nxsem_destroy(&dev->d_rdlock);
+  nxsem_destroy(&dev->d_wrlock);
   nxsem_destroy(&dev->d_rdsem);
   nxsem_destroy(&dev->d_wrsem);
   kmm_free(dev);
@@ -173,7 +555,6 @@ int pipecommon_open(FAR struct file *filep)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
-  int                    sval;
   int                    ret;
 
   DEBUGASSERT(dev != NULL);
@@ -218,10 +599,7 @@ int pipecommon_open(FAR struct file *filep)
 
       if (dev->d_nwriters == 1)
         {
-          while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-            {
-              nxsem_post(&dev->d_rdsem);
-            }
+          pipecommon_wakeup(&dev->d_rdsem);
         }
     }
 
@@ -280,7 +658,6 @@ int pipecommon_close(FAR struct file *filep)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
-  int                    sval;
   int                    ret;
 
   DEBUGASSERT(dev && filep->f_inode->i_crefs > 0);
@@ -318,10 +695,7 @@ int pipecommon_close(FAR struct file *filep)
 
           if (--dev->d_nwriters <= 0)
             {
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
+              pipecommon_wakeup(&dev->d_rdsem);
 
               /* Inform poll readers that other end closed. */
 
@@ -392,11 +766,9 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 {
   FAR struct inode      *inode  = filep->f_inode;
   FAR struct pipe_dev_s *dev    = inode->i_private;
-#ifdef CONFIG_DEV_PIPEDUMP
-  FAR uint8_t           *start  = (FAR uint8_t *)buffer;
-#endif
-  ssize_t                nread  = 0;
-  int                    sval;
+  pipe_ndx_t             rdndx;
+  ssize_t                nread;
+  size_t                 chunk;
   int                    ret;
 
   DEBUGASSERT(dev);
@@ -406,9 +778,11 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
       return 0;
     }
 
-  /* Make sure that we have exclusive access to the device structure */
+  /* Make sure that we are the only reader.  The writer does not take this
+   * lock.
+   */
 
-  ret = nxsem_wait(&dev->d_bfsem);
+  ret = nxsem_wait(&dev->d_rdlock);
   if (ret < 0)
     {
       /* May fail because a signal was received or if the task was
@@ -420,68 +794,36 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* If the pipe is empty, then wait for something to be written to it */
 
-  while (dev->d_wrndx == dev->d_rdndx)
+  nread = pipecommon_rdwait(dev, (filep->f_oflags & O_NONBLOCK) != 0);
+  if (nread <= 0)
     {
-      /* If O_NONBLOCK was set, then return EGAIN */
-
-      if (filep->f_oflags & O_NONBLOCK)
-        {
-          nxsem_post(&dev->d_bfsem);
-          return -EAGAIN;
-        }
-
-      /* If there are no writers on the pipe, then return end of file */
-
-      if (dev->d_nwriters <= 0)
-        {
-          nxsem_post(&dev->d_bfsem);
-          return 0;
-        }
-
-      /* Otherwise, wait for something to be written to the pipe */
-
-      sched_lock();
-      nxsem_post(&dev->d_bfsem);
-      ret = nxsem_wait(&dev->d_rdsem);
-      sched_unlock();
-
-      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
-        {
-          /* May fail because a signal was received or if the task was
-           * canceled.
-           */
-
-          return ret;
-        }
+      return nread;
     }
 
-  /* Then return whatever is available in the pipe (which is at least one byte) */
+  /* Then return whatever is available in the pipe (which is at least one
+   * byte).  The data is copied in at most two pieces, split where the
+   * ring buffer wraps around.
+   */
 
-  nread = 0;
-  while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
+  if ((size_t)nread > len)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
-        {
-          dev->d_rdndx = 0;
-        }
-
-      nread++;
+      nread = len;
     }
 
-  /* Notify all waiting writers that bytes have been removed from the buffer */
-
-  while (nxsem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
+  rdndx = dev->d_rdndx;
+  chunk = dev->d_bufsize - rdndx;
+  if (chunk > (size_t)nread)
     {
-      nxsem_post(&dev->d_wrsem);
+      chunk = nread;
     }
 
-  /* Notify all poll/select waiters that they can write to the FIFO */
+  memcpy(buffer, &dev->d_buffer[rdndx], chunk);
+  memcpy(buffer + chunk, dev->d_buffer, nread - chunk);
 
-  pipecommon_pollnotify(dev, POLLOUT);
+  pipecommon_rdadvance(dev, rdndx, nread);
 
-  nxsem_post(&dev->d_bfsem);
-  pipe_dumpbuffer("From PIPE:", start, nread);
+  nxsem_post(&dev->d_rdlock);
+  pipe_dumpbuffer("From PIPE:", (FAR uint8_t *)buffer, nread);
   return nread;
 }
 
@@ -494,10 +836,10 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
-  ssize_t                nwritten = 0;
-  ssize_t                last;
-  int                    nxtwrndx;
-  int                    sval;
+  pipe_ndx_t             wrndx;
+  size_t                 nwritten = 0;
+  ssize_t                nbytes;
+  size_t                 chunk;
   int                    ret;
 
   DEBUGASSERT(dev);
@@ -536,9 +878,11 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 
   DEBUGASSERT(up_interrupt_context() == false);
 
-  /* Make sure that we have exclusive access to the device structure */
+  /* Make sure that we are the only writer.  The reader does not take this
+   * lock.
+   */
 
-  ret = nxsem_wait(&dev->d_bfsem);
+  ret = nxsem_wait(&dev->d_wrlock);
   if (ret < 0)
     {
       /* May fail because a signal was received or if the task was
@@ -550,98 +894,46 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 
   /* Loop until all of the bytes have been written */
 
-  last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Wait for room in the buffer.  If O_NONBLOCK was set, then return
+       * partial bytes written or EGAIN.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      nbytes = pipecommon_wrwait(dev, (filep->f_oflags & O_NONBLOCK) != 0);
+      if (nbytes < 0)
         {
-          nxtwrndx = 0;
+          return nwritten == 0 ? nbytes : (ssize_t)nwritten;
         }
 
-      /* Would the next write overflow the circular buffer? */
+      /* Copy as much as fits, in at most two pieces split where the ring
+       * buffer wraps around.
+       */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if ((size_t)nbytes > len - nwritten)
         {
-          /* No... copy the byte */
-
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
-
-          /* Is the write complete? */
-
-          nwritten++;
-          if ((size_t)nwritten >= len)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
-
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
-
-              /* Notify all poll/select waiters that they can read from the FIFO */
-
-              pipecommon_pollnotify(dev, POLLIN);
-
-              /* Return the number of bytes written */
-
-              nxsem_post(&dev->d_bfsem);
-              return len;
-            }
+          nbytes = len - nwritten;
         }
-      else
-        {
-          /* There is not enough room for the next byte.  Was anything written in this pass? */
-
-          if (last < nwritten)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
 
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
-
-              /* Notify all poll/select waiters that they can read from the FIFO */
-
-              pipecommon_pollnotify(dev, POLLIN);
-            }
-
-          last = nwritten;
-
-          /* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
-
-          if (filep->f_oflags & O_NONBLOCK)
-            {
-              if (nwritten == 0)
-                {
-                  nwritten = -EAGAIN;
-                }
-
-              nxsem_post(&dev->d_bfsem);
-              return nwritten;
-            }
+      wrndx = dev->d_wrndx;
+      chunk = dev->d_bufsize - wrndx;
+      if (chunk > (size_t)nbytes)
+        {
+          chunk = nbytes;
+        }
 
-          /* There is more to be written.. wait for data to be removed fro
-           * the pipe
-           */
+      memcpy(&dev->d_buffer[wrndx], buffer + nwritten, chunk);
+      memcpy(dev->d_buffer, buffer + nwritten + chunk, nbytes - chunk);
 
-          sched_lock();
-          nxsem_post(&dev->d_bfsem);
-          ret = nxsem_wait(&dev->d_wrsem);
-          sched_unlock();
+      pipecommon_wradvance(dev, wrndx, nbytes);
+      nwritten += nbytes;
 
-          if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
-            {
-              /* Either call nxsem_wait may fail because a signal was
-               * received or if the task was canceled.
-               */
+      /* Is the write complete? */
 
-              return nwritten == 0 ? (ssize_t)ret : nwritten;
-            }
+      if (nwritten >= len)
+        {
+          nxsem_post(&dev->d_wrlock);
+          return len;
         }
     }
 }
@@ -656,7 +948,8 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
   pollevent_t            eventset;
-  pipe_ndx_t             nbytes;
+  irqstate_t             flags;
+  size_t                 nbytes;
   int                    ret;
   int                    i;
 
@@ -676,6 +969,7 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
        * slot for the poll structure reference
        */
 
+      flags = enter_critical_section();
       for (i = 0; i < CONFIG_DEV_PIPE_NPOLLWAITERS; i++)
         {
           /* Find an available slot */
@@ -690,6 +984,8 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
             }
         }
 
+      leave_critical_section(flags);
+
       if (i >= CONFIG_DEV_PIPE_NPOLLWAITERS)
         {
           fds->priv   = NULL;
@@ -698,17 +994,11 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
         }
 
       /* Should immediately notify on any of the requested events?
-       * First, determine how many bytes are in the buffer
+       * First, determine how many bytes are in the buffer.  The slot is
+       * bound first so that read() and write() notify any later change.
        */
 
-      if (dev->d_wrndx >= dev->d_rdndx)
-        {
-          nbytes = dev->d_wrndx - dev->d_rdndx;
-        }
-      else
-        {
-          nbytes = dev->d_bufsize + dev->d_wrndx - dev->d_rdndx;
-        }
+      nbytes = pipecommon_nbytes(dev, dev->d_wrndx, dev->d_rdndx);
 
       /* Notify the POLLOUT event if the pipe is not full, but only if
        * there is readers.
@@ -764,8 +1054,10 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Remove all memory of the poll setup */
 
+      flags                = enter_critical_section();
       *slot                = NULL;
       fds->priv            = NULL;
+      leave_critical_section(flags);
     }
 
 errout:
@@ -815,11 +1107,22 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      case PIPEIOC_SETSIZE:
+        {
+          ret = pipecommon_resize(dev, arg);
+        }
+        break;
+
+      case PIPEIOC_GETSIZE:
+        {
+          *(FAR int *)((uintptr_t)arg) = dev->d_bufsize;
+          ret = OK;
+        }
+        break;
+
       case FIONWRITE:  /* Number of bytes waiting in send queue */
       case FIONREAD:   /* Number of bytes available for reading */
         {
-          int count;
-
           /* Determine the number of bytes written to the buffer.  This is,
            * of course, also the number of bytes that may be read from the
            * buffer.
@@ -828,16 +1131,8 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
            *   d_wrndx - Index to next location to add a byte to the buffer.
            */
 
-          if (dev->d_wrndx < dev->d_rdndx)
-            {
-              count = (dev->d_bufsize - dev->d_rdndx) + dev->d_wrndx;
-            }
-          else
-            {
-              count = dev->d_wrndx - dev->d_rdndx;
-            }
-
-          *(FAR int *)((uintptr_t)arg) = count;
+          *(FAR int *)((uintptr_t)arg) =
+            pipecommon_nbytes(dev, dev->d_wrndx, dev->d_rdndx);
           ret = 0;
         }
         break;
@@ -846,24 +1141,14 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
       case FIONSPACE:
         {
-          int count;
-
           /* Determine the number of bytes free in the buffer.
            *
            *   d_rdndx - index to remove next byte from the buffer
            *   d_wrndx - Index to next location to add a byte to the buffer.
            */
 
-          if (dev->d_wrndx < dev->d_rdndx)
-            {
-              count = (dev->d_rdndx - dev->d_wrndx) - 1;
-            }
-          else
-            {
-              count = ((dev->d_bufsize - dev->d_wrndx) + dev->d_rdndx) - 1;
-            }
-
-          *(FAR int *)((uintptr_t)arg) = count;
+          *(FAR int *)((uintptr_t)arg) =
+            pipecommon_nspace(dev, dev->d_wrndx, dev->d_rdndx);
           ret = 0;
         }
         break;
@@ -913,4 +1198,214 @@ int pipecommon_unlink(FAR struct inode *inode)
 }
 #endif
 
+/****************************************************************************
+ * Name: pipe_check
+ *
+ * Description:
+ *   Check if an open file is the read or write end of a pipe or FIFO.
+ *
+ ****************************************************************************/
+
+bool pipe_check(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  return inode != NULL && INODE_IS_DRIVER(inode) &&
+         inode->u.i_ops != NULL && inode->u.i_ops->read == pipecommon_read;
+}
+
+/****************************************************************************
+ * Name: pipe_splice_read
+ *
+ * Description:
+ *   Pass the data at the head of a pipe to 'callback' in place, without
+ *   copying it out of the pipe buffer first.  The callback is called with
+ *   at most two contiguous pieces of the ring buffer, the second one only
+ *   if the first was consumed completely.  This blocks like read() if the
+ *   pipe is empty.
+ *
+ * Input Parameters:
+ *   filep    - The read end of the pipe
+ *   len      - The maximum number of bytes to pass on
+ *   nonblock - Return -EAGAIN instead of waiting for data
+ *   peek     - Leave the data in the pipe
+ *   callback - Consumes the data.  Returns the number of bytes consumed or
+ *              a negated errno value.
+ *   arg      - The argument of the callback
+ *
+ * Returned Value:
+ *   The number of bytes consumed by the callback, zero at end of file, or
+ *   a negated errno value if nothing was consumed.
+ *
+ ****************************************************************************/
+
+ssize_t pipe_splice_read(FAR struct file *filep, size_t len, bool nonblock,
+                         bool peek, pipe_splice_t callback, FAR void *arg)
+{
+  FAR struct pipe_dev_s *dev = filep->f_inode->i_private;
+  pipe_ndx_t rdndx;
+  ssize_t navail;
+  ssize_t nxfer;
+  ssize_t ret;
+  size_t chunk;
+
+  DEBUGASSERT(dev != NULL && callback != NULL);
+
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return -EBADF;
+    }
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  ret = nxsem_wait(&dev->d_rdlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((filep->f_oflags & O_NONBLOCK) != 0)
+    {
+      nonblock = true;
+    }
+
+  navail = pipecommon_rdwait(dev, nonblock);
+  if (navail <= 0)
+    {
+      return navail;
+    }
+
+  if ((size_t)navail > len)
+    {
+      navail = len;
+    }
+
+  rdndx = dev->d_rdndx;
+  chunk = dev->d_bufsize - rdndx;
+  if (chunk > (size_t)navail)
+    {
+      chunk = navail;
+    }
+
+  nxfer = callback(arg, &dev->d_buffer[rdndx], chunk);
+  if (nxfer == (ssize_t)chunk && (size_t)navail > chunk)
+    {
+      ret = callback(arg, dev->d_buffer, navail - chunk);
+      if (ret > 0)
+        {
+          nxfer += ret;
+        }
+    }
+
+  if (nxfer > 0 && !peek)
+    {
+      pipecommon_rdadvance(dev, rdndx, nxfer);
+    }
+
+  nxsem_post(&dev->d_rdlock);
+  return nxfer;
+}
+
+/****************************************************************************
+ * Name: pipe_splice_write
+ *
+ * Description:
+ *   Let 'callback' fill the free space of a pipe buffer in place, without
+ *   staging the data in another buffer first.  The callback is called with
+ *   at most two contiguous pieces of the ring buffer, the second one only
+ *   if the first was filled completely.  This blocks like write() if the
+ *   pipe is full.
+ *
+ * Input Parameters:
+ *   filep    - The write end of the pipe
+ *   len      - The maximum number of bytes to add
+ *   nonblock - Return -EAGAIN instead of waiting for space
+ *   callback - Produces the data.  Returns the number of bytes produced,
+ *              zero if there is no more data, or a negated errno value.
+ *   arg      - The argument of the callback
+ *
+ * Returned Value:
+ *   The number of bytes added to the pipe or a negated errno value if
+ *   nothing was added.
+ *
+ ****************************************************************************/
+
+ssize_t pipe_splice_write(FAR struct file *filep, size_t len, bool nonblock,
+                          pipe_splice_t callback, FAR void *arg)
+{
+  FAR struct pipe_dev_s *dev = filep->f_inode->i_private;
+  pipe_ndx_t wrndx;
+  ssize_t nspace;
+  ssize_t nxfer;
+  ssize_t ret;
+  size_t chunk;
+
+  DEBUGASSERT(dev != NULL && callback != NULL);
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EBADF;
+    }
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (dev->d_nreaders <= 0)
+    {
+      return -EPIPE;
+    }
+
+  ret = nxsem_wait(&dev->d_wrlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((filep->f_oflags & O_NONBLOCK) != 0)
+    {
+      nonblock = true;
+    }
+
+  nspace = pipecommon_wrwait(dev, nonblock);
+  if (nspace < 0)
+    {
+      return nspace;
+    }
+
+  if ((size_t)nspace > len)
+    {
+      nspace = len;
+    }
+
+  wrndx = dev->d_wrndx;
+  chunk = dev->d_bufsize - wrndx;
+  if (chunk > (size_t)nspace)
+    {
+      chunk = nspace;
+    }
+
+  nxfer = callback(arg, &dev->d_buffer[wrndx], chunk);
+  if (nxfer == (ssize_t)chunk && (size_t)nspace > chunk)
+    {
+      ret = callback(arg, dev->d_buffer, nspace - chunk);
+      if (ret > 0)
+        {
+          nxfer += ret;
+        }
+    }
+
+  if (nxfer > 0)
+    {
+      pipecommon_wradvance(dev, wrndx, nxfer);
+    }
+
+  nxsem_post(&dev->d_wrlock);
+  return nxfer;
+}
+
 #endif /* CONFIG_PIPES */
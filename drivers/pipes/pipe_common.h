@@ -125,15 +125,23 @@ typedef uint8_t pipe_ndx_t;   /*  8-bit index */
 /* This structure represents the state of one pipe.  A reference to this
  * structure is retained in the i_private field of the inode whenthe pipe/fifo
  * device is registered.
+ *
+ * d_buffer is a single-producer/single-consumer ring:  Only the writer
+ * holding d_wrlock advances d_wrndx and only the reader holding d_rdlock
+ * advances d_rdndx, so readers and writers never share a lock while moving
+ * data.  d_bfsem protects the remaining state (open counts, flags, poll
+ * slots, buffer allocation) and is not taken by read() and write().
  */
 
 struct pipe_dev_s
 {
-  sem_t      d_bfsem;       /* Used to serialize access to d_buffer and indices */
+  sem_t      d_bfsem;       /* Used to serialize access to the pipe state */
+  sem_t      d_rdlock;      /* Serializes readers */
+  sem_t      d_wrlock;      /* Serializes writers */
   sem_t      d_rdsem;       /* Empty buffer - Reader waits for data write */
   sem_t      d_wrsem;       /* Full buffer - Writer waits for data read */
-  pipe_ndx_t d_wrndx;       /* Index in d_buffer to save next byte written */
-  pipe_ndx_t d_rdndx;       /* Index in d_buffer to return the next byte read */
+  volatile pipe_ndx_t d_wrndx; /* Index in d_buffer of the next byte written */
+  volatile pipe_ndx_t d_rdndx; /* Index in d_buffer of the next byte read */
   pipe_ndx_t d_bufsize;     /* allocated size of d_buffer in bytes */
   uint8_t    d_nwriters;    /* Number of reference counts for write access */
   uint8_t    d_nreaders;    /* Number of reference counts for read access */
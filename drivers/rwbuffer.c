@@ -55,6 +55,23 @@
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+#ifndef CONFIG_DRVR_WRSEGMENTS
+#  define CONFIG_DRVR_WRSEGMENTS 4
+#endif
+
+#ifndef CONFIG_DRVR_WRINFLIGHT
+#  define CONFIG_DRVR_WRINFLIGHT 2
+#endif
+
+/* Committed segments are written back on the low priority work queue if
+ * there is one.  Otherwise, they are written in the context of the thread
+ * that commits them.
+ */
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_SCHED_WORKQUEUE)
+#  define RWB_ASYNC 1
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -102,6 +119,24 @@ static int rwb_forcetake(FAR sem_t *sem)
 
 #define rwb_semgive(s) nxsem_post(s)
 
+/****************************************************************************
+ * Name: rwb_devtake/rwb_devgive
+ *
+ * Description:
+ *   With write-back on the work queue, the callouts may be called from the
+ *   worker thread and from the buffer user at the same time.  The device
+ *   semaphore keeps them from running concurrently.
+ *
+ ****************************************************************************/
+
+#ifdef RWB_ASYNC
+#  define rwb_devtake(r) rwb_forcetake(&(r)->devsem)
+#  define rwb_devgive(r) rwb_semgive(&(r)->devsem)
+#else
+#  define rwb_devtake(r)
+#  define rwb_devgive(r)
+#endif
+
 /****************************************************************************
  * Name: rwb_overlap
  ****************************************************************************/
@@ -125,23 +160,182 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
     }
 }
 
+/****************************************************************************
+ * Name: rwb_rhdiscard
+ *
+ * Description:
+ *   Discard the read-ahead buffer if it overlaps blocks that were written.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static void rwb_rhdiscard(FAR struct rwbuffer_s *rwb, off_t startblock,
+                          size_t nblocks)
+{
+  if (rwb->rhmaxblocks > 0)
+    {
+      rwb_forcetake(&rwb->rhsem);
+      if (rwb->rhnblocks > 0 &&
+          rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock,
+                      nblocks))
+        {
+          rwb->rhnblocks    = 0;
+          rwb->rhblockstart = (off_t)-1;
+        }
+
+      rwb_semgive(&rwb->rhsem);
+    }
+}
+#else
+#  define rwb_rhdiscard(r,s,n)
+#endif
+
+/****************************************************************************
+ * Name: rwb_devwrite
+ *
+ * Description:
+ *   Write blocks to the media through the flush callout and account for
+ *   the write in the statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static ssize_t rwb_devwrite(FAR struct rwbuffer_s *rwb,
+                            FAR const uint8_t *buffer, off_t startblock,
+                            size_t nblocks)
+{
+  clock_t elapsed;
+  ssize_t ret;
+
+  rwb_devtake(rwb);
+
+  elapsed = clock_systimer();
+  ret     = rwb->wrflush(rwb->dev, buffer, startblock, nblocks);
+  elapsed = clock_systimer() - elapsed;
+
+  rwb->wrstats.devwrites++;
+  rwb->wrstats.flushticks += elapsed;
+  if (elapsed > rwb->wrstats.maxflushticks)
+    {
+      rwb->wrstats.maxflushticks = elapsed;
+    }
+
+  if (ret > 0)
+    {
+      rwb->wrstats.devblocks += ret;
+    }
+
+  rwb_devgive(rwb);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_resetwrbuffer
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
+static void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 {
-  /* We assume that the caller holds the wrsem */
+  FAR struct rwb_segment_s *seg;
+  int i;
 
-  rwb->wrnblocks       = 0;
-  rwb->wrblockstart    = (off_t)-1;
-  rwb->wrexpectedblock = (off_t)-1;
+  /* We assume that the caller holds the wrsem.  A segment that is being
+   * written cannot be discarded; it will be freed when the write is done.
+   */
+
+  rwb->wrninflight = 0;
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state == RWB_SEG_WRITING)
+        {
+          rwb->wrninflight++;
+        }
+      else
+        {
+          seg->state   = RWB_SEG_FREE;
+          seg->nblocks = 0;
+        }
+    }
 }
 #endif
 
 /****************************************************************************
- * Name: rwb_wrflush
+ * Name: rwb_oldestseg
+ *
+ * Description:
+ *   Return the segment with the lowest sequence number in 'state', or NULL.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_segment_s *rwb_oldestseg(FAR struct rwbuffer_s *rwb,
+                                               uint8_t state)
+{
+  FAR struct rwb_segment_s *oldest = NULL;
+  FAR struct rwb_segment_s *seg;
+  int i;
+
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state == state &&
+          (oldest == NULL || (int32_t)(seg->seq - oldest->seq) < 0))
+        {
+          oldest = seg;
+        }
+    }
+
+  return oldest;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_commit
+ *
+ * Description:
+ *   Queue a dirty segment for write-back.  Segments are written in the
+ *   order in which they are committed.  A block may be in several
+ *   segments, but only the newest of them is dirty, so this keeps the
+ *   newest data last on the media.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_commit(FAR struct rwbuffer_s *rwb,
+                       FAR struct rwb_segment_s *seg)
+{
+  DEBUGASSERT(seg->state == RWB_SEG_DIRTY && seg->nblocks > 0);
+
+  seg->state = RWB_SEG_COMMITTED;
+  seg->seq   = rwb->wrseq++;
+  rwb->wrninflight++;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_commitall
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_commitall(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwb_segment_s *seg;
+
+  while ((seg = rwb_oldestseg(rwb, RWB_SEG_DIRTY)) != NULL)
+    {
+      rwb_commit(rwb, seg);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrwait
+ *
+ * Description:
+ *   Wait until the write of a segment completes.  The wrsem is released
+ *   while waiting, so the caller must re-examine the write buffer.
  *
  * Assumptions:
  *   The caller holds the wrsem semaphore.
@@ -149,29 +343,163 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
+static void rwb_wrwait(FAR struct rwbuffer_s *rwb)
 {
-  int ret;
+  rwb->wrnwaiters++;
+  rwb_semgive(&rwb->wrsem);
+
+  rwb_semtake(&rwb->wrdonesem);
+  rwb_forcetake(&rwb->wrsem);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrprocess
+ *
+ * Description:
+ *   Write all committed segments to the media, oldest first.  Only one
+ *   thread writes segments at a time.  The wrsem is released during each
+ *   media write so that the buffer user may continue to fill other
+ *   segments.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrprocess(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwb_segment_s *seg;
+  ssize_t ret;
+
+  if (rwb->wrbusy)
+    {
+      return;
+    }
 
-  if (rwb->wrnblocks > 0)
+  rwb->wrbusy = true;
+  while ((seg = rwb_oldestseg(rwb, RWB_SEG_COMMITTED)) != NULL)
     {
       finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-      (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+            (long)seg->blockstart, seg->nblocks, seg->buffer);
+
+      /* The segment is not modified while it is being written */
+
+      seg->state = RWB_SEG_WRITING;
+      rwb_semgive(&rwb->wrsem);
+
+      /* On success, the flush method will return the number of blocks
+       * written.  Anything other than the number requested is an error.
+       * The error is reported by the next rwb_flush().
+       */
+
+      ret = rwb_devwrite(rwb, seg->buffer, seg->blockstart, seg->nblocks);
 
-      /* Flush cache.  On success, the flush method will return the number
-       * of blocks written.  Anything other than the number requested is
-       * an error.
+      /* The media now has the new data.  Data read ahead before cannot
+       * be used any more.
        */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      rwb_rhdiscard(rwb, seg->blockstart, seg->nblocks);
+      rwb_forcetake(&rwb->wrsem);
+
+      if (ret != seg->nblocks)
         {
-          ferr("ERROR: Error flushing write buffer: %d\n", ret);
+          ferr("ERROR: Error flushing write buffer: %d\n", (int)ret);
+          if (rwb->wrerror == OK)
+            {
+              rwb->wrerror = ret < 0 ? (int)ret : -EIO;
+            }
         }
 
-      rwb_resetwrbuffer(rwb);
+      seg->state   = RWB_SEG_FREE;
+      seg->nblocks = 0;
+      rwb->wrninflight--;
+
+      /* Wake up all threads waiting for a segment to be written */
+
+      while (rwb->wrnwaiters > 0)
+        {
+          rwb->wrnwaiters--;
+          rwb_semgive(&rwb->wrdonesem);
+        }
     }
+
+  rwb->wrbusy = false;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrsync
+ *
+ * Description:
+ *   Wait until all committed segments have been written to the media.  If
+ *   no other thread is writing segments, the caller writes them itself.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrsync(FAR struct rwbuffer_s *rwb)
+{
+  while (rwb->wrninflight > 0)
+    {
+      if (!rwb->wrbusy)
+        {
+          rwb_wrprocess(rwb);
+        }
+      else
+        {
+          rwb_wrwait(rwb);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrworker
+ *
+ * Description:
+ *   Write back committed segments on the worker thread.
+ *
+ ****************************************************************************/
+
+#ifdef RWB_ASYNC
+static void rwb_wrworker(FAR void *arg)
+{
+  FAR struct rwbuffer_s *rwb = (FAR struct rwbuffer_s *)arg;
+  DEBUGASSERT(rwb != NULL);
+
+  rwb_forcetake(&rwb->wrsem);
+  rwb_wrprocess(rwb);
+  rwb_semgive(&rwb->wrsem);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrkick
+ *
+ * Description:
+ *   Start the write-back of committed segments.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrkick(FAR struct rwbuffer_s *rwb)
+{
+#ifdef RWB_ASYNC
+  if (work_available(&rwb->wrwork))
+    {
+      work_queue(LPWORK, &rwb->wrwork, rwb_wrworker, (FAR void *)rwb, 0);
+    }
+#else
+  rwb_wrprocess(rwb);
+#endif
 }
 #endif
 
@@ -191,11 +519,12 @@ static void rwb_wrtimeout(FAR void *arg)
 
   /* If a timeout elapses with write buffer activity, this watchdog
    * handler function will be evoked on the thread of execution of the
-   * worker thread.
+   * worker thread.  Write back all dirty segments.
    */
 
   rwb_forcetake(&rwb->wrsem);
-  rwb_wrflush(rwb);
+  rwb_commitall(rwb);
+  rwb_wrprocess(rwb);
   rwb_semgive(&rwb->wrsem);
 }
 #endif
@@ -218,78 +547,298 @@ static void rwb_wrstarttimeout(FAR struct rwbuffer_s *rwb)
 }
 #endif
 
-/****************************************************************************
- * Name: rwb_wrcanceltimeout
- ****************************************************************************/
+/****************************************************************************
+ * Name: rwb_wrcanceltimeout
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static inline void rwb_wrcanceltimeout(FAR struct rwbuffer_s *rwb)
+{
+#if CONFIG_DRVR_WRDELAY != 0
+  work_cancel(LPWORK, &rwb->work);
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_findwrseg
+ *
+ * Description:
+ *   Find the dirty segment that can take 'block':  Either the block is in
+ *   the extent of the segment or it extends the extent.  The number of
+ *   blocks that can be copied into the segment is returned in 'ncopy'.
+ *   Dirty extents never overlap, so the copy stops where the next dirty
+ *   extent starts.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_segment_s *
+rwb_findwrseg(FAR struct rwbuffer_s *rwb, off_t block, size_t nblocks,
+              FAR size_t *ncopy)
+{
+  FAR struct rwb_segment_s *found = NULL;
+  FAR struct rwb_segment_s *seg;
+  off_t limit;
+  int i;
+
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state != RWB_SEG_DIRTY || block < seg->blockstart)
+        {
+          continue;
+        }
+
+      /* A segment that holds the block wins over one that it extends */
+
+      if (block < seg->blockstart + seg->nblocks)
+        {
+          found = seg;
+          break;
+        }
+
+      if (block == seg->blockstart + seg->nblocks &&
+          seg->nblocks < rwb->wrsegblocks)
+        {
+          found = seg;
+        }
+    }
+
+  limit = block + nblocks;
+  if (found != NULL && limit > found->blockstart + rwb->wrsegblocks)
+    {
+      limit = found->blockstart + rwb->wrsegblocks;
+    }
+
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state == RWB_SEG_DIRTY &&
+          seg->blockstart > block && seg->blockstart < limit)
+        {
+          limit = seg->blockstart;
+        }
+    }
+
+  *ncopy = limit - block;
+  return found;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_allocseg
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_segment_s *rwb_allocseg(FAR struct rwbuffer_s *rwb,
+                                              off_t block)
+{
+  FAR struct rwb_segment_s *seg;
+  int i;
+
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state == RWB_SEG_FREE)
+        {
+          finfo("Fresh segment starting at block: 0x%08lx\n", (long)block);
+
+          seg->state      = RWB_SEG_DIRTY;
+          seg->blockstart = block;
+          seg->nblocks    = 0;
+          seg->seq        = rwb->wrseq++;
+          return seg;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_writebuffer
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
+                               off_t startblock, uint32_t nblocks,
+                               FAR const uint8_t *wrbuffer)
+{
+  FAR struct rwb_segment_s *seg;
+  clock_t stallstart = 0;
+  bool stalled = false;
+  bool kick = false;
+  size_t remaining;
+  size_t ncopy;
+  off_t offset;
+
+  /* Write writebuffer Logic */
+
+  rwb_wrcanceltimeout(rwb);
+
+  for (remaining = nblocks; remaining > 0; )
+    {
+      seg = rwb_findwrseg(rwb, startblock, remaining, &ncopy);
+      if (seg == NULL)
+        {
+          /* Start a new extent in a free segment */
+
+          if (rwb_allocseg(rwb, startblock) != NULL)
+            {
+              continue;
+            }
+
+          /* All segments are in use.  Commit the oldest dirty segment
+           * unless another one is already waiting to be written, and wait
+           * for a segment to become free.
+           */
+
+          if (!stalled)
+            {
+              stalled    = true;
+              stallstart = clock_systimer();
+              rwb->wrstats.stalls++;
+            }
+
+          if (rwb_oldestseg(rwb, RWB_SEG_COMMITTED) == NULL &&
+              (seg = rwb_oldestseg(rwb, RWB_SEG_DIRTY)) != NULL)
+            {
+              rwb_commit(rwb, seg);
+            }
+
+          if (!rwb->wrbusy)
+            {
+              rwb_wrprocess(rwb);
+            }
+          else
+            {
+              rwb_wrwait(rwb);
+            }
+
+          continue;
+        }
+
+      /* Add data to the segment */
+
+      offset = startblock - seg->blockstart;
+
+      finfo("writebuffer: copying %d bytes from %p to %p\n",
+            ncopy * rwb->blocksize, wrbuffer,
+            &seg->buffer[offset * rwb->blocksize]);
+      memcpy(&seg->buffer[offset * rwb->blocksize], wrbuffer,
+             ncopy * rwb->blocksize);
+
+      if (offset + ncopy > seg->nblocks)
+        {
+          seg->nblocks = offset + ncopy;
+        }
+
+      startblock += ncopy;
+      wrbuffer   += ncopy * rwb->blocksize;
+      remaining  -= ncopy;
+
+      /* Write back full segments right away, while the remaining
+       * segments keep absorbing new data.
+       */
+
+      if (seg->nblocks == rwb->wrsegblocks &&
+          rwb->wrninflight < CONFIG_DRVR_WRINFLIGHT)
+        {
+          rwb_commit(rwb, seg);
+          kick = true;
+        }
+    }
+
+  if (stalled)
+    {
+      rwb->wrstats.stallticks += clock_systimer() - stallstart;
+    }
+
+  rwb->wrstats.wrblocks += nblocks;
 
-#ifdef CONFIG_DRVR_WRITEBUFFER
-static inline void rwb_wrcanceltimeout(FAR struct rwbuffer_s *rwb)
-{
-#if CONFIG_DRVR_WRDELAY != 0
-  work_cancel(LPWORK, &rwb->work);
-#endif
+  if (kick)
+    {
+      rwb_wrkick(rwb);
+    }
+
+  rwb_wrstarttimeout(rwb);
+  return nblocks;
 }
 #endif
 
 /****************************************************************************
- * Name: rwb_writebuffer
+ * Name: rwb_findrdseg
+ *
+ * Description:
+ *   Find the segment with the newest data of 'block'.  The number of
+ *   blocks that can be read from that segment is returned in 'nread'.  If
+ *   no segment has the block, NULL is returned and 'nread' is the number
+ *   of blocks up to the next buffered block.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
-                               off_t startblock, uint32_t nblocks,
-                               FAR const uint8_t *wrbuffer)
+static bool rwb_newer(FAR struct rwb_segment_s *seg1,
+                      FAR struct rwb_segment_s *seg2)
 {
-  int ret;
+  /* Only the newest copy of a block is dirty */
 
-  /* Write writebuffer Logic */
+  if (seg1->state == RWB_SEG_DIRTY || seg2->state == RWB_SEG_DIRTY)
+    {
+      return seg1->state == RWB_SEG_DIRTY;
+    }
 
-  rwb_wrcanceltimeout(rwb);
+  return (int32_t)(seg1->seq - seg2->seq) > 0;
+}
 
-  /* First: Should we flush out our cache? We would do that if (1) we already
-   * buffering blocks and the next block writing is not in the same sequence,
-   * or (2) the number of blocks would exceed our allocated buffer capacity
-   */
+static FAR struct rwb_segment_s *
+rwb_findrdseg(FAR struct rwbuffer_s *rwb, off_t block, size_t nblocks,
+              FAR size_t *nread)
+{
+  FAR struct rwb_segment_s *found = NULL;
+  FAR struct rwb_segment_s *seg;
+  off_t limit;
+  int i;
 
-  if (((startblock != rwb->wrexpectedblock) && (rwb->wrnblocks)) ||
-      ((rwb->wrnblocks + nblocks) > rwb->wrmaxblocks))
+  for (i = 0; i < rwb->wrnsegs; i++)
     {
-      finfo("writebuffer miss, expected: %08x, given: %08x\n",
-            rwb->wrexpectedblock, startblock);
-
-      /* Flush the write buffer */
-
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret < 0)
+      seg = &rwb->wrsegs[i];
+      if (seg->state != RWB_SEG_FREE &&
+          block >= seg->blockstart &&
+          block < seg->blockstart + seg->nblocks &&
+          (found == NULL || rwb_newer(seg, found)))
         {
-          ferr("ERROR: Error writing multiple from cache: %d\n", -ret);
-          return ret;
+          found = seg;
         }
-
-      rwb_resetwrbuffer(rwb);
     }
 
-  /* writebuffer is empty? Then initialize it */
+  /* Stop where the extent ends or where newer data starts */
 
-  if (rwb->wrnblocks == 0)
+  limit = block + nblocks;
+  if (found != NULL && limit > found->blockstart + found->nblocks)
     {
-      finfo("Fresh cache starting at block: 0x%08x\n", startblock);
-      rwb->wrblockstart = startblock;
+      limit = found->blockstart + found->nblocks;
     }
 
-  /* Add data to cache */
-
-  finfo("writebuffer: copying %d bytes from %p to %p\n",
-        nblocks * rwb->blocksize, wrbuffer,
-        &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-  memcpy(&rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize],
-         wrbuffer, nblocks * rwb->blocksize);
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg != found && seg->state != RWB_SEG_FREE &&
+          seg->nblocks > 0 &&
+          seg->blockstart > block && seg->blockstart < limit &&
+          (found == NULL || rwb_newer(seg, found)))
+        {
+          limit = seg->blockstart;
+        }
+    }
 
-  rwb->wrnblocks      += nblocks;
-  rwb->wrexpectedblock = rwb->wrblockstart + rwb->wrnblocks;
-  rwb_wrstarttimeout(rwb);
-  return nblocks;
+  *nread = limit - block;
+  return found;
 }
 #endif
 
@@ -382,7 +931,10 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 
   /* Now perform the read */
 
+  rwb_devtake(rwb);
   ret = rwb->rhreload(rwb->dev, rwb->rhbuffer, startblock, nblocks);
+  rwb_devgive(rwb);
+
   if (ret == nblocks)
     {
       /* Update information about what is in the read-ahead buffer */
@@ -413,133 +965,143 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, size_t blockcount)
 {
-  int ret = OK;
+  FAR struct rwb_segment_s *seg;
+  FAR struct rwb_segment_s *tail;
+  off_t endblock = startblock + blockcount;
+  off_t segend;
+  ssize_t nwritten;
+  size_t ntail;
+  bool busy;
+  int ret;
+  int i;
 
-  /* Is there a write buffer?  Is data saved in the write buffer? */
+  /* Is there a write buffer? */
 
-  if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
+  if (rwb->wrmaxblocks == 0)
     {
-      off_t wrbend;
-      off_t invend;
-
-      finfo("startblock=%d blockcount=%p\n", startblock, blockcount);
-
-      ret = rwb_semtake(&rwb->wrsem);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
-       */
-
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
-      invend = startblock + blockcount;
+      return OK;
+    }
 
-      if (wrbend <= startblock || rwb->wrblockstart >= invend)
-        {
-          ret = OK;
-        }
+  ret = nxsem_wait(&rwb->wrsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
-      /* 2. We invalidate the entire write buffer. */
+  /* Segments that were committed cannot be changed any more.  Let the
+   * write-back of the invalidated blocks complete first.
+   */
 
-      else if (rwb->wrblockstart >= startblock && wrbend <= invend)
+  do
+    {
+      busy = false;
+      for (i = 0; i < rwb->wrnsegs; i++)
         {
-          rwb->wrnblocks = 0;
-          ret = OK;
+          seg = &rwb->wrsegs[i];
+          if ((seg->state == RWB_SEG_COMMITTED ||
+               seg->state == RWB_SEG_WRITING) &&
+              rwb_overlap(seg->blockstart, seg->nblocks, startblock,
+                          blockcount))
+            {
+              busy = true;
+              break;
+            }
         }
 
-      /* We are going to invalidate a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 2. We invalidate a portion in the middle of the write buffer
-       */
-
-      else if (rwb->wrblockstart < startblock && wrbend > invend)
+      if (busy)
         {
-          FAR uint8_t *src;
-          off_t block;
-          off_t offset;
-          size_t nblocks;
-
-          /* Write the blocks at the end of the media to hardware */
-
-          nblocks = wrbend - invend;
-          block   = invend;
-          offset  = block - rwb->wrblockstart;
-          src     = rwb->wrbuffer + offset * rwb->blocksize;
-
-          ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-          if (ret < 0)
+          if (!rwb->wrbusy)
             {
-              ferr("ERROR: wrflush failed: %d\n", ret);
+              rwb_wrprocess(rwb);
             }
-
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
-
           else
             {
-              rwb->wrnblocks = startblock - rwb->wrblockstart;
-              ret = OK;
+              rwb_wrwait(rwb);
             }
         }
+    }
+  while (busy);
 
-      /* 3. We invalidate a portion at the end of the write buffer */
+  /* Now remove the invalidated blocks from the dirty extents */
 
-      else if (wrbend > startblock && wrbend <= invend)
+  for (i = 0; i < rwb->wrnsegs; i++)
+    {
+      seg = &rwb->wrsegs[i];
+      if (seg->state != RWB_SEG_DIRTY ||
+          !rwb_overlap(seg->blockstart, seg->nblocks, startblock,
+                       blockcount))
         {
-          rwb->wrnblocks = wrbend - startblock;
-          ret = OK;
+          continue;
         }
 
-      /* 4. We invalidate a portion at the beginning of the write buffer */
-
-      else /* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
+      segend = seg->blockstart + seg->nblocks;
 
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
+      /* 1. The extent is wholly invalidated */
 
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the write buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
+      if (startblock <= seg->blockstart && endblock >= segend)
+        {
+          seg->state   = RWB_SEG_FREE;
+          seg->nblocks = 0;
+        }
 
-          ninval = invend - rwb->wrblockstart;
-          src    = rwb->wrbuffer + ninval * rwb->blocksize;
+      /* 2. The head of the extent is invalidated */
 
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
+      else if (startblock <= seg->blockstart)
+        {
+          ntail = segend - endblock;
+          memmove(seg->buffer,
+                  &seg->buffer[(endblock - seg->blockstart) *
+                               rwb->blocksize],
+                  ntail * rwb->blocksize);
+
+          seg->blockstart = endblock;
+          seg->nblocks    = ntail;
+        }
 
-          nkeep  = rwb->wrnblocks - ninval;
+      /* 3. The tail of the extent is invalidated */
 
-          /* Then move the data that we are keeping to the beginning
-           * the write buffer.
-           */
+      else if (endblock >= segend)
+        {
+          seg->nblocks = startblock - seg->blockstart;
+        }
 
-          memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
+      /* 4. A hole is punched in the middle of the extent.  The tail moves
+       *    to a free segment or, if there is none, is written out now.
+       */
 
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
+      else
+        {
+          ntail = segend - endblock;
+          tail  = rwb_allocseg(rwb, endblock);
+          if (tail != NULL)
+            {
+              memcpy(tail->buffer,
+                     &seg->buffer[(endblock - seg->blockstart) *
+                                  rwb->blocksize],
+                     ntail * rwb->blocksize);
+              tail->nblocks = ntail;
+            }
+          else
+            {
+              nwritten = rwb_devwrite(rwb,
+                                      &seg->buffer[(endblock -
+                                                    seg->blockstart) *
+                                                   rwb->blocksize],
+                                      endblock, ntail);
+              rwb_rhdiscard(rwb, endblock, ntail);
+              if (nwritten != ntail)
+                {
+                  ferr("ERROR: Failed to write the tail: %d\n",
+                       (int)nwritten);
+                  ret = nwritten < 0 ? (int)nwritten : -EIO;
+                }
+            }
 
-          rwb->wrblockstart = invend;
-          rwb->wrnblocks    = nkeep;
-          ret = OK;
+          seg->nblocks = startblock - seg->blockstart;
         }
-
-      rwb_semgive(&rwb->wrsem);
     }
 
+  rwb_semgive(&rwb->wrsem);
   return ret;
 }
 #endif
@@ -686,40 +1248,77 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
   DEBUGASSERT(rwb->wrflush != NULL);
   rwb->wrbuffer = NULL;
+  rwb->wrsegs   = NULL;
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
   DEBUGASSERT(rwb->rhreload != NULL);
   rwb->rhbuffer = NULL;
 #endif
 
+#ifdef RWB_ASYNC
+  nxsem_init(&rwb->devsem, 0, 1);
+#endif
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
+      int i;
+
       finfo("Initialize the write buffer\n");
 
-      /* Initialize the write buffer access semaphore */
+      /* Initialize the write buffer access semaphore and the semaphore
+       * that signals the end of segment writes.
+       */
 
       nxsem_init(&rwb->wrsem, 0, 1);
+      nxsem_init(&rwb->wrdonesem, 0, 0);
 
-      /* Initialize write buffer parameters */
+      /* Initialize write buffer parameters.  The write buffer is divided
+       * into segments of equal size.
+       */
 
-      rwb_resetwrbuffer(rwb);
+      rwb->wrnsegs = CONFIG_DRVR_WRSEGMENTS;
+      if (rwb->wrnsegs > rwb->wrmaxblocks)
+        {
+          rwb->wrnsegs = rwb->wrmaxblocks;
+        }
+
+      rwb->wrsegblocks = rwb->wrmaxblocks / rwb->wrnsegs;
+      rwb->wrninflight = 0;
+      rwb->wrnwaiters  = 0;
+      rwb->wrbusy      = false;
+      rwb->wrerror     = OK;
+      rwb->wrseq       = 0;
+      memset(&rwb->wrstats, 0, sizeof(struct rwb_stats_s));
 
       /* Allocate the write buffer */
 
-      rwb->wrbuffer = NULL;
-      if (rwb->wrmaxblocks > 0)
+      allocsize     = rwb->wrnsegs * rwb->wrsegblocks * rwb->blocksize;
+      rwb->wrbuffer = kmm_malloc(allocsize);
+      if (!rwb->wrbuffer)
         {
-          allocsize     = rwb->wrmaxblocks * rwb->blocksize;
-          rwb->wrbuffer = kmm_malloc(allocsize);
-          if (!rwb->wrbuffer)
-            {
-              ferr("Write buffer kmm_malloc(%d) failed\n", allocsize);
-              return -ENOMEM;
-            }
+          ferr("Write buffer kmm_malloc(%d) failed\n", allocsize);
+          return -ENOMEM;
+        }
+
+      rwb->wrsegs = (FAR struct rwb_segment_s *)
+        kmm_zalloc(rwb->wrnsegs * sizeof(struct rwb_segment_s));
+      if (!rwb->wrsegs)
+        {
+          ferr("Write buffer segments kmm_zalloc failed\n");
+          return -ENOMEM;
+        }
+
+      for (i = 0; i < rwb->wrnsegs; i++)
+        {
+          rwb->wrsegs[i].buffer =
+            &rwb->wrbuffer[i * rwb->wrsegblocks * rwb->blocksize];
         }
 
-      finfo("Write buffer size: %d bytes\n", allocsize);
+      rwb_resetwrbuffer(rwb);
+
+      finfo("Write buffer size: %d bytes in %d segments\n",
+            allocsize, rwb->wrnsegs);
     }
 #endif /* CONFIG_DRVR_WRITEBUFFER */
 
@@ -767,11 +1366,20 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
   if (rwb->wrmaxblocks > 0)
     {
       rwb_wrcanceltimeout(rwb);
+#ifdef RWB_ASYNC
+      work_cancel(LPWORK, &rwb->wrwork);
+#endif
       nxsem_destroy(&rwb->wrsem);
+      nxsem_destroy(&rwb->wrdonesem);
       if (rwb->wrbuffer)
         {
           kmm_free(rwb->wrbuffer);
         }
+
+      if (rwb->wrsegs)
+        {
+          kmm_free(rwb->wrsegs);
+        }
     }
 #endif
 
@@ -785,6 +1393,10 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
         }
     }
 #endif
+
+#ifdef RWB_ASYNC
+  nxsem_destroy(&rwb->devsem);
+#endif
 }
 
 /****************************************************************************
@@ -869,7 +1481,9 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
        * the user buffer.
        */
 
+      rwb_devtake(rwb);
       ret = rwb->rhreload(rwb->dev, rdbuffer, startblock, nblocks);
+      rwb_devgive(rwb);
     }
 
   return (ssize_t)ret;
@@ -889,29 +1503,36 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
         (long)startblock, (long)nblocks, rdbuffer);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  /* If the new read data overlaps any part of the write buffer, we
-   * directly copy write buffer to read buffer. This boost performance.
+  /* Blocks that are in the write buffer are newer than the blocks on the
+   * media.  They are copied from the write buffer and only the gaps
+   * between them are read from the media.  The wrsem is held throughout
+   * so that no segment is freed before the gaps have been read.
    */
 
   if (rwb->wrmaxblocks > 0)
     {
+      FAR struct rwb_segment_s *seg;
+      size_t rdblocks;
+
       ret = nxsem_wait(&rwb->wrsem);
       if (ret < 0)
         {
           return (ssize_t)ret;
         }
 
-      /* If the write buffer overlaps the block(s) requested */
-
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
-                      nblocks))
+      while (nblocks > 0)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
-
-          if (rwb->wrblockstart > startblock)
+          seg = rwb_findrdseg(rwb, startblock, nblocks, &rdblocks);
+          if (seg != NULL)
+            {
+              memcpy(rdbuffer,
+                     &seg->buffer[(startblock - seg->blockstart) *
+                                  rwb->blocksize],
+                     rdblocks * rwb->blocksize);
+              rwb->wrstats.rdhits += rdblocks;
+            }
+          else
             {
-              rdblocks = rwb->wrblockstart - startblock;
               ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
               if (ret < 0)
                 {
@@ -919,22 +1540,13 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
                   return (ssize_t)ret;
                 }
 
-              startblock += ret;
-              nblocks    -= ret;
-              rdbuffer   += ret * rwb->blocksize;
-              readblocks += ret;
-            }
-
-          if (rwb->wrblockstart < startblock)
-            {
-              wrnpass = startblock - rwb->wrblockstart;
+              if (ret < rdblocks)
+                {
+                  readblocks += ret;
+                  break;
+                }
             }
 
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
-
           startblock += rdblocks;
           nblocks    -= rdblocks;
           rdbuffer   += rdblocks * rwb->blocksize;
@@ -942,6 +1554,7 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
         }
 
       rwb_semgive(&rwb->wrsem);
+      return readblocks;
     }
 #endif
 
@@ -963,83 +1576,52 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
 {
   int ret = OK;
 
-#ifdef CONFIG_DRVR_READAHEAD
-  if (rwb->rhmaxblocks > 0)
-    {
-      /* If the new write data overlaps any part of the read buffer, then
-       * flush the data from the read buffer.  We could attempt some more
-       * exotic handling -- but this simple logic is well-suited for simple
-       * streaming applications.
-       */
-
-      ret = nxsem_wait(&rwb->rhsem);
-      if (ret < 0)
-        {
-          return (ssize_t)ret;
-        }
-
-      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock,
-                      nblocks))
-        {
-#ifdef CONFIG_DRVR_INVALIDATE
-          /* Just invalidate the read buffer startblock + nblocks data */
-
-          ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
-          if (ret < 0)
-            {
-              ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
-              rwb_semgive(&rwb->rhsem);
-              return (ssize_t)ret;
-            }
-#else
-          rwb_resetrhbuffer(rwb);
-#endif
-        }
+  /* If the new write data overlaps any part of the read buffer, then
+   * flush the data from the read buffer.  We could attempt some more
+   * exotic handling -- but this simple logic is well-suited for simple
+   * streaming applications.
+   */
 
-      rwb_semgive(&rwb->rhsem);
-    }
-#endif
+  rwb_rhdiscard(rwb, startblock, nblocks);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
       finfo("startblock=%d wrbuffer=%p\n", startblock, wrbuffer);
 
+      ret = nxsem_wait(&rwb->wrsem);
+      if (ret < 0)
+        {
+          return (ssize_t)ret;
+        }
+
       /* Use the block cache unless the buffer size is bigger than block
        * cache.
        */
 
       if (nblocks > rwb->wrmaxblocks)
         {
-          /* First flush the cache */
-
-          ret = nxsem_wait(&rwb->wrsem);
-          if (ret < 0)
-            {
-              return (ssize_t)ret;
-            }
+          /* First write back the cache so that the media sees the writes
+           * in order.
+           */
 
-          rwb_wrflush(rwb);
-          rwb_semgive(&rwb->wrsem);
+          rwb_commitall(rwb);
+          rwb_wrsync(rwb);
 
           /* Then transfer the data directly to the media */
 
-          ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+          rwb->wrstats.wrblocks += nblocks;
+          ret = rwb_devwrite(rwb, wrbuffer, startblock, nblocks);
         }
       else
         {
           /* Buffer the data in the write buffer */
 
-          ret = nxsem_wait(&rwb->wrsem);
-          if (ret < 0)
-            {
-              return (ssize_t)ret;
-            }
-
           ret = rwb_writebuffer(rwb, startblock, nblocks, wrbuffer);
-          rwb_semgive(&rwb->wrsem);
         }
 
+      rwb_semgive(&rwb->wrsem);
+
       /* On success, return the number of blocks that we were requested to
        * write.  This is for compatibility with the normal return of a block
        * driver write method
@@ -1098,6 +1680,8 @@ ssize_t rwb_readbytes(FAR struct rwbuffer_s *dev, off_t offset,
 #ifdef CONFIG_DRVR_REMOVABLE
 int rwb_mediaremoved(FAR struct rwbuffer_s *rwb)
 {
+  int ret;
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -1107,6 +1691,7 @@ int rwb_mediaremoved(FAR struct rwbuffer_s *rwb)
           return ret;
         }
 
+      rwb_wrcanceltimeout(rwb);
       rwb_resetwrbuffer(rwb);
       rwb_semgive(&rwb->wrsem);
     }
@@ -1170,7 +1755,8 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
  * Name: rwb_flush
  *
  * Description:
- *   Flush the write buffer
+ *   Flush the write buffer.  Returns the first error of a write-back since
+ *   the last flush.
  *
  ****************************************************************************/
 
@@ -1179,13 +1765,84 @@ int rwb_flush(FAR struct rwbuffer_s *rwb)
 {
   int ret;
 
+  if (rwb->wrmaxblocks == 0)
+    {
+      return OK;
+    }
+
   ret = rwb_forcetake(&rwb->wrsem);
   rwb_wrcanceltimeout(rwb);
-  rwb_wrflush(rwb);
+  rwb_commitall(rwb);
+  rwb_wrsync(rwb);
+
+  if (ret == OK)
+    {
+      ret = rwb->wrerror;
+    }
+
+  rwb->wrerror = OK;
   rwb_semgive(&rwb->wrsem);
 
   return ret;
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_getstats
+ *
+ * Description:
+ *   Return the write buffer statistics.  The write amplification is
+ *   devblocks / wrblocks; the mean write-back latency is flushticks /
+ *   devwrites.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+int rwb_getstats(FAR struct rwbuffer_s *rwb, FAR struct rwb_stats_s *stats)
+{
+  int ret;
+
+  DEBUGASSERT(rwb != NULL && stats != NULL);
+
+  if (rwb->wrmaxblocks == 0)
+    {
+      return -ENOSYS;
+    }
+
+  ret = nxsem_wait(&rwb->wrsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memcpy(stats, &rwb->wrstats, sizeof(struct rwb_stats_s));
+  rwb_semgive(&rwb->wrsem);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_lock/rwb_unlock
+ *
+ * Description:
+ *   Lock the device against the callouts.  With write-back on the work
+ *   queue, the flush callout may run at any time on the worker thread.  A
+ *   driver that accesses the media other than through the callouts (to
+ *   probe for a card, for example) must hold the device lock while doing
+ *   so.  The callouts must not be called with the lock held.
+ *
+ ****************************************************************************/
+
+void rwb_lock(FAR struct rwbuffer_s *rwb)
+{
+  DEBUGASSERT(rwb != NULL);
+  rwb_devtake(rwb);
+}
+
+void rwb_unlock(FAR struct rwbuffer_s *rwb)
+{
+  DEBUGASSERT(rwb != NULL);
+  rwb_devgive(rwb);
+}
+
 #endif /* CONFIG_DRVR_WRITEBUFFER || CONFIG_DRVR_READAHEAD */
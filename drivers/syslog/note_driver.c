@@ -41,15 +41,26 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/sched_note.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
 #include <nuttx/fs/fs.h>
 
 #if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
     defined(CONFIG_DRIVER_NOTE)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_DRIVER_NOTE_INTERVAL
+#  define CONFIG_DRIVER_NOTE_INTERVAL 10
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -61,6 +72,10 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
  * Private Data
  ****************************************************************************/
 
+/* sched_note_get() allows only one reader at a time */
+
+static sem_t g_note_sem = SEM_INITIALIZER(1);
+
 static const struct file_operations note_fops =
 {
   NULL,          /* open */
@@ -88,13 +103,40 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
 {
   ssize_t notelen;
   ssize_t retlen ;
+  int ret;
 
   DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
 
+  ret = nxsem_wait(&g_note_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait until there is at least one note, unless O_NONBLOCK was set.
+   * Adding a note cannot wake up the reader:  The scheduler hooks run in
+   * contexts where no semaphore may be posted.  So the buffer is polled.
+   */
+
+  while ((notelen = sched_note_size()) == 0)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          nxsem_post(&g_note_sem);
+          return -EAGAIN;
+        }
+
+      ret = nxsig_usleep(CONFIG_DRIVER_NOTE_INTERVAL * 1000);
+      if (ret < 0)
+        {
+          nxsem_post(&g_note_sem);
+          return ret;
+        }
+    }
+
   /* Then loop, adding as many notes as possible to the user buffer. */
 
   retlen = 0;
-  sched_lock();
   do
     {
      /* Get the next note (removing it from the buffer) */
@@ -135,7 +177,7 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
     }
   while (notelen > 0 && notelen <= buflen);
 
-  sched_unlock();
+  nxsem_post(&g_note_sem);
   return retlen;
 }
 
@@ -42,7 +42,24 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <syslog.h>
+#include <time.h>
+
+#include <nuttx/syslog/syslog.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output that does not come from syslog(), such as the output of
+ * /dev/syslog or of the console, has no priority.  It is given the highest
+ * priority so that it passes the level filter of every channel.
+ */
+
+#define SYSLOG_PRIORITY_RAW LOG_EMERG
 
 /****************************************************************************
  * Public Data
@@ -58,13 +75,6 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* This is the current syslog channel in use.  It initially points to
- * g_default_channel.
- */
-
-struct syslog_channel_s; /* Forward reference */
-EXTERN FAR const struct syslog_channel_s *g_syslog_channel;
-
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -228,11 +238,10 @@ int syslog_add_intbuffer(int ch);
  *
  * Description:
  *   Flush any characters that may have been added to the interrupt buffer
- *   to the SYSLOG device.
+ *   to the SYSLOG channels.
  *
  * Input Parameters:
- *   channel - The syslog channel to use in performing the flush operation.
- *   force   - Use the force() method of the channel vs. the putc() method.
+ *   force   - Use the force() method of the channels vs. the putc() method.
  *
  * Returned Value:
  *   On success, the character is echoed back to the caller.  A negated
@@ -244,8 +253,259 @@ int syslog_add_intbuffer(int ch);
  ****************************************************************************/
 
 #ifdef CONFIG_SYSLOG_INTBUFFER
-int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
-                           bool force);
+int syslog_flush_intbuffer(bool force);
+#endif
+
+/****************************************************************************
+ * Name: syslog_ring_initialize
+ *
+ * Description:
+ *   Start the daemon that outputs the messages buffered in the SYSLOG ring
+ *   buffer.  Until this is called, messages are not buffered but written
+ *   directly to the SYSLOG channels.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+int syslog_ring_initialize(void);
+#endif
+
+/****************************************************************************
+ * Name: syslog_ring_write
+ *
+ * Description:
+ *   Add a message to the SYSLOG ring buffer.  This never blocks and may be
+ *   called from interrupt handlers.  If the ring buffer is full, the
+ *   message is dropped and counted.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   buffer   - The buffer containing the data to be output
+ *   buflen   - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes consumed (buffered or dropped) is returned.
+ *   -EAGAIN is returned if the ring buffer is not yet in use; the caller
+ *   must then output the data itself.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+ssize_t syslog_ring_write(int priority, FAR const char *buffer,
+                          size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_ring_flush
+ *
+ * Description:
+ *   Output all of the messages in the SYSLOG ring buffer using the force
+ *   method of the channels.  This is only used in emergency situations
+ *   (e.g., in assertion handling).  A batch that the daemon was outputting
+ *   when it was interrupted may be repeated.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+void syslog_ring_flush(void);
+#endif
+
+/****************************************************************************
+ * Name: syslog_ring_write_binary
+ *
+ * Description:
+ *   Add a binary record to the SYSLOG ring buffer.  The record is never
+ *   split and is formatted by syslog_binary_format() when it is output.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   record   - The binary record
+ *   reclen   - The size of the record in bytes
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the record was buffered or dropped.  -EAGAIN
+ *   is returned if the ring buffer is not yet in use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+int syslog_ring_write_binary(int priority, FAR const void *record,
+                             size_t reclen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_binary_write
+ *
+ * Description:
+ *   Record a message in binary form:  The address of the format string, a
+ *   time stamp and the values of the arguments are added to the SYSLOG ring
+ *   buffer without formatting the message.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string.  Only a format string in the .text or
+ *              .rodata of the image is referenced by a record.
+ *   ap       - The arguments.  They are not consumed.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   if the message can not be recorded (format string not in the image,
+ *   unsupported conversion, too many arguments or ring buffer not yet in
+ *   use); the caller must then format the message itself.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+int syslog_binary_write(int priority, FAR const IPTR char *fmt,
+                        FAR va_list *ap);
+#endif
+
+/****************************************************************************
+ * Name: syslog_binary_format
+ *
+ * Description:
+ *   Convert a binary record to the output sent to the SYSLOG channels:
+ *   the formatted message or, with CONFIG_SYSLOG_BINARY_RAW, the record
+ *   itself as a line of base64 for tools/syslogdecode.
+ *
+ * Input Parameters:
+ *   record - The binary record
+ *   reclen - The size of the record in bytes
+ *   buffer - The output buffer
+ *   buflen - The size of the output buffer
+ *
+ * Returned Value:
+ *   The number of bytes in the output buffer.  Zero is returned if the
+ *   output does not fit; nothing is ever truncated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+size_t syslog_binary_format(FAR const void *record, size_t reclen,
+                            FAR char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_binary_output
+ *
+ * Description:
+ *   Format a binary record that does not fit in the buffer directly to the
+ *   SYSLOG channels.  The buffer is written out each time it fills up.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   record   - The binary record
+ *   reclen   - The size of the record in bytes
+ *   buffer   - A buffer to format the message in
+ *   buflen   - The size of the buffer
+ *   force    - Use the force method of the channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SYSLOG_BINARY) && !defined(CONFIG_SYSLOG_BINARY_RAW)
+void syslog_binary_output(int priority, FAR const void *record,
+                          size_t reclen, FAR char *buffer, size_t buflen,
+                          bool force);
+#endif
+
+/****************************************************************************
+ * Name: syslog_timestamp
+ *
+ * Description:
+ *   Get the time stamp of a SYSLOG message.  Zero is returned if the timer
+ *   hardware is not yet available.
+ *
+ * Input Parameters:
+ *   ts - The location to return the time stamp
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SYSLOG_TIMESTAMP) || defined(CONFIG_SYSLOG_BINARY)
+void syslog_timestamp(FAR struct timespec *ts);
+#endif
+
+/****************************************************************************
+ * Name: syslog_channel_putc, syslog_channel_force and syslog_channel_write
+ *
+ * Description:
+ *   Send output to every SYSLOG channel whose level admits the priority
+ *   of the output, using the putc(), force() or write() method of the
+ *   channels.  syslog_channel_write() falls back to putc() for channels
+ *   without a write() method.
+ *
+ * Input Parameters:
+ *   priority - The priority of the output
+ *   ch       - The character to output (must be positive)
+ *   buffer   - The buffer containing the data to be output
+ *   buflen   - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   On success (i.e., at least one channel accepted the output or no
+ *   channel is interested in it), the character or the number of bytes
+ *   is returned.  Otherwise, the negated errno value returned by the last
+ *   channel is returned.
+ *
+ ****************************************************************************/
+
+int syslog_channel_putc(int priority, int ch);
+int syslog_channel_force(int priority, int ch);
+ssize_t syslog_channel_write(int priority, FAR const char *buffer,
+                             size_t buflen);
+
+/****************************************************************************
+ * Name: syslog_channel_flush
+ *
+ * Description:
+ *   Flush the buffered output of every SYSLOG channel.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; the last negated errno value returned
+ *   by a channel is returned on any failure.
+ *
+ ****************************************************************************/
+
+int syslog_channel_flush(void);
+
+/****************************************************************************
+ * Name: syslog_channel_unbind
+ *
+ * Description:
+ *   Remove every channel that uses the given putc() method.  This is used
+ *   to detach the channels that share the SYSLOG device before the device
+ *   is re-opened.
+ *
+ * Input Parameters:
+ *   putc - The putc() method of the channels to remove.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_SYSLOG_MAX_CHANNELS > 1
+void syslog_channel_unbind(syslog_putc_t putc);
 #endif
 
 /****************************************************************************
@@ -265,6 +525,21 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
 
 int syslog_putc(int ch);
 
+/****************************************************************************
+ * Name: syslog_putc_priority and syslog_write_priority
+ *
+ * Description:
+ *   The same as syslog_putc() and syslog_write(), except that the output
+ *   has a priority and is only sent to the channels that accept messages
+ *   of that priority.  syslog_putc() and syslog_write() output is sent
+ *   with SYSLOG_PRIORITY_RAW.
+ *
+ ****************************************************************************/
+
+int syslog_putc_priority(int priority, int ch);
+ssize_t syslog_write_priority(int priority, FAR const char *buffer,
+                              size_t buflen);
+
 /****************************************************************************
  * Name: syslog_write
  *
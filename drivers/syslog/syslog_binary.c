@@ -0,0 +1,876 @@
+/****************************************************************************
+ * drivers/syslog/syslog_binary.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/streams.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_BINARY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A binary record holds:
+ *
+ *   - The priority of the message (1 byte)
+ *   - The time stamp, seconds and nanoseconds (4 bytes each)
+ *   - The address of the format string (the size of a pointer)
+ *   - One tagged value for each argument and each '*' width or precision.
+ *     Integers and pointers are tagged with their size in bytes and
+ *     followed by their value.  Doubles are tagged with 'd' or, if double
+ *     has only 32 bits, with 'f'.  Strings are copied and are tagged with
+ *     's'.
+ *
+ * All values are in the byte order of the target and are not aligned.
+ * tools/syslogdecode.c decodes the same layout.
+ */
+
+#define SYSLOG_BINARY_HDRSIZE (9 + sizeof(FAR const char *))
+
+#define SYSLOG_ARG_DOUBLE     (sizeof(double) == 4 ? 'f' : 'd')
+#define SYSLOG_ARG_STRING     's'
+
+/* The size of a conversion specification with the '*' width and precision
+ * replaced by their values.
+ */
+
+#define SYSLOG_SPEC_MAX       32
+
+#ifdef CONFIG_SYSLOG_BINARY_RAW
+/* Each record is output as one line:  An ASCII RS character and the record
+ * encoded in base64.
+ */
+
+#  define SYSLOG_BINARY_MARK  0x1e
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One parsed conversion specification */
+
+struct syslog_spec_s
+{
+  bool wstar;                  /* The width is given by an argument */
+  bool pstar;                  /* The precision is given by an argument */
+  int prec;                    /* The precision, or -1 if none */
+  char size;                   /* h, H (hh), l, L (ll), z or 0 */
+  char conv;                   /* The conversion character */
+};
+
+#ifndef CONFIG_SYSLOG_BINARY_RAW
+/* The stream that records are formatted to.  When the buffer is full, it
+ * is either written to the SYSLOG channels (spill) or the rest of the
+ * output is only counted.
+ */
+
+struct syslog_binstream_s
+{
+  struct lib_outstream_s public;
+  FAR char *buffer;            /* The output buffer */
+  size_t buflen;               /* The size of the output buffer */
+  size_t nbuf;                 /* The number of bytes in the buffer */
+  int priority;                /* The priority of the message */
+  bool spill;                  /* Output the buffer when it is full */
+  bool force;                  /* Use the force method of the channels */
+};
+#endif
+
+/* An argument, as recorded */
+
+union syslog_arg_u
+{
+  int i;
+  long l;
+#ifdef CONFIG_HAVE_LONG_LONG
+  long long ll;
+#endif
+  size_t z;
+  FAR void *p;
+  double d;
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The read-only part of the image, as defined by the linker script */
+
+extern const char _stext[];    /* Start of .text */
+extern const char _etext[];    /* End+1 of .text + .rodata */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY_RAW
+static const char g_base64[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_binary_parse
+ *
+ * Description:
+ *   Parse the conversion specification following a '%' in the format
+ *   string.  Only the syntax supported by lib_vsprintf() is accepted;
+ *   numbered arguments are not.
+ *
+ * Returned Value:
+ *   A pointer to the character following the conversion specification,
+ *   or NULL if it is not supported.
+ *
+ ****************************************************************************/
+
+static FAR const IPTR char *
+syslog_binary_parse(FAR const IPTR char *fmt, FAR struct syslog_spec_s *spec)
+{
+  spec->wstar = false;
+  spec->pstar = false;
+  spec->prec  = -1;
+  spec->size  = 0;
+
+  while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' ||
+         *fmt == '0')
+    {
+      fmt++;
+    }
+
+  if (*fmt == '*')
+    {
+      spec->wstar = true;
+      fmt++;
+    }
+  else
+    {
+      while (*fmt >= '0' && *fmt <= '9')
+        {
+          fmt++;
+        }
+    }
+
+  if (*fmt == '.')
+    {
+      fmt++;
+      if (*fmt == '*')
+        {
+          spec->pstar = true;
+          fmt++;
+        }
+      else
+        {
+          spec->prec = 0;
+          while (*fmt >= '0' && *fmt <= '9')
+            {
+              spec->prec = spec->prec * 10 + *fmt++ - '0';
+            }
+        }
+    }
+
+  if (*fmt == 'h' || *fmt == 'l')
+    {
+      spec->size = *fmt++;
+      if (*fmt == spec->size)
+        {
+          spec->size = spec->size == 'h' ? 'H' : 'L';
+          fmt++;
+        }
+    }
+  else if (*fmt == 'z')
+    {
+      spec->size = *fmt++;
+    }
+
+  spec->conv = *fmt;
+  if (spec->conv == '\0' || spec->conv == '$')
+    {
+      return NULL;
+    }
+
+  return fmt + 1;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_put
+ *
+ * Description:
+ *   Append one tagged value to a record.  Returns NULL if it does not fit.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *syslog_binary_put(FAR uint8_t *ptr, FAR uint8_t *end,
+                                      uint8_t tag, FAR const void *data,
+                                      size_t len)
+{
+  if (ptr == NULL || (size_t)(end - ptr) < len + 1)
+    {
+      return NULL;
+    }
+
+  *ptr++ = tag;
+  memcpy(ptr, data, len);
+  return ptr + len;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_get
+ *
+ * Description:
+ *   Take the next tagged value from a record.  Returns NULL if the value
+ *   is missing or has a different tag.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *syslog_binary_get(FAR const uint8_t *ptr,
+                                            FAR const uint8_t *end,
+                                            uint8_t tag, FAR void *data,
+                                            size_t len)
+{
+  if (ptr == NULL || (size_t)(end - ptr) < len + 1 || *ptr != tag)
+    {
+      return NULL;
+    }
+
+  memcpy(data, ptr + 1, len);
+  return ptr + 1 + len;
+}
+
+#ifndef CONFIG_SYSLOG_BINARY_RAW
+
+/****************************************************************************
+ * Name: syslog_binary_spill
+ *
+ * Description:
+ *   Write the content of the stream buffer to the SYSLOG channels.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_spill(FAR struct syslog_binstream_s *stream)
+{
+  size_t i;
+
+  if (stream->force)
+    {
+      for (i = 0; i < stream->nbuf; i++)
+        {
+          syslog_channel_force(stream->priority, stream->buffer[i]);
+        }
+    }
+  else if (stream->nbuf > 0)
+    {
+      syslog_channel_write(stream->priority, stream->buffer, stream->nbuf);
+    }
+
+  stream->nbuf = 0;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_store
+ ****************************************************************************/
+
+static void syslog_binary_store(FAR struct syslog_binstream_s *stream,
+                                char ch)
+{
+  if (stream->nbuf >= stream->buflen && stream->spill)
+    {
+      syslog_binary_spill(stream);
+    }
+
+  if (stream->nbuf < stream->buflen)
+    {
+      stream->buffer[stream->nbuf++] = ch;
+    }
+
+  stream->public.nput++;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_putc
+ *
+ * Description:
+ *   The putc method of the stream used to format records.  Like the
+ *   SYSLOG stream, this discards carriage returns and adds one before each
+ *   linefeed.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct syslog_binstream_s *stream =
+    (FAR struct syslog_binstream_s *)this;
+
+  if (ch == '\r')
+    {
+      return;
+    }
+
+  if (ch == '\n')
+    {
+      syslog_binary_store(stream, '\r');
+    }
+
+  syslog_binary_store(stream, ch);
+}
+
+/****************************************************************************
+ * Name: syslog_binary_text
+ *
+ * Description:
+ *   Format a record as the text that nx_vsyslog() would have produced.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_text(FAR const uint8_t *record, size_t reclen,
+                               FAR struct syslog_binstream_s *stream)
+{
+  struct syslog_spec_s spec;
+  union syslog_arg_u arg;
+  FAR const IPTR char *fmt;
+  FAR const IPTR char *start;
+  FAR const uint8_t *ptr;
+  FAR const uint8_t *end = record + reclen;
+  char spectext[SYSLOG_SPEC_MAX];
+  uint32_t sec;
+  uint32_t nsec;
+  int len;
+  int val;
+  char c;
+
+  stream->public.put   = syslog_binary_putc;
+  stream->public.flush = lib_noflush;
+  stream->public.nput  = 0;
+  stream->nbuf         = 0;
+
+  memcpy(&sec, &record[1], 4);
+  memcpy(&nsec, &record[5], 4);
+  memcpy(&fmt, &record[9], sizeof(fmt));
+  ptr = record + SYSLOG_BINARY_HDRSIZE;
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  lib_sprintf(&stream->public, "[%5d.%06d] ", (int)sec, (int)(nsec / 1000));
+#else
+  UNUSED(sec);
+  UNUSED(nsec);
+#endif
+
+#ifdef CONFIG_SYSLOG_PREFIX
+  lib_sprintf(&stream->public, "%s", CONFIG_SYSLOG_PREFIX_STRING);
+#endif
+
+  while ((c = *fmt++) != '\0')
+    {
+      if (c != '%')
+        {
+          syslog_binary_putc(&stream->public, c);
+          continue;
+        }
+      else if (*fmt == '%')
+        {
+          syslog_binary_putc(&stream->public, '%');
+          fmt++;
+          continue;
+        }
+
+      /* Rebuild the conversion specification with the values of any '*'
+       * width or precision filled in.
+       */
+
+      start = fmt - 1;
+      fmt   = syslog_binary_parse(fmt, &spec);
+      if (fmt == NULL)
+        {
+          break;
+        }
+
+      len = 0;
+      while (start < fmt && len < SYSLOG_SPEC_MAX - 12)
+        {
+          c = *start++;
+          if (c != '*')
+            {
+              spectext[len++] = c;
+              continue;
+            }
+
+          ptr = syslog_binary_get(ptr, end, sizeof(int), &val, sizeof(int));
+          if (ptr == NULL)
+            {
+              break;
+            }
+
+          /* A negative precision is the same as no precision */
+
+          if (spectext[len - 1] == '.' && val < 0)
+            {
+              len--;
+              continue;
+            }
+
+          len += snprintf(&spectext[len], 12, "%d", val);
+        }
+
+      if (ptr == NULL || start < fmt)
+        {
+          break;
+        }
+
+      spectext[len] = '\0';
+
+      /* Then fetch the argument and format it */
+
+      switch (spec.conv)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+            switch (spec.size)
+              {
+                case 'l':
+                  ptr = syslog_binary_get(ptr, end, sizeof(long), &arg.l,
+                                          sizeof(long));
+                  if (ptr != NULL)
+                    {
+                      lib_sprintf(&stream->public, spectext, arg.l);
+                    }
+                  break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+                case 'L':
+                  ptr = syslog_binary_get(ptr, end, sizeof(long long),
+                                          &arg.ll, sizeof(long long));
+                  if (ptr != NULL)
+                    {
+                      lib_sprintf(&stream->public, spectext, arg.ll);
+                    }
+                  break;
+#endif
+
+                case 'z':
+                  ptr = syslog_binary_get(ptr, end, sizeof(size_t), &arg.z,
+                                          sizeof(size_t));
+                  if (ptr != NULL)
+                    {
+                      lib_sprintf(&stream->public, spectext, arg.z);
+                    }
+                  break;
+
+                default:
+                  ptr = syslog_binary_get(ptr, end, sizeof(int), &arg.i,
+                                          sizeof(int));
+                  if (ptr != NULL)
+                    {
+                      lib_sprintf(&stream->public, spectext, arg.i);
+                    }
+                  break;
+              }
+            break;
+
+          case 'p':
+            ptr = syslog_binary_get(ptr, end, sizeof(FAR void *), &arg.p,
+                                    sizeof(FAR void *));
+            if (ptr != NULL)
+              {
+                lib_sprintf(&stream->public, spectext, arg.p);
+              }
+            break;
+
+          case 's':
+            if (ptr < end && *ptr == SYSLOG_ARG_STRING &&
+                memchr(ptr + 1, '\0', end - ptr - 1) != NULL)
+              {
+                lib_sprintf(&stream->public, spectext, ptr + 1);
+                ptr += strlen((FAR const char *)ptr + 1) + 2;
+              }
+            else
+              {
+                ptr = NULL;
+              }
+            break;
+
+          default:
+            ptr = syslog_binary_get(ptr, end, SYSLOG_ARG_DOUBLE, &arg.d,
+                                    sizeof(double));
+            if (ptr != NULL)
+              {
+                lib_sprintf(&stream->public, spectext, arg.d);
+              }
+            break;
+        }
+
+      if (ptr == NULL)
+        {
+          /* The record does not match the format string */
+
+          break;
+        }
+    }
+}
+
+#else /* CONFIG_SYSLOG_BINARY_RAW */
+
+/****************************************************************************
+ * Name: syslog_binary_base64
+ *
+ * Description:
+ *   Output a record, unformatted, as one base64 encoded line for decoding
+ *   on the host.
+ *
+ ****************************************************************************/
+
+static size_t syslog_binary_base64(FAR const uint8_t *record, size_t reclen,
+                                   FAR char *buffer, size_t buflen)
+{
+  uint32_t bits;
+  size_t nout;
+  size_t i;
+
+  /* The whole line must fit, a partial record can not be decoded */
+
+  if (buflen < 4 * ((reclen + 2) / 3) + 3)
+    {
+      return 0;
+    }
+
+  nout = 0;
+  buffer[nout++] = SYSLOG_BINARY_MARK;
+
+  for (i = 0; i < reclen; i += 3)
+    {
+      bits = (uint32_t)record[i] << 16;
+      if (i + 1 < reclen)
+        {
+          bits |= (uint32_t)record[i + 1] << 8;
+        }
+
+      if (i + 2 < reclen)
+        {
+          bits |= record[i + 2];
+        }
+
+      buffer[nout++] = g_base64[(bits >> 18) & 0x3f];
+      buffer[nout++] = g_base64[(bits >> 12) & 0x3f];
+      buffer[nout++] = i + 1 < reclen ? g_base64[(bits >> 6) & 0x3f] : '=';
+      buffer[nout++] = i + 2 < reclen ? g_base64[bits & 0x3f] : '=';
+    }
+
+  buffer[nout++] = '\r';
+  buffer[nout++] = '\n';
+  return nout;
+}
+
+#endif /* CONFIG_SYSLOG_BINARY_RAW */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_binary_write
+ *
+ * Description:
+ *   Record a message in binary form in the SYSLOG ring buffer.  The format
+ *   string is only scanned for the types of the arguments; formatting is
+ *   left to the SYSLOG daemon (or to the host).
+ *
+ ****************************************************************************/
+
+int syslog_binary_write(int priority, FAR const IPTR char *fmt,
+                        FAR va_list *ap)
+{
+  uint8_t record[CONFIG_SYSLOG_BINARY_MAXSIZE];
+  FAR uint8_t *ptr;
+  FAR uint8_t *end = record + sizeof(record);
+  FAR const char *str;
+  struct syslog_spec_s spec;
+  union syslog_arg_u arg;
+  struct timespec ts;
+  uint32_t value;
+  size_t len;
+  va_list copy;
+  int ret = OK;
+  char c;
+
+  /* The record only refers to the format string, which must therefore
+   * live as long as the image.  A format string built at run time or
+   * one in a loadable module is not in .text or .rodata; such messages
+   * are formatted right away by the caller.
+   */
+
+  if (fmt < _stext || fmt >= _etext)
+    {
+      return -EFAULT;
+    }
+
+  syslog_timestamp(&ts);
+
+  record[0] = (uint8_t)priority;
+  value     = (uint32_t)ts.tv_sec;
+  memcpy(&record[1], &value, 4);
+  value     = (uint32_t)ts.tv_nsec;
+  memcpy(&record[5], &value, 4);
+  memcpy(&record[9], &fmt, sizeof(fmt));
+  ptr       = record + SYSLOG_BINARY_HDRSIZE;
+
+  /* Work on a copy of the argument list so that the caller can still
+   * format the message if it can not be recorded.
+   */
+
+  va_copy(copy, *ap);
+
+  while ((c = *fmt++) != '\0')
+    {
+      if (c != '%')
+        {
+          continue;
+        }
+      else if (*fmt == '%')
+        {
+          fmt++;
+          continue;
+        }
+
+      fmt = syslog_binary_parse(fmt, &spec);
+      if (fmt == NULL)
+        {
+          ret = -ENOSYS;
+          break;
+        }
+
+      if (spec.wstar)
+        {
+          arg.i = va_arg(copy, int);
+          ptr   = syslog_binary_put(ptr, end, sizeof(int), &arg.i,
+                                    sizeof(int));
+        }
+
+      if (spec.pstar)
+        {
+          arg.i     = va_arg(copy, int);
+          spec.prec = arg.i < 0 ? -1 : arg.i;
+          ptr       = syslog_binary_put(ptr, end, sizeof(int), &arg.i,
+                                        sizeof(int));
+        }
+
+      switch (spec.conv)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+            switch (spec.size)
+              {
+                case 'l':
+                  arg.l = va_arg(copy, long);
+                  ptr   = syslog_binary_put(ptr, end, sizeof(long), &arg.l,
+                                            sizeof(long));
+                  break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+                case 'L':
+                  arg.ll = va_arg(copy, long long);
+                  ptr    = syslog_binary_put(ptr, end, sizeof(long long),
+                                             &arg.ll, sizeof(long long));
+                  break;
+#else
+                case 'L':
+                  ret = -ENOSYS;
+                  break;
+#endif
+
+                case 'z':
+                  arg.z = va_arg(copy, size_t);
+                  ptr   = syslog_binary_put(ptr, end, sizeof(size_t),
+                                            &arg.z, sizeof(size_t));
+                  break;
+
+                default:
+                  arg.i = va_arg(copy, int);
+                  ptr   = syslog_binary_put(ptr, end, sizeof(int), &arg.i,
+                                            sizeof(int));
+                  break;
+              }
+            break;
+
+          case 'p':
+            arg.p = va_arg(copy, FAR void *);
+            ptr   = syslog_binary_put(ptr, end, sizeof(FAR void *), &arg.p,
+                                      sizeof(FAR void *));
+            break;
+
+          case 's':
+
+            /* The string may not outlive the call, so it is copied.  Only
+             * the characters within the precision are accessed.
+             */
+
+            str = va_arg(copy, FAR const char *);
+            if (str == NULL)
+              {
+                str = "(null)";
+              }
+
+            len = spec.prec < 0 ? strlen(str) : strnlen(str, spec.prec);
+            ptr = syslog_binary_put(ptr, end, SYSLOG_ARG_STRING, str, len);
+            if (ptr != NULL && ptr < end)
+              {
+                *ptr++ = '\0';
+              }
+            else
+              {
+                ptr = NULL;
+              }
+            break;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+            arg.d = va_arg(copy, double);
+            ptr   = syslog_binary_put(ptr, end, SYSLOG_ARG_DOUBLE, &arg.d,
+                                      sizeof(double));
+            break;
+
+          default:
+
+            /* %n and anything unknown */
+
+            ret = -ENOSYS;
+            break;
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+      else if (ptr == NULL)
+        {
+          ret = -E2BIG;
+          break;
+        }
+    }
+
+  va_end(copy);
+
+  if (ret >= 0)
+    {
+      ret = syslog_ring_write_binary(priority, record, ptr - record);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_format
+ *
+ * Description:
+ *   Convert a binary record to the output sent to the SYSLOG channels.
+ *
+ ****************************************************************************/
+
+size_t syslog_binary_format(FAR const void *record, size_t reclen,
+                            FAR char *buffer, size_t buflen)
+{
+#ifndef CONFIG_SYSLOG_BINARY_RAW
+  struct syslog_binstream_s stream;
+#endif
+
+  if (reclen < SYSLOG_BINARY_HDRSIZE)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_SYSLOG_BINARY_RAW
+  return syslog_binary_base64(record, reclen, buffer, buflen);
+#else
+  stream.buffer   = buffer;
+  stream.buflen   = buflen;
+  stream.priority = 0;
+  stream.spill    = false;
+  stream.force    = false;
+
+  syslog_binary_text(record, reclen, &stream);
+  return stream.public.nput <= buflen ? stream.public.nput : 0;
+#endif
+}
+
+/****************************************************************************
+ * Name: syslog_binary_output
+ *
+ * Description:
+ *   Format a binary record directly to the SYSLOG channels, a buffer full
+ *   at a time.  This is used for messages that do not fit in the buffer.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SYSLOG_BINARY_RAW
+void syslog_binary_output(int priority, FAR const void *record,
+                          size_t reclen, FAR char *buffer, size_t buflen,
+                          bool force)
+{
+  struct syslog_binstream_s stream;
+
+  if (reclen < SYSLOG_BINARY_HDRSIZE || buflen == 0)
+    {
+      return;
+    }
+
+  stream.buffer   = buffer;
+  stream.buflen   = buflen;
+  stream.priority = priority;
+  stream.spill    = true;
+  stream.force    = force;
+
+  syslog_binary_text(record, reclen, &stream);
+  syslog_binary_spill(&stream);
+}
+#endif
+
+#endif /* CONFIG_SYSLOG_BINARY */
@@ -40,9 +40,13 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <syslog.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/syslog/syslog.h>
 
 #ifdef CONFIG_RAMLOG_SYSLOG
@@ -108,9 +112,23 @@ static const struct syslog_channel_s g_default_channel =
 };
 #endif
 
-/* This is the current syslog channel in use */
+/* These are the syslog channels in use.  The channels in use are always
+ * at the beginning of the table.  The table initially holds only
+ * g_default_channel.
+ */
 
-FAR const struct syslog_channel_s *g_syslog_channel = &g_default_channel;
+static FAR const struct syslog_channel_s *volatile
+  g_syslog_channel[CONFIG_SYSLOG_MAX_CHANNELS] =
+{
+  &g_default_channel
+};
+
+/* This is the lowest priority (highest value) that each channel receives */
+
+static uint8_t g_syslog_level[CONFIG_SYSLOG_MAX_CHANNELS] =
+{
+  LOG_DEBUG
+};
 
 /****************************************************************************
  * Private Functions
@@ -162,12 +180,366 @@ int syslog_channel(FAR const struct syslog_channel_s *channel)
 
   if (channel != NULL)
     {
+      irqstate_t flags;
+      int ret = OK;
+#if CONFIG_SYSLOG_MAX_CHANNELS > 1
+      int i;
+#endif
+
       DEBUGASSERT(channel->sc_putc != NULL && channel->sc_force != NULL &&
                   channel->sc_flush != NULL);
 
-      g_syslog_channel = channel;
-      return OK;
+      flags = enter_critical_section();
+
+#if CONFIG_SYSLOG_MAX_CHANNELS > 1
+      if (g_syslog_channel[0] != &g_default_channel)
+        {
+          /* Add the channel to the first free slot (unless it is already
+           * in use).
+           */
+
+          for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+            {
+              if (g_syslog_channel[i] == channel)
+                {
+                  break;
+                }
+              else if (g_syslog_channel[i] == NULL)
+                {
+                  g_syslog_level[i]   = LOG_DEBUG;
+                  g_syslog_channel[i] = channel;
+                  break;
+                }
+            }
+
+          if (i >= CONFIG_SYSLOG_MAX_CHANNELS)
+            {
+              ret = -ENOMEM;
+            }
+        }
+      else
+#endif
+        {
+          /* Replace the default (or the only) channel */
+
+          g_syslog_level[0]   = LOG_DEBUG;
+          g_syslog_channel[0] = channel;
+        }
+
+      leave_critical_section(flags);
+      return ret;
     }
 
   return -EINVAL;
 }
+
+/****************************************************************************
+ * Name: syslog_channel_remove
+ *
+ * Description:
+ *   Stop using a channel that was added with syslog_channel().  If no
+ *   channel remains, the built-in default channel is used again.
+ *
+ * Input Parameters:
+ *   channel - The channel to be removed.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -ENOENT is returned if the channel
+ *   is not in use.
+ *
+ ****************************************************************************/
+
+int syslog_channel_remove(FAR const struct syslog_channel_s *channel)
+{
+  irqstate_t flags;
+  int ret = -ENOENT;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      if (g_syslog_channel[i] == channel)
+        {
+          /* Close the gap so that the channels in use stay together */
+
+          for (; i < CONFIG_SYSLOG_MAX_CHANNELS - 1; i++)
+            {
+              g_syslog_level[i]   = g_syslog_level[i + 1];
+              g_syslog_channel[i] = g_syslog_channel[i + 1];
+            }
+
+          g_syslog_channel[i] = NULL;
+          ret = OK;
+          break;
+        }
+    }
+
+  /* Fall back to the default channel if that was the last one */
+
+  if (g_syslog_channel[0] == NULL)
+    {
+      g_syslog_level[0]   = LOG_DEBUG;
+      g_syslog_channel[0] = &g_default_channel;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_channel_level
+ *
+ * Description:
+ *   Set the lowest priority of the messages that are sent to a channel.
+ *
+ * Input Parameters:
+ *   channel  - A channel that was added with syslog_channel().
+ *   priority - One of LOG_EMERG through LOG_DEBUG.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on any failure.
+ *
+ ****************************************************************************/
+
+int syslog_channel_level(FAR const struct syslog_channel_s *channel,
+                         int priority)
+{
+  int i;
+
+  if (priority < LOG_EMERG || priority > LOG_DEBUG)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      if (g_syslog_channel[i] == channel)
+        {
+          g_syslog_level[i] = (uint8_t)priority;
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: syslog_channel_unbind
+ *
+ * Description:
+ *   Remove every channel that uses the given putc() method.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SYSLOG_MAX_CHANNELS > 1
+void syslog_channel_unbind(syslog_putc_t putc)
+{
+  FAR const struct syslog_channel_s *channel;
+  int i = 0;
+
+  while (i < CONFIG_SYSLOG_MAX_CHANNELS &&
+         (channel = g_syslog_channel[i]) != NULL)
+    {
+      if (channel->sc_putc == putc)
+        {
+          /* The following channels move down into this slot */
+
+          syslog_channel_remove(channel);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: syslog_channel_putc
+ *
+ * Description:
+ *   Send one character to every channel that accepts the priority, using
+ *   the putc() method of the channels.
+ *
+ ****************************************************************************/
+
+int syslog_channel_putc(int priority, int ch)
+{
+  FAR const struct syslog_channel_s *channel;
+  bool accepted = false;
+  int errcode = OK;
+  int i;
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      channel = g_syslog_channel[i];
+      if (channel == NULL)
+        {
+          break;
+        }
+
+      if (priority <= g_syslog_level[i])
+        {
+          int ret;
+
+          DEBUGASSERT(channel->sc_putc != NULL);
+          ret = channel->sc_putc(ch);
+          if (ret < 0)
+            {
+              errcode = ret;
+            }
+          else
+            {
+              accepted = true;
+            }
+        }
+    }
+
+  /* Report an error only if no channel took the character, so that a
+   * retry does not duplicate the output on the others.
+   */
+
+  return (!accepted && errcode < 0) ? errcode : ch;
+}
+
+/****************************************************************************
+ * Name: syslog_channel_force
+ *
+ * Description:
+ *   Send one character to every channel that accepts the priority, using
+ *   the force() method of the channels.
+ *
+ ****************************************************************************/
+
+int syslog_channel_force(int priority, int ch)
+{
+  FAR const struct syslog_channel_s *channel;
+  bool accepted = false;
+  int errcode = OK;
+  int i;
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      channel = g_syslog_channel[i];
+      if (channel == NULL)
+        {
+          break;
+        }
+
+      if (priority <= g_syslog_level[i])
+        {
+          int ret;
+
+          DEBUGASSERT(channel->sc_force != NULL);
+          ret = channel->sc_force(ch);
+          if (ret < 0)
+            {
+              errcode = ret;
+            }
+          else
+            {
+              accepted = true;
+            }
+        }
+    }
+
+  return (!accepted && errcode < 0) ? errcode : ch;
+}
+
+/****************************************************************************
+ * Name: syslog_channel_write
+ *
+ * Description:
+ *   Send a buffer to every channel that accepts the priority, using the
+ *   write() method of the channels (or putc() if there is none).
+ *
+ ****************************************************************************/
+
+ssize_t syslog_channel_write(int priority, FAR const char *buffer,
+                             size_t buflen)
+{
+  FAR const struct syslog_channel_s *channel;
+  bool accepted = false;
+  int errcode = OK;
+  int i;
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      channel = g_syslog_channel[i];
+      if (channel == NULL)
+        {
+          break;
+        }
+
+      if (priority <= g_syslog_level[i])
+        {
+          ssize_t ret;
+
+#ifdef CONFIG_SYSLOG_WRITE
+          if (channel->sc_write != NULL)
+            {
+              ret = channel->sc_write(buffer, buflen);
+            }
+          else
+#endif
+            {
+              size_t nwritten;
+
+              DEBUGASSERT(channel->sc_putc != NULL);
+              for (nwritten = 0; nwritten < buflen; nwritten++)
+                {
+                  channel->sc_putc(buffer[nwritten]);
+                }
+
+              ret = buflen;
+            }
+
+          if (ret < 0)
+            {
+              errcode = (int)ret;
+            }
+          else
+            {
+              accepted = true;
+            }
+        }
+    }
+
+  return (!accepted && errcode < 0) ? (ssize_t)errcode : (ssize_t)buflen;
+}
+
+/****************************************************************************
+ * Name: syslog_channel_flush
+ *
+ * Description:
+ *   Flush the buffered output of every channel.
+ *
+ ****************************************************************************/
+
+int syslog_channel_flush(void)
+{
+  FAR const struct syslog_channel_s *channel;
+  int result;
+  int ret = OK;
+  int i;
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      channel = g_syslog_channel[i];
+      if (channel == NULL)
+        {
+          break;
+        }
+
+      DEBUGASSERT(channel->sc_flush != NULL);
+      result = channel->sc_flush();
+      if (result < 0)
+        {
+          ret = result;
+        }
+    }
+
+  return ret;
+}
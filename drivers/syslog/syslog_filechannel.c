@@ -151,6 +151,14 @@ int syslog_file_channel(FAR const char *devpath)
 
   sched_lock();
 
+#if CONFIG_SYSLOG_MAX_CHANNELS > 1
+  /* Stop using the channels that share the device before it is re-opened
+   * as the file.
+   */
+
+  syslog_channel_unbind(syslog_dev_putc);
+#endif
+
   /* Uninitialize any driver interface that may have been in place */
 
   syslog_dev_uninitialize();
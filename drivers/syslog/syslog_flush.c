@@ -79,18 +79,21 @@
 
 int syslog_flush(void)
 {
-  DEBUGASSERT(g_syslog_channel != NULL);
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+  /* Output the messages that the SYSLOG daemon has not written yet */
+
+  syslog_ring_flush();
+#endif
 
 #ifdef CONFIG_SYSLOG_INTBUFFER
   /* Flush any characters that may have been added to the interrupt
    * buffer.
    */
 
-  syslog_flush_intbuffer(g_syslog_channel, true);
+  syslog_flush_intbuffer(true);
 #endif
 
-  /* Then flush all of the buffered output to the SYSLOG device */
+  /* Then flush all of the buffered output to the SYSLOG devices */
 
-  DEBUGASSERT(g_syslog_channel->sc_flush != NULL);
-  return g_syslog_channel->sc_flush();
+  return syslog_channel_flush();
 }
@@ -70,17 +70,17 @@
 
 int syslog_force(int ch)
 {
-  DEBUGASSERT(g_syslog_channel != NULL && g_syslog_channel->sc_force != NULL);
-
 #ifdef CONFIG_SYSLOG_INTBUFFER
   /* Flush any characters that may have been added to the interrupt
    * buffer through the emergency channel
    */
 
-  syslog_flush_intbuffer(g_syslog_channel, true);
+  syslog_flush_intbuffer(true);
 #endif
 
-  /* Then send the character to the emergency channel */
+  /* Then send the character to the emergency channels.  This bypasses the
+   * SYSLOG ring buffer, if any.
+   */
 
-  return g_syslog_channel->sc_force(ch);
+  return syslog_channel_force(SYSLOG_PRIORITY_RAW, ch);
 }
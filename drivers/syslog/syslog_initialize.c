@@ -106,6 +106,15 @@ int syslog_initialize(void)
   syslog_rpmsg_init();
 #endif
 
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+  /* Start deferring SYSLOG output to the SYSLOG daemon */
+
+  if (ret >= 0)
+    {
+      ret = syslog_ring_initialize();
+    }
+#endif
+
   return ret;
 }
 
@@ -276,8 +276,7 @@ int syslog_add_intbuffer(int ch)
  *   to the SYSLOG device.
  *
  * Input Parameters:
- *   channel - The syslog channel to use in performing the flush operation.
- *   force   - Use the force() method of the channel vs. the putc() method.
+ *   force   - Use the force() method of the channels vs. the putc() method.
  *
  * Returned Value:
  *   On success, the character is echoed back to the caller.  A negated
@@ -288,16 +287,15 @@ int syslog_add_intbuffer(int ch)
  *
  ****************************************************************************/
 
-int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
-                           bool force)
+int syslog_flush_intbuffer(bool force)
 {
-  syslog_putc_t putfunc;
+  CODE int (*putfunc)(int priority, int ch);
   int ch;
   int ret = OK;
 
   /* Select which putc function to use for this flush */
 
-  putfunc = force ? channel->sc_putc : channel->sc_force;
+  putfunc = force ? syslog_channel_force : syslog_channel_putc;
 
   /* This logic is performed with the scheduler disabled to protect from
    * concurrent modification by other tasks.
@@ -316,7 +314,7 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
       ch = syslog_remove_intbuffer();
       if (ch != EOF)
         {
-          ret = putfunc(ch);
+          ret = putfunc(SYSLOG_PRIORITY_RAW, ch);
         }
     }
   while (ch != EOF && ret >= 0);
@@ -54,13 +54,16 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: syslog_putc
+ * Name: syslog_putc_priority
  *
  * Description:
- *   This is the low-level system logging interface.
+ *   This is the low-level system logging interface for output that has a
+ *   priority.  The character is only sent to the channels that accept
+ *   messages of that priority.
  *
  * Input Parameters:
- *   ch - The character to add to the SYSLOG (must be positive).
+ *   priority - The priority of the message
+ *   ch       - The character to add to the SYSLOG (must be positive).
  *
  * Returned Value:
  *   On success, the character is echoed back to the caller.  A negated
@@ -68,9 +71,18 @@
  *
  ****************************************************************************/
 
-int syslog_putc(int ch)
+int syslog_putc_priority(int priority, int ch)
 {
-  DEBUGASSERT(g_syslog_channel != NULL);
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+  char c = (char)ch;
+
+  /* Defer the output to the SYSLOG daemon if it is running */
+
+  if (syslog_ring_write(priority, &c, 1) != -EAGAIN)
+    {
+      return ch;
+    }
+#endif
 
   /* Is this an attempt to do SYSLOG output from an interrupt handler? */
 
@@ -93,23 +105,39 @@ int syslog_putc(int ch)
            * with output data that may have been buffered by sc_putc().
            */
 
-          DEBUGASSERT(g_syslog_channel->sc_force != NULL);
-
-          return g_syslog_channel->sc_force(ch);
+          return syslog_channel_force(priority, ch);
         }
     }
   else
     {
-      DEBUGASSERT(g_syslog_channel->sc_putc != NULL);
-
 #ifdef CONFIG_SYSLOG_INTBUFFER
       /* Flush any characters that may have been added to the interrupt
        * buffer.
        */
 
-      syslog_flush_intbuffer(g_syslog_channel, false);
+      syslog_flush_intbuffer(false);
 #endif
 
-      return g_syslog_channel->sc_putc(ch);
+      return syslog_channel_putc(priority, ch);
     }
 }
+
+/****************************************************************************
+ * Name: syslog_putc
+ *
+ * Description:
+ *   This is the low-level system logging interface.
+ *
+ * Input Parameters:
+ *   ch - The character to add to the SYSLOG (must be positive).
+ *
+ * Returned Value:
+ *   On success, the character is echoed back to the caller.  A negated
+ *   errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int syslog_putc(int ch)
+{
+  return syslog_putc_priority(SYSLOG_PRIORITY_RAW, ch);
+}
@@ -0,0 +1,695 @@
+/****************************************************************************
+ * drivers/syslog/syslog_ringbuffer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SYSLOG_RING_SIZE     CONFIG_SYSLOG_RINGBUFFER_SIZE
+#define SYSLOG_RING_MASK     (SYSLOG_RING_SIZE - 1)
+
+#if SYSLOG_RING_SIZE < 64 || (SYSLOG_RING_SIZE & SYSLOG_RING_MASK) != 0
+#  error CONFIG_SYSLOG_RINGBUFFER_SIZE must be a power of two (>= 64)
+#endif
+
+/* The length of a record, up to a quarter of the ring, must fit in the
+ * 16-bit rc_len.
+ */
+
+#if SYSLOG_RING_SIZE > 131072
+#  error CONFIG_SYSLOG_RINGBUFFER_SIZE must not exceed 128 KiB
+#endif
+
+/* Every record starts on a four byte boundary */
+
+#define SYSLOG_RING_HDRSIZE  sizeof(struct syslog_record_s)
+#define SYSLOG_RING_ALIGN(n) (((n) + 3) & ~3)
+
+/* A record holds no more than a quarter of the ring buffer so that a long
+ * message does not lock out everybody else.  Longer writes are split.
+ */
+
+#define SYSLOG_RING_MAXDATA  (SYSLOG_RING_SIZE / 4 - SYSLOG_RING_HDRSIZE)
+
+#define SYSLOG_RECORD(ndx) \
+  ((FAR struct syslog_record_s *) \
+   &g_syslog_ring.sr_buffer[(ndx) & SYSLOG_RING_MASK])
+
+/* On SMP, the daemon runs concurrently on another CPU and barriers must
+ * order the header of a record and sr_head, the data of a record and its
+ * state, and the reading of a record and sr_tail.
+ */
+
+#ifdef CONFIG_SMP
+#  define syslog_ring_barrier() SP_DMB()
+#else
+#  define syslog_ring_barrier()
+#endif
+
+/* Record states */
+
+#define SYSLOG_RECORD_BUSY   0  /* Reserved, the data is being copied */
+#define SYSLOG_RECORD_READY  1  /* The data is ready to be output */
+#define SYSLOG_RECORD_PAD    2  /* Unused space up to the end of the ring */
+#define SYSLOG_RECORD_BINARY 3  /* A binary record is ready to be output */
+
+#if defined(CONFIG_SYSLOG_BINARY) && \
+    CONFIG_SYSLOG_BINARY_MAXSIZE > SYSLOG_RING_SIZE / 4 - 4
+#  error CONFIG_SYSLOG_BINARY_MAXSIZE must not exceed a quarter of the ring
+#endif
+
+/* A raw record is output as one base64 line, which must fit in the batch
+ * buffer.
+ */
+
+#if defined(CONFIG_SYSLOG_BINARY_RAW) && \
+    4 * ((CONFIG_SYSLOG_BINARY_MAXSIZE + 2) / 3) + 3 > \
+    CONFIG_SYSLOG_RINGBUFFER_BATCH
+#  error CONFIG_SYSLOG_RINGBUFFER_BATCH is too small for a base64 record
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Each record in the ring buffer begins with this header.  The data
+ * follows the header and is never wrapped around the end of the ring.
+ */
+
+struct syslog_record_s
+{
+  uint16_t rc_len;             /* Number of bytes of data */
+  uint8_t rc_priority;         /* Priority of the message */
+  volatile uint8_t rc_state;   /* See SYSLOG_RECORD_* definitions */
+};
+
+/* This structure describes the ring buffer.  Writers reserve space for a
+ * record with a short critical section, then copy the data and mark the
+ * record ready with only pre-emption disabled.  The daemon consumes the
+ * records, except after a crash when syslog_ring_flush() takes over.
+ */
+
+struct syslog_ring_s
+{
+  volatile uint32_t sr_head;   /* Next byte to reserve (free running) */
+  volatile uint32_t sr_tail;   /* First byte not yet output (free running) */
+  uint32_t sr_dropped;         /* Number of writes dropped and not reported */
+  bool sr_active;              /* The daemon has been started */
+  bool sr_waiting;             /* The daemon is waiting for a record */
+  sem_t sr_sem;                /* Wakes up the daemon */
+  uint8_t sr_buffer[SYSLOG_RING_SIZE] aligned_data(4);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_ring_s g_syslog_ring;
+
+/* The daemon collects consecutive records of the same priority here */
+
+static char g_syslog_batch[CONFIG_SYSLOG_RINGBUFFER_BATCH];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_ring_wakeup
+ *
+ * Description:
+ *   Wake up the daemon if it is waiting for a record.
+ *
+ ****************************************************************************/
+
+static void syslog_ring_wakeup(void)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (g_syslog_ring.sr_waiting)
+    {
+      g_syslog_ring.sr_waiting = false;
+      nxsem_post(&g_syslog_ring.sr_sem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: syslog_ring_report
+ *
+ * Description:
+ *   Report the number of writes that were dropped because the ring buffer
+ *   was full.
+ *
+ ****************************************************************************/
+
+static void syslog_ring_report(void)
+{
+  irqstate_t flags;
+  uint32_t dropped;
+  char msg[40];
+  int len;
+
+  flags = enter_critical_section();
+  dropped = g_syslog_ring.sr_dropped;
+  g_syslog_ring.sr_dropped = 0;
+  leave_critical_section(flags);
+
+  if (dropped > 0)
+    {
+      len = snprintf(msg, sizeof(msg), "[%lu syslog writes dropped]\r\n",
+                     (unsigned long)dropped);
+      syslog_channel_write(SYSLOG_PRIORITY_RAW, msg, len);
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_ring_consume
+ *
+ * Description:
+ *   Give the space of the records before 'next' back to the writers.  This
+ *   fails if syslog_ring_flush() has moved sr_tail since the daemon last
+ *   read it; the daemon must then not store its stale tail.
+ *
+ ****************************************************************************/
+
+static bool syslog_ring_consume(uint32_t tail, uint32_t next)
+{
+  irqstate_t flags;
+  bool ret;
+
+  flags = enter_critical_section();
+  ret = g_syslog_ring.sr_tail == tail;
+  if (ret)
+    {
+      g_syslog_ring.sr_tail = next;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_ring_drain
+ *
+ * Description:
+ *   Output all of the records that are ready.  Consecutive records of the
+ *   same priority are written to the channels as one batch.
+ *
+ ****************************************************************************/
+
+static void syslog_ring_drain(void)
+{
+  FAR struct syslog_record_s *record;
+  FAR const char *data;
+  uint32_t tail;
+  uint32_t next;
+  size_t nbatch = 0;
+#ifdef CONFIG_SYSLOG_BINARY
+  size_t len;
+#endif
+  int priority = 0;
+
+  syslog_ring_report();
+
+  tail = g_syslog_ring.sr_tail;
+  while (tail != g_syslog_ring.sr_head)
+    {
+      /* The header of the record was written before sr_head was advanced */
+
+      syslog_ring_barrier();
+
+      record = SYSLOG_RECORD(tail);
+      if (record->rc_state == SYSLOG_RECORD_BUSY)
+        {
+          /* The writer has not finished with this record yet */
+
+          break;
+        }
+
+      syslog_ring_barrier();
+
+      data = (FAR const char *)(record + 1);
+      if (record->rc_state == SYSLOG_RECORD_READY)
+        {
+          /* Output the batch if this record does not belong to it */
+
+          if (nbatch > 0 &&
+              (record->rc_priority != priority ||
+               nbatch + record->rc_len > CONFIG_SYSLOG_RINGBUFFER_BATCH))
+            {
+              syslog_channel_write(priority, g_syslog_batch, nbatch);
+              nbatch = 0;
+            }
+
+          if (record->rc_len > CONFIG_SYSLOG_RINGBUFFER_BATCH)
+            {
+              /* Too big to batch.. output it straight from the ring */
+
+              syslog_channel_write(record->rc_priority, data,
+                                   record->rc_len);
+            }
+          else
+            {
+              memcpy(&g_syslog_batch[nbatch], data, record->rc_len);
+              priority = record->rc_priority;
+              nbatch  += record->rc_len;
+            }
+        }
+#ifdef CONFIG_SYSLOG_BINARY
+      else if (record->rc_state == SYSLOG_RECORD_BINARY)
+        {
+          /* Format the message at the end of the batch */
+
+          if (nbatch > 0 && record->rc_priority != priority)
+            {
+              syslog_channel_write(priority, g_syslog_batch, nbatch);
+              nbatch = 0;
+            }
+
+          len = syslog_binary_format(data, record->rc_len,
+                                     &g_syslog_batch[nbatch],
+                                     CONFIG_SYSLOG_RINGBUFFER_BATCH - nbatch);
+          if (len == 0 && nbatch > 0)
+            {
+              /* It did not fit.. output the batch and try again with the
+               * whole buffer.
+               */
+
+              syslog_channel_write(priority, g_syslog_batch, nbatch);
+              nbatch = 0;
+
+              len = syslog_binary_format(data, record->rc_len,
+                                         g_syslog_batch,
+                                         CONFIG_SYSLOG_RINGBUFFER_BATCH);
+            }
+
+#ifndef CONFIG_SYSLOG_BINARY_RAW
+          if (len == 0)
+            {
+              /* Too big to batch.. output it on its own */
+
+              syslog_binary_output(record->rc_priority, data,
+                                   record->rc_len, g_syslog_batch,
+                                   CONFIG_SYSLOG_RINGBUFFER_BATCH, false);
+            }
+#endif
+
+          priority = record->rc_priority;
+          nbatch  += len;
+        }
+#endif
+
+      /* The record has been consumed.  Give the space back to the writers
+       * right away.
+       */
+
+      next = tail + SYSLOG_RING_ALIGN(SYSLOG_RING_HDRSIZE + record->rc_len);
+      if (!syslog_ring_consume(tail, next))
+        {
+          /* The ring was flushed under us and the batch has already been
+           * output.
+           */
+
+          return;
+        }
+
+      tail = next;
+    }
+
+  if (nbatch > 0)
+    {
+      syslog_channel_write(priority, g_syslog_batch, nbatch);
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_ring_ready
+ *
+ * Description:
+ *   Return true if the daemon has something to do.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+static bool syslog_ring_ready(void)
+{
+  uint32_t tail = g_syslog_ring.sr_tail;
+
+  return g_syslog_ring.sr_dropped > 0 ||
+         (tail != g_syslog_ring.sr_head &&
+          SYSLOG_RECORD(tail)->rc_state != SYSLOG_RECORD_BUSY);
+}
+
+/****************************************************************************
+ * Name: syslog_ring_daemon
+ *
+ * Description:
+ *   The SYSLOG daemon.  Outputs the records in the ring buffer, then waits
+ *   for more.
+ *
+ ****************************************************************************/
+
+static int syslog_ring_daemon(int argc, FAR char *argv[])
+{
+  irqstate_t flags;
+
+  for (; ; )
+    {
+      syslog_ring_drain();
+
+      flags = enter_critical_section();
+      if (!syslog_ring_ready())
+        {
+          /* Writers that see this flag will wake us up */
+
+          g_syslog_ring.sr_waiting = true;
+          leave_critical_section(flags);
+
+          nxsem_wait_uninterruptible(&g_syslog_ring.sr_sem);
+        }
+      else
+        {
+          leave_critical_section(flags);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syslog_ring_add
+ *
+ * Description:
+ *   Add records with the given final state to the ring buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t syslog_ring_add(int priority, FAR const char *buffer,
+                               size_t buflen, uint8_t state)
+{
+  FAR struct syslog_record_s *record;
+  irqstate_t flags;
+  uint32_t head;
+  size_t remaining;
+  size_t nbytes;
+  size_t need;
+  size_t pad;
+
+  if (!g_syslog_ring.sr_active)
+    {
+      return -EAGAIN;
+    }
+
+  for (remaining = buflen; remaining > 0; remaining -= nbytes)
+    {
+      nbytes = remaining;
+      if (nbytes > SYSLOG_RING_MAXDATA)
+        {
+          nbytes = SYSLOG_RING_MAXDATA;
+        }
+
+      need = SYSLOG_RING_ALIGN(SYSLOG_RING_HDRSIZE + nbytes);
+
+      /* A busy record holds up the daemon, so the writer must not be
+       * suspended or killed before the record is published.  Interrupt
+       * handlers that write in the meantime do so without delay.
+       */
+
+      sched_lock();
+
+      /* Reserve space for the record.  If the record does not fit before
+       * the end of the ring, the rest of the ring is padded and the record
+       * goes to the beginning.
+       */
+
+      flags = enter_critical_section();
+
+      head = g_syslog_ring.sr_head;
+      pad  = SYSLOG_RING_SIZE - (head & SYSLOG_RING_MASK);
+      if (pad >= need)
+        {
+          pad = 0;
+        }
+
+      if (head + pad + need - g_syslog_ring.sr_tail > SYSLOG_RING_SIZE)
+        {
+          /* No space.. drop the rest of the message rather than wait for
+           * the daemon.
+           */
+
+          g_syslog_ring.sr_dropped++;
+          leave_critical_section(flags);
+          sched_unlock();
+          break;
+        }
+
+      if (pad > 0)
+        {
+          record              = SYSLOG_RECORD(head);
+          record->rc_len      = pad - SYSLOG_RING_HDRSIZE;
+          record->rc_state    = SYSLOG_RECORD_PAD;
+          head               += pad;
+        }
+
+      record                  = SYSLOG_RECORD(head);
+      record->rc_len          = nbytes;
+      record->rc_priority     = priority;
+      record->rc_state        = SYSLOG_RECORD_BUSY;
+
+      /* The daemon does not take the lock.  It must see the header before
+       * the new sr_head.
+       */
+
+      syslog_ring_barrier();
+      g_syslog_ring.sr_head   = head + need;
+
+      leave_critical_section(flags);
+
+      /* Copy the data with interrupts enabled, then publish the record */
+
+      memcpy(record + 1, buffer, nbytes);
+      syslog_ring_barrier();
+      record->rc_state = state;
+      sched_unlock();
+
+      buffer += nbytes;
+    }
+
+  syslog_ring_wakeup();
+  return buflen;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_ring_write
+ *
+ * Description:
+ *   Add a message to the SYSLOG ring buffer.  This never blocks and may be
+ *   called from interrupt handlers.  If the ring buffer is full, the
+ *   message is dropped and counted.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   buffer   - The buffer containing the data to be output
+ *   buflen   - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes consumed (buffered or dropped) is returned.
+ *   -EAGAIN is returned if the ring buffer is not yet in use; the caller
+ *   must then output the data itself.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_ring_write(int priority, FAR const char *buffer,
+                          size_t buflen)
+{
+  return syslog_ring_add(priority, buffer, buflen, SYSLOG_RECORD_READY);
+}
+
+/****************************************************************************
+ * Name: syslog_ring_write_binary
+ *
+ * Description:
+ *   Add a binary record to the SYSLOG ring buffer.  The record is
+ *   formatted by syslog_binary_format() when it is output.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+int syslog_ring_write_binary(int priority, FAR const void *record,
+                             size_t reclen)
+{
+  ssize_t ret;
+
+  ret = syslog_ring_add(priority, (FAR const char *)record, reclen,
+                        SYSLOG_RECORD_BINARY);
+  return ret < 0 ? (int)ret : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: syslog_ring_flush
+ *
+ * Description:
+ *   Output all of the messages in the SYSLOG ring buffer using the force
+ *   method of the channels.  This is called after a crash.  A busy record
+ *   belongs to a writer that will never finish and is skipped.  A daemon
+ *   that was interrupted in the middle of the ring sees that sr_tail has
+ *   moved and gives up its batch.
+ *
+ ****************************************************************************/
+
+void syslog_ring_flush(void)
+{
+  FAR struct syslog_record_s *record;
+  FAR const char *data;
+  irqstate_t flags;
+  uint32_t tail;
+  size_t len;
+  size_t i;
+#if defined(CONFIG_SYSLOG_BINARY) && !defined(CONFIG_SYSLOG_BINARY_RAW)
+  char buffer[32];
+#endif
+
+  flags = enter_critical_section();
+
+  tail = g_syslog_ring.sr_tail;
+  while (tail != g_syslog_ring.sr_head)
+    {
+      syslog_ring_barrier();
+
+      record = SYSLOG_RECORD(tail);
+      syslog_ring_barrier();
+
+      data = (FAR const char *)(record + 1);
+      len  = record->rc_len;
+
+#ifdef CONFIG_SYSLOG_BINARY
+      if (record->rc_state == SYSLOG_RECORD_BINARY)
+        {
+#ifdef CONFIG_SYSLOG_BINARY_RAW
+          len  = syslog_binary_format(data, len, g_syslog_batch,
+                                      CONFIG_SYSLOG_RINGBUFFER_BATCH);
+          data = g_syslog_batch;
+#else
+          /* The message is forced out as it is formatted, so a small
+           * buffer will do and the batch buffer of the daemon is not
+           * disturbed.
+           */
+
+          syslog_binary_output(record->rc_priority, data, len, buffer,
+                               sizeof(buffer), true);
+          len = 0;
+#endif
+        }
+      else
+#endif
+      if (record->rc_state != SYSLOG_RECORD_READY)
+        {
+          len = 0;
+        }
+
+      for (i = 0; i < len; i++)
+        {
+          syslog_channel_force(record->rc_priority, data[i]);
+        }
+
+      tail += SYSLOG_RING_ALIGN(SYSLOG_RING_HDRSIZE + record->rc_len);
+      syslog_ring_barrier();
+      g_syslog_ring.sr_tail = tail;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: syslog_ring_initialize
+ *
+ * Description:
+ *   Start the daemon that outputs the messages buffered in the SYSLOG ring
+ *   buffer.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int syslog_ring_initialize(void)
+{
+  int ret;
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&g_syslog_ring.sr_sem, 0, 0);
+  nxsem_setprotocol(&g_syslog_ring.sr_sem, SEM_PRIO_NONE);
+
+  ret = kthread_create("syslogd", CONFIG_SYSLOG_RINGBUFFER_PRIORITY,
+                       CONFIG_SYSLOG_RINGBUFFER_STACKSIZE,
+                       syslog_ring_daemon, NULL);
+  if (ret < 0)
+    {
+      nxsem_destroy(&g_syslog_ring.sr_sem);
+      return ret;
+    }
+
+  g_syslog_ring.sr_active = true;
+  return OK;
+}
+
+#endif /* CONFIG_SYSLOG_RINGBUFFER */
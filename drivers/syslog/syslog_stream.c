@@ -75,8 +75,10 @@ static int syslogstream_flush(FAR struct lib_syslogstream_s *stream)
 
       do
         {
-          ssize_t nbytes = syslog_write((FAR const char *)iob->io_data,
-                                        (size_t)iob->io_len);
+          ssize_t nbytes =
+            syslog_write_priority(stream->priority,
+                                  (FAR const char *)iob->io_data,
+                                  (size_t)iob->io_len);
           if (nbytes < 0)
             {
               ret = (int)nbytes;
@@ -129,16 +131,16 @@ static void syslogstream_addchar(FAR struct lib_syslogstream_s *stream, int ch)
 
 static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
 {
+  FAR struct lib_syslogstream_s *stream =
+    (FAR struct lib_syslogstream_s *)this;
+
+  DEBUGASSERT(stream != NULL);
+
   /* Discard carriage returns */
 
   if (ch != '\r')
     {
 #ifdef CONFIG_SYSLOG_BUFFER
-      FAR struct lib_syslogstream_s *stream =
-        (FAR struct lib_syslogstream_s *)this;
-
-      DEBUGASSERT(stream != NULL);
-
       /* Do we have an IO buffer? */
 
       if (stream->iob != NULL)
@@ -171,7 +173,7 @@ static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
                * failure, syslog_putc returns a negated errno value.
                */
 
-              ret = syslog_putc(ch);
+              ret = syslog_putc_priority(stream->priority, ch);
               if (ret >= 0)
                 {
                   this->nput++;
@@ -200,15 +202,17 @@ static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
  *   Only accessible from with the OS SYSLOG logic.
  *
  * Input Parameters:
- *   stream - User allocated, uninitialized instance of struct
- *            lib_syslogstream_s to be initialized.
+ *   stream   - User allocated, uninitialized instance of struct
+ *              lib_syslogstream_s to be initialized.
+ *   priority - The priority of the message written to the stream.
  *
  * Returned Value:
  *   None (User allocated instance initialized).
  *
  ****************************************************************************/
 
-void syslogstream_create(FAR struct lib_syslogstream_s *stream)
+void syslogstream_create(FAR struct lib_syslogstream_s *stream,
+                         int priority)
 {
 #ifdef CONFIG_SYSLOG_BUFFER
   FAR struct iob_s *iob;
@@ -221,6 +225,7 @@ void syslogstream_create(FAR struct lib_syslogstream_s *stream)
   stream->public.put   = syslogstream_putc;
   stream->public.flush = lib_noflush;
   stream->public.nput  = 0;
+  stream->priority     = priority;
 
 #ifdef CONFIG_SYSLOG_BUFFER
   /* Allocate an IOB */
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <errno.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
@@ -60,8 +61,9 @@
  *   one character at a time.
  *
  * Input Parameters:
- *   buffer - The buffer containing the data to be output
- *   buflen - The number of bytes in the buffer
+ *   priority - The priority of the message
+ *   buffer   - The buffer containing the data to be output
+ *   buflen   - The number of bytes in the buffer
  *
  * Returned Value:
  *   On success, the number of characters written is returned.  A negated
@@ -69,7 +71,8 @@
  *
  ****************************************************************************/
 
-static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
+static ssize_t syslog_default_write(int priority, FAR const char *buffer,
+                                    size_t buflen)
 {
   size_t nwritten;
 
@@ -85,24 +88,13 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
           else
 #endif
             {
-              DEBUGASSERT(g_syslog_channel->sc_force != NULL);
-              g_syslog_channel->sc_force(*buffer++);
+              syslog_channel_force(priority, *buffer++);
             }
         }
     }
-#ifdef CONFIG_SYSLOG_WRITE
-  else if (g_syslog_channel->sc_write)
-    {
-      nwritten = g_syslog_channel->sc_write(buffer, buflen);
-    }
-#endif
   else
     {
-      for (nwritten = 0; nwritten < buflen; nwritten++)
-        {
-          DEBUGASSERT(g_syslog_channel->sc_putc != NULL);
-          g_syslog_channel->sc_putc(*buffer++);
-        }
+      syslog_channel_write(priority, buffer, buflen);
     }
 
   return buflen;
@@ -113,14 +105,17 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: syslog_write
+ * Name: syslog_write_priority
  *
  * Description:
- *   This is the low-level, multiple character, system logging interface.
+ *   This is the low-level, multiple character, system logging interface
+ *   for output that has a priority.  The data is only sent to the channels
+ *   that accept messages of that priority.
  *
  * Input Parameters:
- *   buffer - The buffer containing the data to be output
- *   buflen - The number of bytes in the buffer
+ *   priority - The priority of the message
+ *   buffer   - The buffer containing the data to be output
+ *   buflen   - The number of bytes in the buffer
  *
  * Returned Value:
  *   On success, the number of characters written is returned.  A negated
@@ -128,8 +123,21 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
  *
  ****************************************************************************/
 
-ssize_t syslog_write(FAR const char *buffer, size_t buflen)
+ssize_t syslog_write_priority(int priority, FAR const char *buffer,
+                              size_t buflen)
 {
+#ifdef CONFIG_SYSLOG_RINGBUFFER
+  ssize_t ret;
+
+  /* Defer the output to the SYSLOG daemon if it is running */
+
+  ret = syslog_ring_write(priority, buffer, buflen);
+  if (ret != -EAGAIN)
+    {
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   if (!up_interrupt_context() && !sched_idletask())
     {
@@ -137,8 +145,30 @@ ssize_t syslog_write(FAR const char *buffer, size_t buflen)
        * buffer.
        */
 
-      syslog_flush_intbuffer(g_syslog_channel, false);
+      syslog_flush_intbuffer(false);
     }
 #endif
-  return syslog_default_write(buffer, buflen);
+
+  return syslog_default_write(priority, buffer, buflen);
+}
+
+/****************************************************************************
+ * Name: syslog_write
+ *
+ * Description:
+ *   This is the low-level, multiple character, system logging interface.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   On success, the number of characters written is returned.  A negated
+ *   errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_write(FAR const char *buffer, size_t buflen)
+{
+  return syslog_write_priority(SYSLOG_PRIORITY_RAW, buffer, buflen);
 }
@@ -344,6 +344,7 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
   /* Initialize the file private data (only need to initialize non-zero elements) */
 
   ff->ff_oflags           = oflags;
+  fat_ffchaininit(ff);
 
   /* Save information that can be used later to recover the directory entry */
 
@@ -1045,6 +1046,8 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   int32_t cluster;
   off_t position;
   unsigned int clustersize;
+  uint32_t chaincluster;
+  uint32_t index;
   int ret;
 
   /* Sanity checks */
@@ -1175,6 +1178,19 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+      /* Start from the closest cluster remembered in the cluster chain
+       * cache rather than from the beginning of the chain.
+       */
+
+      index = fat_ffchainfind(ff, position / clustersize, &chaincluster);
+      if (index > 0)
+        {
+          cluster       = chaincluster;
+          filep->f_pos  = (off_t)index * clustersize;
+          position     -= filep->f_pos;
+        }
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1245,6 +1261,8 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
 
           filep->f_pos += clustersize;
           position     -= clustersize;
+
+          fat_ffchainadd(ff, ++index, cluster);
         }
 
       /* We get here after we have found the sector containing
@@ -1553,6 +1571,7 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+  fat_ffchaininit(newff);
 
   /* Attach the private date to the struct file instance */
 
@@ -1858,12 +1877,27 @@ static int fat_truncate(FAR struct file *filep, off_t length)
 
       if (ret >= 0)
         {
+          FAR struct fat_file_s *tmp;
+
           /* The truncation has completed without error.  Update the file
            * size.
            */
 
           ff->ff_size = length;
           ret = OK;
+
+          /* Clusters beyond the new end of the file are gone.  Forget them
+           * in all open instances of the file.
+           */
+
+          for (tmp = fs->fs_head; tmp; tmp = tmp->ff_next)
+            {
+              if (tmp == ff || (tmp->ff_dirsector == ff->ff_dirsector &&
+                                tmp->ff_dirindex == ff->ff_dirindex))
+                {
+                  fat_ffchaininit(tmp);
+                }
+            }
         }
     }
   else
@@ -2247,6 +2281,10 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+  /* Write back any dirty sectors in the sector cache */
+
+  fat_fscacheflush(fs);
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2274,10 +2312,7 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* Release the mountpoint private data */
 
-  if (fs->fs_buffer)
-    {
-      fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
-    }
+  fat_fscacheuninit(fs);
 
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
@@ -2525,7 +2560,11 @@ static int fat_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
   fs->fs_currentsector = dirsector;
   memset(direntry, 0, fs->fs_hwsectorsize);
 
-  /* Now clear all sectors in the new directory cluster (except for the first) */
+  /* Now clear all sectors in the new directory cluster (except for the
+   * first).  They are written directly, so any cached copies are stale.
+   */
+
+  fat_fscacheinvalidate(fs, dirsector, fs->fs_fatsecperclus);
 
   for (i = 1; i < fs->fs_fatsecperclus; i++)
     {
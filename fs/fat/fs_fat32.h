@@ -837,6 +837,37 @@
 
 #endif
 
+/****************************************************************************
+ * Sector and cluster chain caches
+ *
+ *   CONFIG_FAT_SECTORCACHE - The number of sectors held in the mountpoint
+ *     sector cache.  With a value of one, there is a single sector buffer.
+ *   CONFIG_FAT_FATREADAHEAD - The number of consecutive FAT sectors read
+ *     into the sector cache when a FAT sector is missed.  Limited to
+ *     CONFIG_FAT_SECTORCACHE.
+ *   CONFIG_FAT_CHAINCACHE - The number of cluster numbers remembered per
+ *     open file to speed up seeking.  Zero disables the cache.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_FAT_SECTORCACHE
+#  define CONFIG_FAT_SECTORCACHE 1
+#endif
+
+#ifndef CONFIG_FAT_FATREADAHEAD
+#  define CONFIG_FAT_FATREADAHEAD 0
+#endif
+
+#if CONFIG_FAT_FATREADAHEAD > CONFIG_FAT_SECTORCACHE
+#  define FAT_READAHEAD CONFIG_FAT_SECTORCACHE
+#else
+#  define FAT_READAHEAD CONFIG_FAT_FATREADAHEAD
+#endif
+
+#ifndef CONFIG_FAT_CHAINCACHE
+#  define CONFIG_FAT_CHAINCACHE 0
+#endif
+
 /****************************************************************************
  * Name: fat_io_alloc and fat_io_free
  *
@@ -868,6 +899,20 @@
  * Public Types
  ****************************************************************************/
 
+/* This structure describes one sector held in the mountpoint sector cache.
+ * The entry referred to by fs_buffer is the "current" sector:  Its sector
+ * number and dirty state are kept in fs_currentsector and fs_dirty while
+ * it is current.
+ */
+
+struct fat_sector_s
+{
+  off_t    cs_sector;              /* The sector held in cs_buffer; -1: none */
+  uint32_t cs_access;              /* Time of the last access (for LRU) */
+  bool     cs_dirty;               /* true: cs_buffer must be written back */
+  uint8_t *cs_buffer;              /* Sector buffer */
+};
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
@@ -902,6 +947,13 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+  uint8_t  fs_cachendx;            /* Cache entry that fs_buffer refers to */
+  uint32_t fs_cacheclock;          /* Access counter of the sector cache */
+  uint8_t *fs_cachemem;            /* Memory of all cache sector buffers */
+#if FAT_READAHEAD > 1
+  uint8_t *fs_rabuffer;            /* FAT read-ahead buffer */
+#endif
+  struct fat_sector_s fs_cache[CONFIG_FAT_SECTORCACHE];
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -923,6 +975,15 @@ struct fat_file_s
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#if CONFIG_FAT_CHAINCACHE > 0
+
+  /* ff_chain[i] holds the cluster at index i * ff_chainstride of the file's
+   * cluster chain, or zero if that cluster is not known.
+   */
+
+  uint32_t ff_chainstride;         /* Chain index step between entries */
+  uint32_t ff_chain[CONFIG_FAT_CHAINCACHE];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1092,8 +1153,12 @@ EXTERN int    fat_remove(struct fat_mountpt_s *fs, const char *relpath,
 
 /* Mountpoint and file buffer cache (for partial sector accesses) */
 
+EXTERN int    fat_fscacheinit(struct fat_mountpt_s *fs);
+EXTERN void   fat_fscacheuninit(struct fat_mountpt_s *fs);
 EXTERN int    fat_fscacheflush(struct fat_mountpt_s *fs);
 EXTERN int    fat_fscacheread(struct fat_mountpt_s *fs, off_t sector);
+EXTERN void   fat_fscacheinvalidate(struct fat_mountpt_s *fs, off_t sector,
+                                    unsigned int nsectors);
 EXTERN int    fat_ffcacheflush(struct fat_mountpt_s *fs,
                                struct fat_file_s *ff);
 EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs,
@@ -1101,6 +1166,20 @@ EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs,
                                     struct fat_file_s *ff);
 
+/* Per-file cluster chain cache */
+
+#if CONFIG_FAT_CHAINCACHE > 0
+EXTERN void   fat_ffchaininit(struct fat_file_s *ff);
+EXTERN uint32_t fat_ffchainfind(struct fat_file_s *ff, uint32_t index,
+                                uint32_t *cluster);
+EXTERN void   fat_ffchainadd(struct fat_file_s *ff, uint32_t index,
+                             uint32_t cluster);
+#else
+#  define fat_ffchaininit(ff)
+#  define fat_ffchainfind(ff,i,c) (0)
+#  define fat_ffchainadd(ff,i,c)
+#endif
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(struct fat_mountpt_s *fs);
@@ -2573,6 +2573,8 @@ int fat_allocatedirentry(struct fat_mountpt_s *fs,
       memset(fs->fs_buffer, 0, fs->fs_hwsectorsize);
 
       sector = fs->fs_currentsector;
+      fat_fscacheinvalidate(fs, sector, fs->fs_fatsecperclus);
+
       for (i = fs->fs_fatsecperclus; i; i--)
         {
           ret = fat_hwwrite(fs, fs->fs_buffer, sector, 1);
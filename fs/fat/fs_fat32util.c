@@ -277,6 +277,250 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscachesync
+ *
+ * Description:
+ *   Save the state of the current sector (fs_buffer) in its sector cache
+ *   entry.  Callers may assign a new sector number to fs_buffer directly;
+ *   the current sector then holds the newest data of that sector and any
+ *   other cache entry holding the same sector is discarded.
+ *
+ ****************************************************************************/
+
+static void fat_fscachesync(struct fat_mountpt_s *fs)
+{
+  struct fat_sector_s *current = &fs->fs_cache[fs->fs_cachendx];
+#if CONFIG_FAT_SECTORCACHE > 1
+  int i;
+#endif
+
+  current->cs_sector = fs->fs_currentsector;
+  current->cs_dirty  = fs->fs_dirty;
+
+#if CONFIG_FAT_SECTORCACHE > 1
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      if (i != fs->fs_cachendx &&
+          fs->fs_cache[i].cs_sector == current->cs_sector)
+        {
+          fs->fs_cache[i].cs_sector = -1;
+          fs->fs_cache[i].cs_dirty  = false;
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: fat_fscacheselect
+ *
+ * Description:
+ *   Make a sector cache entry the current sector.
+ *
+ ****************************************************************************/
+
+static void fat_fscacheselect(struct fat_mountpt_s *fs, int ndx)
+{
+  fs->fs_cachendx      = ndx;
+  fs->fs_buffer        = fs->fs_cache[ndx].cs_buffer;
+  fs->fs_currentsector = fs->fs_cache[ndx].cs_sector;
+  fs->fs_dirty         = fs->fs_cache[ndx].cs_dirty;
+}
+
+/****************************************************************************
+ * Name: fat_fscachewrite
+ *
+ * Description:
+ *   Write back one sector cache entry if it is dirty.  Sectors in the FAT
+ *   region are also written to each copy of the FAT.
+ *
+ ****************************************************************************/
+
+static int fat_fscachewrite(struct fat_mountpt_s *fs,
+                            struct fat_sector_s *cs)
+{
+  off_t sector = cs->cs_sector;
+  int ret;
+  int i;
+
+  if (!cs->cs_dirty)
+    {
+      return OK;
+    }
+
+  /* Write the dirty sector */
+
+  ret = fat_hwwrite(fs, cs->cs_buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, cs->cs_buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  /* No longer dirty */
+
+  cs->cs_dirty = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscachevictim
+ *
+ * Description:
+ *   Select the sector cache entry to be replaced:  An unused entry if
+ *   there is one, otherwise the least recently used one.  The entry is
+ *   written back if it is dirty and then marked unused.
+ *
+ * Returned Value:
+ *   The index of the entry on success; a negated errno value if the
+ *   write-back failed.
+ *
+ ****************************************************************************/
+
+static int fat_fscachevictim(struct fat_mountpt_s *fs)
+{
+  struct fat_sector_s *cs;
+  int victim = 0;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_sector < 0)
+        {
+          victim = i;
+          break;
+        }
+
+      if ((int32_t)(cs->cs_access - fs->fs_cache[victim].cs_access) < 0)
+        {
+          victim = i;
+        }
+    }
+
+  cs  = &fs->fs_cache[victim];
+  ret = fat_fscachewrite(fs, cs);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  cs->cs_sector = -1;
+  return victim;
+}
+
+/****************************************************************************
+ * Name: fat_fscacheload
+ *
+ * Description:
+ *   Load a sector that is not in the sector cache into a free or replaced
+ *   entry.  When a FAT sector is missed, the following FAT sectors are
+ *   read with the same request and cached as well.
+ *
+ * Returned Value:
+ *   The index of the entry holding the requested sector on success; a
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int fat_fscacheload(struct fat_mountpt_s *fs, off_t sector)
+{
+  struct fat_sector_s *cs;
+  int ndx;
+  int ret;
+#if FAT_READAHEAD > 1
+  off_t fatend = fs->fs_fatbase + fs->fs_nfatsects;
+  int nsectors;
+  int i;
+  int j;
+
+  if (sector >= fs->fs_fatbase && sector < fatend)
+    {
+      nsectors = FAT_READAHEAD;
+      if (sector + nsectors > fatend)
+        {
+          nsectors = fatend - sector;
+        }
+
+      ret = fat_hwread(fs, fs->fs_rabuffer, sector, nsectors);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Cache the sectors that are not cached yet.  The requested sector
+       * comes last so that it is the most recently used one.
+       */
+
+      for (i = nsectors - 1; i >= 0; i--)
+        {
+          for (j = 0; i > 0 && j < CONFIG_FAT_SECTORCACHE; j++)
+            {
+              if (fs->fs_cache[j].cs_sector == sector + i)
+                {
+                  break;
+                }
+            }
+
+          if (i > 0 && j < CONFIG_FAT_SECTORCACHE)
+            {
+              continue;
+            }
+
+          ndx = fat_fscachevictim(fs);
+          if (ndx < 0)
+            {
+              return ndx;
+            }
+
+          cs = &fs->fs_cache[ndx];
+          memcpy(cs->cs_buffer, &fs->fs_rabuffer[i * fs->fs_hwsectorsize],
+                 fs->fs_hwsectorsize);
+          cs->cs_sector = sector + i;
+          cs->cs_dirty  = false;
+          cs->cs_access = ++fs->fs_cacheclock;
+        }
+
+      return ndx;
+    }
+#endif
+
+  ndx = fat_fscachevictim(fs);
+  if (ndx < 0)
+    {
+      return ndx;
+    }
+
+  cs  = &fs->fs_cache[ndx];
+  ret = fat_hwread(fs, cs->cs_buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  cs->cs_sector = sector;
+  cs->cs_dirty  = false;
+  return ndx;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -534,12 +778,11 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   fs->fs_hwsectorsize = geo.geo_sectorsize;
   fs->fs_hwnsectors   = geo.geo_nsectors;
 
-  /* Allocate a buffer to hold one hardware sector */
+  /* Allocate the sector cache.  fs_buffer refers to one of its sectors. */
 
-  fs->fs_buffer = (FAR uint8_t *)fat_io_alloc(fs->fs_hwsectorsize);
-  if (!fs->fs_buffer)
+  ret = fat_fscacheinit(fs);
+  if (ret < 0)
     {
-      ret = -ENOMEM;
       goto errout;
     }
 
@@ -671,8 +914,7 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
-  fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
-  fs->fs_buffer = 0;
+  fat_fscacheuninit(fs);
 
 errout:
   fs->fs_mounted = false;
@@ -779,6 +1021,25 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
 
           if (nsectorswritten == nsectors)
             {
+#if CONFIG_FAT_SECTORCACHE > 1
+              int i;
+
+              /* Any other cached copy of the sectors is now stale */
+
+              for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+                {
+                  struct fat_sector_s *cs = &fs->fs_cache[i];
+
+                  if (i != fs->fs_cachendx && cs->cs_buffer != buffer &&
+                      cs->cs_sector >= sector &&
+                      cs->cs_sector < sector + nsectors)
+                    {
+                      cs->cs_sector = -1;
+                      cs->cs_dirty  = false;
+                    }
+                }
+#endif
+
               ret = OK;
             }
           else if (nsectorswritten < 0)
@@ -1761,57 +2022,112 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscacheinit
+ *
+ * Description:
+ *   Allocate the sector cache of the mountpoint.  fs_hwsectorsize must be
+ *   valid.
+ *
+ ****************************************************************************/
+
+int fat_fscacheinit(struct fat_mountpt_s *fs)
+{
+  int i;
+
+  fs->fs_cachemem = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_SECTORCACHE * fs->fs_hwsectorsize);
+  if (fs->fs_cachemem == NULL)
+    {
+      return -ENOMEM;
+    }
+
+#if FAT_READAHEAD > 1
+  fs->fs_rabuffer = (FAR uint8_t *)
+    fat_io_alloc(FAT_READAHEAD * fs->fs_hwsectorsize);
+  if (fs->fs_rabuffer == NULL)
+    {
+      fat_io_free(fs->fs_cachemem,
+                  CONFIG_FAT_SECTORCACHE * fs->fs_hwsectorsize);
+      fs->fs_cachemem = NULL;
+      return -ENOMEM;
+    }
+#endif
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      fs->fs_cache[i].cs_sector = -1;
+      fs->fs_cache[i].cs_access = 0;
+      fs->fs_cache[i].cs_dirty  = false;
+      fs->fs_cache[i].cs_buffer =
+        &fs->fs_cachemem[i * fs->fs_hwsectorsize];
+    }
+
+  fs->fs_cacheclock = 0;
+  fat_fscacheselect(fs, 0);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscacheuninit
+ *
+ * Description:
+ *   Free the sector cache of the mountpoint.  Dirty sectors are discarded;
+ *   fat_fscacheflush() must be called first to keep them.
+ *
+ ****************************************************************************/
+
+void fat_fscacheuninit(struct fat_mountpt_s *fs)
+{
+  if (fs->fs_cachemem != NULL)
+    {
+      fat_io_free(fs->fs_cachemem,
+                  CONFIG_FAT_SECTORCACHE * fs->fs_hwsectorsize);
+      fs->fs_cachemem = NULL;
+    }
+
+#if FAT_READAHEAD > 1
+  if (fs->fs_rabuffer != NULL)
+    {
+      fat_io_free(fs->fs_rabuffer, FAT_READAHEAD * fs->fs_hwsectorsize);
+      fs->fs_rabuffer = NULL;
+    }
+#endif
+
+  fs->fs_buffer = NULL;
+}
+
 /****************************************************************************
  * Name: fat_fscacheflush
  *
  * Description:
- *   Flush any dirty sector if fs_buffer as necessary
+ *   Write back all dirty sectors of the sector cache
  *
  ****************************************************************************/
 
 int fat_fscacheflush(struct fat_mountpt_s *fs)
 {
   int ret;
+  int i;
 
-  /* Check if the fs_buffer is dirty.  In this case, we will write back the
-   * contents of fs_buffer.
+  /* Record the state of fs_buffer in its cache entry, then write back
+   * every dirty entry.
    */
 
-  if (fs->fs_dirty)
-    {
-      /* Write the dirty sector */
+  fat_fscachesync(fs);
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      ret = fat_fscachewrite(fs, &fs->fs_cache[i]);
       if (ret < 0)
         {
           return ret;
         }
-
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
-      /* No longer dirty */
-
-      fs->fs_dirty = false;
     }
 
+  /* fs_buffer is no longer dirty */
+
+  fs->fs_dirty = false;
   return OK;
 }
 
@@ -1819,48 +2135,87 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
  * Name: fat_fscacheread
  *
  * Description:
- *   Read the specified sector into the sector cache, flushing any existing
- *   dirty sectors as necessary.
+ *   Make the specified sector the current sector in fs_buffer, reading it
+ *   into the sector cache if it is not cached.  The least recently used
+ *   sector is replaced (and written back if dirty) as necessary.
  *
  ****************************************************************************/
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
-  int ret;
+  int ndx;
+  int i;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
    * fs->fs_buffer. If the requested sector is the same as this sector, then
-   * we do nothing. Otherwise, we will have to read the new sector.
+   * we do nothing.
    */
 
-  if (fs->fs_currentsector != sector)
+  if (fs->fs_currentsector == sector)
     {
-      /* We will need to read the new sector.  First, flush the cached
-       * sector if it is dirty.
-       */
+      return OK;
+    }
 
-      ret = fat_fscacheflush(fs);
-      if (ret < 0)
-        {
-          return ret;
-        }
+  /* Save the state of the current sector, then look for the requested
+   * sector in the cache.
+   */
 
-      /* Then read the specified sector into the cache */
+  fat_fscachesync(fs);
 
-      ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
-      if (ret < 0)
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      if (fs->fs_cache[i].cs_sector == sector)
         {
-          return ret;
+          fs->fs_cache[i].cs_access = ++fs->fs_cacheclock;
+          fat_fscacheselect(fs, i);
+          return OK;
         }
+    }
 
-      /* Update the cached sector number */
+  /* Not cached.  Read it, replacing some other sector. */
 
-      fs->fs_currentsector = sector;
+  ndx = fat_fscacheload(fs, sector);
+  if (ndx < 0)
+    {
+      /* The current entry may have been replaced; resynchronize with it */
+
+      fat_fscacheselect(fs, fs->fs_cachendx);
+      return ndx;
     }
 
+  fs->fs_cache[ndx].cs_access = ++fs->fs_cacheclock;
+  fat_fscacheselect(fs, ndx);
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscacheinvalidate
+ *
+ * Description:
+ *   Discard the cached copies of sectors that are written with
+ *   fat_hwwrite(), bypassing the sector cache.  The current sector in
+ *   fs_buffer is kept.
+ *
+ ****************************************************************************/
+
+void fat_fscacheinvalidate(struct fat_mountpt_s *fs, off_t sector,
+                           unsigned int nsectors)
+{
+  struct fat_sector_s *cs;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (i != fs->fs_cachendx && cs->cs_sector >= sector &&
+          cs->cs_sector < sector + nsectors)
+        {
+          cs->cs_sector = -1;
+          cs->cs_dirty  = false;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: fat_ffcacheflush
  *
@@ -1978,6 +2333,98 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
   return OK;
 }
 
+#if CONFIG_FAT_CHAINCACHE > 0
+/****************************************************************************
+ * Name: fat_ffchaininit
+ *
+ * Description:
+ *   Forget all cluster numbers remembered in the cluster chain cache of the
+ *   file.  This must be done whenever the cluster chain is shortened.
+ *
+ ****************************************************************************/
+
+void fat_ffchaininit(struct fat_file_s *ff)
+{
+  memset(ff->ff_chain, 0, sizeof(ff->ff_chain));
+  ff->ff_chainstride = 1;
+}
+
+/****************************************************************************
+ * Name: fat_ffchainfind
+ *
+ * Description:
+ *   Find the closest remembered cluster at or before the cluster at 'index'
+ *   in the file's cluster chain.
+ *
+ * Returned Value:
+ *   The chain index of the cluster returned in 'cluster' or zero if no
+ *   cluster is remembered.  In that case, the caller must start from the
+ *   first cluster of the file.
+ *
+ ****************************************************************************/
+
+uint32_t fat_ffchainfind(struct fat_file_s *ff, uint32_t index,
+                         uint32_t *cluster)
+{
+  uint32_t slot;
+
+  slot = index / ff->ff_chainstride;
+  if (slot >= CONFIG_FAT_CHAINCACHE)
+    {
+      slot = CONFIG_FAT_CHAINCACHE - 1;
+    }
+
+  for (; slot > 0; slot--)
+    {
+      if (ff->ff_chain[slot] != 0)
+        {
+          *cluster = ff->ff_chain[slot];
+          return slot * ff->ff_chainstride;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fat_ffchainadd
+ *
+ * Description:
+ *   Remember the cluster at 'index' in the file's cluster chain.  Only
+ *   every ff_chainstride'th cluster is remembered.  When the file grows
+ *   beyond the reach of the cache, every other entry is dropped and the
+ *   stride is doubled so that the whole file is always covered.
+ *
+ ****************************************************************************/
+
+void fat_ffchainadd(struct fat_file_s *ff, uint32_t index, uint32_t cluster)
+{
+  int i;
+
+  if (index % ff->ff_chainstride != 0)
+    {
+      return;
+    }
+
+  while (index / ff->ff_chainstride >= CONFIG_FAT_CHAINCACHE)
+    {
+      for (i = 0; i < CONFIG_FAT_CHAINCACHE; i++)
+        {
+          ff->ff_chain[i] = 2 * i < CONFIG_FAT_CHAINCACHE ?
+                            ff->ff_chain[2 * i] : 0;
+        }
+
+      ff->ff_chainstride <<= 1;
+      if (index % ff->ff_chainstride != 0)
+        {
+          return;
+        }
+    }
+
+  ff->ff_chain[index / ff->ff_chainstride] = cluster;
+}
+#endif /* CONFIG_FAT_CHAINCACHE > 0 */
+
 /****************************************************************************
  * Name: fat_updatefsinfo
  *
@@ -44,6 +44,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "mmap/fs_rammap.h"
 
 /****************************************************************************
  * Public Functions
@@ -80,6 +81,19 @@ int file_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Remove the file from all epoll instances while its driver state
+       * is still valid.
+       */
+
+      epoll_release(filep);
+
+      /* Copies of the file in memory can no longer be found through it */
+
+      if (INODE_IS_MOUNTPT(inode))
+        {
+          rammap_closed(filep);
+        }
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
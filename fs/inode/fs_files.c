@@ -25,7 +25,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
+#include <strings.h>
+#include <fcntl.h>
 #include <assert.h>
 #include <sched.h>
 #include <errno.h>
@@ -35,6 +39,15 @@
 #include <nuttx/semaphore.h>
 
 #include "inode/inode.h"
+#include "mmap/fs_rammap.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The bits of fl_inuse[] that correspond to descriptors of a block */
+
+#define FILES_ROWMASK ((uint32_t)0xffffffff >> (32 - FILELIST_BLOCK))
 
 /****************************************************************************
  * Private Functions
@@ -55,6 +68,63 @@ static int _files_semtake(FAR struct filelist *list)
 
 #define _files_semgive(list) nxsem_post(&list->fl_sem)
 
+/****************************************************************************
+ * Name: _files_index
+ *
+ * Description:
+ *   Return the descriptor of the file structure 'filep' in 'list' or -1 if
+ *   'filep' is not part of 'list'.
+ *
+ ****************************************************************************/
+
+static int _files_index(FAR struct filelist *list, FAR struct file *filep)
+{
+  FAR struct file *block;
+  int row;
+
+  for (row = 0; row < FILELIST_NBLOCKS; row++)
+    {
+      block = list->fl_blocks[row];
+      if (block != NULL && filep >= block && filep < block + FILELIST_BLOCK)
+        {
+          return row * FILELIST_BLOCK + (int)(filep - block);
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: _files_extend
+ *
+ * Description:
+ *   Make sure that the block containing descriptor 'fd' is allocated.
+ *
+ * Assumptions:
+ *   Caller holds the list semaphore or has the only reference to the list.
+ *
+ ****************************************************************************/
+
+static int _files_extend(FAR struct filelist *list, int fd)
+{
+  FAR struct file *block;
+  int row = FILELIST_ROW(fd);
+
+  if (list->fl_blocks[row] == NULL)
+    {
+      block = (FAR struct file *)
+        kmm_zalloc(FILELIST_BLOCK * sizeof(struct file));
+      if (block == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      list->fl_blocks[row] = block;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: _files_close
  *
@@ -76,6 +146,19 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Remove the file from all epoll instances while its driver state
+       * is still valid.
+       */
+
+      epoll_release(filep);
+
+      /* Copies of the file in memory can no longer be found through it */
+
+      if (INODE_IS_MOUNTPT(inode))
+        {
+          rammap_closed(filep);
+        }
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -129,6 +212,10 @@ void files_initlist(FAR struct filelist *list)
   /* Initialize the list access mutex */
 
   nxsem_init(&list->fl_sem, 0, 1);
+
+  /* The first block of descriptors is always present */
+
+  list->fl_blocks[0] = list->fl_files;
 }
 
 /****************************************************************************
@@ -141,18 +228,43 @@ void files_initlist(FAR struct filelist *list)
 
 void files_releaselist(FAR struct filelist *list)
 {
-  int i;
+  FAR struct file *block;
+  uint32_t inuse;
+  int row;
+  int col;
 
   DEBUGASSERT(list);
 
-  /* Close each file descriptor .. Normally, you would need take the list
-   * semaphore, but it is safe to ignore the semaphore in this context
+  /* Close each open file descriptor .. Normally, you would need take the
+   * list semaphore, but it is safe to ignore the semaphore in this context
    * because there should not be any references in this context.
    */
 
-  for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (row = 0; row < FILELIST_NBLOCKS; row++)
     {
-      _files_close(&list->fl_files[i]);
+      block = list->fl_blocks[row];
+      if (block == NULL)
+        {
+          continue;
+        }
+
+      inuse = list->fl_inuse[row];
+      while (inuse != 0)
+        {
+          col    = ffsl((long)inuse) - 1;
+          inuse &= ~((uint32_t)1 << col);
+          _files_close(&block[col]);
+        }
+
+      list->fl_inuse[row] = 0;
+
+      /* The first block is part of the list itself */
+
+      if (row > 0)
+        {
+          list->fl_blocks[row] = NULL;
+          kmm_free(block);
+        }
     }
 
   /* Destroy the semaphore */
@@ -160,6 +272,87 @@ void files_releaselist(FAR struct filelist *list)
   nxsem_destroy(&list->fl_sem);
 }
 
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of the descriptor 'fd' in 'list', NULL if
+ *   'fd' is out of range or if its block has never been allocated.  The
+ *   file structure is returned whether or not the descriptor is open.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd)
+{
+  FAR struct file *block;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return NULL;
+    }
+
+  block = list->fl_blocks[FILELIST_ROW(fd)];
+  return block != NULL ? &block[FILELIST_COL(fd)] : NULL;
+}
+
+/****************************************************************************
+ * Name: files_duplist
+ *
+ * Description:
+ *   Duplicate the first 'nfds' open descriptors of 'plist' that are not
+ *   marked close-on-exec into 'clist', using the same descriptor numbers.
+ *   This is used to let a new task inherit the descriptors of its parent.
+ *
+ * Assumptions:
+ *   'plist' is the list of the calling task.  The task owning 'clist' has
+ *   not started yet.
+ *
+ ****************************************************************************/
+
+void files_duplist(FAR struct filelist *plist, FAR struct filelist *clist,
+                   int nfds)
+{
+  FAR struct file *filep;
+  uint32_t inuse;
+  int row;
+  int col;
+  int fd;
+
+  for (row = 0; row < FILELIST_NBLOCKS; row++)
+    {
+      /* Only the open descriptors of the parent are visited */
+
+      inuse = plist->fl_inuse[row];
+      while (inuse != 0)
+        {
+          col    = ffsl((long)inuse) - 1;
+          inuse &= ~((uint32_t)1 << col);
+          fd     = row * FILELIST_BLOCK + col;
+
+          if (fd >= nfds)
+            {
+              return;
+            }
+
+          filep = &plist->fl_blocks[row][col];
+          if (filep->f_inode == NULL || (filep->f_oflags & O_CLOEXEC) != 0)
+            {
+              continue;
+            }
+
+          if (_files_extend(clist, fd) < 0)
+            {
+              return;
+            }
+
+          if (file_dup2(filep, &clist->fl_blocks[row][col]) >= 0)
+            {
+              files_setinuse(clist, fd, true);
+            }
+        }
+    }
+}
+
 /****************************************************************************
  * Name: file_dup2
  *
@@ -181,6 +374,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 {
   FAR struct filelist *list;
   FAR struct inode *inode;
+  int fd2 = -1;
   int ret;
 
   if (filep1 == NULL || filep1->f_inode == NULL || filep2 == NULL)
@@ -206,6 +400,13 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 
           return ret;
         }
+
+      /* filep2 is usually a descriptor of the list whose in-use bit must
+       * follow the state of filep2.  It may also be a file structure of
+       * some other list or no list at all.
+       */
+
+      fd2 = _files_index(list, filep2);
     }
 
   /* If there is already an inode contained in the new file structure,
@@ -266,6 +467,11 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 
   if (list != NULL)
     {
+      if (fd2 >= 0)
+        {
+          files_setinuse(list, fd2, true);
+        }
+
       _files_semgive(list);
     }
 
@@ -283,6 +489,11 @@ errout_with_inode:
 errout_with_sem:
   if (list != NULL)
     {
+      if (fd2 >= 0)
+        {
+          files_setinuse(list, fd2, filep2->f_inode != NULL);
+        }
+
       _files_semgive(list);
     }
 
@@ -296,19 +507,31 @@ errout_with_sem:
  *   Allocate a struct files instance and associate it with an inode
  *   instance.  Returns the file descriptor == index into the files array.
  *
+ *   The lowest free descriptor >= minfd is found with one ffsl() per block
+ *   of descriptors.
+ *
  ****************************************************************************/
 
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 {
   FAR struct filelist *list;
+  FAR struct file *filep;
+  uint32_t avail;
+  int row;
+  int col;
+  int fd;
   int ret;
-  int i;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
   list = sched_getfiles();
   DEBUGASSERT(list != NULL);
 
+  if (minfd < 0)
+    {
+      minfd = 0;
+    }
+
   ret = _files_semtake(list);
   if (ret < 0)
     {
@@ -317,23 +540,101 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
       return ret;
     }
 
-  for (i = minfd; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (row = FILELIST_ROW(minfd); row < FILELIST_NBLOCKS; row++)
     {
-      if (!list->fl_files[i].f_inode)
+      avail = ~list->fl_inuse[row] & FILES_ROWMASK;
+      if (row == FILELIST_ROW(minfd))
         {
-          list->fl_files[i].f_oflags = oflags;
-          list->fl_files[i].f_pos    = pos;
-          list->fl_files[i].f_inode  = inode;
-          list->fl_files[i].f_priv   = NULL;
-          _files_semgive(list);
-          return i;
+          avail &= ~(((uint32_t)1 << FILELIST_COL(minfd)) - 1);
         }
+
+      if (avail == 0)
+        {
+          continue;
+        }
+
+      col = ffsl((long)avail) - 1;
+      fd  = row * FILELIST_BLOCK + col;
+
+      if (fd >= CONFIG_NFILE_DESCRIPTORS ||
+          _files_extend(list, fd) < 0)
+        {
+          break;
+        }
+
+      filep           = &list->fl_blocks[row][col];
+      filep->f_oflags = oflags;
+      filep->f_pos    = pos;
+      filep->f_inode  = inode;
+      filep->f_priv   = NULL;
+
+      files_setinuse(list, fd, true);
+      _files_semgive(list);
+      return fd;
     }
 
   _files_semgive(list);
   return ERROR;
 }
 
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Make sure that the file structure of the descriptor 'fd' exists so that
+ *   it can be the target of dup2().
+ *
+ ****************************************************************************/
+
+int files_extend(FAR struct filelist *list, int fd)
+{
+  int ret;
+
+  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return -EBADF;
+    }
+
+  if (list->fl_blocks[FILELIST_ROW(fd)] != NULL)
+    {
+      return OK;
+    }
+
+  ret = _files_semtake(list);
+  if (ret >= 0)
+    {
+      ret = _files_extend(list, fd);
+      _files_semgive(list);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: files_setinuse
+ *
+ * Description:
+ *   Mark the descriptor 'fd' as used or free in the in-use bitmap.
+ *
+ * Assumptions:
+ *   Caller holds the list semaphore.
+ *
+ ****************************************************************************/
+
+void files_setinuse(FAR struct filelist *list, int fd, bool inuse)
+{
+  uint32_t bit = (uint32_t)1 << FILELIST_COL(fd);
+
+  if (inuse)
+    {
+      list->fl_inuse[FILELIST_ROW(fd)] |= bit;
+    }
+  else
+    {
+      list->fl_inuse[FILELIST_ROW(fd)] &= ~bit;
+    }
+}
+
 /****************************************************************************
  * Name: files_close
  *
@@ -349,6 +650,7 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 int files_close(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file     *filep;
   int                  ret;
 
   /* Get the thread-specific file list.  It should never be NULL in this
@@ -360,8 +662,8 @@ int files_close(int fd)
 
   /* If the file was properly opened, there should be an inode assigned */
 
-  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS ||
-      !list->fl_files[fd].f_inode)
+  filep = files_fget(list, fd);
+  if (filep == NULL || !filep->f_inode)
     {
       return -EBADF;
     }
@@ -371,7 +673,8 @@ int files_close(int fd)
   ret = _files_semtake(list);
   if (ret >= 0)
     {
-      ret = _files_close(&list->fl_files[fd]);
+      ret = _files_close(filep);
+      files_setinuse(list, fd, false);
       _files_semgive(list);
     }
 
@@ -390,19 +693,22 @@ int files_close(int fd)
 void files_release(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file *filep;
   int ret;
 
   list = sched_getfiles();
   DEBUGASSERT(list != NULL);
 
-  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS)
+  filep = files_fget(list, fd);
+  if (filep != NULL)
     {
       ret = _files_semtake(list);
       if (ret >= 0)
         {
-          list->fl_files[fd].f_oflags  = 0;
-          list->fl_files[fd].f_pos     = 0;
-          list->fl_files[fd].f_inode = NULL;
+          filep->f_oflags  = 0;
+          filep->f_pos     = 0;
+          filep->f_inode   = NULL;
+          files_setinuse(list, fd, false);
           _files_semgive(list);
         }
     }
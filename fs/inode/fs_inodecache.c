@@ -0,0 +1,342 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODE_CACHE_MASK (CONFIG_FS_INODE_CACHE_NENTRIES - 1)
+
+#if (CONFIG_FS_INODE_CACHE_NENTRIES & INODE_CACHE_MASK) != 0
+#  error CONFIG_FS_INODE_CACHE_NENTRIES must be a power of two
+#endif
+
+#if CONFIG_FS_INODE_CACHE_PATHLEN > 255
+#  error CONFIG_FS_INODE_CACHE_PATHLEN must not exceed 255
+#endif
+
+/* 32-bit FNV-1a hash of the path */
+
+#define INODE_CACHE_HASHINIT   2166136261u
+#define INODE_CACHE_HASH(h,c)  (((h) ^ (uint8_t)(c)) * 16777619u)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached path.  An entry is keyed either by a complete path or, if the
+ * search terminated at a mountpoint, by the path of the mountpoint so that
+ * it serves every path below the mountpoint.
+ */
+
+struct inode_cache_s
+{
+  uint32_t          ic_gen;     /* Generation of the entry, 0: unused */
+  uint32_t          ic_hash;    /* Hash of ic_path[] */
+  FAR struct inode *ic_node;    /* The inode found, NULL if negative entry */
+  FAR struct inode *ic_peer;    /* Node to the "left" of the inode */
+  FAR struct inode *ic_parent;  /* Node "above" the inode */
+  uint8_t           ic_len;     /* Length of ic_path[] */
+  uint8_t           ic_resid;   /* Offset of the residual path if negative */
+  char              ic_path[CONFIG_FS_INODE_CACHE_PATHLEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache and its statistics are protected by the inode semaphore that
+ * every caller of inode_search() holds.  Entries of an older generation are
+ * stale, so invalidating the whole cache is a single increment.
+ */
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODE_CACHE_NENTRIES];
+static uint32_t g_inode_cachegen = 1;
+static struct inode_cachestats_s g_inode_cachestats;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_find
+ *
+ * Description:
+ *   Find the entry of the first 'len' characters of 'path'.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_cache_s *inode_cache_find(FAR const char *path,
+                                                  size_t len, uint32_t hash)
+{
+  FAR struct inode_cache_s *entry;
+
+  entry = &g_inode_cache[hash & INODE_CACHE_MASK];
+  if (entry->ic_gen == g_inode_cachegen && entry->ic_hash == hash &&
+      entry->ic_len == len && memcmp(entry->ic_path, path, len) == 0)
+    {
+      return entry;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: inode_cache_skipslash
+ ****************************************************************************/
+
+static FAR const char *inode_cache_skipslash(FAR const char *name)
+{
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  return name;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Try to complete an inode search from the cache.  The path is hashed
+ *   once; the cache is probed at the end of each path segment for a
+ *   mountpoint and at the end of the path for any cached result.
+ *
+ * Input Parameters:
+ *   desc - The search descriptor, set up as for inode_search()
+ *
+ * Returned Value:
+ *   OK or -ENOENT with 'desc' filled in as _inode_search() would have done
+ *   it; -EAGAIN if the result is not cached.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+int inode_cache_lookup(FAR struct inode_search_s *desc)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *path = desc->path;
+  FAR const char *name;
+  uint32_t hash = INODE_CACHE_HASHINIT;
+  size_t len;
+
+  if (*path != '/')
+    {
+      return -EAGAIN;
+    }
+
+  for (len = 0; len <= CONFIG_FS_INODE_CACHE_PATHLEN; len++)
+    {
+      if (len > 1 && (path[len] == '/' || path[len] == '\0'))
+        {
+          entry = inode_cache_find(path, len, hash);
+          if (entry != NULL)
+            {
+              name = inode_cache_skipslash(&path[len]);
+
+              if (entry->ic_node == NULL && *name == '\0')
+                {
+                  /* A negative entry of the complete path */
+
+                  desc->path    = &path[entry->ic_resid];
+                  desc->node    = NULL;
+                  desc->peer    = entry->ic_peer;
+                  desc->parent  = entry->ic_parent;
+                  desc->relpath = NULL;
+
+                  g_inode_cachestats.ics_neghits++;
+                  return -ENOENT;
+                }
+
+              if (entry->ic_node != NULL &&
+                  (*name == '\0' || INODE_IS_MOUNTPT(entry->ic_node)))
+                {
+                  /* The complete path or the mountpoint below which the
+                   * rest of the path lies.
+                   */
+
+                  desc->path    = name;
+                  desc->node    = entry->ic_node;
+                  desc->peer    = entry->ic_peer;
+                  desc->parent  = entry->ic_parent;
+                  desc->relpath = name;
+
+                  g_inode_cachestats.ics_hits++;
+                  return OK;
+                }
+            }
+        }
+
+      if (path[len] == '\0')
+        {
+          break;
+        }
+
+      hash = INODE_CACHE_HASH(hash, path[len]);
+    }
+
+  g_inode_cachestats.ics_misses++;
+  return -EAGAIN;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of an inode search that did not pass through a
+ *   soft link.
+ *
+ * Input Parameters:
+ *   path - The path that was searched
+ *   desc - The search descriptor as returned by _inode_search()
+ *   ret  - The value returned by _inode_search()
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *path, FAR struct inode_search_s *desc,
+                     int ret)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *end;
+  uint32_t hash = INODE_CACHE_HASHINIT;
+  size_t resid = 0;
+  size_t len;
+  size_t i;
+
+  /* A failed soft link leaves the descriptor pointing into the link
+   * target instead of 'path'.  Such results are not cached.
+   */
+
+  len = strlen(path);
+  end = ret == OK ? desc->relpath : desc->path;
+  if (end == NULL || end < path || end > path + len)
+    {
+      return;
+    }
+
+  if (ret == OK && desc->node != NULL)
+    {
+      /* The key ends with the name of the inode found.  If that is a
+       * mountpoint, 'relpath' is the part of the path below it.
+       */
+
+      len = end - path;
+      while (len > 0 && path[len - 1] == '/')
+        {
+          len--;
+        }
+    }
+  else if (ret == -ENOENT && desc->node == NULL)
+    {
+      resid = end - path;
+    }
+  else
+    {
+      return;
+    }
+
+  if (len > CONFIG_FS_INODE_CACHE_PATHLEN)
+    {
+      return;
+    }
+
+  for (i = 0; i < len; i++)
+    {
+      hash = INODE_CACHE_HASH(hash, path[i]);
+    }
+
+  entry            = &g_inode_cache[hash & INODE_CACHE_MASK];
+  entry->ic_gen    = g_inode_cachegen;
+  entry->ic_hash   = hash;
+  entry->ic_node   = desc->node;
+  entry->ic_peer   = desc->peer;
+  entry->ic_parent = desc->parent;
+  entry->ic_len    = (uint8_t)len;
+  entry->ic_resid  = (uint8_t)resid;
+  memcpy(entry->ic_path, path, len);
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Forget all cached paths.  This must be called whenever the shape of
+ *   the inode tree changes or an inode becomes a mountpoint or soft link.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  if (++g_inode_cachegen == 0)
+    {
+      /* The generation wrapped around; really clear the entries */
+
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+
+  g_inode_cachestats.ics_flushes++;
+}
+
+/****************************************************************************
+ * Name: inode_cache_getstats
+ *
+ * Description:
+ *   Return a snapshot of the cache statistics.
+ *
+ ****************************************************************************/
+
+void inode_cache_getstats(FAR struct inode_cachestats_s *stats)
+{
+  DEBUGASSERT(stats != NULL);
+  memcpy(stats, &g_inode_cachestats, sizeof(struct inode_cachestats_s));
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
@@ -117,6 +117,10 @@ FAR struct inode *inode_unlink(FAR const char *path)
         }
 
       node->i_peer = NULL;
+
+      /* Forget the cached searches that may reach the node */
+
+      inode_cache_invalidate();
     }
 
   RELEASE_SEARCH(&desc);
@@ -461,6 +461,9 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
 int inode_search(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR const char *path;
+#endif
   int ret;
 
   /* Perform the common _inode_search() logic.  This does everything except
@@ -473,8 +476,31 @@ int inode_search(FAR struct inode_search_s *desc)
   desc->linktgt = NULL;
 #endif
 
+#ifdef CONFIG_FS_INODE_CACHE
+  /* Results that involve no soft link are cached.  Such results do not
+   * depend on 'nofollow'.
+   */
+
+  path = desc->path;
+  ret  = inode_cache_lookup(desc);
+  if (ret != -EAGAIN)
+    {
+      return ret;
+    }
+#endif
+
   ret = _inode_search(desc);
 
+#ifdef CONFIG_FS_INODE_CACHE
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+  if (desc->linktgt == NULL &&
+      (desc->node == NULL || !INODE_IS_SOFTLINK(desc->node)))
+#endif
+    {
+      inode_cache_add(path, desc, ret);
+    }
+#endif
+
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   if (ret >= 0)
     {
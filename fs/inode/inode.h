@@ -128,6 +128,18 @@ struct inode_search_s
 #endif
 };
 
+/* Statistics of the path lookup cache */
+
+#ifdef CONFIG_FS_INODE_CACHE
+struct inode_cachestats_s
+{
+  uint32_t ics_hits;         /* Searches resolved from the cache */
+  uint32_t ics_neghits;      /* Searches resolved by a negative entry */
+  uint32_t ics_misses;       /* Searches that walked the inode tree */
+  uint32_t ics_flushes;      /* Number of times the cache was invalidated */
+};
+#endif
+
 /* Callback used by foreach_inode to traverse all inodes in the pseudo-
  * file system.
  */
@@ -366,6 +378,66 @@ void inode_release(FAR struct inode *inode);
 
 int foreach_inode(foreach_inode_t handler, FAR void *arg);
 
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Try to complete an inode search from the path lookup cache.
+ *
+ * Returned Value:
+ *   OK or -ENOENT with 'desc' filled in as by inode_search(); -EAGAIN if
+ *   the result is not cached.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+int inode_cache_lookup(FAR struct inode_search_s *desc);
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of an inode search of 'path' that did not pass
+ *   through a soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *path, FAR struct inode_search_s *desc,
+                     int ret);
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Forget all cached paths.  This must be called whenever the shape of
+ *   the inode tree changes or an inode becomes a mountpoint or soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void);
+
+/****************************************************************************
+ * Name: inode_cache_getstats
+ *
+ * Description:
+ *   Return a snapshot of the path lookup cache statistics.
+ *
+ ****************************************************************************/
+
+void inode_cache_getstats(FAR struct inode_cachestats_s *stats);
+#else
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: files_initialize
  *
@@ -413,6 +485,45 @@ int files_close(int fd);
 
 void files_release(int fd);
 
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Make sure that the file structure of the descriptor 'fd' exists so that
+ *   it can be the target of dup2().
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBADF if 'fd' is out of range or -ENOMEM if the
+ *   block of descriptors could not be allocated.
+ *
+ ****************************************************************************/
+
+int files_extend(FAR struct filelist *list, int fd);
+
+/****************************************************************************
+ * Name: files_setinuse
+ *
+ * Description:
+ *   Mark the descriptor 'fd' as used or free in the in-use bitmap.
+ *
+ * Assumptions:
+ *   Caller holds the list semaphore.
+ *
+ ****************************************************************************/
+
+void files_setinuse(FAR struct filelist *list, int fd, bool inuse);
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove the registrations of an open file from all epoll instances.
+ *   Called before the file is closed.
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR struct file *filep);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "inode/inode.h"
+#include "fs_rammap.h"
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   Write the changes made to a writable MAP_SHARED mapping back to the
+ *   mapped file.  The write-back is always synchronous, so MS_ASYNC is
+ *   handled like MS_SYNC.  All mappings of a file share the same memory, so
+ *   there is nothing to do for MS_INVALIDATE.  Nothing is written for other
+ *   mappings.
+ *
+ * Input Parameters:
+ *   start   An address within the mapping
+ *   length  The length of the range to write back
+ *   flags   MS_ASYNC or MS_SYNC, optionally combined with MS_INVALIDATE
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set:
+ *
+ *     EINVAL
+ *      Both MS_ASYNC and MS_SYNC were specified.
+ *     ENOMEM
+ *      'start' is not within a mapping.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *start, size_t length, int flags)
+{
+  FAR struct fs_rammap_s *curr;
+  size_t offset;
+  int errcode;
+  int ret;
+
+  if ((flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  rammap_initialize();
+  ret = rammap_lock();
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  /* Find the region containing the start address */
+
+  for (curr = g_rammaps.head; curr; curr = curr->flink)
+    {
+      if (curr->refs > 0 &&
+          (uintptr_t)start >= (uintptr_t)curr->addr &&
+          (uintptr_t)start < (uintptr_t)curr->addr + curr->length)
+        {
+          break;
+        }
+    }
+
+  if (!curr)
+    {
+      ferr("ERROR: Region not found\n");
+      errcode = ENOMEM;
+      goto errout_with_semaphore;
+    }
+
+  /* Limit the range to the region and write it back */
+
+  offset = (uintptr_t)start - (uintptr_t)curr->addr;
+  if (length > curr->length - offset)
+    {
+      length = curr->length - offset;
+    }
+
+  ret = rammap_sync(curr, offset, length);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_semaphore;
+    }
+
+  rammap_unlock();
+  return OK;
+
+errout_with_semaphore:
+  rammap_unlock();
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_RAMMAP */
@@ -92,8 +92,11 @@
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
- *      into RAM.  munmap() is required in this case to free the allocated
- *      memory holding the shared copy of the file.
+ *      into RAM.  munmap() is required in this case to release the
+ *      allocated memory holding the shared copy of the file.  The memory is
+ *      freed (or cached) when the last mapping of the copy is removed.
+ *      Changes to a writable MAP_SHARED mapping are then written back to
+ *      the file.
  *
  * Input Parameters:
  *   start   The start address of the mapping to delete.  For this
@@ -110,7 +113,6 @@
 
 int munmap(FAR void *start, size_t length)
 {
-  FAR struct fs_rammap_s *prev;
   FAR struct fs_rammap_s *curr;
   FAR void *newaddr;
   unsigned int offset;
@@ -120,20 +122,21 @@ int munmap(FAR void *start, size_t length)
   /* Find a region containing this start and length in the list of regions */
 
   rammap_initialize();
-  ret = nxsem_wait(&g_rammaps.exclsem);
+  ret = rammap_lock();
   if (ret < 0)
     {
-      errcode = ret;
+      errcode = -ret;
       goto errout;
     }
 
   /* Search the list of regions */
 
-  for (prev = NULL, curr = g_rammaps.head; curr; prev = curr, curr = curr->flink)
+  for (curr = g_rammaps.head; curr; curr = curr->flink)
     {
       /* Does this region include any part of the specified range? */
 
-      if ((uintptr_t)start < (uintptr_t)curr->addr + curr->length &&
+      if (curr->refs > 0 &&
+          (uintptr_t)start < (uintptr_t)curr->addr + curr->length &&
           (uintptr_t)start + length >= (uintptr_t)curr->addr)
         {
           break;
@@ -164,49 +167,49 @@ int munmap(FAR void *start, size_t length)
       goto errout_with_semaphore;
     }
 
-  /* Okay.. the region is beging umapped to the end.  Make sure the length
-   * indicates that.
-   */
-
-  length = curr->length - offset;
-
   /* Are we unmapping the entire region (offset == 0)? */
 
-  if (length >= curr->length)
+  if (offset == 0)
     {
-      /* Yes.. remove the mapping from the list */
+      /* Yes.. drop the reference to the region.  The last reference frees
+       * the region (or keeps it in the cache of unmapped regions).
+       */
 
-      if (prev)
+      ret = rammap_release(curr);
+      if (ret < 0)
         {
-          prev->flink = curr->flink;
+          errcode = -ret;
+          goto errout_with_semaphore;
         }
-      else
-        {
-          g_rammaps.head = curr->flink;
-        }
-
-      /* Then free the region */
-
-      kumm_free(curr);
     }
 
   /* No.. We have been asked to "unmap' only a portion of the memory
-   * (offset > 0).
+   * (offset > 0).  The memory of a region that is shared with other
+   * mappings is left as it is.
    */
 
-  else
+  else if (curr->refs == 1)
     {
-      newaddr = kumm_realloc(curr->addr, sizeof(struct fs_rammap_s) + length);
-      DEBUGASSERT(newaddr == (FAR void *)(curr->addr));
+      /* Write back the part that is removed, then give its memory back */
+
+      ret = rammap_sync(curr, offset, curr->length - offset);
+      if (ret < 0)
+        {
+          errcode = -ret;
+          goto errout_with_semaphore;
+        }
+
+      newaddr = kumm_realloc(curr, sizeof(struct fs_rammap_s) + offset);
+      DEBUGASSERT(newaddr == (FAR void *)curr);
       UNUSED(newaddr); /* May not be used */
-      curr->length = length;
+      curr->length = offset;
     }
 
-  nxsem_post(&g_rammaps.exclsem);
+  rammap_unlock();
   return OK;
 
 errout_with_semaphore:
-  nxsem_post(&g_rammaps.exclsem);
+  rammap_unlock();
 
 errout:
   set_errno(errcode);
@@ -41,10 +41,13 @@
 
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/fs/fs.h>
@@ -55,6 +58,12 @@
 
 #ifdef CONFIG_FS_RAMMAP
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NO_HOLDER ((pid_t)-1)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -63,6 +72,154 @@
 
 struct fs_allmaps_s g_rammaps;
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_remove
+ *
+ * Description:
+ *   Remove a region from the list of regions.
+ *
+ ****************************************************************************/
+
+static void rammap_remove(FAR struct fs_rammap_s *map)
+{
+  FAR struct fs_rammap_s *prev;
+
+  if (g_rammaps.head == map)
+    {
+      g_rammaps.head = map->flink;
+    }
+  else
+    {
+      prev = g_rammaps.head;
+      while (prev->flink != map)
+        {
+          prev = prev->flink;
+        }
+
+      prev->flink = map->flink;
+    }
+
+  map->flink = NULL;
+}
+
+/****************************************************************************
+ * Name: rammap_append
+ *
+ * Description:
+ *   Add a region at the end of the list of regions.  The list is thereby
+ *   kept in the order of last use, so that the oldest unmapped regions are
+ *   evicted first.
+ *
+ ****************************************************************************/
+
+static void rammap_append(FAR struct fs_rammap_s *map)
+{
+  FAR struct fs_rammap_s *prev;
+
+  map->flink = NULL;
+  if (g_rammaps.head == NULL)
+    {
+      g_rammaps.head = map;
+    }
+  else
+    {
+      prev = g_rammaps.head;
+      while (prev->flink != NULL)
+        {
+          prev = prev->flink;
+        }
+
+      prev->flink = map;
+    }
+}
+
+/****************************************************************************
+ * Name: rammap_free
+ *
+ * Description:
+ *   Free a region that is no longer mapped.
+ *
+ ****************************************************************************/
+
+static void rammap_free(FAR struct fs_rammap_s *map)
+{
+  inode_release(map->inode);
+  kumm_free(map);
+}
+
+/****************************************************************************
+ * Name: rammap_evict
+ *
+ * Description:
+ *   Free unmapped, cached regions, oldest first, until no more than 'limit'
+ *   bytes remain cached.
+ *
+ ****************************************************************************/
+
+static void rammap_evict(size_t limit)
+{
+  FAR struct fs_rammap_s *prev = NULL;
+  FAR struct fs_rammap_s *curr;
+  FAR struct fs_rammap_s *next;
+
+  for (curr = g_rammaps.head; curr && g_rammaps.cached > limit; curr = next)
+    {
+      next = curr->flink;
+      if (curr->refs > 0)
+        {
+          prev = curr;
+          continue;
+        }
+
+      if (prev)
+        {
+          prev->flink = next;
+        }
+      else
+        {
+          g_rammaps.head = next;
+        }
+
+      g_rammaps.cached -= curr->length;
+      rammap_free(curr);
+    }
+}
+
+/****************************************************************************
+ * Name: rammap_find
+ *
+ * Description:
+ *   Find a shareable region holding 'length' bytes of the file from
+ *   'offset' on.  Regions read before the file was modified are not
+ *   returned.
+ *
+ ****************************************************************************/
+
+static FAR struct fs_rammap_s *rammap_find(FAR struct file *filep,
+                                           FAR const struct stat *buf,
+                                           size_t length, off_t offset)
+{
+  FAR struct fs_rammap_s *map;
+
+  for (map = g_rammaps.head; map; map = map->flink)
+    {
+      if (map->shared && !map->stale && map->inode == filep->f_inode &&
+          map->ino == buf->st_ino &&
+          (map->ino != 0 || map->filep == filep) &&
+          map->offset == offset && map->length == length &&
+          map->size == buf->st_size && map->mtime == buf->st_mtime)
+        {
+          return map;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -86,10 +243,344 @@ void rammap_initialize(void)
   if (!g_rammaps.initialized)
     {
       nxsem_init(&g_rammaps.exclsem, 0, 1);
+      g_rammaps.holder      = NO_HOLDER;
       g_rammaps.initialized = true;
     }
 }
 
+/****************************************************************************
+ * Name: rammap_lock
+ *
+ * Description:
+ *   Get exclusive access to the list of regions.  The lock may be taken
+ *   again by its holder:  Writing a region back to the file calls
+ *   rammap_modified().
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_lock(void)
+{
+  pid_t me = getpid();
+  int ret;
+
+  if (g_rammaps.holder == me)
+    {
+      g_rammaps.count++;
+      DEBUGASSERT(g_rammaps.count > 0);
+      return OK;
+    }
+
+  ret = nxsem_wait_uninterruptible(&g_rammaps.exclsem);
+  if (ret >= 0)
+    {
+      g_rammaps.holder = me;
+      g_rammaps.count  = 1;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rammap_unlock
+ *
+ * Description:
+ *   Relinquish exclusive access to the list of regions.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_unlock(void)
+{
+  DEBUGASSERT(g_rammaps.holder == getpid());
+
+  if (g_rammaps.count > 1)
+    {
+      g_rammaps.count--;
+    }
+  else
+    {
+      g_rammaps.holder = NO_HOLDER;
+      g_rammaps.count  = 0;
+      nxsem_post(&g_rammaps.exclsem);
+    }
+}
+
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write part of a writable MAP_SHARED region back to the mapped file.
+ *   The caller must hold the lock (rammap_lock()).
+ *
+ * Input Parameters:
+ *   map     The region
+ *   offset  The offset of the part to write into the region
+ *   length  The length of the part to write
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length)
+{
+  FAR const uint8_t *wrbuffer;
+  struct stat buf;
+  ssize_t nwritten;
+  off_t fpos;
+  bool stale;
+  int ret;
+
+  if (!map->writeback)
+    {
+      return OK;
+    }
+
+  /* The part of the region beyond the end of the file is only padding.
+   * Do not extend the file with it.
+   */
+
+  fpos = map->offset + offset;
+  if (fpos >= map->size)
+    {
+      return OK;
+    }
+
+  if (length > map->size - fpos)
+    {
+      length = map->size - fpos;
+    }
+
+  fpos = file_seek(&map->file, fpos, SEEK_SET);
+  if (fpos < 0)
+    {
+      return (int)fpos;
+    }
+
+  /* Writing the file marks all of its shared regions stale, this one
+   * included.  This region still matches the file afterwards.
+   */
+
+  stale = map->stale;
+  wrbuffer = (FAR const uint8_t *)map->addr + offset;
+  while (length > 0)
+    {
+      nwritten = file_write(&map->file, wrbuffer, length);
+      if (nwritten < 0)
+        {
+          if (nwritten != -EINTR)
+            {
+              ferr("ERROR: Write failed: offset=%d errno=%d\n",
+                   (int)map->offset, (int)nwritten);
+              return (int)nwritten;
+            }
+
+          continue;
+        }
+
+      wrbuffer += nwritten;
+      length   -= nwritten;
+    }
+
+  ret = file_fsync(&map->file);
+  if (ret >= 0 && !stale && file_fstat(&map->file, &buf) >= 0)
+    {
+      map->size  = buf.st_size;
+      map->mtime = buf.st_mtime;
+      map->stale = false;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rammap_release
+ *
+ * Description:
+ *   Drop one reference to a region.  When the last mapping is gone, changes
+ *   of a writable MAP_SHARED region are written back.  The region is then
+ *   freed or, if it can be shared, kept in the cache of unmapped regions.
+ *   The caller must hold the lock (rammap_lock()).
+ *
+ * Input Parameters:
+ *   map  The region
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the write-back failed.
+ *   The reference is dropped in any case.
+ *
+ ****************************************************************************/
+
+int rammap_release(FAR struct fs_rammap_s *map)
+{
+  int ret = OK;
+
+  DEBUGASSERT(map->refs > 0);
+  if (--map->refs > 0)
+    {
+      return OK;
+    }
+
+  if (map->writeback)
+    {
+      ret = rammap_sync(map, 0, map->length);
+      file_close(&map->file);
+      map->writeback = false;
+    }
+
+  rammap_remove(map);
+
+  if (map->shared && !map->stale && CONFIG_FS_RAMMAP_CACHESIZE > 0)
+    {
+      /* Keep the region as the most recently used one and trim the cache */
+
+      rammap_append(map);
+      g_rammaps.cached += map->length;
+      rammap_evict(CONFIG_FS_RAMMAP_CACHESIZE);
+    }
+  else
+    {
+      rammap_free(map);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rammap_modified
+ *
+ * Description:
+ *   Called after the file was modified through the open file 'filep'.
+ *   Regions of the file are no longer shared.  Regions of files that
+ *   cannot be identified are no longer shared if they are on the same
+ *   file system.
+ *
+ * Input Parameters:
+ *   filep  The open file that was used to modify the file
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_modified(FAR struct file *filep)
+{
+  FAR struct fs_rammap_s *map;
+  struct stat buf;
+  bool havestat = false;
+
+  if (!g_rammaps.initialized || g_rammaps.head == NULL ||
+      rammap_lock() < 0)
+    {
+      return;
+    }
+
+  for (map = g_rammaps.head; map; map = map->flink)
+    {
+      if (!map->shared || map->stale || map->inode != filep->f_inode)
+        {
+          continue;
+        }
+
+      /* Regions of other files with serial numbers are still valid */
+
+      if (map->ino != 0)
+        {
+          if (!havestat)
+            {
+              if (file_fstat(filep, &buf) < 0)
+                {
+                  buf.st_ino = 0;
+                }
+
+              havestat = true;
+            }
+
+          if (buf.st_ino != 0 && buf.st_ino != map->ino)
+            {
+              continue;
+            }
+        }
+
+      map->stale = true;
+    }
+
+  rammap_unlock();
+}
+
+/****************************************************************************
+ * Name: rammap_closed
+ *
+ * Description:
+ *   Called before the open file 'filep' is closed.  Regions that are
+ *   identified by the open file are no longer shared.
+ *
+ * Input Parameters:
+ *   filep  The open file
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_closed(FAR struct file *filep)
+{
+  FAR struct fs_rammap_s *prev = NULL;
+  FAR struct fs_rammap_s *curr;
+  FAR struct fs_rammap_s *next;
+
+  if (!g_rammaps.initialized || g_rammaps.head == NULL ||
+      rammap_lock() < 0)
+    {
+      return;
+    }
+
+  for (curr = g_rammaps.head; curr; curr = next)
+    {
+      next = curr->flink;
+      if (curr->filep != filep)
+        {
+          prev = curr;
+          continue;
+        }
+
+      /* Regions that are still mapped are freed by the last munmap() */
+
+      curr->filep  = NULL;
+      curr->shared = false;
+      if (curr->refs > 0)
+        {
+          prev = curr;
+          continue;
+        }
+
+      if (prev)
+        {
+          prev->flink = next;
+        }
+      else
+        {
+          g_rammaps.head = next;
+        }
+
+      g_rammaps.cached -= curr->length;
+      rammap_free(curr);
+    }
+
+  rammap_unlock();
+}
+
 /****************************************************************************
  * Name: rammmap
  *
@@ -101,11 +592,16 @@ void rammap_initialize(void)
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h.
+ *   flags   See the MAP_* definitions in sys/mman.h.
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
  *   value MAP_FAILED is returned, and errno is set  appropriately.
  *
+ *     EACCES
+ *      A writable MAP_SHARED mapping was requested but 'fd' is not open
+ *      for writing.
  *     EBADF
  *      'fd' is not a valid file descriptor.
  *     EINVAL
@@ -115,55 +611,132 @@ void rammap_initialize(void)
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset)
+FAR void *rammap(int fd, size_t length, off_t offset, int prot, int flags)
 {
   FAR struct fs_rammap_s *map;
+  FAR struct file *filep;
   FAR uint8_t *alloc;
   FAR uint8_t *rdbuffer;
+  struct stat buf;
   ssize_t nread;
   off_t fpos;
+  bool writeback;
+  bool shared;
   int errcode;
   int ret;
 
-  /* There is a major design flaw that I have not yet thought of fix for:
-   * The goal is to have a single region of memory that represents a single
-   * file and can be shared by many threads.  That is, given a filename a
-   * thread should be able to open the file, get a file descriptor, and
-   * call mmap() to get a memory region.  Different file descriptors opened
-   * with the same file path should get the same memory region when mapped.
-   *
-   * The design flaw is that I don't have sufficient knowledge to know that
-   * these different file descriptors map to the same file.  So, for the time
-   * being, a new memory region is created each time that rammap() is called.
-   * Not very useful!
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  /* Writable, private mappings get a copy of their own.  All others may
+   * share the region.  Changes to writable, shared mappings are written
+   * back to the file.
+   */
+
+  writeback = (flags & MAP_SHARED) != 0 && (prot & PROT_WRITE) != 0;
+  shared    = (flags & MAP_PRIVATE) == 0 || (prot & PROT_WRITE) == 0;
+
+  if (writeback && (filep->f_oflags & O_WROK) == 0)
+    {
+      errcode = EACCES;
+      goto errout;
+    }
+
+  /* The inode of a mounted file system does not identify the file, the
+   * serial number reported by the file system does.  Regions of files
+   * without one are shared only through the same open file.  The size and
+   * modification time tell whether a copy of the file is still valid if
+   * the file was modified other than through the VFS.
    */
 
-  /* Allocate a region of memory of the specified size */
+  ret = file_fstat(filep, &buf);
+  if (ret < 0 || !INODE_IS_MOUNTPT(filep->f_inode))
+    {
+      memset(&buf, 0, sizeof(struct stat));
+      shared = false;
+    }
+
+  rammap_initialize();
+  ret = rammap_lock();
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  /* Is this part of the file already in memory? */
+
+  if (shared)
+    {
+      map = rammap_find(filep, &buf, length, offset);
+      if (map != NULL)
+        {
+          if (writeback && !map->writeback)
+            {
+              memset(&map->file, 0, sizeof(struct file));
+              ret = file_dup2(filep, &map->file);
+              if (ret < 0)
+                {
+                  errcode = -ret;
+                  goto errout_with_semaphore;
+                }
+
+              map->writeback = true;
+            }
+
+          if (map->refs++ == 0)
+            {
+              g_rammaps.cached -= map->length;
+            }
+
+          rammap_unlock();
+          return map->addr;
+        }
+    }
+
+  /* Allocate a region of memory of the specified size.  Under memory
+   * pressure, give up the cached regions and try again.
+   */
 
   alloc = (FAR uint8_t *)kumm_malloc(sizeof(struct fs_rammap_s) + length);
+  if (!alloc && g_rammaps.cached > 0)
+    {
+      rammap_evict(0);
+      alloc = (FAR uint8_t *)
+        kumm_malloc(sizeof(struct fs_rammap_s) + length);
+    }
+
   if (!alloc)
     {
       ferr("ERROR: Region allocation failed, length: %d\n", (int)length);
       errcode = ENOMEM;
-      goto errout;
+      goto errout_with_semaphore;
     }
 
   /* Initialize the region */
 
-  map         = (FAR struct fs_rammap_s *)alloc;
+  map           = (FAR struct fs_rammap_s *)alloc;
   memset(map, 0, sizeof(struct fs_rammap_s));
-  map->addr   = alloc + sizeof(struct fs_rammap_s);
-  map->length = length;
-  map->offset = offset;
+  map->addr     = alloc + sizeof(struct fs_rammap_s);
+  map->length   = length;
+  map->offset   = offset;
+  map->ino      = buf.st_ino;
+  map->size     = buf.st_size;
+  map->mtime    = buf.st_mtime;
+  map->filep    = buf.st_ino == 0 && shared ? filep : NULL;
+  map->refs     = 1;
+  map->shared   = shared;
 
   /* Seek to the specified file offset */
 
-  fpos = lseek(fd, offset,  SEEK_SET);
-  if (fpos == (off_t)-1)
+  fpos = file_seek(filep, offset, SEEK_SET);
+  if (fpos < 0)
     {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
-       */
+      /* Seek failed... EINVAL is probably the correct response. */
 
       ferr("ERROR: Seek to position %d failed\n", (int)offset);
       errcode = EINVAL;
@@ -175,7 +748,7 @@ FAR void *rammap(int fd, size_t length, off_t offset)
   rdbuffer = map->addr;
   while (length > 0)
     {
-      nread = nx_read(fd, rdbuffer, length);
+      nread = file_read(filep, rdbuffer, length);
       if (nread < 0)
         {
           /* Handle the special case where the read was interrupted by a
@@ -192,6 +765,8 @@ FAR void *rammap(int fd, size_t length, off_t offset)
               errcode = (int)-nread;
               goto errout_with_region;
             }
+
+          continue;
         }
 
       /* Check for end of file. */
@@ -211,25 +786,43 @@ FAR void *rammap(int fd, size_t length, off_t offset)
 
   memset(rdbuffer, 0, length);
 
-  /* Add the buffer to the list of regions */
+  /* Keep a reference to the file and, for write-back, an open file */
 
-  rammap_initialize();
-  ret = nxsem_wait(&g_rammaps.exclsem);
+  ret = inode_addref(filep->f_inode);
   if (ret < 0)
     {
       errcode = -ret;
       goto errout_with_region;
     }
 
-  map->flink  = g_rammaps.head;
-  g_rammaps.head = map;
+  map->inode = filep->f_inode;
 
-  nxsem_post(&g_rammaps.exclsem);
+  if (writeback)
+    {
+      ret = file_dup2(filep, &map->file);
+      if (ret < 0)
+        {
+          inode_release(map->inode);
+          errcode = -ret;
+          goto errout_with_region;
+        }
+
+      map->writeback = true;
+    }
+
+  /* Add the buffer to the list of regions */
+
+  rammap_append(map);
+
+  rammap_unlock();
   return map->addr;
 
 errout_with_region:
   kumm_free(alloc);
 
+errout_with_semaphore:
+  rammap_unlock();
+
 errout:
   set_errno(errcode);
   return MAP_FAILED;
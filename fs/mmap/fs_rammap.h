@@ -45,8 +45,27 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* rammap_modified() is called by the VFS after a file was written,
+ * truncated or opened with O_TRUNC through an open file.  Shared regions
+ * of that file that were read before are then no longer shared.
+ * rammap_closed() is called before an open file is closed.
+ */
+
+#ifndef CONFIG_FS_RAMMAP
+#  define rammap_modified(f)
+#  define rammap_closed(f)
+#endif
+
 #ifdef CONFIG_FS_RAMMAP
 
 /****************************************************************************
@@ -65,9 +84,18 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes to the in-memory image reach the file only through msync() or
+ *   the final munmap() of a writable MAP_SHARED mapping.
  * - There are not access privileges.
+ *
+ * Mappings of the same part of the same file with the same length share
+ * one region unless they are writable and MAP_PRIVATE.  The file is
+ * identified by the inode of the file system and the file serial number.
+ * If the file system does not report serial numbers, only mappings made
+ * through the same open file share a region.  The region is reference
+ * counted.  Shared regions that are no longer mapped are kept up
+ * to CONFIG_FS_RAMMAP_CACHESIZE bytes in total so that mapping the file
+ * again does not read it again.
  */
 
 struct fs_rammap_s
@@ -76,6 +104,16 @@ struct fs_rammap_s
   FAR void           *addr;        /* Start of allocated memory */
   size_t              length;      /* Length of region */
   off_t               offset;      /* File offset */
+  FAR struct inode   *inode;       /* The mapped file */
+  ino_t               ino;         /* File serial number */
+  off_t               size;        /* File size when the region was read */
+  time_t              mtime;       /* File modification time at that time */
+  FAR struct file    *filep;       /* Open file if no serial number */
+  uint16_t            refs;        /* Number of mappings of the region */
+  bool                shared;      /* True: Other mappings may share it */
+  bool                stale;       /* True: The file was modified since */
+  bool                writeback;   /* True: 'file' is open for write-back */
+  struct file         file;        /* Used to write back MAP_SHARED changes */
 };
 
 /* This structure defines all "mapped" files */
@@ -84,7 +122,10 @@ struct fs_allmaps_s
 {
   bool                initialized; /* True: This structure has been initialized */
   sem_t               exclsem;     /* Provides exclusive access the list */
-  struct fs_rammap_s *head;        /* List of mapped files */
+  pid_t               holder;      /* The current holder of exclsem */
+  int16_t             count;       /* Number of counts held */
+  size_t              cached;      /* Total size of unmapped, cached regions */
+  struct fs_rammap_s *head;        /* List of mapped files, oldest first */
 };
 
 /****************************************************************************
@@ -115,6 +156,40 @@ extern struct fs_allmaps_s g_rammaps;
 
 void rammap_initialize(void);
 
+/****************************************************************************
+ * Name: rammap_lock
+ *
+ * Description:
+ *   Get exclusive access to the list of regions.  The lock may be taken
+ *   again by its holder:  Writing a region back to the file calls
+ *   rammap_modified().
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_lock(void);
+
+/****************************************************************************
+ * Name: rammap_unlock
+ *
+ * Description:
+ *   Relinquish exclusive access to the list of regions.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_unlock(void);
+
 /****************************************************************************
  * Name: rammmap
  *
@@ -126,11 +201,16 @@ void rammap_initialize(void);
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h.
+ *   flags   See the MAP_* definitions in sys/mman.h.
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
  *   value MAP_FAILED is returned, and errno is set  appropriately.
  *
+ *     EACCES
+ *      A writable MAP_SHARED mapping was requested but 'fd' is not open
+ *      for writing.
  *     EBADF
  *      'fd' is not a valid file descriptor.
  *     EINVAL
@@ -140,7 +220,82 @@ void rammap_initialize(void);
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset);
+FAR void *rammap(int fd, size_t length, off_t offset, int prot, int flags);
+
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write part of a writable MAP_SHARED region back to the mapped file.
+ *   The caller must hold the lock (rammap_lock()).
+ *
+ * Input Parameters:
+ *   map     The region
+ *   offset  The offset of the part to write into the region
+ *   length  The length of the part to write
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length);
+
+/****************************************************************************
+ * Name: rammap_release
+ *
+ * Description:
+ *   Drop one reference to a region.  When the last mapping is gone, changes
+ *   of a writable MAP_SHARED region are written back.  The region is then
+ *   freed or, if it can be shared, kept in the cache of unmapped regions.
+ *   The caller must hold the lock (rammap_lock()).
+ *
+ * Input Parameters:
+ *   map  The region
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the write-back failed.
+ *   The reference is dropped in any case.
+ *
+ ****************************************************************************/
+
+int rammap_release(FAR struct fs_rammap_s *map);
+
+/****************************************************************************
+ * Name: rammap_modified
+ *
+ * Description:
+ *   Called after the file was modified through the open file 'filep'.
+ *   Regions of the file are no longer shared.  Regions of files that
+ *   cannot be identified are no longer shared if they are on the same
+ *   file system.
+ *
+ * Input Parameters:
+ *   filep  The open file that was used to modify the file
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_modified(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: rammap_closed
+ *
+ * Description:
+ *   Called before the open file 'filep' is closed.  Regions that are
+ *   identified by the open file are no longer shared.
+ *
+ * Input Parameters:
+ *   filep  The open file
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void rammap_closed(FAR struct file *filep);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_RAMMAP_H */
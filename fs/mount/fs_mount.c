@@ -466,6 +466,12 @@ int mount(FAR const char *source, FAR const char *target,
   mountpt_inode->i_mode    = mode;
 #endif
   mountpt_inode->i_private = fshandle;
+
+  /* Paths below the new mountpoint no longer end in the pseudo file
+   * system.
+   */
+
+  inode_cache_invalidate();
   inode_semgive();
 
   /* We can release our reference to the blkdrver_inode, if the filesystem
@@ -82,9 +82,12 @@ extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations inodecache_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations mqueue_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
+extern const struct procfs_operations wqueue_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -148,6 +151,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
 
+#if !defined(CONFIG_DISABLE_MQUEUE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MQUEUE)
+  { "mqueue",        &mqueue_operations,          PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_BLOCKS
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -160,6 +167,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/usage",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_FS_INODE_CACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_INODECACHE)
+  { "fs/inodecache", &inodecache_operations,      PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_FS_SMARTFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
   { "fs/smartfs**",  &smartfs_procfsoperations,   PROCFS_UNKOWN_TYPE },
 #endif
@@ -189,6 +200,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_VERSION)
   { "version",       &version_operations,         PROCFS_FILE_TYPE   },
 #endif
+
+#if defined(CONFIG_WQUEUE_STATISTICS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+  { "wqueue",        &wqueue_operations,          PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
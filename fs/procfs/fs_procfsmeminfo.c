@@ -188,6 +188,46 @@ static void meminfo_progmem(FAR struct progmem_info_s *progmem)
 }
 #endif
 
+/****************************************************************************
+ * Name: meminfo_cache
+ *
+ * Description:
+ *   Generate one line per size class of the small object cache of a heap.
+ *
+ ****************************************************************************/
+
+#ifdef MM_HAVE_CACHE
+static size_t meminfo_cache(FAR struct meminfo_file_s *procfile,
+                            FAR struct mm_heap_s *heap,
+                            FAR const char *name, FAR char *buffer,
+                            size_t buflen, FAR off_t *offset)
+{
+  struct mm_cacheinfo_s info;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize = 0;
+  int ndx;
+
+  for (ndx = 0; ndx < MM_CACHE_NCLASSES && totalsize < buflen; ndx++)
+    {
+      mm_cacheinfo(heap, ndx, &info);
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "%s%4lu:%11lu%11lu%11lu\n", name,
+                            (unsigned long)info.size,
+                            (unsigned long)info.cached,
+                            (unsigned long)info.hits,
+                            (unsigned long)info.misses);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 &buffer[totalsize], buflen - totalsize,
+                                 offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_open
  ****************************************************************************/
@@ -333,6 +373,47 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef MM_HAVE_CACHE
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show small object cache information */
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Cache: %11s%11s%11s\n",
+                            "cached", "hits", "misses");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          copysize   = meminfo_cache(procfile, &g_kmmheap, "Kc", buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+#endif
+
+#ifdef CONFIG_BUILD_FLAT
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          copysize   = meminfo_cache(procfile, &g_mmheap, "Uc", buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+#endif
+    }
+#endif
+
 #ifdef CONFIG_MM_PGALLOC
   if (totalsize < buflen)
     {
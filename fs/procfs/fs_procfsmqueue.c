@@ -0,0 +1,361 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsmqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "inode/inode.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_DISABLE_MQUEUE) && CONFIG_MQ_MAXMSGSIZE > 0 && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MQUEUE_LINELEN 128
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct mqueue_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[MQUEUE_LINELEN];      /* Pre-allocated buffer for the lines */
+};
+
+/* The state of one read while traversing the message queues */
+
+struct mqueue_read_s
+{
+  FAR struct mqueue_file_s *procfile; /* The open "file" */
+  FAR char *buffer;                   /* Remaining user buffer */
+  size_t buflen;                      /* Size of the remaining user buffer */
+  size_t totalsize;                   /* Number of bytes returned */
+  off_t offset;                       /* File offset still to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     mqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     mqueue_close(FAR struct file *filep);
+static ssize_t mqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     mqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     mqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_procfs.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations mqueue_operations =
+{
+  mqueue_open,   /* open */
+  mqueue_close,  /* close */
+  mqueue_read,   /* read */
+  NULL,          /* write */
+  mqueue_dup,    /* dup */
+  NULL,          /* opendir */
+  NULL,          /* closedir */
+  NULL,          /* readdir */
+  NULL,          /* rewinddir */
+  mqueue_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mqueue_copyline
+ *
+ * Description:
+ *   Copy one formatted line to the user buffer.
+ *
+ ****************************************************************************/
+
+static void mqueue_copyline(FAR struct mqueue_read_s *info, size_t linesize)
+{
+  size_t copysize;
+
+  if (linesize >= MQUEUE_LINELEN)
+    {
+      linesize = MQUEUE_LINELEN - 1;
+    }
+
+  copysize         = procfs_memcpy(info->procfile->line, linesize,
+                                   info->buffer, info->buflen,
+                                   &info->offset);
+  info->buffer    += copysize;
+  info->buflen    -= copysize;
+  info->totalsize += copysize;
+}
+
+/****************************************************************************
+ * Name: mqueue_callback
+ *
+ * Description:
+ *   Format one line for each message queue inode.
+ *
+ ****************************************************************************/
+
+static int mqueue_callback(FAR struct inode *node, FAR char dirpath[PATH_MAX],
+                           FAR void *arg)
+{
+  FAR struct mqueue_read_s *info = (FAR struct mqueue_read_s *)arg;
+  FAR struct mqueue_inode_s *msgq;
+  size_t linesize;
+
+  if (!INODE_IS_MQUEUE(node) || node->u.i_mqueue == NULL)
+    {
+      return 0;
+    }
+
+  /* Stop once the user buffer is full */
+
+  if (info->buflen == 0)
+    {
+      return 1;
+    }
+
+  /* The counts are sampled without locking; they are only statistics */
+
+  msgq     = node->u.i_mqueue;
+  linesize = snprintf(info->procfile->line, MQUEUE_LINELEN,
+                      "%5d %5d %5d %6u %9lu %9lu %s/%s\n",
+                      msgq->nmsgs, msgq->maxmsgs, msgq->peakmsgs,
+                      (unsigned int)msgq->maxmsgsize,
+                      (unsigned long)msgq->nbytes,
+                      (unsigned long)msgq->peakbytes,
+                      dirpath, node->i_name);
+
+  mqueue_copyline(info, linesize);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mqueue_open
+ ****************************************************************************/
+
+static int mqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct mqueue_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "mqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct mqueue_file_s *)
+    kmm_zalloc(sizeof(struct mqueue_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mqueue_close
+ ****************************************************************************/
+
+static int mqueue_close(FAR struct file *filep)
+{
+  FAR struct mqueue_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct mqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mqueue_read
+ ****************************************************************************/
+
+static ssize_t mqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  struct mqueue_read_s info;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  info.procfile  = (FAR struct mqueue_file_s *)filep->f_priv;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.totalsize = 0;
+  info.offset    = filep->f_pos;
+  DEBUGASSERT(info.procfile);
+
+  /* The first line is the headers */
+
+  linesize = snprintf(info.procfile->line, MQUEUE_LINELEN,
+                      " MSGS   MAX  PEAK MSGSIZE    BYTES PEAKBYTES "
+                      "NAME\n");
+  mqueue_copyline(&info, linesize);
+
+  /* Followed by one line per message queue */
+
+  foreach_inode(mqueue_callback, &info);
+
+  /* Update the file offset */
+
+  filep->f_pos += info.totalsize;
+  return info.totalsize;
+}
+
+/****************************************************************************
+ * Name: mqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int mqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct mqueue_file_s *oldattr;
+  FAR struct mqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct mqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct mqueue_file_s *)
+    kmm_malloc(sizeof(struct mqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct mqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int mqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "mqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "mqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_DISABLE_MQUEUE && !CONFIG_FS_PROCFS_EXCLUDE_MQUEUE */
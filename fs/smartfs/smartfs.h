@@ -319,6 +319,12 @@ struct smartfs_ofile_s
                                            */
 };
 
+/* In-RAM index of the entries of a directory (see smartfs_dirindex.c) */
+
+#ifdef CONFIG_SMARTFS_DIRINDEX
+struct smartfs_dirindex_s;
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a smartfs filesystem.
@@ -337,6 +343,11 @@ struct smartfs_mountpt_s
   char                       *fs_rwbuffer;   /* Read/Write working buffer */
   char                       *fs_workbuffer; /* Working buffer */
   uint8_t                     fs_rootsector; /* Root directory sector num */
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  FAR struct smartfs_dirindex_s *fs_dirindex; /* Directory indexes, MRU first */
+  FAR char                   *fs_dirbuffer;  /* Directory sector for readdir */
+  uint16_t                    fs_dirsector;  /* Sector held in fs_dirbuffer */
+#endif
 };
 
 /****************************************************************************
@@ -390,6 +401,27 @@ int smartfs_shrinkfile(FAR struct smartfs_mountpt_s *fs,
 int smartfs_extendfile(FAR struct smartfs_mountpt_s *fs,
         FAR struct smartfs_ofile_s *sf, off_t length);
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+int smartfs_dirindex_lookup(FAR struct smartfs_mountpt_s *fs,
+        uint16_t dirsector, FAR const char *name, FAR uint16_t *dsector);
+
+void smartfs_dirindex_add(FAR struct smartfs_mountpt_s *fs,
+        uint16_t dirsector, uint16_t dsector, uint16_t doffset,
+        FAR const char *name);
+
+void smartfs_dirindex_remove(FAR struct smartfs_mountpt_s *fs,
+        uint16_t dirsector, uint16_t dsector, uint16_t doffset,
+        FAR const char *name);
+
+void smartfs_dirindex_drop(FAR struct smartfs_mountpt_s *fs,
+        uint16_t dirsector);
+
+void smartfs_dirindex_free(FAR struct smartfs_mountpt_s *fs);
+
+int smartfs_dirindex_read(FAR struct smartfs_mountpt_s *fs,
+        uint16_t sector, FAR char **buffer);
+#endif
+
 uint16_t smartfs_rdle16(FAR const void *val);
 
 void smartfs_wrle16(void *dest, uint16_t val);
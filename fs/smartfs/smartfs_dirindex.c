@@ -0,0 +1,658 @@
+/****************************************************************************
+ * fs/smartfs/smartfs_dirindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_DIRINDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SMARTFS_DIRINDEX_NDIRS
+#  define CONFIG_SMARTFS_DIRINDEX_NDIRS 4
+#endif
+
+/* Hash values 0 and 1 mark empty and deleted slots */
+
+#define DIRINDEX_EMPTY      0
+#define DIRINDEX_DELETED    1
+
+#define DIRINDEX_MINSLOTS   16
+#define DIRINDEX_MAXSLOTS   32768
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One slot of the open addressed hash table */
+
+struct smartfs_dirslot_s
+{
+  uint16_t          hash;         /* Name hash, or EMPTY / DELETED */
+  uint16_t          dsector;      /* Sector holding the directory entry */
+  uint16_t          doffset;      /* Offset of the directory entry */
+};
+
+/* The index of one directory */
+
+struct smartfs_dirindex_s
+{
+  FAR struct smartfs_dirindex_s *next;   /* Next index, in MRU order */
+  FAR struct smartfs_dirslot_s  *slots;  /* Hash table */
+  uint16_t          dirsector;    /* First sector of the directory */
+  uint16_t          nslots;       /* Number of slots, a power of two */
+  uint16_t          nentries;     /* Number of entries in the table */
+  uint16_t          nused;        /* Number of entries and deleted slots */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dirhash
+ *
+ * Description: Hash an entry name the same way as it is compared, i.e. no
+ *   more than namesize characters.
+ *
+ ****************************************************************************/
+
+static uint16_t smartfs_dirhash(FAR struct smartfs_mountpt_s *fs,
+                                FAR const char *name)
+{
+  uint32_t hash = 2166136261ul;
+  int i;
+
+  for (i = 0; i < fs->fs_llformat.namesize && name[i] != '\0'; i++)
+    {
+      hash ^= (uint8_t)name[i];
+      hash *= 16777619ul;
+    }
+
+  hash = (hash ^ (hash >> 16)) & 0xffff;
+  return hash <= DIRINDEX_DELETED ? hash + 2 : hash;
+}
+
+/****************************************************************************
+ * Name: smartfs_direntactive
+ *
+ * Description: Test if a directory entry is valid and active
+ *
+ ****************************************************************************/
+
+static bool smartfs_direntactive(FAR struct smartfs_entry_header_s *entry)
+{
+  uint16_t flags;
+
+#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
+  flags = smartfs_rdle16(&entry->flags);
+#else
+  flags = entry->flags;
+#endif
+
+  return (flags & SMARTFS_DIRENT_EMPTY) !=
+         (SMARTFS_ERASEDSTATE_16BIT & SMARTFS_DIRENT_EMPTY) &&
+         (flags & SMARTFS_DIRENT_ACTIVE) ==
+         (SMARTFS_ERASEDSTATE_16BIT & SMARTFS_DIRENT_ACTIVE);
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_place
+ *
+ * Description: Put an entry in the first free slot of its probe sequence
+ *
+ ****************************************************************************/
+
+static void smartfs_dirindex_place(FAR struct smartfs_dirindex_s *index,
+                                   uint16_t hash, uint16_t dsector,
+                                   uint16_t doffset)
+{
+  FAR struct smartfs_dirslot_s *slot;
+  uint16_t mask = index->nslots - 1;
+  uint16_t i = hash & mask;
+
+  while (index->slots[i].hash > DIRINDEX_DELETED)
+    {
+      i = (i + 1) & mask;
+    }
+
+  slot = &index->slots[i];
+  if (slot->hash == DIRINDEX_EMPTY)
+    {
+      index->nused++;
+    }
+
+  slot->hash    = hash;
+  slot->dsector = dsector;
+  slot->doffset = doffset;
+  index->nentries++;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_resize
+ *
+ * Description: Rehash the table into nslots slots.  This also drops the
+ *   deleted slots.
+ *
+ ****************************************************************************/
+
+static int smartfs_dirindex_resize(FAR struct smartfs_dirindex_s *index,
+                                   uint32_t nslots)
+{
+  FAR struct smartfs_dirslot_s *oldslots = index->slots;
+  uint16_t oldnslots = index->nslots;
+  uint16_t i;
+
+  if (nslots > DIRINDEX_MAXSLOTS)
+    {
+      return -ENOMEM;
+    }
+
+  index->slots = (FAR struct smartfs_dirslot_s *)
+    kmm_zalloc(nslots * sizeof(struct smartfs_dirslot_s));
+  if (index->slots == NULL)
+    {
+      index->slots = oldslots;
+      return -ENOMEM;
+    }
+
+  index->nslots   = nslots;
+  index->nentries = 0;
+  index->nused    = 0;
+
+  for (i = 0; i < oldnslots; i++)
+    {
+      if (oldslots[i].hash > DIRINDEX_DELETED)
+        {
+          smartfs_dirindex_place(index, oldslots[i].hash,
+                                 oldslots[i].dsector, oldslots[i].doffset);
+        }
+    }
+
+  kmm_free(oldslots);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_insert
+ *
+ * Description: Add an entry to the index, keeping the load of the table
+ *   below 3/4 so that a probe sequence always ends at an empty slot.
+ *
+ ****************************************************************************/
+
+static int smartfs_dirindex_insert(FAR struct smartfs_dirindex_s *index,
+                                   uint16_t hash, uint16_t dsector,
+                                   uint16_t doffset)
+{
+  uint32_t nslots;
+  int ret;
+
+  if (((uint32_t)index->nused + 1) * 4 > (uint32_t)index->nslots * 3)
+    {
+      /* Grow the table, unless it is mostly deleted slots */
+
+      nslots = index->nslots;
+      if (((uint32_t)index->nentries + 1) * 2 > nslots)
+        {
+          nslots <<= 1;
+        }
+
+      ret = smartfs_dirindex_resize(index, nslots);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  smartfs_dirindex_place(index, hash, dsector, doffset);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_find
+ *
+ * Description: Find the index of a directory and move it to the head of
+ *   the list.
+ *
+ ****************************************************************************/
+
+static FAR struct smartfs_dirindex_s *
+smartfs_dirindex_find(FAR struct smartfs_mountpt_s *fs, uint16_t dirsector)
+{
+  FAR struct smartfs_dirindex_s *index;
+  FAR struct smartfs_dirindex_s *prev = NULL;
+
+  for (index = fs->fs_dirindex; index != NULL; index = index->next)
+    {
+      if (index->dirsector == dirsector)
+        {
+          if (prev != NULL)
+            {
+              prev->next = index->next;
+              index->next = fs->fs_dirindex;
+              fs->fs_dirindex = index;
+            }
+
+          return index;
+        }
+
+      prev = index;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_release
+ ****************************************************************************/
+
+static void smartfs_dirindex_release(FAR struct smartfs_dirindex_s *index)
+{
+  kmm_free(index->slots);
+  kmm_free(index);
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_build
+ *
+ * Description: Read the sector chain of a directory and index all of its
+ *   active entries.  The least recently used index is released if there
+ *   are too many.
+ *
+ ****************************************************************************/
+
+static int smartfs_dirindex_build(FAR struct smartfs_mountpt_s *fs,
+                                  uint16_t dirsector,
+                                  FAR struct smartfs_dirindex_s **result)
+{
+  FAR struct smartfs_dirindex_s *index;
+  FAR struct smartfs_dirindex_s *victim;
+  FAR struct smartfs_dirindex_s **pprev;
+  FAR struct smartfs_chain_header_s *header;
+  FAR struct smartfs_entry_header_s *entry;
+  struct smart_read_write_s readwrite;
+  uint16_t entrysize;
+  uint16_t offset;
+  uint16_t sector;
+  uint16_t nsectors = 0;
+  int count = 0;
+  int ret;
+
+  index = (FAR struct smartfs_dirindex_s *)
+    kmm_zalloc(sizeof(struct smartfs_dirindex_s));
+  if (index == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  index->dirsector = dirsector;
+  ret = smartfs_dirindex_resize(index, DIRINDEX_MINSLOTS);
+  if (ret < 0)
+    {
+      kmm_free(index);
+      return ret;
+    }
+
+  entrysize = sizeof(struct smartfs_entry_header_s) +
+              fs->fs_llformat.namesize;
+  header    = (FAR struct smartfs_chain_header_s *)fs->fs_rwbuffer;
+  sector    = dirsector;
+
+  while (sector != SMARTFS_ERASEDSTATE_16BIT)
+    {
+      /* Guard against a looped chain */
+
+      if (++nsectors > fs->fs_llformat.nsectors)
+        {
+          ret = -EIO;
+          goto errout;
+        }
+
+      readwrite.logsector = sector;
+      readwrite.count     = fs->fs_llformat.availbytes;
+      readwrite.buffer    = (FAR uint8_t *)fs->fs_rwbuffer;
+      readwrite.offset    = 0;
+      ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      for (offset = sizeof(struct smartfs_chain_header_s);
+           offset + entrysize < readwrite.count;
+           offset += entrysize)
+        {
+          entry = (FAR struct smartfs_entry_header_s *)
+            &fs->fs_rwbuffer[offset];
+          if (smartfs_direntactive(entry))
+            {
+              ret = smartfs_dirindex_insert(index,
+                                            smartfs_dirhash(fs, entry->name),
+                                            sector, offset);
+              if (ret < 0)
+                {
+                  goto errout;
+                }
+            }
+        }
+
+      sector = SMARTFS_NEXTSECTOR(header);
+    }
+
+  /* Make room for the new index and add it at the head of the list */
+
+  pprev = &fs->fs_dirindex;
+  while (*pprev != NULL && ++count < CONFIG_SMARTFS_DIRINDEX_NDIRS)
+    {
+      pprev = &(*pprev)->next;
+    }
+
+  while (*pprev != NULL)
+    {
+      victim = *pprev;
+      *pprev = victim->next;
+      smartfs_dirindex_release(victim);
+    }
+
+  index->next = fs->fs_dirindex;
+  fs->fs_dirindex = index;
+  *result = index;
+  return OK;
+
+errout:
+  smartfs_dirindex_release(index);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dirindex_lookup
+ *
+ * Description: Find the sector of the directory chain starting at
+ *   dirsector that holds the active entry called name.  The index of the
+ *   directory is built on first use.  Candidates are verified on the media,
+ *   so that a hash collision never reports the wrong entry.
+ *
+ * Returned Value:
+ *   OK if the entry was found, -ENOENT if the directory holds no such
+ *   entry, or another negated errno value if the index is not available
+ *   and the caller must search the directory itself.
+ *
+ ****************************************************************************/
+
+int smartfs_dirindex_lookup(FAR struct smartfs_mountpt_s *fs,
+                            uint16_t dirsector, FAR const char *name,
+                            FAR uint16_t *dsector)
+{
+  FAR struct smartfs_dirindex_s *index;
+  FAR struct smartfs_dirslot_s *slot;
+  FAR struct smartfs_entry_header_s *entry;
+  struct smart_read_write_s readwrite;
+  uint16_t hash;
+  uint16_t mask;
+  uint16_t i;
+  int ret;
+
+  index = smartfs_dirindex_find(fs, dirsector);
+  if (index == NULL)
+    {
+      ret = smartfs_dirindex_build(fs, dirsector, &index);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  hash  = smartfs_dirhash(fs, name);
+  mask  = index->nslots - 1;
+  entry = (FAR struct smartfs_entry_header_s *)fs->fs_rwbuffer;
+
+  for (i = hash & mask; index->slots[i].hash != DIRINDEX_EMPTY;
+       i = (i + 1) & mask)
+    {
+      slot = &index->slots[i];
+      if (slot->hash != hash)
+        {
+          continue;
+        }
+
+      readwrite.logsector = slot->dsector;
+      readwrite.offset    = slot->doffset;
+      readwrite.count     = sizeof(struct smartfs_entry_header_s) +
+                            fs->fs_llformat.namesize;
+      readwrite.buffer    = (FAR uint8_t *)fs->fs_rwbuffer;
+      ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (smartfs_direntactive(entry) &&
+          strncmp(entry->name, name, fs->fs_llformat.namesize) == 0)
+        {
+          *dsector = slot->dsector;
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_add
+ *
+ * Description: Record an entry created in the directory starting at
+ *   dirsector.  Nothing is done if the directory is not indexed.
+ *
+ ****************************************************************************/
+
+void smartfs_dirindex_add(FAR struct smartfs_mountpt_s *fs,
+                          uint16_t dirsector, uint16_t dsector,
+                          uint16_t doffset, FAR const char *name)
+{
+  FAR struct smartfs_dirindex_s *index;
+
+  fs->fs_dirsector = SMARTFS_ERASEDSTATE_16BIT;
+
+  index = smartfs_dirindex_find(fs, dirsector);
+  if (index != NULL &&
+      smartfs_dirindex_insert(index, smartfs_dirhash(fs, name),
+                              dsector, doffset) < 0)
+    {
+      smartfs_dirindex_drop(fs, dirsector);
+    }
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_remove
+ *
+ * Description: Forget an entry removed from the directory starting at
+ *   dirsector.
+ *
+ ****************************************************************************/
+
+void smartfs_dirindex_remove(FAR struct smartfs_mountpt_s *fs,
+                             uint16_t dirsector, uint16_t dsector,
+                             uint16_t doffset, FAR const char *name)
+{
+  FAR struct smartfs_dirindex_s *index;
+  FAR struct smartfs_dirslot_s *slot;
+  uint16_t hash;
+  uint16_t mask;
+  uint16_t i;
+
+  fs->fs_dirsector = SMARTFS_ERASEDSTATE_16BIT;
+
+  index = smartfs_dirindex_find(fs, dirsector);
+  if (index == NULL)
+    {
+      return;
+    }
+
+  if (name == NULL)
+    {
+      smartfs_dirindex_drop(fs, dirsector);
+      return;
+    }
+
+  hash = smartfs_dirhash(fs, name);
+  mask = index->nslots - 1;
+
+  for (i = hash & mask; index->slots[i].hash != DIRINDEX_EMPTY;
+       i = (i + 1) & mask)
+    {
+      slot = &index->slots[i];
+      if (slot->hash == hash && slot->dsector == dsector &&
+          slot->doffset == doffset)
+        {
+          slot->hash = DIRINDEX_DELETED;
+          index->nentries--;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_drop
+ *
+ * Description: Release the index of the directory starting at dirsector,
+ *   e.g. because the directory was deleted.
+ *
+ ****************************************************************************/
+
+void smartfs_dirindex_drop(FAR struct smartfs_mountpt_s *fs,
+                           uint16_t dirsector)
+{
+  FAR struct smartfs_dirindex_s **pprev;
+  FAR struct smartfs_dirindex_s *index;
+
+  fs->fs_dirsector = SMARTFS_ERASEDSTATE_16BIT;
+
+  for (pprev = &fs->fs_dirindex; *pprev != NULL; pprev = &(*pprev)->next)
+    {
+      index = *pprev;
+      if (index->dirsector == dirsector)
+        {
+          *pprev = index->next;
+          smartfs_dirindex_release(index);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_free
+ *
+ * Description: Release all directory indexes and the readdir buffer of a
+ *   mountpoint.
+ *
+ ****************************************************************************/
+
+void smartfs_dirindex_free(FAR struct smartfs_mountpt_s *fs)
+{
+  FAR struct smartfs_dirindex_s *index;
+
+  while ((index = fs->fs_dirindex) != NULL)
+    {
+      fs->fs_dirindex = index->next;
+      smartfs_dirindex_release(index);
+    }
+
+  if (fs->fs_dirbuffer != NULL)
+    {
+      kmm_free(fs->fs_dirbuffer);
+      fs->fs_dirbuffer = NULL;
+    }
+
+  fs->fs_dirsector = SMARTFS_ERASEDSTATE_16BIT;
+}
+
+/****************************************************************************
+ * Name: smartfs_dirindex_read
+ *
+ * Description: Read a directory sector for readdir.  The sector is kept in
+ *   a buffer of its own, so that it is read only once while its entries are
+ *   returned one at a time.  Any change to a directory invalidates the
+ *   buffer.
+ *
+ * Returned Value:
+ *   The number of bytes read, or a negated errno value.  *buffer is set to
+ *   the buffer holding the sector.
+ *
+ ****************************************************************************/
+
+int smartfs_dirindex_read(FAR struct smartfs_mountpt_s *fs,
+                          uint16_t sector, FAR char **buffer)
+{
+  struct smart_read_write_s readwrite;
+  int ret;
+
+  if (fs->fs_dirbuffer == NULL)
+    {
+      fs->fs_dirbuffer = (FAR char *)
+        kmm_malloc(fs->fs_llformat.availbytes);
+      fs->fs_dirsector = SMARTFS_ERASEDSTATE_16BIT;
+    }
+
+  if (fs->fs_dirbuffer != NULL && fs->fs_dirsector == sector)
+    {
+      *buffer = fs->fs_dirbuffer;
+      return fs->fs_llformat.availbytes;
+    }
+
+  *buffer = fs->fs_dirbuffer != NULL ? fs->fs_dirbuffer : fs->fs_rwbuffer;
+
+  readwrite.logsector = sector;
+  readwrite.count     = fs->fs_llformat.availbytes;
+  readwrite.buffer    = (FAR uint8_t *)*buffer;
+  readwrite.offset    = 0;
+  ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+
+  if (fs->fs_dirbuffer != NULL)
+    {
+      fs->fs_dirsector = ret < 0 ? SMARTFS_ERASEDSTATE_16BIT : sector;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SMARTFS_DIRINDEX */
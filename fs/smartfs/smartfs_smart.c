@@ -1287,8 +1287,11 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
   uint16_t              entrysize;
   uint16_t              namelen;
   struct                smartfs_chain_header_s *header;
+#ifndef CONFIG_SMARTFS_DIRINDEX
   struct                smart_read_write_s readwrite;
+#endif
   struct                smartfs_entry_header_s *entry;
+  FAR char             *buffer;
 
   /* Sanity checks */
 
@@ -1314,11 +1317,17 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
     {
       /* Read the logical sector */
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+      ret = smartfs_dirindex_read(fs, dir->u.smartfs.fs_currsector,
+                                  &buffer);
+#else
+      buffer = fs->fs_rwbuffer;
       readwrite.logsector = dir->u.smartfs.fs_currsector;
       readwrite.count = fs->fs_llformat.availbytes;
-      readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
+      readwrite.buffer = (uint8_t *)buffer;
       readwrite.offset = 0;
       ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long) &readwrite);
+#endif
       if (ret < 0)
         {
           goto errout_with_semaphore;
@@ -1330,7 +1339,7 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
         {
           /* Point to next entry */
 
-          entry = (struct smartfs_entry_header_s *) &fs->fs_rwbuffer[
+          entry = (struct smartfs_entry_header_s *) &buffer[
             dir->u.smartfs.fs_curroffset];
 
           /* Test if this entry is valid and active */
@@ -1344,7 +1353,7 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
 
               dir->u.smartfs.fs_curroffset += entrysize;
               entry = (struct smartfs_entry_header_s *)
-                &fs->fs_rwbuffer[dir->u.smartfs.fs_curroffset];
+                &buffer[dir->u.smartfs.fs_curroffset];
 
               continue;
             }
@@ -1382,7 +1391,7 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
 
               dir->u.smartfs.fs_curroffset =
                 sizeof(struct smartfs_chain_header_s);
-              header = (struct smartfs_chain_header_s *) fs->fs_rwbuffer;
+              header = (struct smartfs_chain_header_s *) buffer;
               dir->u.smartfs.fs_currsector = SMARTFS_NEXTSECTOR(header);
             }
 
@@ -1397,7 +1406,7 @@ static int smartfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
        * done and will report ENOENT.
        */
 
-      header = (struct smartfs_chain_header_s *) fs->fs_rwbuffer;
+      header = (struct smartfs_chain_header_s *) buffer;
       dir->u.smartfs.fs_curroffset = sizeof(struct smartfs_chain_header_s);
       dir->u.smartfs.fs_currsector = SMARTFS_NEXTSECTOR(header);
     }
@@ -1984,8 +1993,16 @@ int smartfs_rename(struct inode *mountpt, const char *oldrelpath,
         {
           ferr("ERROR: Error %d writing flag bytes for sector %d\n",
                ret, readwrite.logsector);
+#ifdef CONFIG_SMARTFS_DIRINDEX
+          smartfs_dirindex_drop(fs, oldentry.dfirst);
+#endif
           goto errout_with_semaphore;
         }
+
+#ifdef CONFIG_SMARTFS_DIRINDEX
+      smartfs_dirindex_remove(fs, oldentry.dfirst, oldentry.dsector,
+                              oldentry.doffset, oldentry.name);
+#endif
     }
   else
     {
@@ -346,6 +346,10 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
   int           found = FALSE;
 #endif
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  smartfs_dirindex_free(fs);
+#endif
+
 #if defined(CONFIG_SMARTFS_MULTI_ROOT_DIRS) || \
   (defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS))
   /* Start at the head of the mounts and search for our entry.  Also
@@ -591,6 +595,21 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs,
 
           offset = 0xffff;
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+          /* Ask the directory index which sector of the chain holds the
+           * entry so that only that sector is searched.  If there is no
+           * index, search the whole chain.
+           */
+
+          ret = smartfs_dirindex_lookup(fs, dirsector, fs->fs_workbuffer,
+                                        &dirsector);
+          if (ret == -ENOENT)
+            {
+              dirsector = SMARTFS_ERASEDSTATE_16BIT;
+              readwrite.count = 0;
+            }
+#endif
+
 #if CONFIG_SMARTFS_ERASEDSTATE == 0xff
           while (dirsector != 0xffff)
 #else
@@ -1111,9 +1130,22 @@ int smartfs_createentry(FAR struct smartfs_mountpt_s *fs,
   memset(direntry->name, 0, fs->fs_llformat.namesize + 1);
   strncpy(direntry->name, filename, fs->fs_llformat.namesize);
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  smartfs_dirindex_add(fs, parentdirsector, psector, offset, filename);
+#endif
+
   ret = OK;
 
 errout:
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  if (ret < 0)
+    {
+      /* The directory may have been partially updated */
+
+      smartfs_dirindex_drop(fs, parentdirsector);
+    }
+#endif
+
   return ret;
 }
 
@@ -1154,6 +1186,13 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs,
    *        bytes of the buffer to read in header info.
    */
 
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  if ((entry->flags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_DIR)
+    {
+      smartfs_dirindex_drop(fs, entry->firstsector);
+    }
+#endif
+
   nextsector = entry->firstsector;
   header = (struct smartfs_chain_header_s *) fs->fs_rwbuffer;
   readwrite.offset = 0;
@@ -1340,6 +1379,18 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs,
   ret = OK;
 
 errout:
+#ifdef CONFIG_SMARTFS_DIRINDEX
+  if (ret < 0)
+    {
+      smartfs_dirindex_drop(fs, entry->dfirst);
+    }
+  else
+    {
+      smartfs_dirindex_remove(fs, entry->dfirst, entry->dsector,
+                              entry->doffset, entry->name);
+    }
+#endif
+
   return ret;
 }
 
@@ -51,10 +51,21 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#if (CONFIG_FS_TMPFS_PAGESIZE & (CONFIG_FS_TMPFS_PAGESIZE - 1)) != 0
+#  error CONFIG_FS_TMPFS_PAGESIZE must be a power of two
 #endif
 
+/* File pages */
+
+#define TMPFS_PAGESIZE      CONFIG_FS_TMPFS_PAGESIZE
+#define TMPFS_PAGENO(pos)   ((size_t)(pos) / TMPFS_PAGESIZE)
+#define TMPFS_PAGEOFF(pos)  ((size_t)(pos) & (TMPFS_PAGESIZE - 1))
+#define TMPFS_NPAGES(size)  (((size) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+
+/* The minimum number of entries in a page table */
+
+#define TMPFS_MINPAGES      4
+
 #define tmpfs_lock_file(tfo) \
            (tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -78,8 +89,16 @@ static int  tmpfs_lock_object(FAR struct tmpfs_object_s *to);
 static void tmpfs_unlock_object(FAR struct tmpfs_object_s *to);
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
               unsigned int nentries);
-static int  tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+static int  tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo,
+              size_t npages);
+static FAR uint8_t *tmpfs_file_page(FAR struct tmpfs_file_s *tfo,
+              size_t pageno, bool alloc);
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first);
+static void tmpfs_truncate_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static int  tmpfs_map_file(FAR struct tmpfs_file_s *tfo,
+              FAR void **mapped);
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -350,74 +369,287 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 }
 
 /****************************************************************************
- * Name: tmpfs_realloc_file
+ * Name: tmpfs_grow_pagetable
+ *
+ * Description:
+ *   Make room for at least 'npages' entries in the page table of the file.
+ *   The table grows geometrically so that appending to a file is done in
+ *   constant amortized time.
+ *
  ****************************************************************************/
 
-static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
-                              size_t newsize)
+static int tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo, size_t npages)
 {
-  FAR struct tmpfs_file_s *oldtfo = *tfo;
-  FAR struct tmpfs_file_s *newtfo;
-  size_t objsize;
-  size_t allocsize;
-  size_t delta;
+  FAR uint8_t **pages;
+  size_t newpages;
+
+  if (npages <= tfo->tfo_npages)
+    {
+      return OK;
+    }
+
+  newpages = tfo->tfo_npages < TMPFS_MINPAGES ?
+             TMPFS_MINPAGES : 2 * tfo->tfo_npages;
+  if (newpages < npages)
+    {
+      newpages = npages;
+    }
+
+  pages = (FAR uint8_t **)
+    kmm_realloc(tfo->tfo_pages, newpages * sizeof(FAR uint8_t *));
+  if (pages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The new entries are holes */
+
+  memset(&pages[tfo->tfo_npages], 0,
+         (newpages - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_alloc += (newpages - tfo->tfo_npages) * sizeof(FAR uint8_t *);
+  tfo->tfo_pages  = pages;
+  tfo->tfo_npages = newpages;
+  return OK;
+}
 
-  /* Check if the current allocation is sufficient */
+/****************************************************************************
+ * Name: tmpfs_file_page
+ *
+ * Description:
+ *   Return the page 'pageno' of the file.  If the page is a hole, return
+ *   NULL or, if 'alloc' is true, allocate a new zeroed page for it.
+ *
+ ****************************************************************************/
 
-  objsize = SIZEOF_TMPFS_FILE(newsize);
+static FAR uint8_t *tmpfs_file_page(FAR struct tmpfs_file_s *tfo,
+                                    size_t pageno, bool alloc)
+{
+  FAR uint8_t *page;
 
-  /* Are we growing or shrinking the object? */
+  if (pageno < tfo->tfo_npages && tfo->tfo_pages[pageno] != NULL)
+    {
+      return tfo->tfo_pages[pageno];
+    }
 
-  if (objsize <= oldtfo->tfo_alloc)
+  if (!alloc || tmpfs_grow_pagetable(tfo, pageno + 1) < 0)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
-       */
+      return NULL;
+    }
+
+  page = (FAR uint8_t *)kmm_zalloc(TMPFS_PAGESIZE);
+  if (page != NULL)
+    {
+      tfo->tfo_pages[pageno] = page;
+      tfo->tfo_alloc        += TMPFS_PAGESIZE;
+    }
+
+  return page;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_pages
+ *
+ * Description:
+ *   Free all pages of the file from page 'first' on.  The page table
+ *   itself is freed when no page remains.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first)
+{
+  FAR uint8_t *block;
+  size_t i;
 
-      if (newsize > 0)
+  for (i = first; i < tfo->tfo_npages; i++)
+    {
+      if (tfo->tfo_pages[i] != NULL)
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
+          /* Pages in the mapped block are freed with the block */
+
+          if (i >= tfo->tfo_nblock)
+            {
+              kmm_free(tfo->tfo_pages[i]);
+            }
+
+          tfo->tfo_pages[i] = NULL;
+          tfo->tfo_alloc   -= TMPFS_PAGESIZE;
+        }
+    }
+
+  if (first < tfo->tfo_nblock)
+    {
+      if (first == 0)
+        {
+          kmm_free(tfo->tfo_block);
+          tfo->tfo_block = NULL;
+        }
+      else
+        {
+          /* Give back the tail of the block.  This is normally done in
+           * place, but the pages are re-addressed in case it is not.
            */
 
-          delta = oldtfo->tfo_alloc - objsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
+          block = (FAR uint8_t *)
+            kmm_realloc(tfo->tfo_block, first * TMPFS_PAGESIZE);
+          if (block != NULL)
             {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+              tfo->tfo_block = block;
+              for (i = 0; i < first; i++)
+                {
+                  tfo->tfo_pages[i] = &block[i * TMPFS_PAGESIZE];
+                }
+            }
+        }
+
+      tfo->tfo_nblock = first;
+    }
+
+  if (first == 0 && tfo->tfo_pages != NULL)
+    {
+      kmm_free(tfo->tfo_pages);
+      tfo->tfo_alloc -= tfo->tfo_npages * sizeof(FAR uint8_t *);
+      tfo->tfo_pages  = NULL;
+      tfo->tfo_npages = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_truncate_file
+ *
+ * Description:
+ *   Change the size of the file.  Growing the file only adds a hole;
+ *   shrinking it frees the pages beyond the new end of the file.
+ *
+ ****************************************************************************/
+
+static void tmpfs_truncate_file(FAR struct tmpfs_file_s *tfo,
+                                size_t newsize)
+{
+  FAR uint8_t *page;
+  size_t npages;
+  size_t offset;
+
+  if (newsize < tfo->tfo_size)
+    {
+      npages = TMPFS_NPAGES(newsize);
+      tmpfs_free_pages(tfo, npages);
 
-              oldtfo->tfo_size = newsize;
-              return OK;
+      /* Data beyond the end of the file must read as zero if the file
+       * grows again.
+       */
+
+      offset = TMPFS_PAGEOFF(newsize);
+      if (offset > 0)
+        {
+          page = tmpfs_file_page(tfo, npages - 1, false);
+          if (page != NULL)
+            {
+              memset(&page[offset], 0, TMPFS_PAGESIZE - offset);
             }
         }
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
+  tfo->tfo_size = newsize;
+}
 
-  allocsize = objsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+/****************************************************************************
+ * Name: tmpfs_map_file
+ *
+ * Description:
+ *   Return the address of the file contents in contiguous memory.  If the
+ *   pages of the file are not contiguous already, they are gathered into
+ *   one page-aligned block that then backs the file.
+ *
+ ****************************************************************************/
 
-  /* Realloc the file object */
+static int tmpfs_map_file(FAR struct tmpfs_file_s *tfo, FAR void **mapped)
+{
+  FAR uint8_t *block;
+  FAR uint8_t *page;
+  size_t npages;
+  size_t i;
+  int ret;
 
-  newtfo = (FAR struct tmpfs_file_s *)kmm_realloc(oldtfo, allocsize);
-  if (newtfo == NULL)
+  npages = TMPFS_NPAGES(tfo->tfo_size);
+  if (npages == 0)
+    {
+      npages = 1;
+    }
+
+  /* Are the pages already contiguous? */
+
+  block = tmpfs_file_page(tfo, 0, false);
+  for (i = 0; block != NULL && i < npages; i++)
+    {
+      if (tmpfs_file_page(tfo, i, false) != &block[i * TMPFS_PAGESIZE])
+        {
+          break;
+        }
+    }
+
+  if (block != NULL && i == npages)
+    {
+      *mapped = block;
+      return OK;
+    }
+
+  /* No.. copy the file into a new block */
+
+  ret = tmpfs_grow_pagetable(tfo, npages);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  block = (FAR uint8_t *)kmm_memalign(TMPFS_PAGESIZE,
+                                      npages * TMPFS_PAGESIZE);
+  if (block == NULL)
     {
       return -ENOMEM;
     }
 
-  /* Adjust the reference in the parent directory entry */
+  for (i = 0; i < npages; i++)
+    {
+      page = tfo->tfo_pages[i];
+      if (page != NULL)
+        {
+          memcpy(&block[i * TMPFS_PAGESIZE], page, TMPFS_PAGESIZE);
+          if (i >= tfo->tfo_nblock)
+            {
+              kmm_free(page);
+            }
+        }
+      else
+        {
+          memset(&block[i * TMPFS_PAGESIZE], 0, TMPFS_PAGESIZE);
+          tfo->tfo_alloc += TMPFS_PAGESIZE;
+        }
 
-  DEBUGASSERT(newtfo->tfo_dirent);
-  newtfo->tfo_dirent->tde_object = (FAR struct tmpfs_object_s *)newtfo;
+      tfo->tfo_pages[i] = &block[i * TMPFS_PAGESIZE];
+    }
 
-  /* Return the new address of the reallocated file object */
+  if (tfo->tfo_block != NULL)
+    {
+      kmm_free(tfo->tfo_block);
+    }
 
-  newtfo->tfo_alloc = allocsize;
-  newtfo->tfo_size  = newsize;
-  *tfo              = newtfo;
+  tfo->tfo_block  = block;
+  tfo->tfo_nblock = npages;
+  *mapped         = block;
   return OK;
 }
 
+/****************************************************************************
+ * Name: tmpfs_free_file
+ ****************************************************************************/
+
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo)
+{
+  tmpfs_free_pages(tfo, 0);
+  kmm_free(tfo);
+}
+
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
  ****************************************************************************/
@@ -454,7 +686,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
     }
 
   /* Otherwise, just decrement the reference count on the file object */
@@ -600,12 +832,12 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s **tdo,
 static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t allocsize;
 
-  /* Create a new zero length file object */
+  /* Create a new zero length file object.  No pages are allocated until
+   * data is written.
+   */
 
-  allocsize = SIZEOF_TMPFS_FILE(CONFIG_FS_TMPFS_FILE_ALLOCGUARD);
-  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(allocsize);
+  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(sizeof(struct tmpfs_file_s));
   if (tfo == NULL)
     {
       return NULL;
@@ -615,11 +847,15 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
    * locked with one reference count.
    */
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_type  = TMPFS_REGULAR;
-  tfo->tfo_refs  = 1;
-  tfo->tfo_flags = 0;
-  tfo->tfo_size  = 0;
+  tfo->tfo_alloc  = sizeof(struct tmpfs_file_s);
+  tfo->tfo_type   = TMPFS_REGULAR;
+  tfo->tfo_refs   = 1;
+  tfo->tfo_flags  = 0;
+  tfo->tfo_size   = 0;
+  tfo->tfo_npages = 0;
+  tfo->tfo_nblock = 0;
+  tfo->tfo_pages  = NULL;
+  tfo->tfo_block  = NULL;
 
   tfo->tfo_exclsem.ts_holder = getpid();
   tfo->tfo_exclsem.ts_count  = 1;
@@ -742,7 +978,7 @@ static int tmpfs_create_file(FAR struct tmpfs_s *fs,
 
 errout_with_file:
   nxsem_destroy(&newtfo->tfo_exclsem.ts_sem);
-  kmm_free(newtfo);
+  tmpfs_free_file(newtfo);
 
 errout_with_parent:
   parent->tdo_refs--;
@@ -1281,7 +1517,15 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
   /* Free the object now */
 
   nxsem_destroy(&to->to_exclsem.ts_sem);
-  kmm_free(to);
+  if (to->to_type == TMPFS_REGULAR)
+    {
+      tmpfs_free_file((FAR struct tmpfs_file_s *)to);
+    }
+  else
+    {
+      kmm_free(to);
+    }
+
   return TMPFS_DELETED;
 }
 
@@ -1442,11 +1686,7 @@ static int tmpfs_open(FAR struct file *filep, FAR const char *relpath,
 
           if (tfo->tfo_size > 0)
             {
-              ret = tmpfs_realloc_file(&tfo, 0);
-              if (ret < 0)
-                {
-                  goto errout_with_filelock;
-                }
+              tmpfs_truncate_file(tfo, 0);
             }
         }
     }
@@ -1562,7 +1802,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
       return OK;
     }
 
@@ -1580,9 +1820,13 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
                           size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nread;
   off_t startpos;
   off_t endpos;
+  off_t pos;
+  size_t offset;
+  size_t nbytes;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1607,15 +1851,43 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   nread    = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  if (startpos >= tfo->tfo_size)
+    {
+      endpos = startpos;
+      nread  = 0;
+    }
+  else if (endpos > tfo->tfo_size)
     {
       endpos = tfo->tfo_size;
       nread  = endpos - startpos;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the file pages to the user buffer.  Holes read as
+   * zeroes.
+   */
+
+  for (pos = startpos; pos < endpos; pos += nbytes)
+    {
+      offset = TMPFS_PAGEOFF(pos);
+      nbytes = TMPFS_PAGESIZE - offset;
+      if (nbytes > endpos - pos)
+        {
+          nbytes = endpos - pos;
+        }
+
+      page = tmpfs_file_page(tfo, TMPFS_PAGENO(pos), false);
+      if (page != NULL)
+        {
+          memcpy(buffer, &page[offset], nbytes);
+        }
+      else
+        {
+          memset(buffer, 0, nbytes);
+        }
+
+      buffer += nbytes;
+    }
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1632,9 +1904,13 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
                            size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nwritten;
   off_t startpos;
   off_t endpos;
+  off_t pos;
+  size_t offset;
+  size_t nbytes;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1653,38 +1929,53 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
-  /* Handle attempts to write beyond the end of the file */
+  /* Copy data from the user buffer to the file pages, allocating pages
+   * as needed.  Pages skipped by a write beyond the end of the file remain
+   * holes.
+   */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  for (pos = startpos; pos < endpos; pos += nbytes)
     {
-      /* Reallocate the file to handle the write past the end of the file. */
+      offset = TMPFS_PAGEOFF(pos);
+      nbytes = TMPFS_PAGESIZE - offset;
+      if (nbytes > endpos - pos)
+        {
+          nbytes = endpos - pos;
+        }
 
-      ret = tmpfs_realloc_file(&tfo, (size_t)endpos);
-      if (ret < 0)
+      page = tmpfs_file_page(tfo, TMPFS_PAGENO(pos), true);
+      if (page == NULL)
         {
-          goto errout_with_lock;
+          break;
         }
 
-      filep->f_priv = tfo;
+      memcpy(&page[offset], buffer, nbytes);
+      buffer += nbytes;
+    }
+
+  /* Return a partial write if memory ran out on the way */
+
+  nwritten = pos - startpos;
+  if (nwritten == 0 && buflen > 0)
+    {
+      tmpfs_unlock_file(tfo);
+      return -ENOMEM;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  if (pos > tfo->tfo_size)
+    {
+      tfo->tfo_size = pos;
+    }
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
-  filep->f_pos += nwritten;
+  filep->f_pos = pos;
 
   /* Release the lock on the file */
 
   tmpfs_unlock_file(tfo);
   return nwritten;
-
-errout_with_lock:
-  tmpfs_unlock_file(tfo);
-  return (ssize_t)ret;
 }
 
 /****************************************************************************
@@ -1755,6 +2046,7 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct tmpfs_file_s *tfo;
   FAR void **ppv = (FAR void**)arg;
+  int ret;
 
   finfo("filep: %p cmd: %d arg: %08lx\n", filep, cmd, arg);
   DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
@@ -1773,8 +2065,15 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
        * the file.
        */
 
-      *ppv = (FAR void *)tfo->tfo_data;
-      return OK;
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = tmpfs_map_file(tfo, ppv);
+      tmpfs_unlock_file(tfo);
+      return ret;
     }
 
   ferr("ERROR: Invalid cmd: %d\n", cmd);
@@ -1891,33 +2190,17 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
   oldsize = tfo->tfo_size;
   if (oldsize != length)
     {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(&tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      filep->f_priv = tfo;
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
+      /* The size is changing.. up or down.  Pages beyond the new end of
+       * the file are freed; a larger file just ends in a hole.
        */
 
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
-
-      ret = OK;
+      tmpfs_truncate_file(tfo, (size_t)length);
     }
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -2335,7 +2618,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
     }
 
   /* Release the reference and lock on the parent directory */
@@ -137,6 +137,13 @@ struct tmpfs_directory_s
  * state.  The file memory object also serves as the open file object,
  * saving an allocation.  This has the negative side effect that no per-
  * open state can be retained (such as open flags).
+ *
+ * The file data is held in pages of CONFIG_FS_TMPFS_PAGESIZE bytes.  A
+ * NULL entry in tfo_pages[] is a hole that reads as zeroes.  Bytes of an
+ * allocated page beyond the end of the file are always zero.  When the
+ * file is memory mapped, its pages are gathered into the single block
+ * tfo_block; the first tfo_nblock entries of tfo_pages[] then point into
+ * that block instead of to separately allocated pages.
  */
 
 struct tmpfs_file_s
@@ -154,11 +161,12 @@ struct tmpfs_file_s
 
   uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
   size_t   tfo_size;     /* Valid file size */
-  uint8_t  tfo_data[1];  /* File data starts here */
+  size_t   tfo_npages;   /* Number of entries in tfo_pages[] */
+  size_t   tfo_nblock;   /* Number of pages held in tfo_block */
+  FAR uint8_t **tfo_pages; /* Page table of the file */
+  FAR uint8_t *tfo_block;  /* Contiguous memory of mapped pages */
 };
 
-#define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
-
 /* This structure represents one instance of a TMPFS file system */
 
 struct tmpfs_s
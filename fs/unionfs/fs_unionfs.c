@@ -2849,6 +2849,12 @@ int unionfs_mount(FAR const char *fspath1, FAR const char *prefix1,
   mpinode->i_mode    = 0755;
 #endif
 
+  /* Paths below the new mountpoint no longer end in the pseudo file
+   * system.
+   */
+
+  inode_cache_invalidate();
+
   /* Call unionfs_dobind to do the real work. */
 
   ret = unionfs_dobind(fspath1, prefix1, fspath2, prefix2,
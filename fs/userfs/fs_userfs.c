@@ -48,6 +48,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
@@ -60,6 +61,7 @@
 #include <nuttx/fs/userfs.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
 
@@ -189,6 +191,58 @@ const struct mountpt_operations userfs_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: userfs_recviob
+ *
+ * Description:
+ *   Wait for the next response datagram from the server and take the I/O
+ *   buffer chain that holds it from the read-ahead queue of the socket.
+ *   The caller must free the chain with IOBUSER_NET_UDP_READAHEAD.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_RX
+static ssize_t userfs_recviob(FAR struct userfs_state_s *priv,
+                              FAR struct iob_s **iobp)
+{
+  struct pollfd fds;
+  sem_t sem;
+  ssize_t ret;
+  int status;
+
+  for (; ; )
+    {
+      ret = psock_recviob(&priv->psock, iobp, NULL, NULL);
+      if (ret != -EAGAIN)
+        {
+          return ret;
+        }
+
+      /* Nothing buffered yet.  Wait until the socket becomes readable. */
+
+      nxsem_init(&sem, 0, 0);
+      nxsem_setprotocol(&sem, SEM_PRIO_NONE);
+
+      memset(&fds, 0, sizeof(struct pollfd));
+      fds.events = POLLIN;
+      fds.sem    = &sem;
+
+      status = psock_poll(&priv->psock, &fds, true);
+      if (status >= 0)
+        {
+          status = nxsem_wait(&sem);
+          psock_poll(&priv->psock, &fds, false);
+        }
+
+      nxsem_destroy(&sem);
+      if (status < 0)
+        {
+          return status;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: userfs_open
  ****************************************************************************/
@@ -365,6 +419,9 @@ static ssize_t userfs_read(FAR struct file *filep, char *buffer,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_read_request_s *req;
   FAR struct userfs_read_response_s *resp;
+#ifdef CONFIG_NET_IOB_RX
+  FAR struct iob_s *iob = NULL;
+#endif
   ssize_t nsent;
   ssize_t nrecvd;
   int respsize;
@@ -405,46 +462,76 @@ static ssize_t userfs_read(FAR struct file *filep, char *buffer,
 
   /* Then get the response from the server */
 
+#ifdef CONFIG_NET_IOB_RX
+  /* Take the response as the network buffered it.  Only the header is
+   * copied to iobuffer; the data is copied straight to the user buffer.
+   */
+
+  nrecvd = userfs_recviob(priv, &iob);
+  if (nrecvd >= SIZEOF_USERFS_READ_RESPONSE_S(0))
+    {
+      iob_copyout(priv->iobuffer, iob, SIZEOF_USERFS_READ_RESPONSE_S(0), 0);
+    }
+#else
   nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
                           0, NULL, NULL);
+#endif
   nxsem_post(&priv->exclsem);
 
   if (nrecvd < 0)
     {
       ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ret = (int)nrecvd;
+      goto errout;
     }
 
+  ret = -EIO;
   if (nrecvd < SIZEOF_USERFS_READ_RESPONSE_S(0))
     {
       ferr("ERROR: Response too small: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      goto errout;
     }
 
   resp = (FAR struct userfs_read_response_s *)priv->iobuffer;
   if (resp->resp != USERFS_RESP_READ)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      goto errout;
     }
 
   if (resp->nread > buflen)
     {
       ferr("ERROR: Response size too large: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      goto errout;
     }
 
   respsize = SIZEOF_USERFS_READ_RESPONSE_S(resp->nread);
   if (respsize != nrecvd)
     {
       ferr("ERROR: Incorrect response size: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      goto errout;
     }
 
   /* Copy the received data to the user buffer */
 
+#ifdef CONFIG_NET_IOB_RX
+  iob_copyout((FAR uint8_t *)buffer, iob, resp->nread,
+              SIZEOF_USERFS_READ_RESPONSE_S(0));
+  iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+#else
   memcpy(buffer, resp->rddata, resp->nread);
+#endif
   return resp->nread;
+
+errout:
+#ifdef CONFIG_NET_IOB_RX
+  if (iob != NULL)
+    {
+      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+    }
+#endif
+
+  return ret;
 }
 
 /****************************************************************************
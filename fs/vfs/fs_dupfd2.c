@@ -89,6 +89,13 @@ int dup2(int fd1, int fd2)
   /* Get the file structures corresponding to the file descriptors. */
 
   ret = fs_getfilep(fd1, &filep1);
+  if (ret >= 0)
+    {
+      /* The block of descriptors containing fd2 may not exist yet */
+
+      ret = files_extend(sched_getfiles(), fd2);
+    }
+
   if (ret >= 0)
     {
       ret = fs_getfilep(fd2, &filep2);
@@ -42,193 +42,1094 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <queue.h>
+#include <assert.h>
 #include <errno.h>
-#include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Events that are always reported, whether requested or not */
+
+#define EPOLL_DEFAULT_EVENTS  (POLLERR | POLLHUP)
+
+/* The subset of the epoll event flags that are passed on to drivers */
+
+#define EPOLL_POLL_EVENTS     (POLLIN | POLLOUT | POLLERR | POLLHUP)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct epoll_head_s;
+
+/* This structure describes one file or socket descriptor registered with
+ * an epoll instance.  The embedded pollfd stays set up with the driver for
+ * as long as the descriptor is registered, so the driver notifies the
+ * epoll instance directly through epoll_pollnotify() when an event occurs.
+ *
+ * A file is referenced through the caller's open file.  It is not opened
+ * again, so drivers that count their openers (such as FIFOs) are not
+ * affected.  The registration is removed by epoll_release() before the
+ * file is closed.  A socket gets a reference of its own (a socket
+ * reference count), so its registration lasts until EPOLL_CTL_DEL or
+ * until the epoll instance is closed.
+ */
+
+struct epoll_node_s
+{
+  dq_entry_t               node;      /* Link in eph->setup (must be first) */
+  FAR struct epoll_node_s *rdnext;    /* Link in the ready list */
+  FAR struct epoll_head_s *eph;       /* The epoll instance */
+  union
+  {
+    FAR struct file       *filep;     /* The registered open file */
+#ifdef CONFIG_NET
+    FAR struct socket     *psock;     /* The referenced socket */
+#endif
+  } u;
+  int                      fd;        /* The registered descriptor */
+  struct epoll_event       ev;        /* Registered events and user data */
+  struct pollfd            pfd;       /* Persistent poll registration */
+  bool                     issock;    /* True: u.psock is in use */
+  bool                     armed;     /* True: pfd is set up with the driver */
+  bool                     rearming;  /* True: re-arm after delivery */
+  bool                     ready;     /* True: in the ready list */
+};
+
+/* This structure describes one epoll instance */
+
+struct epoll_head_s
+{
+  dq_entry_t               node;      /* In g_epoll_heads (must be first) */
+  sem_t                    exclsem;   /* Mutual exclusion for eph->setup */
+  sem_t                    waitsem;   /* Posted when a node becomes ready */
+  dq_queue_t               setup;     /* List of registered descriptors */
+  FAR struct epoll_node_s *rdhead;    /* Head of the ready list */
+  FAR struct epoll_node_s *rdtail;    /* Tail of the ready list */
+  FAR struct pollfd       *fds;       /* poll() waiter on the epoll fd */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int epoll_do_close(FAR struct file *filep);
+static int epoll_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                         bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_epoll_ops =
+{
+  NULL,            /* open */
+  epoll_do_close,  /* close */
+  NULL,            /* read */
+  NULL,            /* write */
+  NULL,            /* seek */
+  NULL,            /* ioctl */
+  epoll_do_poll    /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL           /* unlink */
+#endif
+};
+
+/* All epoll instances, so that a file can be removed from them when it is
+ * closed.
+ */
+
+static dq_queue_t g_epoll_heads;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_semtake
+ ****************************************************************************/
+
+static int epoll_semtake(FAR struct epoll_head_s *eph)
+{
+  return nxsem_wait(&eph->exclsem);
+}
+
+#define epoll_semgive(eph) nxsem_post(&(eph)->exclsem)
+
+/****************************************************************************
+ * Name: epoll_head
+ *
+ * Description:
+ *   Map an epoll file descriptor to the epoll instance.
+ *
+ ****************************************************************************/
+
+static int epoll_head(int epfd, FAR struct epoll_head_s **eph)
+{
+  FAR struct file *filep;
+  int ret;
+
+  if ((unsigned int)epfd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return -EBADF;
+    }
+
+  ret = fs_getfilep(epfd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (filep->f_inode == NULL || filep->f_inode->u.i_ops != &g_epoll_ops)
+    {
+      return -EINVAL;
+    }
+
+  *eph = (FAR struct epoll_head_s *)filep->f_inode->i_private;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_pollnotify
+ *
+ * Description:
+ *   The poll notification callback.  Drivers call this function through
+ *   poll_notify() when an event occurs on a registered descriptor.  The
+ *   node is simply queued in the ready list and epoll_wait() is awakened;
+ *   no other registered descriptors are examined.
+ *
+ *   This function may be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+static void epoll_pollnotify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node_s *epn = (FAR struct epoll_node_s *)fds->arg;
+  FAR struct epoll_head_s *eph = epn->eph;
+  irqstate_t flags;
+  bool wakeup = false;
+
+  flags = enter_critical_section();
+
+  /* An edge-triggered descriptor is re-armed after each delivery.  Do not
+   * report the level that was already reported again.
+   */
+
+  if (epn->rearming && (epn->ev.events & EPOLLET) != 0)
+    {
+      fds->revents = 0;
+    }
+  else if (fds->revents != 0 && !epn->ready)
+    {
+      epn->ready  = true;
+      epn->rdnext = NULL;
+
+      if (eph->rdtail != NULL)
+        {
+          eph->rdtail->rdnext = epn;
+        }
+      else
+        {
+          eph->rdhead = epn;
+        }
+
+      eph->rdtail = epn;
+      wakeup      = true;
+    }
+
+  leave_critical_section(flags);
+
+  if (wakeup)
+    {
+      nxsem_post(&eph->waitsem);
+
+      /* Somebody may also be polling the epoll descriptor itself */
+
+      if (eph->fds != NULL)
+        {
+          eph->fds->revents |= (eph->fds->events & POLLIN);
+          if (eph->fds->revents != 0)
+            {
+              poll_notify(eph->fds);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a node from the ready list.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR struct epoll_head_s *eph,
+                          FAR struct epoll_node_s *epn)
+{
+  FAR struct epoll_node_s *prev;
+  FAR struct epoll_node_s *curr;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (epn->ready)
+    {
+      for (prev = NULL, curr = eph->rdhead;
+           curr != NULL && curr != epn;
+           prev = curr, curr = curr->rdnext);
+
+      DEBUGASSERT(curr == epn);
+
+      if (prev != NULL)
+        {
+          prev->rdnext = epn->rdnext;
+        }
+      else
+        {
+          eph->rdhead = epn->rdnext;
+        }
+
+      if (eph->rdtail == epn)
+        {
+          eph->rdtail = prev;
+        }
+
+      epn->rdnext = NULL;
+      epn->ready  = false;
+    }
+
+  epn->pfd.revents = 0;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_poll
+ *
+ * Description:
+ *   Setup or teardown the persistent poll registration of one node.
+ *
+ ****************************************************************************/
+
+static int epoll_poll(FAR struct epoll_node_s *epn, bool setup)
+{
+  int ret;
+
+  if (setup == epn->armed)
+    {
+      return OK;
+    }
+
+#ifdef CONFIG_NET
+  if (epn->issock)
+    {
+      ret = psock_poll(epn->u.psock, &epn->pfd, setup);
+    }
+  else
+#endif
+    {
+      ret = file_poll(epn->u.filep, &epn->pfd, setup);
+    }
+
+  if (!setup || ret >= 0)
+    {
+      epn->armed = setup;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   (Re-)arm the poll registration of one node with the current events.
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_node_s *epn)
+{
+  epn->pfd.fd      = epn->fd;
+  epn->pfd.events  = (pollevent_t)(epn->ev.events & EPOLL_POLL_EVENTS) |
+                     EPOLL_DEFAULT_EVENTS;
+  epn->pfd.revents = 0;
+  epn->pfd.sem     = &epn->eph->waitsem;
+  epn->pfd.priv    = NULL;
+  epn->pfd.cb      = epoll_pollnotify;
+  epn->pfd.arg     = epn;
+
+  return epoll_poll(epn, true);
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ ****************************************************************************/
+
+static FAR struct epoll_node_s *epoll_find(FAR struct epoll_head_s *eph,
+                                           int fd)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&eph->setup); entry != NULL; entry = dq_next(entry))
+    {
+      FAR struct epoll_node_s *epn = (FAR struct epoll_node_s *)entry;
+
+      if (epn->fd == fd)
+        {
+          return epn;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_remove
+ *
+ * Description:
+ *   Teardown the poll registration of one node, release its reference on
+ *   the socket and free it.
+ *
+ ****************************************************************************/
+
+static void epoll_remove(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_node_s *epn)
+{
+  epoll_poll(epn, false);
+  epoll_unready(eph, epn);
+  dq_rem(&epn->node, &eph->setup);
+
+#ifdef CONFIG_NET
+  if (epn->issock)
+    {
+      /* This closes the socket if the descriptor was already closed */
+
+      psock_close(epn->u.psock);
+    }
+#endif
+
+  kmm_free(epn);
+}
+
+/****************************************************************************
+ * Name: epoll_scan
+ *
+ * Description:
+ *   Drivers that have not been converted to poll_notify() still post
+ *   pfd.sem directly without invoking the callback.  If epoll_wait() was
+ *   awakened but nothing was queued, find such nodes and queue them.  This
+ *   is the only path that visits every registered descriptor.
+ *
+ ****************************************************************************/
+
+static void epoll_scan(FAR struct epoll_head_s *eph)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&eph->setup); entry != NULL; entry = dq_next(entry))
+    {
+      FAR struct epoll_node_s *epn = (FAR struct epoll_node_s *)entry;
+
+      if (epn->armed && !epn->ready && epn->pfd.revents != 0)
+        {
+          epoll_pollnotify(&epn->pfd);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_harvest
+ *
+ * Description:
+ *   Move up to maxevents ready nodes to the caller's event array and re-arm
+ *   the delivered nodes according to their trigger mode.
+ *
+ ****************************************************************************/
+
+static int epoll_harvest(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node_s *delivered = NULL;
+  FAR struct epoll_node_s *epn;
+  irqstate_t flags;
+  int count = 0;
+
+  /* First detach the delivered nodes from the ready list so that a
+   * level-triggered node, which is re-queued immediately when re-armed,
+   * is not reported twice by the same call.
+   */
+
+  while (count < maxevents)
+    {
+      pollevent_t revents;
+
+      flags = enter_critical_section();
+      epn   = eph->rdhead;
+      if (epn == NULL)
+        {
+          leave_critical_section(flags);
+          break;
+        }
+
+      eph->rdhead = epn->rdnext;
+      if (eph->rdhead == NULL)
+        {
+          eph->rdtail = NULL;
+        }
+
+      epn->ready       = false;
+      revents          = epn->pfd.revents;
+      epn->pfd.revents = 0;
+      leave_critical_section(flags);
+
+      revents &= (pollevent_t)(epn->ev.events & EPOLL_POLL_EVENTS) |
+                 EPOLL_DEFAULT_EVENTS;
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[count].events = revents;
+      evs[count].data   = epn->ev.data;
+      count++;
+
+      epn->rdnext = delivered;
+      delivered   = epn;
+    }
+
+  /* Then re-arm the delivered nodes.  Re-arming lets the driver report the
+   * current state again: a level-triggered node that is still ready is
+   * re-queued right away, an edge-triggered node waits for the next event,
+   * and a one-shot node stays disabled until EPOLL_CTL_MOD.
+   */
+
+  while (delivered != NULL)
+    {
+      epn         = delivered;
+      delivered   = epn->rdnext;
+      epn->rdnext = NULL;
+
+      epoll_poll(epn, false);
+      epn->pfd.revents = 0;
+
+      if ((epn->ev.events & EPOLLONESHOT) == 0)
+        {
+          epn->rearming = true;
+          epoll_arm(epn);
+          epn->rearming = false;
+        }
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: epoll_do_close
+ ****************************************************************************/
+
+static int epoll_do_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct epoll_head_s *eph;
+  FAR dq_entry_t *entry;
+
+  DEBUGASSERT(inode != NULL && inode->i_private != NULL);
+
+  /* Nothing to do until the last reference to the epoll instance goes
+   * away.  dup() shares the inode reference count.
+   */
+
+  if (inode->i_crefs > 1)
+    {
+      return OK;
+    }
+
+  eph = (FAR struct epoll_head_s *)inode->i_private;
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_rem(&eph->node, &g_epoll_heads);
+  nxsem_post(&g_epoll_sem);
+
+  while ((entry = dq_peek(&eph->setup)) != NULL)
+    {
+      epoll_remove(eph, (FAR struct epoll_node_s *)entry);
+    }
+
+  nxsem_destroy(&eph->exclsem);
+  nxsem_destroy(&eph->waitsem);
+  kmm_free(eph);
+
+  inode->i_private = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_do_poll
+ *
+ * Description:
+ *   Support poll() on the epoll descriptor itself.  The descriptor is
+ *   readable when the ready list is not empty.
+ *
+ ****************************************************************************/
+
+static int epoll_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                         bool setup)
+{
+  FAR struct epoll_head_s *eph;
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(filep->f_inode != NULL && filep->f_inode->i_private != NULL);
+  eph = (FAR struct epoll_head_s *)filep->f_inode->i_private;
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      if (eph->fds != NULL)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          eph->fds = fds;
+          if (eph->rdhead != NULL)
+            {
+              fds->revents |= (fds->events & POLLIN);
+              if (fds->revents != 0)
+                {
+                  poll_notify(fds);
+                }
+            }
+        }
+    }
+  else if (eph->fds == fds)
+    {
+      eph->fds = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: epoll_create
+ * Name: epoll_create1
  *
  * Description:
+ *   Create an epoll instance and return a file descriptor referring to it.
  *
  * Input Parameters:
+ *   flags - Zero or EPOLL_CLOEXEC
  *
  * Returned Value:
+ *   A new epoll file descriptor on success; -1 (ERROR) on failure with the
+ *   errno value set appropriately.
  *
  ****************************************************************************/
 
-int epoll_create(int size)
+int epoll_create1(int flags)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head_s *eph;
+  FAR struct inode *inode;
+  int errcode;
+  int fd;
+
+  if ((flags & ~EPOLL_CLOEXEC) != 0)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
 
-  eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+  if (eph == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
 
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+  nxsem_init(&eph->exclsem, 0, 1);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
    */
 
-  return (int)((intptr_t)eph);
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
+  dq_init(&eph->setup);
+
+  /* The epoll instance is represented by an anonymous inode that is not
+   * linked into the pseudo-filesystem tree.  It is marked deleted so that
+   * it is freed when the last file descriptor referring to it is closed.
+   */
+
+  inode = (FAR struct inode *)kmm_zalloc(FSNODE_SIZE(0));
+  if (inode == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_eph;
+    }
+
+  INODE_SET_DRIVER(inode);
+  inode->i_flags    |= FSNODEFLAG_DELETED;
+  inode->i_crefs     = 1;
+  inode->u.i_ops     = &g_epoll_ops;
+  inode->i_private   = eph;
+
+  fd = files_allocate(inode, O_RDOK | flags, 0, 0);
+  if (fd < 0)
+    {
+      errcode = EMFILE;
+      goto errout_with_inode;
+    }
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_addlast(&eph->node, &g_epoll_heads);
+  nxsem_post(&g_epoll_sem);
+
+  return fd;
+
+errout_with_inode:
+  kmm_free(inode);
+
+errout_with_eph:
+  nxsem_destroy(&eph->exclsem);
+  nxsem_destroy(&eph->waitsem);
+  kmm_free(eph);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
 }
 
 /****************************************************************************
- * Name: epoll_close
+ * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance.  The size argument is only a hint and is
+ *   ignored, but it must be greater than zero.
  *
  * Input Parameters:
+ *   size - A hint of the number of descriptors that will be registered
  *
  * Returned Value:
+ *   A new epoll file descriptor on success; -1 (ERROR) on failure with the
+ *   errno value set appropriately.
  *
  ****************************************************************************/
 
-void epoll_close(int epfd)
+int epoll_create(int size)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  return epoll_create1(0);
+}
 
-  kmm_free(eph->evs);
-  kmm_free(eph);
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Close an epoll instance.  This is the same as close(epfd) and is
+ *   retained for compatibility.
+ *
+ * Input Parameters:
+ *   epfd - The epoll file descriptor
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_close(int epfd)
+{
+  close(epfd);
 }
 
 /****************************************************************************
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a file or socket descriptor registration.
+ *   Registered descriptors stay set up with their drivers until they are
+ *   removed, so the cost of epoll_wait() does not depend on the number of
+ *   registered descriptors.  Closing a file descriptor removes its
+ *   registration.  A registration holds a reference on a socket, so
+ *   closing a socket descriptor does not remove it; use EPOLL_CTL_DEL
+ *   first.
  *
  * Input Parameters:
+ *   epfd - The epoll file descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The target file or socket descriptor
+ *   ev   - The events to monitor (EPOLLET and EPOLLONESHOT are supported)
+ *          and the user data to return.  Ignored by EPOLL_CTL_DEL.
  *
  * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with the errno value set
+ *   appropriately.
  *
  ****************************************************************************/
 
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_node_s *epn;
+  int ret;
+
+  ret = epoll_head(epfd, &eph);
+  if (ret < 0)
+    {
+      goto errout;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  if (fd == epfd)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  if (op != EPOLL_CTL_DEL && ev == NULL)
+    {
+      ret = -EFAULT;
+      goto errout;
+    }
+
+  ret = epoll_semtake(eph);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  epn = epoll_find(eph, fd);
 
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
-              epfd, eph->occupied, fd, ev->events);
+        {
+          FAR struct file *filep = NULL;
+#ifdef CONFIG_NET
+          FAR struct socket *psock = NULL;
+#endif
 
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+          finfo("%d CTL ADD: fd=%d ev=%08x\n", epfd, fd, ev->events);
 
-      case EPOLL_CTL_DEL:
-        {
-          int i;
+          if (epn != NULL)
+            {
+              ret = -EEXIST;
+              break;
+            }
 
-          for (i = 0; i < eph->occupied; i++)
+          if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS)
             {
-              if (eph->evs[i].data.fd == fd)
+              ret = fs_getfilep(fd, &filep);
+              if (ret >= 0 && filep->f_inode == NULL)
                 {
-                  if (i != eph->occupied - 1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
+                  ret = -EBADF;
                 }
             }
+#ifdef CONFIG_NET
+          else if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS +
+                                       CONFIG_NSOCKET_DESCRIPTORS))
+            {
+              psock = sockfd_socket(fd);
+              ret   = psock != NULL && psock->s_crefs > 0 ? OK : -EBADF;
+            }
+#endif
+          else
+            {
+              ret = -EBADF;
+            }
+
+          if (ret < 0)
+            {
+              break;
+            }
+
+          epn = (FAR struct epoll_node_s *)
+            kmm_zalloc(sizeof(struct epoll_node_s));
+          if (epn == NULL)
+            {
+              ret = -ENOMEM;
+              break;
+            }
+
+          /* Take a reference of our own on a socket */
+
+#ifdef CONFIG_NET
+          if (psock != NULL)
+            {
+              /* A duplicate socket would not follow the connection state
+               * of the original, so reference the socket itself.  close()
+               * then only drops the descriptor's reference.
+               */
 
-          return -ENOENT;
+              net_lock();
+              psock->s_crefs++;
+              net_unlock();
+
+              epn->u.psock = psock;
+              epn->issock  = true;
+            }
+          else
+#endif
+            {
+              epn->u.filep = filep;
+            }
+
+          epn->eph    = eph;
+          epn->fd     = fd;
+          epn->ev     = *ev;
+
+          dq_addlast(&epn->node, &eph->setup);
+
+          ret = epoll_arm(epn);
+          if (ret < 0)
+            {
+              epoll_remove(eph, epn);
+            }
         }
+        break;
+
+      case EPOLL_CTL_DEL:
+        finfo("%d CTL DEL: fd=%d\n", epfd, fd);
+
+        if (epn == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
+
+        epoll_remove(eph, epn);
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%d CTL MOD: fd=%d ev=%08x\n", epfd, fd, ev->events);
+
+        if (epn == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
+
+        epoll_poll(epn, false);
+        epoll_unready(eph, epn);
+
+        epn->ev = *ev;
+        ret     = epoll_arm(epn);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  epoll_semgive(eph);
+
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove the registrations of an open file from all epoll instances.
+ *   This is called before the file is closed, while the driver state that
+ *   the registrations are set up with is still valid.
+ *
+ * Input Parameters:
+ *   filep - The open file that is being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR struct file *filep)
+{
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *hentry;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *next;
+
+  if (dq_peek(&g_epoll_heads) == NULL)
+    {
+      return;
+    }
 
-          for (i = 0; i < eph->occupied; i++)
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  for (hentry = dq_peek(&g_epoll_heads); hentry != NULL;
+       hentry = dq_next(hentry))
+    {
+      eph = (FAR struct epoll_head_s *)hentry;
+
+      nxsem_wait_uninterruptible(&eph->exclsem);
+      for (entry = dq_peek(&eph->setup); entry != NULL; entry = next)
+        {
+          next = dq_next(entry);
+          epn  = (FAR struct epoll_node_s *)entry;
+
+          if (!epn->issock && epn->u.filep == filep)
             {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
+              epoll_remove(eph, epn);
             }
-
-          return -ENOENT;
         }
+
+      epoll_semgive(eph);
     }
 
-  return -EINVAL;
+  nxsem_post(&g_epoll_sem);
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on an epoll instance.  Only descriptors that were
+ *   reported ready by their drivers are visited.
  *
  * Input Parameters:
+ *   epfd      - The epoll file descriptor
+ *   evs       - The array that receives the ready events
+ *   maxevents - The maximum number of events to return
+ *   timeout   - The timeout in milliseconds.  -1 waits indefinitely and
+ *               zero returns immediately.
  *
  * Returned Value:
+ *   The number of ready events, zero on timeout, or -1 (ERROR) on failure
+ *   with the errno value set appropriately.
  *
  ****************************************************************************/
 
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
                int timeout)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph;
+  clock_t start = 0;
+  clock_t ticks = 0;
+  bool awakened = false;
+  int count = 0;
+  int ret;
+
+  /* epoll_wait() is a cancellation point */
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  enter_cancellation_point();
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  ret = epoll_head(epfd, &eph);
+  if (ret < 0)
+    {
+      goto errout;
+    }
 
-  if (rc <= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      if (rc < 0)
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  if (timeout > 0)
+    {
+      /* Round timeout up to next full tick, as does poll() */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
+      start = clock_systimer();
+    }
+
+  for (; ; )
+    {
+      ret = epoll_semtake(eph);
+      if (ret < 0)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          goto errout;
+        }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
-            }
+      if (awakened && eph->rdhead == NULL)
+        {
+          epoll_scan(eph);
         }
 
-      return rc;
-    }
+      count = epoll_harvest(eph, evs, maxevents);
+      epoll_semgive(eph);
+
+      if (count > 0 || timeout == 0)
+        {
+          break;
+        }
 
-  /* Iterate over non NULL event fds */
+      /* Wait for a driver to report an event.  A stale semaphore count only
+       * causes another trip through the loop.
+       */
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
-    {
-      if (eph->evs[counter].revents != 0)
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, ticks);
+        }
+      else
         {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
+          ret = nxsem_wait(&eph->waitsem);
         }
+
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
+            {
+              /* Return zero in the event of a timeout */
+
+              count = 0;
+              break;
+            }
+
+          goto errout;
+        }
+
+      awakened = true;
     }
 
-  return i;
+  leave_cancellation_point();
+  return count;
+
+errout:
+  leave_cancellation_point();
+  set_errno(-ret);
+  return ERROR;
 }
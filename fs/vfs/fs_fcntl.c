@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <assert.h>
@@ -48,6 +49,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 
 #include "inode/inode.h"
@@ -235,6 +237,36 @@ int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
         ret = -ENOSYS; /* Not implemented */
         break;
 
+      case F_SETPIPE_SZ:
+        /* Change the buffer size of the pipe referred to by fd to arg bytes
+         * and return the new size.
+         */
+
+        {
+          ret = file_ioctl(filep, PIPEIOC_SETSIZE, va_arg(ap, int));
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+
+        /* Fall through */
+
+      case F_GETPIPE_SZ:
+        /* Return the buffer size of the pipe referred to by fd */
+
+        {
+          int size;
+
+          ret = file_ioctl(filep, PIPEIOC_GETSIZE,
+                           (unsigned long)((uintptr_t)&size));
+          if (ret >= 0)
+            {
+              ret = size;
+            }
+        }
+        break;
+
       default:
         break;
     }
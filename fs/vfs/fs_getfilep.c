@@ -100,8 +100,10 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  /* And return the file pointer from the list */
+  /* And return the file pointer from the list.  There is none if the
+   * block of the descriptor has never been allocated.
+   */
 
-  *filep = &list->fl_files[fd];
-  return OK;
+  *filep = files_fget(list, fd);
+  return *filep != NULL ? OK : -EBADF;
 }
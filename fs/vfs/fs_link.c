@@ -152,6 +152,17 @@ int link(FAR const char *path1, FAR const char *path2)
         }
 
       ret = inode_reserve(path2, &inode);
+      if (ret >= 0)
+        {
+          /* Initialize the inode.  Cached searches that went through the
+           * new inode did not know that it is a soft link.
+           */
+
+          INODE_SET_SOFTLINK(inode);
+          inode->u.i_link = newpath2;
+          inode_cache_invalidate();
+        }
+
       inode_semgive();
 
       if (ret < 0)
@@ -160,11 +171,6 @@ int link(FAR const char *path1, FAR const char *path2)
           errcode = -ret;
           goto errout_with_search;
         }
-
-      /* Initialize the inode */
-
-      INODE_SET_SOFTLINK(inode);
-      inode->u.i_link = newpath2;
     }
 
   /* Symbolic link successfully created */
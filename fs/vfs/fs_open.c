@@ -53,6 +53,7 @@
 
 #include "inode/inode.h"
 #include "driver/driver.h"
+#include "mmap/fs_rammap.h"
 
 /****************************************************************************
  * Public Functions
@@ -244,6 +245,13 @@ int nx_vopen(FAR const char *path, int oflags, va_list ap)
       goto errout_with_fd;
     }
 
+  if ((oflags & O_TRUNC) != 0 && INODE_IS_MOUNTPT(inode))
+    {
+      /* Copies of the file in memory may be stale now */
+
+      rammap_modified(filep);
+    }
+
 #ifdef CONFIG_PSEUDOTERM_SUSV1
   /* If the return value from the open method is > 0, then it may actually
    * be an encoded file descriptor.  This kind of logic is currently only
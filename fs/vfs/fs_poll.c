@@ -45,6 +45,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/cancelpt.h>
@@ -139,6 +140,8 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
+      fds[i].arg     = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -294,6 +297,50 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report the events already accumulated in fds->revents to the waiter.
+ *   If the waiter provided a notification callback (as epoll does), that
+ *   callback is invoked; otherwise the poll semaphore is posted.  The
+ *   semaphore count is limited to one since a single wakeup is sufficient
+ *   for poll() to re-examine all of its descriptors.
+ *
+ *   This function may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure with the updated revents
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds)
+{
+  irqstate_t flags;
+  int semcount;
+
+  DEBUGASSERT(fds != NULL);
+
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+  else if (fds->sem != NULL)
+    {
+      flags = enter_critical_section();
+      nxsem_getvalue(fds->sem, &semcount);
+      if (semcount < 1)
+        {
+          nxsem_post(fds->sem);
+        }
+
+      leave_critical_section(flags);
+    }
+}
+
 /****************************************************************************
  * Name: file_poll
  *
@@ -348,7 +395,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
 
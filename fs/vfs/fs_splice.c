@@ -0,0 +1,579 @@
+/****************************************************************************
+ * fs/vfs/fs_splice.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+#include <nuttx/drivers/drivers.h>
+
+#ifdef CONFIG_PIPES
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#  define SPLICE_HAVE_SOCKETS 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One end of a splice() */
+
+struct splice_end_s
+{
+  FAR struct file   *filep;    /* The open file, NULL for a socket */
+#ifdef SPLICE_HAVE_SOCKETS
+  FAR struct socket *psock;    /* The socket, NULL for a file */
+#endif
+  FAR off_t         *offset;   /* File position to use instead of f_pos */
+  size_t             nxfer;    /* Bytes moved so far by this call */
+  bool               nonblock; /* SPLICE_F_NONBLOCK was given */
+};
+
+/* The user memory of a vmsplice() */
+
+struct splice_iov_s
+{
+  FAR const struct iovec *iov; /* The current I/O vector */
+  int                iovcnt;   /* The number of vectors left */
+  size_t             offset;   /* The offset into the current vector */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice_getend
+ *
+ * Description:
+ *   Look up the file or socket of one end of a transfer.
+ *
+ ****************************************************************************/
+
+static int splice_getend(int fd, FAR off_t *offset, bool nonblock,
+                         FAR struct splice_end_s *end)
+{
+  int ret;
+
+  memset(end, 0, sizeof(struct splice_end_s));
+  end->nonblock = nonblock;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#ifdef SPLICE_HAVE_SOCKETS
+      end->psock = sockfd_socket(fd);
+      if (end->psock == NULL)
+        {
+          return -EBADF;
+        }
+
+      return offset == NULL ? OK : -ESPIPE;
+#else
+      return -EBADF;
+#endif
+    }
+
+  ret = fs_getfilep(fd, &end->filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Pipes have no file position */
+
+  if (offset != NULL && pipe_check(end->filep))
+    {
+      return -ESPIPE;
+    }
+
+  end->offset = offset;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: splice_ispipe
+ ****************************************************************************/
+
+static inline bool splice_ispipe(FAR struct splice_end_s *end)
+{
+  return end->filep != NULL && pipe_check(end->filep);
+}
+
+/****************************************************************************
+ * Name: splice_copyin
+ *
+ * Description:
+ *   Copy the data of one pipe buffer into another pipe buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_copyin(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  FAR uint8_t **src = (FAR uint8_t **)arg;
+
+  memcpy(buffer, *src, len);
+  *src += len;
+  return len;
+}
+
+/****************************************************************************
+ * Name: splice_topipe
+ *
+ * Description:
+ *   Move data from the buffer of one pipe into another pipe.  Only the first
+ *   piece of the input buffer may wait for space in the output pipe.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_topipe(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  FAR struct splice_end_s *out = (FAR struct splice_end_s *)arg;
+  ssize_t ret;
+
+  ret = pipe_splice_write(out->filep, len, out->nonblock || out->nxfer > 0,
+                          splice_copyin, &buffer);
+  if (ret == -EAGAIN && out->nxfer > 0)
+    {
+      ret = 0;
+    }
+
+  if (ret > 0)
+    {
+      out->nxfer += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: splice_tofile
+ *
+ * Description:
+ *   Write data from the buffer of a pipe to a file or socket.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_tofile(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  FAR struct splice_end_s *out = (FAR struct splice_end_s *)arg;
+  ssize_t ret;
+
+#ifdef SPLICE_HAVE_SOCKETS
+  if (out->psock != NULL)
+    {
+      return psock_send(out->psock, buffer, len, 0);
+    }
+#endif
+
+  if (out->offset != NULL)
+    {
+      ret = file_pwrite(out->filep, buffer, len, *out->offset);
+      if (ret > 0)
+        {
+          *out->offset += ret;
+        }
+
+      return ret;
+    }
+
+  return file_write(out->filep, buffer, len);
+}
+
+/****************************************************************************
+ * Name: splice_fromfile
+ *
+ * Description:
+ *   Read data from a file or socket into the buffer of a pipe.  Only the
+ *   first read from a socket may wait for data.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_fromfile(FAR void *arg, FAR uint8_t *buffer,
+                               size_t len)
+{
+  FAR struct splice_end_s *in = (FAR struct splice_end_s *)arg;
+  ssize_t ret;
+
+#ifdef SPLICE_HAVE_SOCKETS
+  if (in->psock != NULL)
+    {
+      ret = psock_recv(in->psock, buffer, len,
+                       in->nxfer > 0 ? MSG_DONTWAIT : 0);
+      if (ret == -EAGAIN && in->nxfer > 0)
+        {
+          ret = 0;
+        }
+    }
+  else
+#endif
+  if (in->offset != NULL)
+    {
+      ret = file_pread(in->filep, buffer, len, *in->offset);
+      if (ret > 0)
+        {
+          *in->offset += ret;
+        }
+    }
+  else
+    {
+      ret = file_read(in->filep, buffer, len);
+    }
+
+  if (ret > 0)
+    {
+      in->nxfer += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: splice_iovcopy, splice_gather and splice_scatter
+ *
+ * Description:
+ *   Copy user memory described by an I/O vector into a pipe buffer, or a
+ *   pipe buffer into user memory.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_iovcopy(FAR struct splice_iov_s *uio,
+                              FAR uint8_t *buffer, size_t len, bool gather)
+{
+  FAR uint8_t *base;
+  size_t nxfer = 0;
+  size_t chunk;
+
+  while (nxfer < len && uio->iovcnt > 0)
+    {
+      base  = (FAR uint8_t *)uio->iov->iov_base + uio->offset;
+      chunk = uio->iov->iov_len - uio->offset;
+      if (chunk > len - nxfer)
+        {
+          chunk = len - nxfer;
+        }
+
+      if (gather)
+        {
+          memcpy(buffer + nxfer, base, chunk);
+        }
+      else
+        {
+          memcpy(base, buffer + nxfer, chunk);
+        }
+
+      nxfer       += chunk;
+      uio->offset += chunk;
+      if (uio->offset >= uio->iov->iov_len)
+        {
+          uio->iov++;
+          uio->iovcnt--;
+          uio->offset = 0;
+        }
+    }
+
+  return nxfer;
+}
+
+static ssize_t splice_gather(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  return splice_iovcopy((FAR struct splice_iov_s *)arg, buffer, len, true);
+}
+
+static ssize_t splice_scatter(FAR void *arg, FAR uint8_t *buffer,
+                              size_t len)
+{
+  return splice_iovcopy((FAR struct splice_iov_s *)arg, buffer, len, false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice
+ *
+ * Description:
+ *   Move up to 'len' bytes between two file descriptors, one of which must
+ *   refer to a pipe.  The other one may be a pipe, a regular file, a device
+ *   or a socket.  The data is copied directly between the pipe buffer and
+ *   the other end; it never passes through a user buffer.
+ *
+ * Input Parameters:
+ *   fd_in   - The file descriptor to read from
+ *   off_in  - If not NULL, the position in fd_in to read from.  It is
+ *             updated and the file position of fd_in is not changed.  Must
+ *             be NULL if fd_in is a pipe or a socket.
+ *   fd_out  - The file descriptor to write to
+ *   off_out - Like off_in, for fd_out
+ *   len     - The maximum number of bytes to move
+ *   flags   - SPLICE_F_NONBLOCK makes the pipe operations non-blocking.
+ *             The other SPLICE_F_* flags are accepted and ignored.
+ *
+ * Returned Value:
+ *   The number of bytes moved, zero at end of input, or -1 with errno set
+ *   on failure.  Fewer bytes than requested may be moved.
+ *
+ ****************************************************************************/
+
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags)
+{
+  struct splice_end_s in;
+  struct splice_end_s out;
+  bool nonblock = (flags & SPLICE_F_NONBLOCK) != 0;
+  ssize_t ret;
+
+  /* splice() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = splice_getend(fd_in, off_in, nonblock, &in);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = splice_getend(fd_out, off_out, nonblock, &out);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  if (splice_ispipe(&in))
+    {
+      if (!splice_ispipe(&out))
+        {
+          ret = pipe_splice_read(in.filep, len, nonblock, false,
+                                 splice_tofile, &out);
+        }
+      else if (in.filep->f_inode != out.filep->f_inode)
+        {
+          ret = pipe_splice_read(in.filep, len, nonblock, false,
+                                 splice_topipe, &out);
+        }
+      else
+        {
+          ret = -EINVAL;
+        }
+    }
+  else if (splice_ispipe(&out))
+    {
+      ret = pipe_splice_write(out.filep, len, nonblock,
+                              splice_fromfile, &in);
+    }
+  else
+    {
+      ret = -EINVAL;
+    }
+
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  leave_cancellation_point();
+  return ret;
+
+errout:
+  set_errno((int)-ret);
+  leave_cancellation_point();
+  return (ssize_t)ERROR;
+}
+
+/****************************************************************************
+ * Name: tee
+ *
+ * Description:
+ *   Copy up to 'len' bytes from one pipe to another without consuming them.
+ *   The data stays in fd_in and may be read again from there.
+ *
+ * Input Parameters:
+ *   fd_in  - The read end of the source pipe
+ *   fd_out - The write end of the destination pipe
+ *   len    - The maximum number of bytes to copy
+ *   flags  - SPLICE_F_NONBLOCK makes the pipe operations non-blocking
+ *
+ * Returned Value:
+ *   The number of bytes copied, zero if fd_in is at end of file, or -1
+ *   with errno set on failure.
+ *
+ ****************************************************************************/
+
+ssize_t tee(int fd_in, int fd_out, size_t len, unsigned int flags)
+{
+  struct splice_end_s in;
+  struct splice_end_s out;
+  bool nonblock = (flags & SPLICE_F_NONBLOCK) != 0;
+  ssize_t ret;
+
+  enter_cancellation_point();
+
+  ret = splice_getend(fd_in, NULL, nonblock, &in);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = splice_getend(fd_out, NULL, nonblock, &out);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  if (!splice_ispipe(&in) || !splice_ispipe(&out) ||
+      in.filep->f_inode == out.filep->f_inode)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  ret = pipe_splice_read(in.filep, len, nonblock, true,
+                         splice_topipe, &out);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  leave_cancellation_point();
+  return ret;
+
+errout:
+  set_errno((int)-ret);
+  leave_cancellation_point();
+  return (ssize_t)ERROR;
+}
+
+/****************************************************************************
+ * Name: vmsplice
+ *
+ * Description:
+ *   Copy user memory into a pipe (if fd is the write end) or pipe data into
+ *   user memory (if fd is the read end).  Without an MMU, user pages cannot
+ *   be lent to the pipe, so this is a gathering write() or a scattering
+ *   read() that copies directly to or from the pipe buffer.
+ *
+ * Input Parameters:
+ *   fd     - The pipe
+ *   iov    - The user memory
+ *   iovcnt - The number of entries in iov
+ *   flags  - SPLICE_F_NONBLOCK makes the pipe operations non-blocking
+ *
+ * Returned Value:
+ *   The number of bytes moved, or -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+ssize_t vmsplice(int fd, FAR const struct iovec *iov, unsigned long iovcnt,
+                 unsigned int flags)
+{
+  struct splice_end_s end;
+  struct splice_iov_s uio;
+  bool nonblock = (flags & SPLICE_F_NONBLOCK) != 0;
+  size_t total = 0;
+  ssize_t nxfer = 0;
+  ssize_t ret;
+  unsigned long i;
+
+  enter_cancellation_point();
+
+  ret = splice_getend(fd, NULL, nonblock, &end);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  if (!splice_ispipe(&end) || iov == NULL || iovcnt == 0)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      total += iov[i].iov_len;
+    }
+
+  uio.iov    = iov;
+  uio.iovcnt = iovcnt;
+  uio.offset = 0;
+
+  if ((end.filep->f_oflags & O_WROK) != 0)
+    {
+      /* Like write(), wait until all of the data is in the pipe */
+
+      while ((size_t)nxfer < total)
+        {
+          ret = pipe_splice_write(end.filep, total - nxfer, nonblock,
+                                  splice_gather, &uio);
+          if (ret <= 0)
+            {
+              break;
+            }
+
+          nxfer += ret;
+        }
+    }
+  else
+    {
+      /* Like read(), return whatever is available */
+
+      ret = pipe_splice_read(end.filep, total, nonblock, false,
+                             splice_scatter, &uio);
+    }
+
+  if (nxfer > 0)
+    {
+      ret = nxfer;
+    }
+
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  leave_cancellation_point();
+  return ret;
+
+errout:
+  set_errno((int)-ret);
+  leave_cancellation_point();
+  return (ssize_t)ERROR;
+}
+
+#endif /* CONFIG_PIPES */
@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "mmap/fs_rammap.h"
 
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 
@@ -67,6 +68,7 @@
 int file_truncate(FAR struct file *filep, off_t length)
 {
   struct inode *inode;
+  int ret;
 
   /* Was this file opened for write access? */
 
@@ -110,7 +112,15 @@ int file_truncate(FAR struct file *filep, off_t length)
 
   /* Yes, then tell the file system to truncate this file */
 
-  return inode->u.i_mops->truncate(filep, length);
+  ret = inode->u.i_mops->truncate(filep, length);
+  if (ret >= 0)
+    {
+      /* Copies of the file in memory may be stale now */
+
+      rammap_modified(filep);
+    }
+
+  return ret;
 }
 
 /****************************************************************************
@@ -55,6 +55,7 @@
 #include <nuttx/net/net.h>
 
 #include "inode/inode.h"
+#include "mmap/fs_rammap.h"
 
 /****************************************************************************
  * Public Functions
@@ -89,6 +90,7 @@
 ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
 {
   FAR struct inode *inode;
+  ssize_t ret;
 
   /* Was this file opened for write access? */
 
@@ -107,7 +109,15 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
 
   /* Yes, then let the driver perform the write */
 
-  return inode->u.i_ops->write(filep, buf, nbytes);
+  ret = inode->u.i_ops->write(filep, buf, nbytes);
+  if (ret > 0 && INODE_IS_MOUNTPT(inode))
+    {
+      /* Copies of the file in memory may be stale now */
+
+      rammap_modified(filep);
+    }
+
+  return ret;
 }
 
 /****************************************************************************
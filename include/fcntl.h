@@ -110,6 +110,8 @@
 #define F_SETLKW    12 /* Like F_SETLK, but wait for lock to become available */
 #define F_SETOWN    13 /* Set pid that will receive SIGIO and SIGURG signals for fd */
 #define F_SETSIG    14 /* Set the signal to be sent */
+#define F_SETPIPE_SZ 15 /* Set the pipe buffer size (linux) */
+#define F_GETPIPE_SZ 16 /* Get the pipe buffer size (linux) */
 
 /* For posix fcntl() and lockf() */
 
@@ -130,6 +132,15 @@
 #define DN_RENAME   4  /* A file was renamed */
 #define DN_ATTRIB   5  /* Attributes of a file were changed */
 
+/* Flags for splice(), tee() and vmsplice() (linux).  Only SPLICE_F_NONBLOCK
+ * has an effect.
+ */
+
+#define SPLICE_F_MOVE     (1 << 0) /* Move pages instead of copying */
+#define SPLICE_F_NONBLOCK (1 << 1) /* Do not block on pipe I/O */
+#define SPLICE_F_MORE     (1 << 2) /* More data will follow */
+#define SPLICE_F_GIFT     (1 << 3) /* User pages are gifted */
+
 /* int creat(const char *path, mode_t mode);
  *
  * is equivalent to open with O_WRONLY|O_CREAT|O_TRUNC.
@@ -174,6 +185,18 @@ extern "C"
 int open(const char *path, int oflag, ...);
 int fcntl(int fd, int cmd, ...);
 
+/* Linux-like interfaces to move data to and from pipes */
+
+#ifdef CONFIG_PIPES
+struct iovec;  /* Forward reference */
+
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags);
+ssize_t tee(int fd_in, int fd_out, size_t len, unsigned int flags);
+ssize_t vmsplice(int fd, FAR const struct iovec *iov, unsigned long iovcnt,
+                 unsigned int flags);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
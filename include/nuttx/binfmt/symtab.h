@@ -90,6 +90,28 @@ void exec_getsymtab(FAR const struct symtab_s **symtab, FAR int *nsymbols);
 
 void exec_setsymtab(FAR const struct symtab_s *symtab, int nsymbols);
 
+/****************************************************************************
+ * Name: exec_getsymhash
+ *
+ * Description:
+ *   Get the precomputed hash index of an application symbol table.  Only
+ *   the generated system symbol table comes with one.
+ *
+ * Input Parameters:
+ *   symtab - The symbol table.
+ *   nsymbols - The number of symbols in the symbol table.
+ *
+ * Returned Value:
+ *   The hash index of the symbol table or NULL if it has no precomputed
+ *   index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYMTAB_HASHED
+FAR const struct symtab_hash_s *
+exec_getsymhash(FAR const struct symtab_s *symtab, int nsymbols);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
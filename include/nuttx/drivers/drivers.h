@@ -43,8 +43,23 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_PIPES
+/* The callback of pipe_splice_read() and pipe_splice_write().  It consumes
+ * or produces up to 'len' bytes of the pipe buffer at 'buffer' and returns
+ * the number of bytes it handled or a negated errno value.
+ */
+
+typedef CODE ssize_t (*pipe_splice_t)(FAR void *arg, FAR uint8_t *buffer,
+                                      size_t len);
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -280,6 +295,49 @@ int pipe2(int fd[2], size_t bufsize);
 int mkfifo2(FAR const char *pathname, mode_t mode, size_t bufsize);
 #endif
 
+/****************************************************************************
+ * Name: pipe_check
+ *
+ * Description:
+ *   Check if an open file is the read or write end of a pipe or FIFO.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PIPES
+struct file;  /* Forward reference */
+
+bool pipe_check(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pipe_splice_read and pipe_splice_write
+ *
+ * Description:
+ *   Move data out of or into a pipe through a callback that works on the
+ *   pipe buffer in place.  These are the building blocks of splice() and
+ *   tee(); they let data go from a pipe to a file or socket, or the other
+ *   way round, with a single copy.
+ *
+ * Input Parameters:
+ *   filep    - The read end (pipe_splice_read) or the write end
+ *              (pipe_splice_write) of the pipe
+ *   len      - The maximum number of bytes to move
+ *   nonblock - Return -EAGAIN instead of waiting
+ *   peek     - Leave the data in the pipe (pipe_splice_read only)
+ *   callback - Consumes or produces the data
+ *   arg      - The argument of the callback
+ *
+ * Returned Value:
+ *   The number of bytes moved, zero at end of file, or a negated errno
+ *   value if nothing was moved.
+ *
+ ****************************************************************************/
+
+ssize_t pipe_splice_read(FAR struct file *filep, size_t len, bool nonblock,
+                         bool peek, pipe_splice_t callback, FAR void *arg);
+ssize_t pipe_splice_write(FAR struct file *filep, size_t len, bool nonblock,
+                          pipe_splice_t callback, FAR void *arg);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -44,7 +44,9 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 
@@ -58,6 +60,45 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+/* The write buffer is divided into segments.  Each segment holds one
+ * extent of contiguous dirty blocks.  A segment is filled while DIRTY,
+ * then COMMITTED for write-back, then WRITING while the flush callout
+ * transfers it to the media, and finally FREE again.
+ */
+
+enum rwb_segstate_e
+{
+  RWB_SEG_FREE = 0,              /* Not in use */
+  RWB_SEG_DIRTY,                 /* Accepting new data */
+  RWB_SEG_COMMITTED,             /* Waiting to be written to the media */
+  RWB_SEG_WRITING                /* Being written to the media */
+};
+
+struct rwb_segment_s
+{
+  FAR uint8_t  *buffer;          /* Data of the segment */
+  off_t         blockstart;      /* First block of the extent */
+  uint16_t      nblocks;         /* Number of blocks in the extent */
+  uint8_t       state;           /* See enum rwb_segstate_e */
+  uint32_t      seq;             /* Age; committed segments flush in order */
+};
+
+/* Write buffer statistics, see rwb_getstats() */
+
+struct rwb_stats_s
+{
+  uint32_t      wrblocks;        /* Blocks written by the buffer user */
+  uint32_t      devblocks;       /* Blocks written to the media */
+  uint32_t      devwrites;       /* Write requests sent to the media */
+  uint32_t      rdhits;          /* Blocks read from the write buffer */
+  uint32_t      stalls;          /* Writes that waited for a free segment */
+  clock_t       stallticks;      /* Total time writers waited */
+  clock_t       flushticks;      /* Total time of the media writes */
+  clock_t       maxflushticks;   /* Longest media write */
+};
+#endif
+
 /* Data transfer callouts.  These must be provided by the block driver
  * logic in order to flush the write buffer when appropriate or to
  * reload the read-ahead buffer, when appropriate.
@@ -140,11 +181,25 @@ struct rwbuffer_s
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
   sem_t         wrsem;           /* Enforces exclusive access to the write buffer */
+  sem_t         wrdonesem;       /* Signals the end of a segment write */
   struct work_s work;            /* Delayed work to flush buffer after a delay with no activity */
+  struct work_s wrwork;          /* Work to write back committed segments */
   uint8_t      *wrbuffer;        /* Allocated write buffer */
-  uint16_t      wrnblocks;       /* Number of blocks in write buffer */
-  off_t         wrblockstart;    /* First block in write buffer */
-  off_t         wrexpectedblock; /* Next block expected */
+  FAR struct rwb_segment_s *wrsegs; /* Write buffer segments */
+  uint16_t      wrnsegs;         /* Number of segments */
+  uint16_t      wrsegblocks;     /* Number of blocks per segment */
+  uint16_t      wrninflight;     /* Number of committed or writing segments */
+  uint16_t      wrnwaiters;      /* Number of threads waiting on wrdonesem */
+  bool          wrbusy;          /* A thread is writing segments */
+  int           wrerror;         /* Deferred write-back error */
+  uint32_t      wrseq;           /* Next segment sequence number */
+  struct rwb_stats_s wrstats;    /* Write buffer statistics */
+#endif
+
+  /* Serializes the callouts to the device */
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_SCHED_WORKQUEUE)
+  sem_t         devsem;          /* Enforces exclusive access to the device */
 #endif
 
   /* This is the state of the read-ahead buffering */
@@ -207,8 +262,17 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
 int rwb_flush(FAR struct rwbuffer_s *rwb);
+int rwb_getstats(FAR struct rwbuffer_s *rwb,
+                 FAR struct rwb_stats_s *stats);
 #endif
 
+/* Exclusive access to the device for media operations that do not go
+ * through the buffer, such as probing or removal of the media.
+ */
+
+void rwb_lock(FAR struct rwbuffer_s *rwb);
+void rwb_unlock(FAR struct rwbuffer_s *rwb);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -95,6 +95,32 @@
 #  define _NX_GETERRVAL(r)     (-errno)
 #endif
 
+/* The file descriptor table of a task group is a list of blocks of
+ * FILELIST_BLOCK descriptors.  The first block is part of the table; the
+ * others are allocated when a descriptor in their range is first needed
+ * and are kept until the task group exits.
+ */
+
+#ifndef CONFIG_NFILE_DESCRIPTORS_PER_BLOCK
+#  define CONFIG_NFILE_DESCRIPTORS_PER_BLOCK 8
+#endif
+
+#if CONFIG_NFILE_DESCRIPTORS_PER_BLOCK > 32
+#  error CONFIG_NFILE_DESCRIPTORS_PER_BLOCK must not exceed 32
+#endif
+
+#if CONFIG_NFILE_DESCRIPTORS < CONFIG_NFILE_DESCRIPTORS_PER_BLOCK
+#  define FILELIST_BLOCK CONFIG_NFILE_DESCRIPTORS
+#else
+#  define FILELIST_BLOCK CONFIG_NFILE_DESCRIPTORS_PER_BLOCK
+#endif
+
+#define FILELIST_NBLOCKS \
+  ((CONFIG_NFILE_DESCRIPTORS + FILELIST_BLOCK - 1) / FILELIST_BLOCK)
+
+#define FILELIST_ROW(fd)  ((fd) / FILELIST_BLOCK)
+#define FILELIST_COL(fd)  ((fd) % FILELIST_BLOCK)
+
 /* Stream flags for the fs_flags field of in struct file_struct */
 
 #define __FS_FLAG_EOF   (1 << 0) /* EOF detected by a read operation */
@@ -408,12 +434,27 @@ struct file
   void             *f_priv;     /* Per file driver private data */
 };
 
-/* This defines a list of files indexed by the file descriptor */
+/* This defines a list of files indexed by the file descriptor.  Use
+ * files_fget() to get the file structure of a descriptor.
+ */
 
 struct filelist
 {
   sem_t   fl_sem;               /* Manage access to the file list */
-  struct file fl_files[CONFIG_NFILE_DESCRIPTORS];
+
+  /* One bit per descriptor of each block, set while the descriptor is in
+   * use.  Only modified with fl_sem held.
+   */
+
+  uint32_t fl_inuse[FILELIST_NBLOCKS];
+
+  /* The blocks of file structures, NULL if not yet allocated.  A block is
+   * never moved or freed while the list exists so that readers need no
+   * lock.
+   */
+
+  FAR struct file *fl_blocks[FILELIST_NBLOCKS];
+  struct file fl_files[FILELIST_BLOCK]; /* The first block */
 };
 
 /* The following structure defines the list of files used for standard C I/O.
@@ -708,6 +749,31 @@ void files_initlist(FAR struct filelist *list);
 
 void files_releaselist(FAR struct filelist *list);
 
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of the descriptor 'fd' in 'list', NULL if
+ *   'fd' is out of range or if its block has never been allocated.  The
+ *   file structure is returned whether or not the descriptor is open.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd);
+
+/****************************************************************************
+ * Name: files_duplist
+ *
+ * Description:
+ *   Duplicate the first 'nfds' open descriptors of 'plist' that are not
+ *   marked close-on-exec into 'clist', using the same descriptor numbers.
+ *   This is used to let a new task inherit the descriptors of its parent.
+ *
+ ****************************************************************************/
+
+void files_duplist(FAR struct filelist *plist, FAR struct filelist *clist,
+                   int nfds);
+
 /****************************************************************************
  * Name: file_dup2
  *
@@ -1316,6 +1382,27 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf);
 
 int fdesc_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Drivers call this function after updating fds->revents in order to
+ *   wake up the waiter.  The waiter is either poll()/select(), which are
+ *   awakened through fds->sem, or a persistent epoll registration, which
+ *   is notified through the fds->cb callback.
+ *
+ *   This function may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure with the updated revents
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
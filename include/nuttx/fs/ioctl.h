@@ -270,6 +270,12 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_RWBSTATS   _BIOC(0x000e)     /* Get the write buffer statistics
+                                           * IN:  Pointer to writable instance
+                                           *      of struct rwb_stats_s in
+                                           *      which to return statistics.
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -386,6 +392,13 @@
                                              *       (default)
                                              *     1=fre when empty
                                              * OUT: None */
+#define PIPEIOC_SETSIZE   _PIPEIOC(0x0002)  /* Resize the pipe buffer
+                                             * IN: unsigned long integer
+                                             *     New buffer size in bytes
+                                             * OUT: None */
+#define PIPEIOC_GETSIZE   _PIPEIOC(0x0003)  /* Get the pipe buffer size
+                                             * IN: Pointer to int
+                                             * OUT: Buffer size in bytes */
 
 /* RTC driver ioctl definitions *********************************************/
 
@@ -32,6 +32,8 @@
 #include <string.h>
 #include <semaphore.h>
 
+#include <nuttx/spinlock.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -165,6 +167,34 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0)
 
+/* Small object cache.  Freed chunks up to CONFIG_MM_CACHE_MAXSIZE bytes
+ * are kept in per-CPU, per-size class lists and handed back out by
+ * mm_malloc() without taking the heap semaphore.  The cache disables
+ * interrupts on the local CPU and so, like the delayed free list, it is
+ * only available in the FLAT build or in the kernel heap.
+ */
+
+#undef MM_HAVE_CACHE
+#if defined(CONFIG_MM_CACHE) && \
+   (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_HAVE_CACHE 1
+
+#  ifdef CONFIG_SMP
+#    define MM_CACHE_NCPUS  CONFIG_SMP_NCPUS
+#  else
+#    define MM_CACHE_NCPUS  1
+#  endif
+
+#  define MM_CACHE_MAXCHUNK \
+     MM_ALIGN_UP(CONFIG_MM_CACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#  define MM_CACHE_NCLASSES (MM_CACHE_MAXCHUNK >> MM_MIN_SHIFT)
+
+/* Map a chunk size (a multiple of MM_MIN_CHUNK) to its size class */
+
+#  define MM_CACHE_NDX(s)   (((s) >> MM_MIN_SHIFT) - 1)
+#  define MM_CACHE_SIZE(n)  (((n) + 1) << MM_MIN_SHIFT)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -218,6 +248,46 @@ struct mm_delaynode_s
 };
 #endif
 
+#ifdef MM_HAVE_CACHE
+/* A cached chunk remains allocated as far as the heap is concerned.  The
+ * link to the next cached chunk of the same size class is kept in the
+ * user data area.
+ */
+
+struct mm_cachenode_s
+{
+  FAR struct mm_cachenode_s *flink;
+};
+
+/* The small object cache of one CPU */
+
+struct mm_cache_s
+{
+#ifdef CONFIG_SMP
+  /* Only the owning CPU uses the cache, except while the cache is being
+   * drained.  This lock is therefore (almost) never contended.
+   */
+
+  spinlock_t mc_lock;
+#endif
+
+  FAR struct mm_cachenode_s *mc_head[MM_CACHE_NCLASSES];
+  uint16_t mc_count[MM_CACHE_NCLASSES];  /* Number of cached chunks */
+  uint32_t mc_hits[MM_CACHE_NCLASSES];   /* Allocations served by cache */
+  uint32_t mc_misses[MM_CACHE_NCLASSES]; /* Allocations from the heap */
+};
+
+/* Statistics for one size class, summed over all CPUs */
+
+struct mm_cacheinfo_s
+{
+  size_t   size;                         /* Chunk size of the class */
+  size_t   cached;                       /* Number of cached chunks */
+  uint32_t hits;                         /* Allocations served by cache */
+  uint32_t misses;                       /* Allocations from the heap */
+};
+#endif
+
 /* What is the size of the freenode? */
 
 #define MM_PTR_SIZE sizeof(FAR struct mm_freenode_s *)
@@ -263,6 +333,12 @@ struct mm_heap_s
 
   struct mm_delaynode_s *mm_delaylist;
 #endif
+
+#ifdef MM_HAVE_CACHE
+  /* Per-CPU small object caches */
+
+  struct mm_cache_s mm_cache[MM_CACHE_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -379,6 +455,20 @@ FAR void *kmm_malloc(size_t size);
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
 
+#ifdef MM_HAVE_CACHE
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
+#endif
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef MM_HAVE_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+int mm_cache_drain(FAR struct mm_heap_s *heap);
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int ndx,
+                 FAR struct mm_cacheinfo_s *info);
+#endif
+
 /* Functions contained in kmm_free.c ****************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -108,11 +108,15 @@ struct mqueue_inode_s
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
-#if CONFIG_MQ_MAXMSGSIZE < 256
+  int16_t peakmsgs;           /* High-water mark of nmsgs */
+#if CONFIG_MQ_MAXMSGSIZE < 256 && \
+    (!defined(CONFIG_MQ_MAXLARGEMSGSIZE) || CONFIG_MQ_MAXLARGEMSGSIZE < 256)
   uint8_t maxmsgsize;         /* Max size of message in message queue */
 #else
   uint16_t maxmsgsize;        /* Max size of message in message queue */
 #endif
+  uint32_t nbytes;            /* Number of payload bytes in the queue */
+  uint32_t peakbytes;         /* High-water mark of nbytes */
   FAR struct mq_des *ntmqdes; /* Notification: Owning mqdes (NULL if none) */
   pid_t ntpid;                /* Notification: Receiving Task's PID */
   struct sigevent ntevent;    /* Notification description */
@@ -295,6 +299,90 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
                           FAR unsigned int *prio,
                           FAR const struct timespec *abstime);
 
+/****************************************************************************
+ * Name: nxmq_alloc_buffer
+ *
+ * Description:
+ *   Allocate a message buffer for the zero-copy interfaces.  The buffer is
+ *   the payload of a message so that nxmq_send_buffer() can queue it
+ *   without copying.  This may be called from an interrupt handler, but
+ *   only for buffers no larger than CONFIG_MQ_MAXMSGSIZE.
+ *
+ * Input Parameters:
+ *   buflen - The size of the buffer in bytes
+ *
+ * Returned Value:
+ *   The allocated buffer or NULL if no message could be allocated.
+ *
+ ****************************************************************************/
+
+FAR void *nxmq_alloc_buffer(size_t buflen);
+
+/****************************************************************************
+ * Name: nxmq_free_buffer
+ *
+ * Description:
+ *   Release a buffer obtained from nxmq_alloc_buffer() that was not sent
+ *   or a buffer returned by nxmq_receive_buffer().
+ *
+ * Input Parameters:
+ *   buffer - The buffer to release
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxmq_free_buffer(FAR void *buffer);
+
+/****************************************************************************
+ * Name: nxmq_send_buffer
+ *
+ * Description:
+ *   Queue the message that holds 'buffer' without copying the payload.
+ *   This behaves like nxmq_send() otherwise.  On success, the buffer
+ *   belongs to the message queue and must no longer be accessed by the
+ *   caller.  On failure, the caller still owns the buffer.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - Buffer obtained from nxmq_alloc_buffer()
+ *   msglen - The length of the message in bytes; no larger than the
+ *            buffer size
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure (see
+ *   nxmq_send()).
+ *
+ ****************************************************************************/
+
+int nxmq_send_buffer(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                     unsigned int prio);
+
+/****************************************************************************
+ * Name: nxmq_receive_buffer
+ *
+ * Description:
+ *   Remove the oldest of the highest priority messages from the message
+ *   queue and return its payload without copying.  This behaves like
+ *   nxmq_receive() otherwise.  The caller must release the buffer with
+ *   nxmq_free_buffer().
+ *
+ * Input Parameters:
+ *   mqdes  - Message Queue Descriptor
+ *   buffer - The location to return the message buffer
+ *   prio   - If not NULL, the location to store message priority.
+ *
+ * Returned Value:
+ *   The length of the message on success; a negated errno value on
+ *   failure (see nxmq_receive()).
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_receive_buffer(mqd_t mqdes, FAR void **buffer,
+                            FAR unsigned int *prio);
+
 /****************************************************************************
  * Name: nxmq_free_msgq
  *
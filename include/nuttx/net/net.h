@@ -1012,6 +1012,45 @@ ssize_t psock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 #define psock_recv(psock,buf,len,flags) \
   psock_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Take the I/O buffer chain at the head of the read-ahead queue of a TCP
+ *   or UDP socket.  This lets in-kernel consumers use the received data
+ *   without copying it.  For a UDP socket, the chain holds exactly one
+ *   datagram.  For a TCP socket, it holds the data of one or more
+ *   segments.  This is an internal OS interface; it never waits for data.
+ *
+ *   The caller owns the returned chain and must release it with
+ *   iob_free_chain() using IOBUSER_NET_TCP_READAHEAD or
+ *   IOBUSER_NET_UDP_READAHEAD.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iobp    - The location to return the I/O buffer chain
+ *   from    - Address of the source of a UDP datagram (may be NULL)
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   The number of bytes in the returned chain on success.  Zero is returned
+ *   with *iobp set to NULL if a TCP peer performed an orderly shutdown.
+ *   Otherwise, a negated errno value is returned:
+ *
+ *   EAGAIN     - No data is buffered
+ *   EBADF      - The socket is not valid
+ *   ENOTCONN   - The TCP socket is not connected
+ *   EOPNOTSUPP - The socket is not a TCP or UDP socket
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_RX
+struct iob_s;  /* Forward reference */
+
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iobp,
+                      FAR struct sockaddr *from, FAR socklen_t *fromlen);
+#endif
+
 /****************************************************************************
  * Name: nx_recvfrom
  *
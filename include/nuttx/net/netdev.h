@@ -220,6 +220,7 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference See iob.h */
 
 struct net_driver_s
 {
@@ -301,6 +302,20 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NET_IOB_RX
+  /* If the driver received the packet into an I/O buffer, d_iob refers to
+   * that IOB and d_buf must point to its data (&io_data[io_offset]).  The
+   * whole packet must be held in that single IOB.  The network may adopt
+   * the IOB to buffer the payload without copying.  In that case it
+   * replaces d_iob and d_buf with a new IOB that holds a copy of the
+   * headers; any outgoing packet is then in the new IOB.  Either way, the
+   * driver owns the IOB in d_iob after the input function returns.
+   * Drivers that do not use IOBs must leave d_iob NULL.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -340,6 +355,16 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NET_CHKSUM_COPY
+  /* When non-zero, d_sndsumlen is the d_sndlen for which d_sndsum holds the
+   * partial checksum of the data at d_appdata, computed while that data was
+   * copied into d_buf.  It is consumed by the next upper layer checksum.
+   */
+
+  uint16_t d_sndsum;
+  uint16_t d_sndsumlen;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
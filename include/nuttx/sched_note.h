@@ -66,6 +66,12 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+/* The maximum length of the name of a user-defined note event, not
+ * including the NUL terminator.  Longer names are truncated.
+ */
+
+#define NOTE_EVENT_NAMELEN 31
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -106,18 +112,27 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+  ,
+  NOTE_USER_BEGIN      = 18,
+  NOTE_USER_END        = 19,
+  NOTE_USER_COUNTER    = 20,
+  NOTE_USER_MARK       = 21
+#endif
 };
 
-/* This structure provides the common header of each note */
+/* This structure provides the common header of each note.  The layout is
+ * the same in all configurations so that a stream of notes can be decoded
+ * without knowing the configuration.  nc_systime holds the system timer
+ * or, with CONFIG_SCHED_NOTE_HIRES, the value of up_critmon_gettime().
+ */
 
 struct note_common_s
 {
   uint8_t nc_length;           /* Length of the note */
   uint8_t nc_type;             /* See enum note_type_e */
   uint8_t nc_priority;         /* Thread/task priority */
-#ifdef CONFIG_SMP
   uint8_t nc_cpu;              /* CPU thread/task running on */
-#endif
   uint8_t nc_pid[2];           /* ID of the thread/task */
   uint8_t nc_systime[4];       /* Time when note was buffered */
 };
@@ -234,6 +249,17 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+/* This is the specific form of the NOTE_USER_* notes */
+
+struct note_event_s
+{
+  struct note_common_s nev_cmn; /* Common note parameters */
+  uint8_t nev_value[4];         /* Counter value, little endian */
+  char    nev_name[1];          /* Start of the NUL terminated event name */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_USER */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -305,12 +331,49 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #  define sched_note_spinabort(t,s)
 #endif
 
+/****************************************************************************
+ * Name: sched_note_event
+ *
+ * Description:
+ *   Add a user-defined note to the instrumentation buffer.  Unlike the
+ *   hooks above, this interface is available to application code.  The
+ *   sched_note_begin() and sched_note_end() macros bracket a span of time,
+ *   sched_note_counter() records the value of a named counter and
+ *   sched_note_mark() records a single point in time.
+ *
+ * Input Parameters:
+ *   type  - One of the NOTE_USER_* note types
+ *   name  - The name of the event.  It is truncated to NOTE_EVENT_NAMELEN
+ *           characters.
+ *   value - The counter value (NOTE_USER_COUNTER only)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_event(uint8_t type, FAR const char *name, int32_t value);
+
+#  define sched_note_begin(n)     sched_note_event(NOTE_USER_BEGIN, n, 0)
+#  define sched_note_end(n)       sched_note_event(NOTE_USER_END, n, 0)
+#  define sched_note_counter(n,v) sched_note_event(NOTE_USER_COUNTER, n, v)
+#  define sched_note_mark(n)      sched_note_event(NOTE_USER_MARK, n, 0)
+#else
+#  define sched_note_begin(n)
+#  define sched_note_end(n)
+#  define sched_note_counter(n,v)
+#  define sched_note_mark(n)
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
  * Description:
  *   Remove the next note from the tail of the circular buffer.  The note
  *   is also removed from the circular buffer to make room for further notes.
+ *   With several CPUs, the oldest of the notes at the tails of the per-CPU
+ *   buffers is returned.  Only one thread at a time may read notes.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -387,6 +450,10 @@ int note_register(void);
 #  define sched_note_spinlocked(t,s)
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
+#  define sched_note_begin(n)
+#  define sched_note_end(n)
+#  define sched_note_counter(n,v)
+#  define sched_note_mark(n)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
@@ -196,6 +196,7 @@ struct iob_s;  /* Forward reference */
 struct lib_syslogstream_s
 {
   struct lib_outstream_s public;
+  int priority;                 /* Priority of the message */
 #ifdef CONFIG_SYSLOG_BUFFER
   FAR struct iob_s *iob;
 #endif
@@ -364,15 +365,17 @@ void lib_nulloutstream(FAR struct lib_outstream_s *nulloutstream);
  *   Only accessible from with the OS SYSLOG logic.
  *
  * Input Parameters:
- *   stream - User allocated, uninitialized instance of struct
- *            lib_syslogstream_s to be initialized.
+ *   stream   - User allocated, uninitialized instance of struct
+ *              lib_syslogstream_s to be initialized.
+ *   priority - The priority of the message written to the stream.
  *
  * Returned Value:
  *   None (User allocated instance initialized).
  *
  ****************************************************************************/
 
-void syslogstream_create(FAR struct lib_syslogstream_s *stream);
+void syslogstream_create(FAR struct lib_syslogstream_s *stream,
+                         int priority);
 
 /****************************************************************************
  * Name: syslogstream_destroy
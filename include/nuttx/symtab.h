@@ -42,10 +42,18 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Marks the end of a hash bucket chain.  A hash index can therefore cover
+ * at most SYMTAB_HASH_NONE symbols.
+ */
+
+#define SYMTAB_HASH_NONE   0xffff
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -70,6 +78,25 @@ struct symtab_s
   FAR const void *sym_value;         /* The value associated with the string */
 };
 
+/* struct symtab_hash_s is a hash index over a symbol table.  The symbols are
+ * distributed over sh_nbuckets buckets by symtab_hash() of their names.
+ * sh_bucket[] holds the table index of the first symbol of each bucket and
+ * sh_chain[] holds, for each symbol, the table index of the next symbol in
+ * the same bucket.  Both lists end with SYMTAB_HASH_NONE.  Symbols appear
+ * in each chain in table order so that a lookup finds the same entry as a
+ * linear search would.
+ *
+ * The index is either generated together with the symbol table by
+ * "mksymtab -h" or built at run time by symtab_hashinit().
+ */
+
+struct symtab_hash_s
+{
+  uint16_t sh_nbuckets;              /* Number of buckets, a power of two */
+  FAR const uint16_t *sh_bucket;     /* First symbol of each bucket */
+  FAR const uint16_t *sh_chain;      /* Next symbol in the same bucket */
+};
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -150,6 +177,70 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 void symtab_sortbyname(FAR struct symtab_s *symtab, int nsyms);
 
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the hash value of a symbol name.  This is the same hash function
+ *   that is used by tools/mksymtab.c to generate the hash index of a symbol
+ *   table.
+ *
+ * Returned Value:
+ *   The hash value of the name.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build a hash index over an existing symbol table.  The symbol table
+ *   must not be modified while the index is in use.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure:  -EINVAL if the table is too large to be indexed or -ENOMEM
+ *   if the index could not be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms);
+
+/****************************************************************************
+ * Name: symtab_hashuninit
+ *
+ * Description:
+ *   Free a hash index that was built by symtab_hashinit().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void symtab_hashuninit(FAR struct symtab_hash_s *hash);
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol in the symbol table with the matching name using the
+ *   hash index of the table.  Access time is independent of the number of
+ *   symbols in the table.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_s *symtab,
+                  FAR const struct symtab_hash_s *hash,
+                  FAR const char *name);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -83,6 +83,10 @@
 #  define CONFIG_SYSLOG_DEVPATH "/dev/ttyS1"
 #endif
 
+#ifndef CONFIG_SYSLOG_MAX_CHANNELS
+#  define CONFIG_SYSLOG_MAX_CHANNELS 1
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
 #  ifndef CONFIG_SYSLOG_INTBUFSIZE
 #    define CONFIG_SYSLOG_INTBUFSIZE 512
@@ -142,17 +146,63 @@ extern "C"
  *   Configure the SYSLOGging function to use the provided channel to
  *   generate SYSLOG output.
  *
+ *   If CONFIG_SYSLOG_MAX_CHANNELS is greater than one, the channel is
+ *   added to the channels already in use (replacing only the built-in
+ *   default channel) and receives messages of all priorities until
+ *   syslog_channel_level() is called.
+ *
  * Input Parameters:
  *   channel - Provides the interface to the channel to be used.
  *
  * Returned Value:
  *   Zero (OK)is returned on  success.  A negated errno value is returned
- *   on any failure.
+ *   on any failure.  -ENOMEM is returned if CONFIG_SYSLOG_MAX_CHANNELS
+ *   channels are already in use.
  *
  ****************************************************************************/
 
 int syslog_channel(FAR const struct syslog_channel_s *channel);
 
+/****************************************************************************
+ * Name: syslog_channel_remove
+ *
+ * Description:
+ *   Stop using a channel that was added with syslog_channel().  If no
+ *   channel remains, the built-in default channel is used again.
+ *
+ * Input Parameters:
+ *   channel - The channel to be removed.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -ENOENT is returned if the channel
+ *   is not in use.
+ *
+ ****************************************************************************/
+
+int syslog_channel_remove(FAR const struct syslog_channel_s *channel);
+
+/****************************************************************************
+ * Name: syslog_channel_level
+ *
+ * Description:
+ *   Set the lowest priority of the messages that are sent to a channel.
+ *   Messages with a lower priority (a higher numeric value) are not sent
+ *   to this channel.  Output that does not come from syslog() (such as
+ *   /dev/syslog or console output) is always sent.
+ *
+ * Input Parameters:
+ *   channel  - A channel that was added with syslog_channel().
+ *   priority - One of LOG_EMERG through LOG_DEBUG.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on any failure.
+ *
+ ****************************************************************************/
+
+int syslog_channel_level(FAR const struct syslog_channel_s *channel,
+                         int priority);
+
 /****************************************************************************
  * Name: syslog_initialize
  *
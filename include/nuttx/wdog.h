@@ -131,6 +131,10 @@ struct wdog_s
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  FAR struct wdog_s *prev;       /* Support for doubly linked wheel slots */
+  uint8_t            slot;       /* Index of the wheel slot of the wdog */
+#endif
 };
 
 /* Watchdog 'handle' */
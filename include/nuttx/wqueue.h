@@ -72,6 +72,9 @@
  *   priority worker thread.  Default: 224
  * CONFIG_SCHED_HPWORKSTACKSIZE - The stack size allocated for the worker
  *   thread.  Default: 2048.
+ * CONFIG_SCHED_HPWORK_PERCPU - Create one high-priority queue per CPU,
+ *   each with one worker thread pinned to its CPU.  Work is queued on the
+ *   queue of the calling CPU.  CONFIG_SCHED_HPNTHREADS is then ignored.
  * CONFIG_SIG_SIGWORK - The signal number that will be used to wake-up
  *   the worker thread.  Default: 17
  *
@@ -88,6 +91,9 @@
  * CONFIG_SCHED_LPWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: 2048.
  *
+ * CONFIG_WQUEUE_STATISTICS - Keep per-worker latency statistics of the
+ *   kernel work queues.  See work_stats().
+ *
  * The user-mode work queue is only available in the protected or kernel
  * builds.  This those configurations, the user-mode work queue provides the
  * same (non-standard) facility for use by applications.
@@ -274,8 +280,26 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  uint8_t cpu;           /* Index of the per-CPU queue holding the work */
+#endif
 };
 
+#ifdef CONFIG_WQUEUE_STATISTICS
+/* This structure holds the statistics of one work queue as returned by
+ * work_stats().  All times are in clock ticks.
+ */
+
+struct work_stats_s
+{
+  uint32_t count;        /* Number of work items performed */
+  clock_t waittime;      /* Total time from due time until started */
+  clock_t waitmax;       /* Longest time from due time until started */
+  clock_t runtime;       /* Total time spent in the work callbacks */
+  clock_t runmax;        /* Longest time spent in one work callback */
+};
+#endif
+
 /* This is an enumeration of the various events that may be
  * notified via work_notifier_signal().
  */
@@ -431,6 +455,32 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_stats
+ *
+ * Description:
+ *   Return the statistics of one kernel work queue, summed over all of its
+ *   worker threads.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID (must be HPWORK or LPWORK)
+ *   ndx   - The CPU index of the per-CPU high priority queue.  Must be zero
+ *           for all other queues.
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.  This error may be
+ *   reported:
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *   -ENOENT - There is no queue with the index ndx
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+int work_stats(int qid, int ndx, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
@@ -110,6 +110,14 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* Non-standard notification callback.  If a callback is provided in struct
+ * pollfd, poll_notify() will call it instead of posting the semaphore.
+ * This is used by epoll to keep persistent registrations with drivers.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -132,6 +140,8 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* Notification callback (NULL: post sem) */
+  FAR void    *arg;     /* Argument for use by the callback */
 };
 
 /****************************************************************************
@@ -40,6 +40,10 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <fcntl.h>
 #include <poll.h>
 
 /****************************************************************************
@@ -50,6 +54,17 @@
 #define EPOLL_CTL_DEL 2 /* Remove a file descriptor from the interface.  */
 #define EPOLL_CTL_MOD 3 /* Change file descriptor epoll_event structure.  */
 
+/* Flags for epoll_create1() */
+
+#define EPOLL_CLOEXEC O_CLOEXEC
+
+/* Event flags that are not EPOLL_EVENTS because an enumeration constant
+ * must be in the range of int.
+ */
+
+#define EPOLLONESHOT  (1ul << 30)
+#define EPOLLET       (1ul << 31)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -72,39 +87,50 @@ enum EPOLL_EVENTS
 #define EPOLLWRBAND EPOLLWRBAND
     EPOLLERR = POLLERR,
 #define EPOLLERR EPOLLERR
-    EPOLLHUP = POLLHUP,
+    EPOLLHUP = POLLHUP
 #define EPOLLHUP EPOLLHUP
   };
 
 typedef union poll_data
 {
+  FAR void    *ptr;
   int          fd;       /* The descriptor being polled */
+  uint32_t     u32;
+#ifdef __INT64_DEFINED
+  uint64_t     u64;
+#endif
 } epoll_data_t;
 
 struct epoll_event
 {
-  epoll_data_t data;
-  FAR sem_t   *sem;      /* Pointer to semaphore used to post output event */
-  pollevent_t  events;   /* The input event flags */
-  pollevent_t  revents;  /* The output event flags */
-  FAR void    *priv;     /* For use by drivers */
-};
-
-struct epoll_head
-{
-  int size;
-  int occupied;
-  FAR struct epoll_event *evs;
+  uint32_t     events;   /* The input/output event flags */
+  epoll_data_t data;     /* Returned unmodified by epoll_wait() */
 };
 
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
 int epoll_create(int size);
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev);
-int epoll_wait(int epfd, struct epoll_event *evs, int maxevents, int timeout);
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev);
+int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
+               int timeout);
 
 void epoll_close(int epfd);
 
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
 #endif /* __INCLUDE_SYS_EPOLL_H */
@@ -78,7 +78,16 @@
 
 #define SYS_set_errno                  (__SYS_set_errno + 0)
 #define SYS_uname                      (__SYS_set_errno + 1)
-#define __SYS_uid                      (__SYS_set_errno + 2)
+#define __SYS_sched_note               (__SYS_set_errno + 2)
+
+/* User-defined instrumentation notes */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+#  define SYS_sched_note_event         (__SYS_sched_note + 0)
+#  define __SYS_uid                    (__SYS_sched_note + 1)
+#else
+#  define __SYS_uid                    (__SYS_sched_note + 0)
+#endif
 
 /* User identity */
 
@@ -356,7 +365,8 @@
 
 #ifdef CONFIG_FS_RAMMAP
 #  define SYS_munmap                   (__SYS_filedesc + 16)
-#  define __SYS_link                   (__SYS_filedesc + 17)
+#  define SYS_msync                    (__SYS_filedesc + 17)
+#  define __SYS_link                   (__SYS_filedesc + 18)
 #else
 #  define __SYS_link                   (__SYS_filedesc + 16)
 #endif
@@ -378,9 +388,18 @@
 
 #if defined(CONFIG_PIPES) && CONFIG_DEV_FIFO_SIZE > 0
 #  define SYS_mkfifo2                  (__SYS_mkfifo2 + 0)
-#  define __SYS_fs_fdopen              (__SYS_mkfifo2 + 1)
+#  define __SYS_splice                 (__SYS_mkfifo2 + 1)
+#else
+#  define __SYS_splice                 (__SYS_mkfifo2 + 0)
+#endif
+
+#ifdef CONFIG_PIPES
+#  define SYS_splice                   (__SYS_splice + 0)
+#  define SYS_tee                      (__SYS_splice + 1)
+#  define SYS_vmsplice                 (__SYS_splice + 2)
+#  define __SYS_fs_fdopen              (__SYS_splice + 3)
 #else
-#  define __SYS_fs_fdopen              (__SYS_mkfifo2 + 0)
+#  define __SYS_fs_fdopen              (__SYS_splice + 0)
 #endif
 
 #if CONFIG_NFILE_STREAMS > 0
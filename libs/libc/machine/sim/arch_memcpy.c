@@ -0,0 +1,95 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_memcpy.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <emmintrin.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcpy
+ *
+ * Description:
+ *   SSE2 version of memcpy() for the x86-64 simulator.  Copies 64 bytes per
+ *   iteration with unaligned loads and aligned stores.
+ *
+ ****************************************************************************/
+
+FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  FAR unsigned char *pout = (FAR unsigned char *)dest;
+  FAR const unsigned char *pin = (FAR const unsigned char *)src;
+  __m128i x0;
+  __m128i x1;
+  __m128i x2;
+  __m128i x3;
+
+  if (n >= 64)
+    {
+      /* Align the destination to a 16-byte boundary */
+
+      while (((uintptr_t)pout & 15) != 0)
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      while (n >= 64)
+        {
+          x0 = _mm_loadu_si128((FAR const __m128i *)pin);
+          x1 = _mm_loadu_si128((FAR const __m128i *)(pin + 16));
+          x2 = _mm_loadu_si128((FAR const __m128i *)(pin + 32));
+          x3 = _mm_loadu_si128((FAR const __m128i *)(pin + 48));
+          _mm_store_si128((FAR __m128i *)pout, x0);
+          _mm_store_si128((FAR __m128i *)(pout + 16), x1);
+          _mm_store_si128((FAR __m128i *)(pout + 32), x2);
+          _mm_store_si128((FAR __m128i *)(pout + 48), x3);
+          pout += 64;
+          pin  += 64;
+          n    -= 64;
+        }
+    }
+
+  while (n >= 16)
+    {
+      x0 = _mm_loadu_si128((FAR const __m128i *)pin);
+      _mm_storeu_si128((FAR __m128i *)pout, x0);
+      pout += 16;
+      pin  += 16;
+      n    -= 16;
+    }
+
+  while (n-- > 0)
+    {
+      *pout++ = *pin++;
+    }
+
+  return dest;
+}
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_memset.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <emmintrin.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memset
+ *
+ * Description:
+ *   SSE2 version of memset() for the x86-64 simulator.  Stores 64 bytes per
+ *   iteration to a 16-byte aligned destination.
+ *
+ ****************************************************************************/
+
+FAR void *memset(FAR void *s, int c, size_t n)
+{
+  FAR unsigned char *p = (FAR unsigned char *)s;
+  __m128i val;
+
+  if (n >= 16)
+    {
+      val = _mm_set1_epi8((char)c);
+
+      /* Store one unaligned vector, then continue from the next 16-byte
+       * boundary.  Up to 15 bytes are written twice.
+       */
+
+      _mm_storeu_si128((FAR __m128i *)p, val);
+      n -= 16 - ((uintptr_t)p & 15);
+      p += 16 - ((uintptr_t)p & 15);
+
+      while (n >= 64)
+        {
+          _mm_store_si128((FAR __m128i *)p, val);
+          _mm_store_si128((FAR __m128i *)(p + 16), val);
+          _mm_store_si128((FAR __m128i *)(p + 32), val);
+          _mm_store_si128((FAR __m128i *)(p + 48), val);
+          p += 64;
+          n -= 64;
+        }
+
+      while (n >= 16)
+        {
+          _mm_store_si128((FAR __m128i *)p, val);
+          p += 16;
+          n -= 16;
+        }
+    }
+
+  while (n-- > 0)
+    {
+      *p++ = (unsigned char)c;
+    }
+
+  return s;
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_strlen.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <emmintrin.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: strlen
+ *
+ * Description:
+ *   SSE2 version of strlen() for the x86-64 simulator.  The string is
+ *   scanned in aligned 16-byte blocks, so no block ever crosses a page
+ *   boundary.  Bytes before the start of the string in the first block
+ *   are masked out.
+ *
+ ****************************************************************************/
+
+size_t strlen(FAR const char *s)
+{
+  FAR const char *p = (FAR const char *)((uintptr_t)s & ~(uintptr_t)15);
+  __m128i zero = _mm_setzero_si128();
+  unsigned int mask;
+
+  mask  = (unsigned int)_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_load_si128((FAR const __m128i *)p), zero));
+  mask &= ~0u << ((uintptr_t)s & 15);
+
+  while (mask == 0)
+    {
+      p   += 16;
+      mask = (unsigned int)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(_mm_load_si128((FAR const __m128i *)p),
+                              zero));
+    }
+
+  return (size_t)(p - s) + __builtin_ctz(mask);
+}
@@ -112,6 +112,25 @@ int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
 int modlib_symvalue(FAR struct module_s *modp,
                     FAR struct mod_loadinfo_s *loadinfo, FAR Elf_Sym *sym);
 
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find a symbol exported by the base code, i.e. in the symbol table
+ *   selected with modlib_setsymtab().  The hash index of the symbol table
+ *   is used if CONFIG_SYMTAB_HASHED is selected.
+ *
+ * Input Parameters:
+ *   name - The name of the symbol
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry or NULL if the base code does not
+ *   export a symbol of that name.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name);
+
 /****************************************************************************
  * Name: modlib_loadshdrs
  *
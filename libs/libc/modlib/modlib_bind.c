@@ -36,6 +36,16 @@
 #include "libc.h"
 #include "modlib/modlib.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of hash chains of the symbol cache (must be a power of two) */
+
+#define MODLIB_SYMCACHE_NHASH   64
+#define MODLIB_SYMCACHE_HASH(i) \
+  ((unsigned int)(i) & (MODLIB_SYMCACHE_NHASH - 1))
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -44,13 +54,29 @@
  * with legacy naming of other ELF types.
  */
 
-typedef struct
+typedef struct Elf_SymCache
 {
-  dq_entry_t      entry;
-  Elf_Sym         sym;
-  int             idx;
+  dq_entry_t      entry;              /* LRU list, most recent first */
+  FAR struct Elf_SymCache *hnext;     /* Next entry in the same hash chain */
+  Elf_Sym         sym;                /* The symbol with its resolved value */
+  int             idx;                /* The symbol table index */
 } Elf_SymCache;
 
+/* The cache of resolved symbols of a module.  It is shared by all of the
+ * relocation sections of the module so that each symbol is read and looked
+ * up only once, no matter how often it is referenced.  Cached symbols are
+ * found by their symbol table index through a small hash table and are
+ * recycled in LRU order once CONFIG_MODLIB_SYMBOL_CACHECOUNT symbols are
+ * cached.
+ */
+
+struct modlib_symcache_s
+{
+  dq_queue_t      lru;                           /* All cached symbols */
+  FAR Elf_SymCache *hash[MODLIB_SYMCACHE_NHASH]; /* Chains by symbol index */
+  int             count;                         /* Number of symbols */
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -133,6 +159,130 @@ static inline int modlib_readrelas(FAR struct mod_loadinfo_s *loadinfo,
                      relsec->sh_offset + offset);
 }
 
+/****************************************************************************
+ * Name: modlib_symcache_find
+ *
+ * Description:
+ *   Find a symbol in the symbol cache and make it the most recently used
+ *   one.
+ *
+ * Returned Value:
+ *   The cached symbol or NULL if the symbol is not in the cache.
+ *
+ ****************************************************************************/
+
+static FAR Elf_Sym *modlib_symcache_find(FAR struct modlib_symcache_s *cache,
+                                         int symidx)
+{
+  FAR Elf_SymCache *entry;
+
+  for (entry = cache->hash[MODLIB_SYMCACHE_HASH(symidx)];
+       entry != NULL;
+       entry = entry->hnext)
+    {
+      if (entry->idx == symidx)
+        {
+          dq_rem(&entry->entry, &cache->lru);
+          dq_addfirst(&entry->entry, &cache->lru);
+          return &entry->sym;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: modlib_symcache_load
+ *
+ * Description:
+ *   Read a symbol from the file, get its value and add it to the symbol
+ *   cache, recycling the least recently used symbol if the cache is full.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ESRCH means that the symbol has no name; the symbol is
+ *   still returned and cached in that case.
+ *
+ ****************************************************************************/
+
+static int modlib_symcache_load(FAR struct module_s *modp,
+                                FAR struct mod_loadinfo_s *loadinfo,
+                                FAR struct modlib_symcache_s *cache,
+                                int symidx, FAR Elf_Sym **sym)
+{
+  FAR Elf_SymCache **prev;
+  FAR Elf_SymCache *entry;
+  int ret;
+
+  if (cache->count < CONFIG_MODLIB_SYMBOL_CACHECOUNT)
+    {
+      entry = lib_malloc(sizeof(Elf_SymCache));
+      if (!entry)
+        {
+          berr("Failed to allocate memory for elf symbols\n");
+          return -ENOMEM;
+        }
+
+      cache->count++;
+    }
+  else
+    {
+      /* Recycle the least recently used symbol */
+
+      entry = (FAR Elf_SymCache *)dq_remlast(&cache->lru);
+      for (prev = &cache->hash[MODLIB_SYMCACHE_HASH(entry->idx)];
+           *prev != entry;
+           prev = &(*prev)->hnext);
+
+      *prev = entry->hnext;
+    }
+
+  /* Read the symbol table entry into memory and get the value of the
+   * symbol (in sym.st_value)
+   */
+
+  ret = modlib_readsym(loadinfo, symidx, &entry->sym);
+  if (ret >= 0)
+    {
+      ret = modlib_symvalue(modp, loadinfo, &entry->sym);
+    }
+
+  if (ret < 0 && ret != -ESRCH)
+    {
+      lib_free(entry);
+      cache->count--;
+      return ret;
+    }
+
+  entry->idx   = symidx;
+  entry->hnext = cache->hash[MODLIB_SYMCACHE_HASH(symidx)];
+  cache->hash[MODLIB_SYMCACHE_HASH(symidx)] = entry;
+  dq_addfirst(&entry->entry, &cache->lru);
+
+  *sym = &entry->sym;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: modlib_symcache_free
+ *
+ * Description:
+ *   Free the symbol cache and all of the cached symbols.
+ *
+ ****************************************************************************/
+
+static void modlib_symcache_free(FAR struct modlib_symcache_s *cache)
+{
+  FAR dq_entry_t *e;
+
+  while ((e = dq_remfirst(&cache->lru)) != NULL)
+    {
+      lib_free(e);
+    }
+
+  lib_free(cache);
+}
+
 /****************************************************************************
  * Name: modlib_relocate and modlib_relocateadd
  *
@@ -146,21 +296,18 @@ static inline int modlib_readrelas(FAR struct mod_loadinfo_s *loadinfo,
  ****************************************************************************/
 
 static int modlib_relocate(FAR struct module_s *modp,
-                           FAR struct mod_loadinfo_s *loadinfo, int relidx)
+                           FAR struct mod_loadinfo_s *loadinfo,
+                           FAR struct modlib_symcache_s *cache, int relidx)
 {
   FAR Elf_Shdr *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rel  *rels;
   FAR Elf_Rel  *rel;
-  FAR Elf_SymCache *cache;
   FAR Elf_Sym  *sym;
-  FAR dq_entry_t *e;
-  dq_queue_t      q;
   uintptr_t       addr;
   int             symidx;
   int             ret;
   int             i;
-  int             j;
 
   rels = lib_malloc(CONFIG_MODLIB_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rel));
   if (!rels)
@@ -169,8 +316,6 @@ static int modlib_relocate(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -178,7 +323,7 @@ static int modlib_relocate(FAR struct module_s *modp,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -203,62 +348,15 @@ static int modlib_relocate(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rel->r_info);
 
-      /* First try the cache */
-
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
-        {
-          cache = (FAR Elf_SymCache *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
+      /* First try the cache.  If the symbol was not found in the cache,
+       * we will need to read the symbol from the file and get its value.
        */
 
+      sym = modlib_symcache_find(cache, symidx);
       if (sym == NULL)
         {
-          if (j < CONFIG_MODLIB_SYMBOL_CACHECOUNT)
-            {
-              cache = lib_malloc(sizeof(Elf_SymCache));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR Elf_SymCache *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = modlib_readsym(loadinfo, symidx, sym);
-          if (ret < 0)
-            {
-              berr("ERROR: Section %d reloc %d: "
-                   "Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              lib_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = modlib_symvalue(modp, loadinfo, sym);
-          if (ret < 0)
+          ret = modlib_symcache_load(modp, loadinfo, cache, symidx, &sym);
+          if (ret == -ESRCH)
             {
               /* The special error -ESRCH is returned only in one condition:
                * The symbol has no name.
@@ -270,24 +368,17 @@ static int modlib_relocate(FAR struct module_s *modp,
                * is best.
                */
 
-              if (ret == -ESRCH)
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  lib_free(cache);
-                  break;
-                }
+              berr("ERROR: Section %d reloc %d: "
+                   "Undefined symbol[%d] has no name: %d\n",
+                   relidx, i, symidx, ret);
+            }
+          else if (ret < 0)
+            {
+              berr("ERROR: Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
             }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -321,31 +412,24 @@ static int modlib_relocate(FAR struct module_s *modp,
     }
 
   lib_free(rels);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      lib_free(e);
-    }
 
   return ret;
 }
 
 static int modlib_relocateadd(FAR struct module_s *modp,
-                           FAR struct mod_loadinfo_s *loadinfo, int relidx)
+                              FAR struct mod_loadinfo_s *loadinfo,
+                              FAR struct modlib_symcache_s *cache,
+                              int relidx)
 {
   FAR Elf_Shdr *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rela *relas;
   FAR Elf_Rela *rela;
-  FAR Elf_SymCache *cache;
   FAR Elf_Sym  *sym;
-  FAR dq_entry_t *e;
-  dq_queue_t      q;
   uintptr_t       addr;
   int             symidx;
   int             ret;
   int             i;
-  int             j;
 
   relas = lib_malloc(CONFIG_MODLIB_RELOCATION_BUFFERCOUNT *
                      sizeof(Elf_Rela));
@@ -355,8 +439,6 @@ static int modlib_relocateadd(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -364,7 +446,7 @@ static int modlib_relocateadd(FAR struct module_s *modp,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -389,62 +471,15 @@ static int modlib_relocateadd(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rela->r_info);
 
-      /* First try the cache */
-
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
-        {
-          cache = (FAR Elf_SymCache *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
+      /* First try the cache.  If the symbol was not found in the cache,
+       * we will need to read the symbol from the file and get its value.
        */
 
+      sym = modlib_symcache_find(cache, symidx);
       if (sym == NULL)
         {
-          if (j < CONFIG_MODLIB_SYMBOL_CACHECOUNT)
-            {
-              cache = lib_malloc(sizeof(Elf_SymCache));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR Elf_SymCache *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = modlib_readsym(loadinfo, symidx, sym);
-          if (ret < 0)
-            {
-              berr("ERROR: Section %d reloc %d: "
-                   "Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              lib_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = modlib_symvalue(modp, loadinfo, sym);
-          if (ret < 0)
+          ret = modlib_symcache_load(modp, loadinfo, cache, symidx, &sym);
+          if (ret == -ESRCH)
             {
               /* The special error -ESRCH is returned only in one condition:
                * The symbol has no name.
@@ -456,24 +491,17 @@ static int modlib_relocateadd(FAR struct module_s *modp,
                * is best.
                */
 
-              if (ret == -ESRCH)
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  lib_free(cache);
-                  break;
-                }
+              berr("ERROR: Section %d reloc %d: "
+                   "Undefined symbol[%d] has no name: %d\n",
+                   relidx, i, symidx, ret);
+            }
+          else if (ret < 0)
+            {
+              berr("ERROR: Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
             }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -507,11 +535,6 @@ static int modlib_relocateadd(FAR struct module_s *modp,
     }
 
   lib_free(relas);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      lib_free(e);
-    }
 
   return ret;
 }
@@ -541,6 +564,7 @@ static int modlib_relocateadd(FAR struct module_s *modp,
 int modlib_bind(FAR struct module_s *modp,
                 FAR struct mod_loadinfo_s *loadinfo)
 {
+  FAR struct modlib_symcache_s *cache;
   int ret;
   int i;
 
@@ -563,6 +587,17 @@ int modlib_bind(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
+  /* Allocate the symbol cache shared by all relocation sections */
+
+  cache = lib_zalloc(sizeof(struct modlib_symcache_s));
+  if (cache == NULL)
+    {
+      berr("Failed to allocate memory for the symbol cache\n");
+      return -ENOMEM;
+    }
+
+  dq_init(&cache->lru);
+
   /* Process relocations in every allocated section */
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
@@ -588,11 +623,11 @@ int modlib_bind(FAR struct module_s *modp,
 
       if (loadinfo->shdr[i].sh_type == SHT_REL)
         {
-          ret = modlib_relocate(modp, loadinfo, i);
+          ret = modlib_relocate(modp, loadinfo, cache, i);
         }
       else if (loadinfo->shdr[i].sh_type == SHT_RELA)
         {
-          ret = modlib_relocateadd(modp, loadinfo, i);
+          ret = modlib_relocateadd(modp, loadinfo, cache, i);
         }
 
       if (ret < 0)
@@ -601,6 +636,8 @@ int modlib_bind(FAR struct module_s *modp,
         }
     }
 
+  modlib_symcache_free(cache);
+
   /* Ensure that the I and D caches are coherent before starting the newly
    * loaded module by cleaning the D cache (i.e., flushing the D cache
    * contents to memory and invalidating the I cache).
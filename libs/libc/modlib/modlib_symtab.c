@@ -29,6 +29,8 @@
 #include <nuttx/symtab.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -44,6 +46,15 @@
 
 #  ifndef CONFIG_MODLIB_NSYMBOLS_VAR
 #    error "CONFIG_MODLIB_NSYMBOLS_VAR must be defined"
+#  endif
+
+  /* The generated system symbol table comes with a hash index */
+
+#  if defined(CONFIG_SYMTAB_HASHED) && defined(CONFIG_MODLIB_SYSTEM_SYMTAB)
+#    define MODLIB_HAVE_SYMHASH 1
+#    define __MODLIB_SYMHASH(t) t##_hash
+#    define _MODLIB_SYMHASH(t)  __MODLIB_SYMHASH(t)
+#    define MODLIB_SYMHASH      _MODLIB_SYMHASH(CONFIG_MODLIB_SYMTAB_ARRAY)
 #  endif
 #endif
 
@@ -56,6 +67,10 @@ extern const struct symtab_s CONFIG_MODLIB_SYMTAB_ARRAY[];
 extern int CONFIG_MODLIB_NSYMBOLS_VAR;
 #endif
 
+#ifdef MODLIB_HAVE_SYMHASH
+extern const struct symtab_hash_s MODLIB_SYMHASH;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -63,6 +78,42 @@ extern int CONFIG_MODLIB_NSYMBOLS_VAR;
 static FAR const struct symtab_s *g_modlib_symtab;
 static FAR int g_modlib_nsymbols;
 
+#ifdef CONFIG_SYMTAB_HASHED
+/* The hash index of g_modlib_symtab (if any) and the index built at run
+ * time for symbol tables that do not come with one.
+ */
+
+static FAR const struct symtab_hash_s *g_modlib_symhash;
+static struct symtab_hash_s g_modlib_rthash;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_defsymtab
+ *
+ * Description:
+ *   Select the default symbol table if no symbol table has been selected
+ *   yet.  The caller must hold the registry lock.
+ *
+ ****************************************************************************/
+
+static inline void modlib_defsymtab(void)
+{
+#ifdef CONFIG_MODLIB_HAVE_SYMTAB
+  if (g_modlib_symtab == NULL)
+    {
+      g_modlib_symtab = CONFIG_MODLIB_SYMTAB_ARRAY;
+      g_modlib_nsymbols = CONFIG_MODLIB_NSYMBOLS_VAR;
+#ifdef MODLIB_HAVE_SYMHASH
+      g_modlib_symhash = &MODLIB_SYMHASH;
+#endif
+    }
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -90,13 +141,7 @@ void modlib_getsymtab(FAR const struct symtab_s **symtab, FAR int *nsymbols)
   /* Borrow the registry lock to assure atomic access */
 
   modlib_registry_lock();
-#ifdef CONFIG_MODLIB_HAVE_SYMTAB
-  if (g_modlib_symtab == NULL)
-    {
-      g_modlib_symtab = CONFIG_MODLIB_SYMTAB_ARRAY;
-      g_modlib_nsymbols = CONFIG_MODLIB_NSYMBOLS_VAR;
-    }
-#endif
+  modlib_defsymtab();
 
   *symtab   = g_modlib_symtab;
   *nsymbols = g_modlib_nsymbols;
@@ -125,5 +170,76 @@ void modlib_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   modlib_registry_lock();
   g_modlib_symtab   = symtab;
   g_modlib_nsymbols = nsymbols;
+
+#ifdef CONFIG_SYMTAB_HASHED
+  /* Any index of the old symbol table is stale now */
+
+  g_modlib_symhash = NULL;
+  symtab_hashuninit(&g_modlib_rthash);
+#endif
+
+  modlib_registry_unlock();
+}
+
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find a symbol exported by the base code, i.e. in the symbol table
+ *   selected with modlib_setsymtab().  The hash index of the symbol table
+ *   is used if CONFIG_SYMTAB_HASHED is selected.
+ *
+ * Input Parameters:
+ *   name - The name of the symbol
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry or NULL if the base code does not
+ *   export a symbol of that name.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name)
+{
+  FAR const struct symtab_s *symbol = NULL;
+
+  /* Borrow the registry lock to assure atomic access */
+
+  modlib_registry_lock();
+  modlib_defsymtab();
+
+  if (g_modlib_symtab != NULL)
+    {
+#ifdef CONFIG_SYMTAB_HASHED
+      /* Index the symbol table on first use if it does not come with a
+       * precomputed index.  Fall back to searching the table if the index
+       * cannot be allocated.
+       */
+
+      if (g_modlib_symhash == NULL &&
+          symtab_hashinit(&g_modlib_rthash, g_modlib_symtab,
+                          g_modlib_nsymbols) >= 0)
+        {
+          g_modlib_symhash = &g_modlib_rthash;
+        }
+
+      if (g_modlib_symhash != NULL)
+        {
+          symbol = symtab_findbyhash(g_modlib_symtab, g_modlib_symhash,
+                                     name);
+        }
+      else
+#endif
+        {
+#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
+          symbol = symtab_findorderedbyname(g_modlib_symtab, name,
+                                            g_modlib_nsymbols);
+#else
+          symbol = symtab_findbyname(g_modlib_symtab, name,
+                                     g_modlib_nsymbols);
+#endif
+        }
+    }
+
   modlib_registry_unlock();
+  return symbol;
 }
@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -65,6 +67,32 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      if (n >= LIBC_WORDSIZE)
+        {
+          FAR const uintptr_t *wp;
+          uintptr_t rep = LIBC_REPEAT(c);
+
+          /* Check the leading bytes up to the first word boundary */
+
+          for (; LIBC_UNALIGNED(p); p++, n--)
+            {
+              if (*p == (unsigned char)c)
+                {
+                  return (FAR void *)p;
+                }
+            }
+
+          /* Skip the words that do not contain 'c' */
+
+          for (wp = (FAR const uintptr_t *)p;
+               n >= LIBC_WORDSIZE && !LIBC_HASBYTE(*wp, rep);
+               wp++, n -= LIBC_WORDSIZE);
+
+          p = (FAR const unsigned char *)wp;
+        }
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
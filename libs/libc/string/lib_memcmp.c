@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +53,43 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip over equal words.  The bytes of the first word that differs are
+   * compared one by one below.
+   */
+
+  if (n >= LIBC_WORDSIZE && LIBC_COALIGNED(p1, p2))
+    {
+      FAR const uintptr_t *w1;
+      FAR const uintptr_t *w2;
+
+      while (LIBC_UNALIGNED(p1))
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      w1 = (FAR const uintptr_t *)p1;
+      w2 = (FAR const uintptr_t *)p2;
+
+      while (n >= LIBC_WORDSIZE && *w1 == *w2)
+        {
+          w1++;
+          w2++;
+          n -= LIBC_WORDSIZE;
+        }
+
+      p1 = (unsigned char *)w1;
+      p2 = (unsigned char *)w2;
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
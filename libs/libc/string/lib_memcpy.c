@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +56,46 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Copy whole words if both buffers can be aligned together */
+
+  if (n >= LIBC_WORDSIZE && LIBC_COALIGNED(pout, pin))
+    {
+      FAR uintptr_t *wout;
+      FAR const uintptr_t *win;
+
+      while (LIBC_UNALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+      win  = (FAR const uintptr_t *)pin;
+
+      while (n >= 4 * LIBC_WORDSIZE)
+        {
+          wout[0] = win[0];
+          wout[1] = win[1];
+          wout[2] = win[2];
+          wout[3] = win[3];
+          wout   += 4;
+          win    += 4;
+          n      -= 4 * LIBC_WORDSIZE;
+        }
+
+      while (n >= LIBC_WORDSIZE)
+        {
+          *wout++ = *win++;
+          n      -= LIBC_WORDSIZE;
+        }
+
+      pout = (FAR unsigned char *)wout;
+      pin  = (FAR unsigned char *)win;
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -56,6 +58,36 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Copy forward a word at a time.  Each word is read before the
+       * destination word is written, so the overlap is harmless.
+       */
+
+      if (count >= LIBC_WORDSIZE && LIBC_COALIGNED(tmp, s))
+        {
+          FAR uintptr_t *wtmp;
+          FAR const uintptr_t *ws;
+
+          while (LIBC_UNALIGNED(tmp))
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          wtmp = (FAR uintptr_t *)tmp;
+          ws   = (FAR const uintptr_t *)s;
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              *wtmp++ = *ws++;
+              count  -= LIBC_WORDSIZE;
+            }
+
+          tmp = (FAR char *)wtmp;
+          s   = (FAR char *)ws;
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -66,6 +98,34 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Copy backward a word at a time */
+
+      if (count >= LIBC_WORDSIZE && LIBC_COALIGNED(tmp, s))
+        {
+          FAR uintptr_t *wtmp;
+          FAR const uintptr_t *ws;
+
+          while (LIBC_UNALIGNED(tmp))
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          wtmp = (FAR uintptr_t *)tmp;
+          ws   = (FAR const uintptr_t *)s;
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              *--wtmp = *--ws;
+              count  -= LIBC_WORDSIZE;
+            }
+
+          tmp = (FAR char *)wtmp;
+          s   = (FAR char *)ws;
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
@@ -46,6 +46,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -176,6 +178,44 @@ FAR void *memset(FAR void *s, int c, size_t n)
           *(FAR uint8_t *)addr = (uint8_t)c;
         }
     }
+#elif defined(CONFIG_LIBC_STRING_OPTSPEED)
+  /* This version stores a machine word at a time */
+
+  FAR unsigned char *p = (FAR unsigned char *)s;
+
+  if (n >= LIBC_WORDSIZE)
+    {
+      uintptr_t val = LIBC_REPEAT(c);
+      FAR uintptr_t *wp;
+
+      while (LIBC_UNALIGNED(p))
+        {
+          *p++ = (unsigned char)c;
+          n--;
+        }
+
+      wp = (FAR uintptr_t *)p;
+
+      while (n >= 4 * LIBC_WORDSIZE)
+        {
+          wp[0] = val;
+          wp[1] = val;
+          wp[2] = val;
+          wp[3] = val;
+          wp   += 4;
+          n    -= 4 * LIBC_WORDSIZE;
+        }
+
+      while (n >= LIBC_WORDSIZE)
+        {
+          *wp++ = val;
+          n    -= LIBC_WORDSIZE;
+        }
+
+      p = (FAR unsigned char *)wp;
+    }
+
+  while (n-- > 0) *p++ = c;
 #else
   /* This version is optimized for size */
 
@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -64,9 +66,45 @@ FAR char *strchr(FAR const char *s, int c)
 {
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      FAR const uintptr_t *ws;
+      uintptr_t rep = LIBC_REPEAT(c);
+      uintptr_t val;
+
+      /* Check the leading bytes up to the first word boundary */
+
+      for (; LIBC_UNALIGNED(s); s++)
+        {
+          if (*s == (char)c)
+            {
+              return (FAR char *)s;
+            }
+
+          if (!*s)
+            {
+              return NULL;
+            }
+        }
+
+      /* Skip the words that contain neither 'c' nor the NUL terminator.
+       * The word that does is examined byte by byte below.
+       */
+
+      for (ws = (FAR const uintptr_t *)s; ; ws++)
+        {
+          val = *ws;
+          if (LIBC_HASZERO(val) || LIBC_HASBYTE(val, rep))
+            {
+              break;
+            }
+        }
+
+      s = (FAR const char *)ws;
+#endif
+
       for (; ; s++)
         {
-          if (*s == c)
+          if (*s == (char)c)
             {
               return (FAR char *)s;
             }
@@ -0,0 +1,73 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+
+/* The word-at-a-time string functions operate on naturally aligned words
+ * of type uintptr_t.  Words are only accessed at aligned addresses, so a
+ * word read never crosses into a page that the byte-wise version would
+ * not have touched.
+ */
+
+#define LIBC_WORDSIZE        sizeof(uintptr_t)
+#define LIBC_WORDMASK        (LIBC_WORDSIZE - 1)
+#define LIBC_UNALIGNED(p)    (((uintptr_t)(p) & LIBC_WORDMASK) != 0)
+
+/* True if two pointers can be aligned to a word boundary together */
+
+#define LIBC_COALIGNED(p,q)  ((((uintptr_t)(p) ^ (uintptr_t)(q)) & \
+                               LIBC_WORDMASK) == 0)
+
+/* A word with the byte 'c' in every byte lane */
+
+#define LIBC_ONES            ((uintptr_t)-1 / 0xff)
+#define LIBC_HIGHS           (LIBC_ONES << 7)
+#define LIBC_REPEAT(c)       (LIBC_ONES * (uint8_t)(c))
+
+/* Non-zero if any byte lane of the word 'x' is zero.  The expression only
+ * has false positives in lanes above a zero byte, so it is exact as far as
+ * the presence of a zero byte is concerned.
+ */
+
+#define LIBC_HASZERO(x)      (((x) - LIBC_ONES) & ~(x) & LIBC_HIGHS)
+
+/* Non-zero if any byte lane of the word 'x' equals the byte in every lane
+ * of 'r' (see LIBC_REPEAT).
+ */
+
+#define LIBC_HASBYTE(x,r)    LIBC_HASZERO((x) ^ (r))
+
+#endif /* CONFIG_LIBC_STRING_OPTSPEED */
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
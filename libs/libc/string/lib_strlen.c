@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,7 +51,29 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *ws;
+
+  /* Check the leading bytes up to the first word boundary */
+
+  for (sc = s; LIBC_UNALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Then test a whole word at a time for a NUL byte */
+
+  for (ws = (FAR const uintptr_t *)sc; !LIBC_HASZERO(*ws); ws++);
+  sc = (const char *)ws;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
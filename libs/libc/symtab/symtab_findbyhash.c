@@ -0,0 +1,72 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_findbyhash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/symtab.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol in the symbol table with the matching name using the
+ *   hash index of the table.  Access time is independent of the number of
+ *   symbols in the table.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_s *symtab,
+                  FAR const struct symtab_hash_s *hash,
+                  FAR const char *name)
+{
+  uint16_t ndx;
+
+  DEBUGASSERT(symtab != NULL && hash != NULL && name != NULL);
+  DEBUGASSERT(hash->sh_nbuckets > 0);
+
+  ndx = hash->sh_bucket[symtab_hash(name) & (hash->sh_nbuckets - 1)];
+  while (ndx != SYMTAB_HASH_NONE)
+    {
+      if (strcmp(name, symtab[ndx].sym_name) == 0)
+        {
+          return &symtab[ndx];
+        }
+
+      ndx = hash->sh_chain[ndx];
+    }
+
+  return NULL;
+}
@@ -0,0 +1,65 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/symtab.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the hash value of a symbol name.  This is the same hash function
+ *   that is used by tools/mksymtab.c to generate the hash index of a symbol
+ *   table.
+ *
+ * Returned Value:
+ *   The hash value of the name.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name)
+{
+  FAR const unsigned char *ptr = (FAR const unsigned char *)name;
+  uint32_t hash = 5381;
+
+  DEBUGASSERT(name != NULL);
+
+  /* This is the DJB hash, h * 33 + c, as used by the GNU hash sections */
+
+  while (*ptr != '\0')
+    {
+      hash = (hash << 5) + hash + *ptr++;
+    }
+
+  return hash;
+}
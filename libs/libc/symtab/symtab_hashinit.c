@@ -0,0 +1,128 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hashinit.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build a hash index over an existing symbol table.  The symbol table
+ *   must not be modified while the index is in use.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure:  -EINVAL if the table is too large to be indexed or -ENOMEM
+ *   if the index could not be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms)
+{
+  FAR uint16_t *bucket;
+  FAR uint16_t *chain;
+  uint32_t nbuckets;
+  uint32_t ndx;
+  int i;
+
+  DEBUGASSERT(hash != NULL && (symtab != NULL || nsyms == 0));
+
+  if (nsyms < 0 || nsyms >= SYMTAB_HASH_NONE)
+    {
+      return -EINVAL;
+    }
+
+  /* Use about two symbols per bucket */
+
+  for (nbuckets = 1; 2 * nbuckets < (uint32_t)nsyms; nbuckets <<= 1);
+
+  /* The bucket heads and the chain links are allocated as one block */
+
+  bucket = (FAR uint16_t *)
+    lib_malloc((nbuckets + nsyms) * sizeof(uint16_t));
+  if (bucket == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  chain = &bucket[nbuckets];
+  for (ndx = 0; ndx < nbuckets; ndx++)
+    {
+      bucket[ndx] = SYMTAB_HASH_NONE;
+    }
+
+  /* Insert the symbols in reverse order so that each chain ends up in table
+   * order.
+   */
+
+  for (i = nsyms - 1; i >= 0; i--)
+    {
+      ndx         = symtab_hash(symtab[i].sym_name) & (nbuckets - 1);
+      chain[i]    = bucket[ndx];
+      bucket[ndx] = (uint16_t)i;
+    }
+
+  hash->sh_nbuckets = (uint16_t)nbuckets;
+  hash->sh_bucket   = bucket;
+  hash->sh_chain    = chain;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: symtab_hashuninit
+ *
+ * Description:
+ *   Free a hash index that was built by symtab_hashinit().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void symtab_hashuninit(FAR struct symtab_hash_s *hash)
+{
+  DEBUGASSERT(hash != NULL);
+
+  if (hash->sh_bucket != NULL)
+    {
+      lib_free((FAR void *)hash->sh_bucket);
+    }
+
+  hash->sh_nbuckets = 0;
+  hash->sh_bucket   = NULL;
+  hash->sh_chain    = NULL;
+}
@@ -0,0 +1,283 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The cache of a CPU is only accessed with local interrupts disabled.  In
+ * the SMP case, the per-CPU spinlock also keeps mm_cache_drain() out while
+ * the owning CPU uses the cache.  No heap-wide lock is ever taken.
+ */
+
+#ifdef CONFIG_SMP
+#  define mm_cache_lock(c)   spin_lock(&(c)->mc_lock)
+#  define mm_cache_unlock(c) spin_unlock(&(c)->mc_lock)
+#else
+#  define mm_cache_lock(c)
+#  define mm_cache_unlock(c)
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'alignsize' bytes from the small object cache
+ *   of the current CPU.
+ *
+ * Input Parameters:
+ *   heap      - The heap
+ *   alignsize - The aligned chunk size, including the chunk header
+ *
+ * Returned Value:
+ *   The user memory of the cached chunk or NULL if the size class is not
+ *   cached or if the cache of the size class is empty.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cachenode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  int ndx;
+
+  if (alignsize > MM_CACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx   = MM_CACHE_NDX(alignsize);
+  flags = up_irq_save();
+  cache = &heap->mm_cache[up_cpu_index()];
+  mm_cache_lock(cache);
+
+  node = cache->mc_head[ndx];
+  if (node != NULL)
+    {
+      cache->mc_head[ndx] = node->flink;
+      cache->mc_count[ndx]--;
+      cache->mc_hits[ndx]++;
+    }
+  else
+    {
+      cache->mc_misses[ndx]++;
+    }
+
+  mm_cache_unlock(cache);
+  up_irq_restore(flags);
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Put a small chunk into the small object cache of the current CPU.  The
+ *   chunk stays allocated as far as the heap is concerned.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The user memory of the chunk being freed
+ *
+ * Returned Value:
+ *   True if the chunk was cached; false if it must be returned to the
+ *   heap because it is too large or because the cache is full.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *alloc;
+  FAR struct mm_cachenode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  bool cached = false;
+  size_t size;
+  int ndx;
+
+  alloc = (FAR struct mm_allocnode_s *)
+    ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  size  = alloc->size;
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(alloc->preceding & MM_ALLOC_BIT);
+
+  if (size > MM_CACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  ndx   = MM_CACHE_NDX(size);
+  node  = (FAR struct mm_cachenode_s *)mem;
+  flags = up_irq_save();
+  cache = &heap->mm_cache[up_cpu_index()];
+  mm_cache_lock(cache);
+
+  if (cache->mc_count[ndx] < CONFIG_MM_CACHE_DEPTH)
+    {
+      node->flink         = cache->mc_head[ndx];
+      cache->mc_head[ndx] = node;
+      cache->mc_count[ndx]++;
+      cached              = true;
+    }
+
+  mm_cache_unlock(cache);
+  up_irq_restore(flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_cache_drain
+ *
+ * Description:
+ *   Return all chunks held in the small object caches of all CPUs to the
+ *   heap.  This is done when an allocation fails.  This function must not
+ *   be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *
+ * Returned Value:
+ *   The number of chunks returned to the heap.
+ *
+ ****************************************************************************/
+
+int mm_cache_drain(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cachenode_s *head;
+  FAR struct mm_cachenode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  int count = 0;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < MM_CACHE_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          /* Detach the whole list, then free the chunks without holding
+           * the cache.
+           */
+
+          flags = up_irq_save();
+          mm_cache_lock(cache);
+
+          head                 = cache->mc_head[ndx];
+          cache->mc_head[ndx]  = NULL;
+          cache->mc_count[ndx] = 0;
+
+          mm_cache_unlock(cache);
+          up_irq_restore(flags);
+
+          while (head != NULL)
+            {
+              node = head;
+              head = node->flink;
+
+              mm_freechunk(heap, node);
+              count++;
+            }
+        }
+    }
+
+  if (count > 0)
+    {
+      minfo("Drained %d cached chunks\n", count);
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the statistics of one size class of the small object cache,
+ *   summed over all CPUs.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   ndx  - The size class index, 0 .. MM_CACHE_NCLASSES - 1
+ *   info - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if ndx is not a valid size class.
+ *
+ ****************************************************************************/
+
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int ndx,
+                 FAR struct mm_cacheinfo_s *info)
+{
+  FAR struct mm_cache_s *cache;
+  int cpu;
+
+  DEBUGASSERT(info != NULL);
+
+  if (ndx < 0 || ndx >= MM_CACHE_NCLASSES)
+    {
+      return -EINVAL;
+    }
+
+  info->size   = MM_CACHE_SIZE(ndx);
+  info->cached = 0;
+  info->hits   = 0;
+  info->misses = 0;
+
+  /* The counters are sampled without locking; they are only statistics */
+
+  for (cpu = 0; cpu < MM_CACHE_NCPUS; cpu++)
+    {
+      cache         = &heap->mm_cache[cpu];
+      info->cached += cache->mc_count[ndx];
+      info->hits   += cache->mc_hits[ndx];
+      info->misses += cache->mc_misses[ndx];
+    }
+
+  return OK;
+}
+
+#endif /* MM_HAVE_CACHE */
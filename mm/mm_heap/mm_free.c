@@ -79,7 +79,42 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  *
  ****************************************************************************/
 
+#ifdef MM_HAVE_CACHE
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+  /* Keep small chunks in the small object cache of this CPU.  This does
+   * not require the heap semaphore and so is also possible from interrupt
+   * handlers.
+   */
+
+  if (!mm_cache_free(heap, mem))
+    {
+      mm_freechunk(heap, mem);
+    }
+}
+
+/****************************************************************************
+ * Name: mm_freechunk
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes, bypassing the
+ *   small object cache.
+ *
+ ****************************************************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
+#else
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+#endif
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
@@ -88,7 +123,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   int ret;
 #endif
 
+#ifndef MM_HAVE_CACHE
   minfo("Freeing %p\n", mem);
+#endif
 
   /* Protect against attempts to free a NULL reference */
 
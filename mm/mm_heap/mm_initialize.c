@@ -181,6 +181,18 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_delaylist = NULL;
 #endif
 
+#ifdef MM_HAVE_CACHE
+  /* Initialize the small object caches */
+
+  memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+#ifdef CONFIG_SMP
+  for (i = 0; i < MM_CACHE_NCPUS; i++)
+    {
+      spin_initialize(&heap->mm_cache[i].mc_lock, SP_UNLOCKED);
+    }
+#endif
+#endif
+
   /* Initialize the node array */
 
   memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
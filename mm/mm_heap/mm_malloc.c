@@ -138,6 +138,18 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
   DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
 
+#ifdef MM_HAVE_CACHE
+  /* Try the small object cache of this CPU first.  This does not require
+   * the MM semaphore.
+   */
+
+  ret = mm_cache_alloc(heap, alignsize);
+  if (ret != NULL)
+    {
+      goto out;
+    }
+#endif
+
   /* We need to hold the MM semaphore while we muck with the nodelist. */
 
   mm_takesemaphore(heap);
@@ -238,6 +250,19 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
   mm_givesemaphore(heap);
 
+#ifdef MM_HAVE_CACHE
+  /* Under memory pressure, return the chunks held in the small object
+   * caches to the heap and try again.
+   */
+
+  if (ret == NULL && mm_cache_drain(heap) > 0)
+    {
+      return mm_malloc(heap, size);
+    }
+
+out:
+#endif
+
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
     {
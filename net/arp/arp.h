@@ -326,8 +326,8 @@ void arp_notify(in_addr_t ipaddr);
  *   ipaddr - Refers to an IP address in network order
  *
  * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
+ *   The caller holds the ARP table lock.  The return value will become
+ *   unstable when the lock is released.
  *
  ****************************************************************************/
 
@@ -348,7 +348,8 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr);
  *             available.
  *
  * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ *   The ARP table is read without locking; the network must still be
+ *   locked if a local network device may be matched.
  *
  ****************************************************************************/
 
@@ -364,12 +365,13 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr);
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the entry was deleted; -ENOENT if there is no entry for
+ *   the IP address.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr);
+int arp_delete(in_addr_t ipaddr);
 
 /****************************************************************************
  * Name: arp_update
@@ -386,9 +388,6 @@ void arp_delete(in_addr_t ipaddr);
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
@@ -408,9 +407,6 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
@@ -430,9 +426,6 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -474,7 +467,7 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_wait(n,t) (0)
 #  define arp_notify(i)
 #  define arp_find(i,e) (-ENOSYS)
-#  define arp_delete(i)
+#  define arp_delete(i) (-ENOSYS)
 #  define arp_update(i,m);
 #  define arp_hdr_update(i,m);
 #  define arp_snapshot(s,n) (0)
@@ -63,6 +63,7 @@
 
 #include <arp/arp.h>
 #include <netdev/netdev.h>
+#include <utils/utils.h>
 
 #ifdef CONFIG_NET_ARP
 
@@ -86,9 +87,13 @@ struct arp_table_info_s
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The table of known address mappings.  The table is modified both by the
+ * network input path and by the ARP ioctls, so it is protected by its own
+ * sequence lock rather than by the network lock:  Lookups never block.
+ */
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct net_seqlock_s g_arplock;
 
 /****************************************************************************
  * Private Functions
@@ -188,16 +193,16 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
   FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  irqstate_t flags;
   int i;
 
+  flags = net_seqlock_wrlock(&g_arplock);
+
   /* Walk through the ARP mapping table and try to find an entry to
    * update. If none is found, the IP -> MAC address mapping is
    * inserted in the ARP table.
@@ -232,6 +237,8 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
   tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
   tabptr->at_time = clock_systimer();
+
+  net_seqlock_wrunlock(&g_arplock, flags);
   return OK;
 }
 
@@ -250,9 +257,6 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
@@ -274,8 +278,8 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
  *   ipaddr - Refers to an IP address in network order
  *
  * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
+ *   The caller holds the ARP table lock.  The return value will become
+ *   unstable when the lock is released.
  *
  ****************************************************************************/
 
@@ -316,7 +320,8 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
  *             available.
  *
  * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ *   The ARP table is read without locking; the network must still be
+ *   locked if a local network device may be matched.
  *
  ****************************************************************************/
 
@@ -324,23 +329,27 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 {
   FAR struct arp_entry_s *tabptr;
   struct arp_table_info_s info;
+  uint32_t seq;
 
-  /* Check if the IPv4 address is already in the ARP table. */
+  /* Check if the IPv4 address is already in the ARP table.  Repeat the
+   * lookup if the table was modified while it was being read.
+   */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  do
     {
-      /* Yes.. return the Ethernet MAC address if the caller has provided a
-       * non-NULL address in 'ethaddr'.
-       */
-
-      if (ethaddr != NULL)
+      seq    = net_seqlock_read(&g_arplock);
+      tabptr = arp_lookup(ipaddr);
+      if (tabptr != NULL && ethaddr != NULL)
         {
           memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
         }
+    }
+  while (net_seqlock_retry(&g_arplock, seq));
 
-      /* Return success in any case meaning that a valid Ethernet MAC
-       * address mapping is available for the IP address.
+  if (tabptr != NULL)
+    {
+      /* Return success meaning that a valid Ethernet MAC address mapping
+       * is available for the IP address.
        */
 
       return OK;
@@ -373,17 +382,20 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the entry was deleted; -ENOENT if there is no entry for
+ *   the IP address.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr)
+int arp_delete(in_addr_t ipaddr)
 {
   FAR struct arp_entry_s *tabptr;
+  irqstate_t flags;
 
   /* Check if the IPv4 address is in the ARP table. */
 
+  flags  = net_seqlock_wrlock(&g_arplock);
   tabptr = arp_lookup(ipaddr);
   if (tabptr != NULL)
     {
@@ -391,6 +403,9 @@ void arp_delete(in_addr_t ipaddr)
 
       tabptr->at_ipaddr = 0;
     }
+
+  net_seqlock_wrunlock(&g_arplock, flags);
+  return tabptr != NULL ? OK : -ENOENT;
 }
 
 /****************************************************************************
@@ -408,9 +423,6 @@ void arp_delete(in_addr_t ipaddr)
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -420,22 +432,32 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
   FAR struct arp_entry_s *tabptr;
   clock_t now;
   unsigned int ncopied;
+  uint32_t seq;
   int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-empty, non-expired entries in the ARP table.  Start over
+   * if the table was modified in the meantime.
+   */
 
-  for (i = 0, now = clock_systimer(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  do
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      seq = net_seqlock_read(&g_arplock);
+
+      for (i = 0, now = clock_systimer(), ncopied = 0;
+           nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
+           i++)
         {
-          memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
-          ncopied++;
+          tabptr = &g_arptable[i];
+          if (tabptr->at_ipaddr != 0 &&
+              now - tabptr->at_time <= ARP_MAXAGE_TICK)
+            {
+              memcpy(&snapshot[ncopied], tabptr,
+                     sizeof(struct arp_entry_s));
+              ncopied++;
+            }
         }
     }
+  while (net_seqlock_retry(&g_arplock, seq));
 
   /* Return the number of entries copied into the user buffer */
 
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -46,8 +47,78 @@
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 
+#include "utils/utils.h"
+
 #ifdef CONFIG_MM_IOB
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_iob_copychksum
+ *
+ * Description:
+ *   Copy 'len' bytes starting at 'offset' in the I/O buffer chain to 'dest'
+ *   like iob_copyout() and return the checksum of the copied data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CHKSUM_COPY
+static uint16_t devif_iob_copychksum(FAR uint8_t *dest,
+                                     FAR const struct iob_s *iob,
+                                     unsigned int len, unsigned int offset)
+{
+  FAR const uint8_t *src;
+  unsigned int ncopy;
+  uint16_t sum = 0;
+  uint16_t part;
+  bool odd = false;
+
+  /* Skip to the I/O buffer containing the data offset */
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  while (iob != NULL && len > 0)
+    {
+      src   = &iob->io_data[iob->io_offset + offset];
+      ncopy = iob->io_len - offset;
+      if (ncopy > len)
+        {
+          ncopy = len;
+        }
+
+      /* A segment that starts at an odd position of the payload has its
+       * 16-bit words split; its sum is byte swapped (RFC 1071).
+       */
+
+      part = chksum_copy(0, dest, src, ncopy);
+      if (odd)
+        {
+          part = (uint16_t)((part << 8) | (part >> 8));
+        }
+
+      sum += part;
+      if (sum < part)
+        {
+          sum++; /* carry */
+        }
+
+      odd    ^= (ncopy & 1) != 0;
+      dest   += ncopy;
+      len    -= ncopy;
+      offset  = 0;
+      iob     = iob->io_flink;
+    }
+
+  return sum;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -74,7 +145,12 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
 
   /* Copy the data from the I/O buffer chain to the device buffer */
 
+#ifdef CONFIG_NET_CHKSUM_COPY
+  dev->d_sndsum    = devif_iob_copychksum(dev->d_appdata, iob, len, offset);
+  dev->d_sndsumlen = len;
+#else
   iob_copyout(dev->d_appdata, iob, len, offset);
+#endif
   dev->d_sndlen = len;
 
 #ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
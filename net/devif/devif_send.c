@@ -48,6 +48,7 @@
 #include <nuttx/net/netdev.h>
 
 #include "devif/devif.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Public Functions
@@ -69,6 +70,13 @@ void devif_send(struct net_driver_s *dev, const void *buf, int len)
 {
   DEBUGASSERT(dev != NULL && len > 0 && len < NETDEV_PKTSIZE(dev));
 
+#ifdef CONFIG_NET_CHKSUM_COPY
+  /* Checksum the payload while copying it */
+
+  dev->d_sndsum    = chksum_copy(0, dev->d_appdata, buf, len);
+  dev->d_sndsumlen = len;
+#else
   memcpy(dev->d_appdata, buf, len);
+#endif
   dev->d_sndlen = len;
 }
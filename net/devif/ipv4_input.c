@@ -341,6 +341,12 @@ int ipv4_input(FAR struct net_driver_s *dev)
   g_netstats.ipv4.recv++;
 #endif
 
+#ifdef CONFIG_NET_CHKSUM_COPY
+  /* Any payload sum left from an earlier packet is not for this one */
+
+  dev->d_sndsumlen = 0;
+#endif
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
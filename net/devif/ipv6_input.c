@@ -289,6 +289,12 @@ int ipv6_input(FAR struct net_driver_s *dev)
   g_netstats.ipv6.recv++;
 #endif
 
+#ifdef CONFIG_NET_CHKSUM_COPY
+  /* Any payload sum left from an earlier packet is not for this one */
+
+  dev->d_sndsumlen = 0;
+#endif
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
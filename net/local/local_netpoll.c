@@ -129,6 +129,27 @@ errout:
 }
 #endif
 
+/****************************************************************************
+ * Name: local_inout_pollnotify
+ *
+ * Description:
+ *   Forward the events reported on one of the shadow pollfds, used when
+ *   both POLLIN and POLLOUT are monitored, to the caller's pollfd.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_inout_pollnotify(FAR struct pollfd *fds)
+{
+  FAR struct pollfd *origfds = (FAR struct pollfd *)fds->arg;
+
+  DEBUGASSERT(origfds != NULL);
+
+  origfds->revents |= fds->revents;
+  poll_notify(origfds);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -152,7 +173,7 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -233,10 +254,14 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
           shadowfds[0].fd     = 1; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
           shadowfds[0].events = fds->events & ~POLLOUT;
+          shadowfds[0].cb     = local_inout_pollnotify;
+          shadowfds[0].arg    = fds;
 
           shadowfds[1].fd     = 0; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
           shadowfds[1].events = fds->events & ~POLLIN;
+          shadowfds[1].cb     = local_inout_pollnotify;
+          shadowfds[1].arg    = fds;
 
           net_unlock();
 
@@ -304,7 +329,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
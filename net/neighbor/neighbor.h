@@ -54,17 +54,20 @@
 #include <nuttx/net/sixlowpan.h>
 #include <nuttx/net/neighbor.h>
 
+#include "utils/utils.h"
+
 #ifdef CONFIG_NET_IPv6
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+/* This is the Neighbor table.  It is protected by its own sequence lock,
+ * g_neighbor_lock, rather than by the network lock.
  */
 
 extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct net_seqlock_s g_neighbor_lock;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -86,6 +89,10 @@ struct net_driver_s; /* Forward reference */
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
  *   returned if there is no matching entry in the Neighbor Table.
  *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock or is within a sequence lock read
+ *   section.
+ *
  ****************************************************************************/
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
@@ -195,9 +202,6 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev);
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
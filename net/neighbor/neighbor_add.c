@@ -81,6 +81,7 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  irqstate_t flags;
   uint8_t lltype;
   clock_t oldest_time;
   int     oldest_ndx;
@@ -88,6 +89,8 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
+  flags = net_seqlock_wrlock(&g_neighbor_lock);
+
   /* Find the matching entry, first unused entry, or the oldest used entry.
    * The unused entry will have ne_time == 0 and should generate the oldest
    * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
@@ -127,6 +130,8 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
   memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
          g_neighbors[oldest_ndx].ne_addr.na_llsize);
 
+  net_seqlock_wrunlock(&g_neighbor_lock, flags);
+
   /* Dump the contents of the new entry */
 
   neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
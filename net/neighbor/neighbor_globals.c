@@ -50,11 +50,12 @@
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+/* This is the Neighbor table.  It is protected by its own sequence lock,
+ * g_neighbor_lock, rather than by the network lock.
  */
 
 struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct net_seqlock_s g_neighbor_lock;
 
 /****************************************************************************
  * Public Functions
@@ -133,23 +133,27 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 {
   FAR struct neighbor_entry_s *neighbor;
   struct neighbor_table_info_s info;
+  uint32_t seq;
 
-  /* Check if the IPv6 address is already in the neighbor table. */
+  /* Check if the IPv6 address is already in the neighbor table.  Repeat
+   * the lookup if the table was modified while it was being read.
+   */
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  do
     {
-      /* Yes.. return the link layer address if the caller has provided a
-       * non-NULL address in 'laddr'.
-       */
-
-      if (laddr != NULL)
+      seq      = net_seqlock_read(&g_neighbor_lock);
+      neighbor = neighbor_findentry(ipaddr);
+      if (neighbor != NULL && laddr != NULL)
         {
           memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
         }
+    }
+  while (net_seqlock_retry(&g_neighbor_lock, seq));
 
-      /* Return success in any case meaning that a valid link layer
-       * address mapping is available for the IPv6 address.
+  if (neighbor != NULL)
+    {
+      /* Return success meaning that a valid link layer address mapping is
+       * available for the IPv6 address.
        */
 
       return OK;
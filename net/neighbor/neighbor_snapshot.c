@@ -75,27 +75,37 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
                                unsigned int nentries)
 {
   unsigned int ncopied;
+  uint32_t seq;
   int i;
 
-  /* Copy all non-empty entries in the Neighbor table. */
+  /* Copy all non-empty entries in the Neighbor table.  Start over if the
+   * table was modified in the meantime.
+   */
 
-  for (i = 0, ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
-       i++)
+  do
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      seq = net_seqlock_read(&g_neighbor_lock);
 
-      /* An unused entry table entry will be nullified.  In particularly,
-       * the Neighbor IP address will be all zero (i.e., the unspecified
-       * IPv6 address).
-       */
-
-      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
+      for (i = 0, ncopied = 0;
+           nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
+           i++)
         {
-          memcpy(&snapshot[ncopied], neighbor, sizeof(struct neighbor_entry_s));
-          ncopied++;
+          FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+
+          /* An unused entry table entry will be nullified.  In
+           * particularly, the Neighbor IP address will be all zero (i.e.,
+           * the unspecified IPv6 address).
+           */
+
+          if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
+            {
+              memcpy(&snapshot[ncopied], neighbor,
+                     sizeof(struct neighbor_entry_s));
+              ncopied++;
+            }
         }
     }
+  while (net_seqlock_retry(&g_neighbor_lock, seq));
 
   /* Return the number of entries copied into the user buffer */
 
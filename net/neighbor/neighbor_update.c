@@ -68,10 +68,14 @@
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
   struct neighbor_entry_s *neighbor;
+  irqstate_t flags;
 
+  flags    = net_seqlock_wrlock(&g_neighbor_lock);
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
       neighbor->ne_time = clock_systimer();
     }
+
+  net_seqlock_wrunlock(&g_neighbor_lock, flags);
 }
@@ -51,6 +51,10 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+#ifdef CONFIG_NET_IOB_RX
+#  include <nuttx/mm/iob.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -497,6 +501,37 @@ struct lifconf;  /* Forward reference */
 int netdev_ipv6_ifconf(FAR struct lifconf *lifc);
 #endif
 
+/****************************************************************************
+ * Name: netdev_iob_adopt
+ *
+ * Description:
+ *   Take over the I/O buffer that the driver received the current packet
+ *   into so that the payload can be buffered without copying.  This is only
+ *   possible if the driver provided an IOB in d_iob and the data lies within
+ *   it.  On success, the driver is given a new IOB holding a copy of the
+ *   headers in place of the adopted one.
+ *
+ * Input Parameters:
+ *   dev        - The device driver structure holding the packet
+ *   buffer     - The start of the data to be adopted, within d_buf
+ *   buflen     - The length of the data to be adopted
+ *   consumerid - The IOB user of the new IOB given to the driver
+ *
+ * Returned Value:
+ *   The adopted IOB, trimmed to the data, or NULL if the data must be
+ *   copied instead.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_RX
+FAR struct iob_s *netdev_iob_adopt(FAR struct net_driver_s *dev,
+                                   FAR uint8_t *buffer, uint16_t buflen,
+                                   enum iob_user_e consumerid);
+#endif
+
 /****************************************************************************
  * Name: netdown_notifier_setup
  *
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NET_IOB_RX
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_adopt
+ *
+ * Description:
+ *   Take over the I/O buffer that the driver received the current packet
+ *   into so that the payload can be buffered without copying.  This is only
+ *   possible if the driver provided an IOB in d_iob and the data lies within
+ *   it.  On success, the driver is given a new IOB holding a copy of the
+ *   headers in place of the adopted one.
+ *
+ * Input Parameters:
+ *   dev        - The device driver structure holding the packet
+ *   buffer     - The start of the data to be adopted, within d_buf
+ *   buflen     - The length of the data to be adopted
+ *   consumerid - The IOB user of the new IOB given to the driver
+ *
+ * Returned Value:
+ *   The adopted IOB, trimmed to the data, or NULL if the data must be
+ *   copied instead.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_adopt(FAR struct net_driver_s *dev,
+                                   FAR uint8_t *buffer, uint16_t buflen,
+                                   enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *newiob;
+  unsigned int hdrlen;
+
+  /* The packet must be held in the single IOB that d_buf refers to and the
+   * data must lie within that packet.
+   */
+
+  if (iob == NULL || buflen == 0 || iob->io_flink != NULL ||
+      dev->d_buf != &iob->io_data[iob->io_offset] ||
+      buffer < dev->d_buf || buffer + buflen > dev->d_buf + iob->io_len)
+    {
+      return NULL;
+    }
+
+  /* The driver still needs a buffer for the rest of the input processing
+   * and for any response.  Don't adopt the IOB if no other one is free.
+   */
+
+  newiob = iob_tryalloc(true, consumerid);
+  if (newiob == NULL)
+    {
+      return NULL;
+    }
+
+  /* Copy the headers since the response may be built from them in place */
+
+  hdrlen = buffer - dev->d_buf;
+  memcpy(newiob->io_data, dev->d_buf, hdrlen);
+
+  newiob->io_len    = hdrlen;
+  newiob->io_pktlen = hdrlen;
+
+  dev->d_appdata = newiob->io_data + (dev->d_appdata - dev->d_buf);
+  dev->d_buf     = newiob->io_data;
+  dev->d_iob     = newiob;
+
+  /* And trim the adopted IOB down to the data */
+
+  iob->io_offset += hdrlen;
+  iob->io_len     = buflen;
+  iob->io_pktlen  = buflen;
+
+  ninfo("Adopted %u bytes\n", buflen);
+  return iob;
+}
+
+#endif /* CONFIG_NET_IOB_RX */
@@ -389,14 +389,12 @@ static int netlink_get_arptable(NETLINK_HANDLE handle,
   entry->payload.msg.ndm_family = req->gen.rtgen_family;
   entry->payload.attr.rta_len   = RTA_LENGTH(tabsize);
 
-  /* Lock the network so that the ARP table will be stable, then copy
-   * the ARP table into the allocated memory.
+  /* Copy the ARP table into the allocated memory.  The ARP table has its
+   * own lock, so the network need not be locked.
    */
 
-  net_lock();
   ncopied = arp_snapshot((FAR struct arp_entry_s *)entry->payload.data,
                          CONFIG_NET_ARPTAB_SIZE);
-  net_unlock();
 
   /* Now we have the real number of valid entries in the ARP table and
    * we can trim the allocation.
@@ -472,15 +470,13 @@ static int netlink_get_nbtable(NETLINK_HANDLE handle,
   entry->payload.msg.ndm_family = req->gen.rtgen_family;
   entry->payload.attr.rta_len   = RTA_LENGTH(tabsize);
 
-  /* Lock the network so that the Neighbor table will be stable, then
-   * copy the Neighbor table into the allocated memory.
+  /* Copy the Neighbor table into the allocated memory.  The Neighbor table
+   * has its own lock, so the network need not be locked.
    */
 
-  net_lock();
   ncopied = neighbor_snapshot(
     (FAR struct neighbor_entry_s *)entry->payload.data,
     CONFIG_NET_IPv6_NCONF_ENTRIES);
-  net_unlock();
 
   /* Now we have the real number of valid entries in the Neighbor table
    * and we can trim the allocation.
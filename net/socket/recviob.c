@@ -0,0 +1,215 @@
+/****************************************************************************
+ * net/socket/recviob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET_IOB_RX
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_recviob
+ *
+ * Description:
+ *   Take the I/O buffer chain at the head of the TCP read-ahead queue.
+ *
+ ****************************************************************************/
+
+#ifdef NET_TCP_HAVE_STACK
+static ssize_t tcp_recviob(FAR struct socket *psock,
+                           FAR struct iob_s **iobp)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  FAR struct iob_s *iob;
+
+  iob = iob_remove_queue(&conn->readahead);
+  if (iob != NULL)
+    {
+      *iobp = iob;
+      return iob->io_pktlen;
+    }
+
+  /* Nothing is buffered.  Report end-of-file if the peer has gracefully
+   * closed the connection.
+   */
+
+  if (!_SS_ISCONNECTED(psock->s_flags))
+    {
+      return _SS_ISCLOSED(psock->s_flags) ? 0 : -ENOTCONN;
+    }
+
+  return -EAGAIN;
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_recviob
+ *
+ * Description:
+ *   Take the next datagram from the UDP read-ahead queue and strip the
+ *   source address that precedes the data in the I/O buffer chain.
+ *
+ ****************************************************************************/
+
+#ifdef NET_UDP_HAVE_STACK
+static ssize_t udp_recviob(FAR struct socket *psock,
+                           FAR struct iob_s **iobp,
+                           FAR struct sockaddr *from,
+                           FAR socklen_t *fromlen)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  FAR struct iob_s *iob;
+  uint8_t src_addr_size;
+  socklen_t len;
+
+  iob = iob_remove_queue(&conn->readahead);
+  if (iob == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  DEBUGASSERT(iob->io_pktlen > 0);
+
+  /* The chain begins with the size of the source address followed by the
+   * source address itself.
+   */
+
+  if (iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0) !=
+      sizeof(uint8_t))
+    {
+      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+      return -EAGAIN;
+    }
+
+  if (from != NULL && fromlen != NULL)
+    {
+      len = src_addr_size < *fromlen ? src_addr_size : *fromlen;
+      iob_copyout((FAR uint8_t *)from, iob, len, sizeof(uint8_t));
+      *fromlen = src_addr_size;
+    }
+
+  *iobp = iob_trimhead(iob, src_addr_size + sizeof(uint8_t),
+                       IOBUSER_NET_UDP_READAHEAD);
+  return (*iobp)->io_pktlen;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Take the I/O buffer chain at the head of the read-ahead queue of a TCP
+ *   or UDP socket.  This lets in-kernel consumers use the received data
+ *   without copying it.  For a UDP socket, the chain holds exactly one
+ *   datagram.  For a TCP socket, it holds the data of one or more
+ *   segments.  This is an internal OS interface; it never waits for data.
+ *
+ *   The caller owns the returned chain and must release it with
+ *   iob_free_chain() using IOBUSER_NET_TCP_READAHEAD or
+ *   IOBUSER_NET_UDP_READAHEAD.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iobp    - The location to return the I/O buffer chain
+ *   from    - Address of the source of a UDP datagram (may be NULL)
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   The number of bytes in the returned chain on success.  Zero is returned
+ *   with *iobp set to NULL if a TCP peer performed an orderly shutdown.
+ *   Otherwise, a negated errno value is returned:
+ *
+ *   EAGAIN     - No data is buffered
+ *   EBADF      - The socket is not valid
+ *   ENOTCONN   - The TCP socket is not connected
+ *   EOPNOTSUPP - The socket is not a TCP or UDP socket
+ *
+ ****************************************************************************/
+
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iobp,
+                      FAR struct sockaddr *from, FAR socklen_t *fromlen)
+{
+  ssize_t ret;
+
+  DEBUGASSERT(iobp != NULL);
+  *iobp = NULL;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_domain != PF_INET && psock->s_domain != PF_INET6)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  net_lock();
+
+  switch (psock->s_type)
+    {
+#ifdef NET_TCP_HAVE_STACK
+      case SOCK_STREAM:
+        ret = tcp_recviob(psock, iobp);
+        break;
+#endif
+
+#ifdef NET_UDP_HAVE_STACK
+      case SOCK_DGRAM:
+        ret = udp_recviob(psock, iobp, from, fromlen);
+        break;
+#endif
+
+      default:
+        ret = -EOPNOTSUPP;
+        break;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_IOB_RX */
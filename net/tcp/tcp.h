@@ -208,6 +208,19 @@ struct tcp_conn_s
 
   FAR struct net_driver_s *dev;
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Hash table support
+   *
+   *   hnext - The next connection in the connection hash bucket.  Only
+   *           connections in the active list are in this table.
+   *   pnext - The next connection in the local port hash bucket.  All
+   *           connections with an assigned local port are in this table.
+   */
+
+  FAR struct tcp_conn_s *hnext;
+  FAR struct tcp_conn_s *pnext;
+#endif
+
   /* Read-ahead buffering.
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
@@ -1107,6 +1120,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device driver structure holding the received packet
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1123,7 +1137,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
 /****************************************************************************
@@ -71,6 +71,20 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_TCP_HASH
+#  if (CONFIG_NET_TCP_HASHSIZE & (CONFIG_NET_TCP_HASHSIZE - 1)) != 0
+#    error CONFIG_NET_TCP_HASHSIZE must be a power of two
+#  endif
+
+#  define TCP_HASH_MASK       (CONFIG_NET_TCP_HASHSIZE - 1)
+
+/* Candidates for an incoming segment are in a single hash bucket */
+
+#  define tcp_active_next(c)  ((c)->hnext)
+#else
+#  define tcp_active_next(c)  ((FAR struct tcp_conn_s *)(c)->node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -91,10 +105,191 @@ static dq_queue_t g_active_tcp_connections;
 
 static uint16_t g_last_tcp_port;
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The active connections hashed by local port, remote port and remote
+ * address and all connections with a local port hashed by the local port.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_HASHSIZE];
+static FAR struct tcp_conn_s *g_tcp_porthash[CONFIG_NET_TCP_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_HASH
+/****************************************************************************
+ * Name: tcp_porthash
+ *
+ * Description:
+ *   Return the local port hash bucket of a port number (in network byte
+ *   order).
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_porthash(uint16_t portno)
+{
+  return (portno ^ (portno >> 8)) & TCP_HASH_MASK;
+}
+
+/****************************************************************************
+ * Name: tcp_connhash
+ *
+ * Description:
+ *   Return the connection hash bucket of a local port, a remote port (both
+ *   in network byte order) and a 32-bit key derived from the remote
+ *   address.
+ *
+ *   The local address is not hashed:  A connection bound to the wildcard
+ *   address must be found for any destination address.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_connhash(uint16_t lport, uint16_t rport,
+                                        uint32_t addrkey)
+{
+  uint32_t key = addrkey ^ ((uint32_t)lport << 16 | rport);
+
+  key ^= key >> 16;
+  key ^= key >> 8;
+  return key & TCP_HASH_MASK;
+}
+
+/****************************************************************************
+ * Name: tcp_ipv6_addrkey
+ *
+ * Description:
+ *   Fold an IPv6 address into a 32-bit hash key.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_addrkey(const net_ipv6addr_t addr)
+{
+  uint32_t key = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= (uint32_t)addr[i] << 16 | addr[i + 1];
+    }
+
+  return key;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_addrkey
+ *
+ * Description:
+ *   Return the hash key of the remote address of a connection.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_conn_addrkey(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return (uint32_t)conn->u.ipv4.raddr;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_ipv6_addrkey(conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_hash_add and tcp_hash_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from the connection hash table.  This
+ *   must accompany each addition to and removal from the active list.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_add(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx;
+
+  ndx = tcp_connhash(conn->lport, conn->rport, tcp_conn_addrkey(conn));
+  conn->hnext = g_tcp_connhash[ndx];
+  g_tcp_connhash[ndx] = conn;
+}
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **pprev;
+  unsigned int ndx;
+
+  ndx = tcp_connhash(conn->lport, conn->rport, tcp_conn_addrkey(conn));
+  for (pprev = &g_tcp_connhash[ndx]; *pprev != NULL;
+       pprev = &(*pprev)->hnext)
+    {
+      if (*pprev == conn)
+        {
+          *pprev = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_port_add and tcp_port_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from the local port hash table.  A
+ *   connection must be removed before its local port number changes.
+ *   Removing a connection that is not in the table is harmless.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_port_add(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx = tcp_porthash(conn->lport);
+
+  conn->pnext = g_tcp_porthash[ndx];
+  g_tcp_porthash[ndx] = conn;
+}
+
+static void tcp_port_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **pprev;
+
+  for (pprev = &g_tcp_porthash[tcp_porthash(conn->lport)]; *pprev != NULL;
+       pprev = &(*pprev)->pnext)
+    {
+      if (*pprev == conn)
+        {
+          *pprev = conn->pnext;
+          conn->pnext = NULL;
+          break;
+        }
+    }
+}
+#else
+#  define tcp_hash_add(conn)
+#  define tcp_hash_remove(conn)
+#  define tcp_port_add(conn)
+#  define tcp_port_remove(conn)
+#endif /* CONFIG_NET_TCP_HASH */
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -112,13 +307,21 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_HASH
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+  for (conn = g_tcp_porthash[tcp_porthash(portno)]; conn != NULL;
+       conn = conn->pnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
     {
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -163,13 +366,21 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_HASH
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+  for (conn = g_tcp_porthash[tcp_porthash(portno)]; conn != NULL;
+       conn = conn->pnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
     {
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -326,10 +537,16 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_HASH
+  conn       = g_tcp_connhash[tcp_connhash(tcp->destport, tcp->srcport,
+                                           (uint32_t)srcipaddr)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -363,9 +580,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = tcp_active_next(conn);
     }
 
   return conn;
@@ -393,10 +610,16 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_HASH
+  conn       = g_tcp_connhash[tcp_connhash(tcp->destport, tcp->srcport,
+                                           tcp_ipv6_addrkey(*srcipaddr))];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -430,9 +653,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = tcp_active_next(conn);
     }
 
   return conn;
@@ -478,6 +701,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_port_remove(conn);
   conn->lport = htons(port);
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
 
@@ -499,6 +723,9 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
       return ret;
     }
 
+  /* The local port is now in use */
+
+  tcp_port_add(conn);
   net_unlock();
   return OK;
 }
@@ -545,6 +772,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_port_remove(conn);
   conn->lport = htons(port);
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
 
@@ -566,6 +794,9 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
       return ret;
     }
 
+  /* The local port is now in use */
+
+  tcp_port_add(conn);
   net_unlock();
   return OK;
 }
@@ -604,6 +835,14 @@ void tcp_initialize(void)
     }
 
   g_last_tcp_port = 1024;
+
+#ifdef CONFIG_NET_TCP_HASH
+  for (i = 0; i < CONFIG_NET_TCP_HASHSIZE; i++)
+    {
+      g_tcp_connhash[i] = NULL;
+      g_tcp_porthash[i] = NULL;
+    }
+#endif
 }
 
 /****************************************************************************
@@ -772,8 +1011,13 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+      tcp_hash_remove(conn);
     }
 
+  /* Release the local port number */
+
+  tcp_port_remove(conn);
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_TCP_READAHEAD);
@@ -1033,6 +1277,8 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_hash_add(conn);
+      tcp_port_add(conn);
     }
 
   return conn;
@@ -1244,7 +1490,9 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
+  tcp_port_remove(conn);
   conn->lport      = htons((uint16_t)port);
+  tcp_port_add(conn);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1266,6 +1514,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_hash_add(conn);
   ret = OK;
 
 errout_with_lock:
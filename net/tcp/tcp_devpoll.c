@@ -86,6 +86,9 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
   dev->d_len     = 0;
   dev->d_sndlen  = 0;
+#ifdef CONFIG_NET_CHKSUM_COPY
+  dev->d_sndsumlen = 0;
+#endif
 
   /* Verify that the connection is established. */
 
@@ -45,6 +45,7 @@
 #include <poll.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
 
@@ -129,7 +130,7 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           info->cb->event   = NULL;
 
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -177,7 +178,7 @@ static inline void tcp_iob_work(FAR void *arg)
            */
 
           fds->revents |= (POLLERR | POLLHUP);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 
@@ -195,7 +196,7 @@ static inline void tcp_iob_work(FAR void *arg)
           /* Yes.. then signal the poll logic */
 
           fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
       else
         {
@@ -371,7 +372,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
@@ -201,9 +201,9 @@ static inline void tcp_newdata(FAR struct net_driver_s *dev,
 #ifdef CONFIG_DEBUG_NET
       uint16_t nsaved;
 
-      nsaved = tcp_datahandler(conn, buffer, buflen);
+      nsaved = tcp_datahandler(dev, conn, buffer, buflen);
 #else
-      tcp_datahandler(conn, buffer, buflen);
+      tcp_datahandler(dev, conn, buffer, buflen);
 #endif
 
       /* There are complicated buffering issues that are not addressed fully
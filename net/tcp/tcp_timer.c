@@ -139,6 +139,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   dev->d_len    = 0;
   dev->d_sndlen = 0;
+#ifdef CONFIG_NET_CHKSUM_COPY
+  dev->d_sndsumlen = 0;
+#endif
 
   /* Check if the connection is in a state in which we simply wait
    * for the connection to time out. If so, we increase the
@@ -50,6 +50,7 @@
 #include <nuttx/net/udp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -79,6 +80,7 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
                                 FAR struct udp_conn_s *conn,
                                 FAR uint8_t *buffer, uint16_t buflen)
 {
+  FAR struct iob_s *data = NULL;
   FAR struct iob_s *iob;
   int ret;
 #ifdef CONFIG_NET_IPv6
@@ -204,7 +206,24 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
       return 0;
     }
 
+#ifdef CONFIG_NET_IOB_RX
+  /* If the driver received the packet into an I/O buffer, then append that
+   * buffer to the chain instead of copying the data.  The address header
+   * was already taken from the packet above.
+   */
+
   if (buflen > 0)
+    {
+      data = netdev_iob_adopt(dev, buffer, buflen,
+                              IOBUSER_NET_UDP_READAHEAD);
+      if (data != NULL)
+        {
+          iob_concat(iob, data);
+        }
+    }
+#endif
+
+  if (buflen > 0 && data == NULL)
     {
       /* Copy the new appdata into the I/O buffer chain */
 
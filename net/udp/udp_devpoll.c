@@ -95,6 +95,9 @@ void udp_poll(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
 
       dev->d_len     = 0;
       dev->d_sndlen  = 0;
+#ifdef CONFIG_NET_CHKSUM_COPY
+      dev->d_sndsumlen = 0;
+#endif
 
       /* Perform the application callback */
 
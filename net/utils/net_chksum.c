@@ -41,33 +41,48 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/compiler.h>
+
 #include "utils/utils.h"
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
+
 /****************************************************************************
- * Public Functions
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* The checksum is accumulated over naturally aligned words in host byte
+ * order (RFC 1071 section 2(B)) and folded to 16 bits at the end.  A 64-bit
+ * accumulator takes 32-bit words and cannot overflow for any packet size;
+ * otherwise 16-bit words are added to a 32-bit accumulator, which cannot
+ * overflow for 65535 bytes either.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+#  define CHKSUM_WORDS32 1
+typedef uint64_t chksum_acc_t;
+#else
+typedef uint32_t chksum_acc_t;
+#endif
+
 /****************************************************************************
- * Name: chksum
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_bytes
  *
  * Description:
- *   Calculate the raw change some over the memory region described by
- *   data and len.
- *
- * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to
- *          chksum().  This should be zero on the first time that check
- *          sum is called.
- *   data - Beginning of the data to include in the checksum.
- *   len  - Length of the data to include in the checksum.
- *
- * Returned Value:
- *   The updated checksum value.
+ *   Calculate the checksum one big-endian 16-bit word at a time.  This is
+ *   used for data that is not 16-bit aligned.
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+static uint16_t chksum_bytes(uint16_t sum, FAR const uint8_t *data,
+                             uint16_t len)
 {
   FAR const uint8_t *dataptr;
   FAR const uint8_t *last_byte;
@@ -104,6 +119,254 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 
   return sum;
 }
+
+/****************************************************************************
+ * Name: chksum_lastbyte
+ *
+ * Description:
+ *   Return a trailing odd byte as the host order value of the big-endian
+ *   16-bit word that it starts.
+ *
+ ****************************************************************************/
+
+static inline chksum_acc_t chksum_lastbyte(uint8_t byte)
+{
+#ifdef CONFIG_ENDIAN_BIG
+  return (chksum_acc_t)byte << 8;
+#else
+  return byte;
+#endif
+}
+
+/****************************************************************************
+ * Name: chksum_finish
+ *
+ * Description:
+ *   Fold the accumulator to 16 bits, convert it to the sum of big-endian
+ *   words and add it to 'sum' with end-around carry.
+ *
+ ****************************************************************************/
+
+static uint16_t chksum_finish(uint16_t sum, chksum_acc_t acc)
+{
+  uint16_t part;
+
+  while ((acc >> 16) != 0)
+    {
+      acc = (acc & 0xffff) + (acc >> 16);
+    }
+
+  part = (uint16_t)acc;
+#ifndef CONFIG_ENDIAN_BIG
+  part = (uint16_t)((part << 8) | (part >> 8));
+#endif
+
+  sum += part;
+  if (sum < part)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
+/****************************************************************************
+ * Name: chksum_aligned
+ *
+ * Description:
+ *   Accumulate 16-bit aligned data in host byte order.
+ *
+ ****************************************************************************/
+
+static chksum_acc_t chksum_aligned(FAR const uint8_t *data, uint16_t len)
+{
+  chksum_acc_t acc = 0;
+#ifdef CHKSUM_WORDS32
+  FAR const uint32_t *src32;
+
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  src32 = (FAR const uint32_t *)data;
+  while (len >= 32)
+    {
+      acc += src32[0];
+      acc += src32[1];
+      acc += src32[2];
+      acc += src32[3];
+      acc += src32[4];
+      acc += src32[5];
+      acc += src32[6];
+      acc += src32[7];
+      src32 += 8;
+      len   -= 32;
+    }
+
+  while (len >= 4)
+    {
+      acc += *src32++;
+      len -= 4;
+    }
+
+  data = (FAR const uint8_t *)src32;
+#endif
+
+  while (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      acc += chksum_lastbyte(*data);
+    }
+
+  return acc;
+}
+
+/****************************************************************************
+ * Name: chksum_copyaligned
+ *
+ * Description:
+ *   Copy data and accumulate it in host byte order.  'src' must be 16-bit
+ *   aligned and 'dest' must have the same alignment as 'src' modulo 4.
+ *
+ ****************************************************************************/
+
+static chksum_acc_t chksum_copyaligned(FAR uint8_t *dest,
+                                       FAR const uint8_t *src, uint16_t len)
+{
+  chksum_acc_t acc = 0;
+  uint16_t word16;
+#ifdef CHKSUM_WORDS32
+  FAR const uint32_t *src32;
+  FAR uint32_t *dest32;
+  uint32_t word32;
+
+  if (((uintptr_t)src & 2) != 0 && len >= 2)
+    {
+      word16 = *(FAR const uint16_t *)src;
+      *(FAR uint16_t *)dest = word16;
+      acc  += word16;
+      src  += 2;
+      dest += 2;
+      len  -= 2;
+    }
+
+  src32  = (FAR const uint32_t *)src;
+  dest32 = (FAR uint32_t *)dest;
+
+  while (len >= 4)
+    {
+      word32    = *src32++;
+      *dest32++ = word32;
+      acc      += word32;
+      len      -= 4;
+    }
+
+  src  = (FAR const uint8_t *)src32;
+  dest = (FAR uint8_t *)dest32;
+#endif
+
+  while (len >= 2)
+    {
+      word16 = *(FAR const uint16_t *)src;
+      *(FAR uint16_t *)dest = word16;
+      acc  += word16;
+      src  += 2;
+      dest += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      *dest = *src;
+      acc  += chksum_lastbyte(*src);
+    }
+
+  return acc;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum
+ *
+ * Description:
+ *   Calculate the raw change some over the memory region described by
+ *   data and len.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+{
+  if (((uintptr_t)data & 1) != 0)
+    {
+      return chksum_bytes(sum, data, len);
+    }
+
+  return chksum_finish(sum, chksum_aligned(data, len));
+}
+
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy 'len' bytes from 'src' to 'dest' and return the checksum of the
+ *   data as chksum() would.  Both are done in one pass over the data when
+ *   the alignments of 'src' and 'dest' allow it.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first call.
+ *   dest - The location to copy the data to
+ *   src  - The data to be copied and included in the checksum
+ *   len  - Length of the data
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len)
+{
+#ifdef CHKSUM_WORDS32
+  uintptr_t mask = 3;
+#else
+  uintptr_t mask = 1;
+#endif
+
+  if (((uintptr_t)src & 1) != 0 ||
+      (((uintptr_t)src ^ (uintptr_t)dest) & mask) != 0)
+    {
+      /* Checksum the copy while it is still in the cache */
+
+      memcpy(dest, src, len);
+      return chksum(sum, dest, len);
+    }
+
+  return chksum_finish(sum, chksum_copyaligned(dest, src, len));
+}
+
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
 /****************************************************************************
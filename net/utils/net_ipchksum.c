@@ -56,6 +56,56 @@
 #define IPv4BUF  ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF  ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: upperlayer_chksum
+ *
+ * Description:
+ *   Add the checksum of the upper layer header and payload at 'upper' to
+ *   the pseudo-header sum.  If the payload sum was computed when the
+ *   payload was copied into d_buf, only the header is summed here.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM)
+static uint16_t upperlayer_chksum(FAR struct net_driver_s *dev,
+                                  uint16_t sum, FAR uint8_t *upper,
+                                  uint16_t upperlen)
+{
+#ifdef CONFIG_NET_CHKSUM_COPY
+  uint16_t sndsumlen = dev->d_sndsumlen;
+  uintptr_t hdrlen;
+
+  /* The payload sum can be used only once and only for this packet */
+
+  dev->d_sndsumlen = 0;
+
+  if (sndsumlen != 0 && sndsumlen == dev->d_sndlen &&
+      dev->d_appdata >= upper)
+    {
+      /* The payload must start at an even offset to add its sum */
+
+      hdrlen = dev->d_appdata - upper;
+      if ((hdrlen & 1) == 0 && hdrlen + sndsumlen == upperlen)
+        {
+          sum += dev->d_sndsum;
+          if (sum < dev->d_sndsum)
+            {
+              sum++; /* carry */
+            }
+
+          return chksum(sum, upper, (uint16_t)hdrlen);
+        }
+    }
+#endif
+
+  return chksum(sum, upper, upperlen);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -116,7 +166,9 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
+  sum = upperlayer_chksum(dev, sum,
+                          &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)],
+                          upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -183,7 +235,8 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+  sum = upperlayer_chksum(dev, sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen],
+                          upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -0,0 +1,165 @@
+/****************************************************************************
+ * net/utils/net_seqlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Readers only run concurrently with a writer on another CPU.  In the
+ * single CPU case, the function calls are sufficient compiler barriers.
+ */
+
+#ifdef CONFIG_SMP
+#  define net_seqlock_barrier() SP_DMB()
+#else
+#  define net_seqlock_barrier()
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_seqlock_wrlock
+ *
+ * Description:
+ *   Begin a modification of a table protected by a sequence lock.  Writers
+ *   are serialized and local interrupts are disabled until the matching
+ *   call to net_seqlock_wrunlock().
+ *
+ * Input Parameters:
+ *   seqlock - The sequence lock of the table
+ *
+ * Returned Value:
+ *   The interrupt state to be passed to net_seqlock_wrunlock().
+ *
+ ****************************************************************************/
+
+irqstate_t net_seqlock_wrlock(FAR struct net_seqlock_s *seqlock)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock(&seqlock->sl_lock);
+#endif
+
+  /* Make the sequence odd so that readers know that the table is being
+   * modified.
+   */
+
+  seqlock->sl_seq++;
+  net_seqlock_barrier();
+  return flags;
+}
+
+/****************************************************************************
+ * Name: net_seqlock_wrunlock
+ *
+ * Description:
+ *   End a modification of a table protected by a sequence lock.
+ *
+ * Input Parameters:
+ *   seqlock - The sequence lock of the table
+ *   flags   - The value returned by net_seqlock_wrlock()
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_seqlock_wrunlock(FAR struct net_seqlock_s *seqlock,
+                          irqstate_t flags)
+{
+  DEBUGASSERT((seqlock->sl_seq & 1) != 0);
+
+  net_seqlock_barrier();
+  seqlock->sl_seq++;
+
+#ifdef CONFIG_SMP
+  spin_unlock(&seqlock->sl_lock);
+#endif
+
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: net_seqlock_read
+ *
+ * Description:
+ *   Begin a lock-free read of a table protected by a sequence lock.  If a
+ *   writer is active on another CPU, this waits for it to finish.
+ *
+ * Input Parameters:
+ *   seqlock - The sequence lock of the table
+ *
+ * Returned Value:
+ *   The sequence value to be passed to net_seqlock_retry().
+ *
+ ****************************************************************************/
+
+uint32_t net_seqlock_read(FAR struct net_seqlock_s *seqlock)
+{
+  uint32_t seq;
+
+  while (((seq = seqlock->sl_seq) & 1) != 0)
+    {
+    }
+
+  net_seqlock_barrier();
+  return seq;
+}
+
+/****************************************************************************
+ * Name: net_seqlock_retry
+ *
+ * Description:
+ *   Check whether a lock-free read begun by net_seqlock_read() raced with
+ *   a writer.
+ *
+ * Input Parameters:
+ *   seqlock - The sequence lock of the table
+ *   seq     - The value returned by net_seqlock_read()
+ *
+ * Returned Value:
+ *   True if the data read may be inconsistent and the read must be
+ *   repeated.
+ *
+ ****************************************************************************/
+
+bool net_seqlock_retry(FAR struct net_seqlock_s *seqlock, uint32_t seq)
+{
+  net_seqlock_barrier();
+  return seqlock->sl_seq != seq;
+}
@@ -41,6 +41,12 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
@@ -57,6 +63,20 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+/* A sequence lock protecting a small, fixed-size network table (such as the
+ * ARP table).  Writers are serialized and run with local interrupts
+ * disabled; readers take no lock at all but must repeat their access if a
+ * writer was active in the meantime.
+ */
+
+struct net_seqlock_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t sl_lock;          /* Serializes writers */
+#endif
+  volatile uint32_t sl_seq;    /* Odd while a write is in progress */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -111,6 +131,33 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_seqlock_wrlock and net_seqlock_wrunlock
+ *
+ * Description:
+ *   Begin and end a modification of a table protected by a sequence lock.
+ *   Local interrupts are disabled between the two calls.
+ *
+ ****************************************************************************/
+
+irqstate_t net_seqlock_wrlock(FAR struct net_seqlock_s *seqlock);
+void net_seqlock_wrunlock(FAR struct net_seqlock_s *seqlock,
+                          irqstate_t flags);
+
+/****************************************************************************
+ * Name: net_seqlock_read and net_seqlock_retry
+ *
+ * Description:
+ *   Begin and validate a lock-free read of a table protected by a sequence
+ *   lock.  The value returned by net_seqlock_read() is passed to
+ *   net_seqlock_retry(); if that returns true, a writer interfered and the
+ *   read must be repeated.
+ *
+ ****************************************************************************/
+
+uint32_t net_seqlock_read(FAR struct net_seqlock_s *seqlock);
+bool net_seqlock_retry(FAR struct net_seqlock_s *seqlock, uint32_t seq);
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
@@ -236,6 +283,30 @@ void net_ipv6_pref2mask(uint8_t preflen, net_ipv6addr_t mask);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy 'len' bytes from 'src' to 'dest' and return the checksum of the
+ *   data as chksum() would, in one pass over the data when possible.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first call.
+ *   dest - The location to copy the data to
+ *   src  - The data to be copied and included in the checksum
+ *   len  - Length of the data
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len);
+#endif
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -112,17 +112,20 @@ mq_msgblockalloc(FAR sq_queue_t *queue, uint16_t nmsgs,
    */
 
   mqmsgblock = (FAR struct mqueue_msg_s *)
-    kmm_malloc(sizeof(struct mqueue_msg_s) * nmsgs);
+    kmm_malloc(MQ_MSG_FIXEDSIZE * nmsgs);
 
   if (mqmsgblock)
     {
-      struct mqueue_msg_s *mqmsg = mqmsgblock;
+      FAR char *next = (FAR char *)mqmsgblock;
+      FAR struct mqueue_msg_s *mqmsg;
       int      i;
 
       for (i = 0; i < nmsgs; i++)
         {
+          mqmsg       = (FAR struct mqueue_msg_s *)next;
           mqmsg->type = alloc_type;
-          sq_addlast((FAR sq_entry_t *)mqmsg++, queue);
+          sq_addlast((FAR sq_entry_t *)mqmsg, queue);
+          next       += MQ_MSG_FIXEDSIZE;
         }
     }
 
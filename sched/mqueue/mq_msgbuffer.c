@@ -0,0 +1,237 @@
+/****************************************************************************
+ * sched/mqueue/mq_msgbuffer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/mqueue.h>
+
+#include "sched/sched.h"
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Get the message that holds a buffer */
+
+#define MQ_BUFFER_MSG(b) \
+  ((FAR struct mqueue_msg_s *) \
+   ((FAR char *)(b) - offsetof(struct mqueue_msg_s, mail)))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_alloc_buffer
+ *
+ * Description:
+ *   Allocate a message buffer for the zero-copy interfaces.  The buffer is
+ *   the payload of a message so that nxmq_send_buffer() can queue it
+ *   without copying.  This may be called from an interrupt handler, but
+ *   only for buffers no larger than CONFIG_MQ_MAXMSGSIZE.
+ *
+ * Input Parameters:
+ *   buflen - The size of the buffer in bytes
+ *
+ * Returned Value:
+ *   The allocated buffer or NULL if no message could be allocated.
+ *
+ ****************************************************************************/
+
+FAR void *nxmq_alloc_buffer(size_t buflen)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+
+  if (buflen > MQ_MAX_LARGEBYTES)
+    {
+      return NULL;
+    }
+
+  mqmsg = nxmq_alloc_msg(buflen);
+  return mqmsg != NULL ? mqmsg->mail : NULL;
+}
+
+/****************************************************************************
+ * Name: nxmq_free_buffer
+ *
+ * Description:
+ *   Release a buffer obtained from nxmq_alloc_buffer() that was not sent
+ *   or a buffer returned by nxmq_receive_buffer().
+ *
+ * Input Parameters:
+ *   buffer - The buffer to release
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxmq_free_buffer(FAR void *buffer)
+{
+  if (buffer != NULL)
+    {
+      nxmq_free_msg(MQ_BUFFER_MSG(buffer));
+    }
+}
+
+/****************************************************************************
+ * Name: nxmq_send_buffer
+ *
+ * Description:
+ *   Queue the message that holds 'buffer' without copying the payload.
+ *   This behaves like nxmq_send() otherwise.  On success, the buffer
+ *   belongs to the message queue and must no longer be accessed by the
+ *   caller.  On failure, the caller still owns the buffer.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - Buffer obtained from nxmq_alloc_buffer()
+ *   msglen - The length of the message in bytes; no larger than the
+ *            buffer size
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure (see
+ *   nxmq_send()).
+ *
+ ****************************************************************************/
+
+int nxmq_send_buffer(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                     unsigned int prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret;
+
+  ret = nxmq_verify_send(mqdes, buffer, msglen, prio);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The msglen of an unsent message is the size of its buffer */
+
+  mqmsg = MQ_BUFFER_MSG(buffer);
+  if (msglen > mqmsg->msglen)
+    {
+      return -EMSGSIZE;
+    }
+
+  /* Wait for space in the message queue unless we are in an interrupt
+   * handler.  See nxmq_send().
+   */
+
+  sched_lock();
+  flags = enter_critical_section();
+
+  if (!up_interrupt_context() &&
+      mqdes->msgq->nmsgs >= mqdes->msgq->maxmsgs)
+    {
+      ret = nxmq_wait_send(mqdes);
+    }
+
+  leave_critical_section(flags);
+
+  /* The payload is already in place; nxmq_do_send() does not copy it */
+
+  if (ret >= 0)
+    {
+      ret = nxmq_do_send(mqdes, mqmsg, buffer, msglen, prio);
+    }
+
+  sched_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxmq_receive_buffer
+ *
+ * Description:
+ *   Remove the oldest of the highest priority messages from the message
+ *   queue and return its payload without copying.  This behaves like
+ *   nxmq_receive() otherwise.  The caller must release the buffer with
+ *   nxmq_free_buffer().
+ *
+ * Input Parameters:
+ *   mqdes  - Message Queue Descriptor
+ *   buffer - The location to return the message buffer
+ *   prio   - If not NULL, the location to store message priority.
+ *
+ * Returned Value:
+ *   The length of the message on success; a negated errno value on
+ *   failure (see nxmq_receive()).
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_receive_buffer(mqd_t mqdes, FAR void **buffer,
+                            FAR unsigned int *prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  ssize_t ret;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  /* There is no user buffer whose size must be checked */
+
+  if (buffer == NULL || mqdes == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if ((mqdes->oflags & O_RDOK) == 0)
+    {
+      return -EPERM;
+    }
+
+  /* Get the next message from the message queue.  See nxmq_receive(). */
+
+  sched_lock();
+  flags = enter_critical_section();
+  ret   = nxmq_wait_receive(mqdes, &mqmsg);
+  leave_critical_section(flags);
+
+  if (ret >= 0)
+    {
+      /* Hand the message itself over to the caller */
+
+      DEBUGASSERT(mqmsg != NULL);
+      ret     = nxmq_do_receive(mqdes, mqmsg, NULL, prio);
+      *buffer = mqmsg->mail;
+    }
+
+  sched_unlock();
+  return ret;
+}
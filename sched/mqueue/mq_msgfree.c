@@ -95,6 +95,15 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
     {
       kmm_free(mqmsg);
     }
+
+#ifdef CONFIG_MQ_MSGSLAB
+  /* Slab messages go back to their slab */
+
+  else if (mqmsg->type == MQ_ALLOC_SLAB)
+    {
+      nxmq_slab_free(mqmsg);
+    }
+#endif
   else
     {
       DEBUGPANIC();
@@ -66,8 +66,8 @@ FAR struct mqueue_inode_s *nxmq_alloc_msgq(mode_t mode,
    * larger than the configured maximum message size.
    */
 
-  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_BYTES);
-  if (attr && attr->mq_msgsize > MQ_MAX_BYTES)
+  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_LARGEBYTES);
+  if (attr && attr->mq_msgsize > MQ_MAX_LARGEBYTES)
     {
       return NULL;
     }
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * sched/mqueue/mq_msgslab.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <queue.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_MSGSLAB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size class 'n' holds messages of up to (MQ_SLAB_MINSIZE << n) bytes of
+ * payload.  Larger messages are allocated individually.
+ */
+
+#define MQ_SLAB_NCLASSES   6
+#define MQ_SLAB_MINSIZE    16
+#define MQ_SLAB_MAXSIZE    (MQ_SLAB_MINSIZE << (MQ_SLAB_NCLASSES - 1))
+#define MQ_SLAB_NMSGS      CONFIG_MQ_MSGSLAB_NMSGS
+
+#define MQ_SLAB_MSGSIZE(c) MQ_MSG_ALIGN(MQ_MSG_SIZE(MQ_SLAB_MINSIZE << (c)))
+#define MQ_SLAB_HDRSIZE    MQ_MSG_ALIGN(sizeof(struct mq_slab_s))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One slab:  A header followed by MQ_SLAB_NMSGS messages of one size
+ * class.
+ */
+
+struct mq_slab_s
+{
+  FAR struct mq_slab_s *flink;  /* Next slab of the same size class */
+  sq_queue_t freelist;          /* Free messages of this slab */
+  uint8_t nfree;                /* Number of free messages */
+  uint8_t sclass;               /* Size class of the messages */
+};
+
+/* The slabs of one size class */
+
+struct mq_slabclass_s
+{
+  sq_queue_t slabs;             /* All slabs of this size class */
+  uint16_t nempty;              /* Number of completely free slabs */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mq_slabclass_s g_mqslabs[MQ_SLAB_NCLASSES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_slab_takemsg
+ *
+ * Description:
+ *   Take a free message from a slab.
+ *
+ * Assumptions:
+ *   Executes within a critical section and the slab has a free message.
+ *
+ ****************************************************************************/
+
+static FAR struct mqueue_msg_s *
+mq_slab_takemsg(FAR struct mq_slabclass_s *slabclass,
+                FAR struct mq_slab_s *slab)
+{
+  DEBUGASSERT(slab->nfree > 0);
+
+  if (slab->nfree-- == MQ_SLAB_NMSGS)
+    {
+      slabclass->nempty--;
+    }
+
+  return (FAR struct mqueue_msg_s *)sq_remfirst(&slab->freelist);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_slab_alloc
+ *
+ * Description:
+ *   Allocate a message from the slabs of the smallest size class that
+ *   holds 'msglen' bytes.  A new slab is allocated from the heap if all
+ *   slabs of the size class are in use.
+ *
+ * Input Parameters:
+ *   msglen - The payload size of the message
+ *
+ * Returned Value:
+ *   The allocated message or NULL if 'msglen' is too large for the slabs
+ *   or if a new slab could not be allocated.
+ *
+ * Assumptions:
+ *   Not called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_slab_alloc(size_t msglen)
+{
+  FAR struct mq_slabclass_s *slabclass;
+  FAR struct mqueue_msg_s *mqmsg;
+  FAR struct mq_slab_s *slab;
+  FAR char *next;
+  irqstate_t flags;
+  size_t msgsize;
+  int sclass;
+  int i;
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  if (msglen > MQ_SLAB_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  for (sclass = 0; (MQ_SLAB_MINSIZE << sclass) < msglen; sclass++)
+    {
+    }
+
+  slabclass = &g_mqslabs[sclass];
+
+  /* Look for a slab with a free message */
+
+  flags = enter_critical_section();
+  for (slab = (FAR struct mq_slab_s *)slabclass->slabs.head;
+       slab != NULL && slab->nfree == 0;
+       slab = slab->flink)
+    {
+    }
+
+  if (slab != NULL)
+    {
+      mqmsg = mq_slab_takemsg(slabclass, slab);
+      leave_critical_section(flags);
+      return mqmsg;
+    }
+
+  leave_critical_section(flags);
+
+  /* All slabs are in use.  Grow the size class by one slab. */
+
+  msgsize = MQ_SLAB_MSGSIZE(sclass);
+  slab    = (FAR struct mq_slab_s *)
+    kmm_malloc(MQ_SLAB_HDRSIZE + MQ_SLAB_NMSGS * msgsize);
+
+  if (slab == NULL)
+    {
+      serr("ERROR: Failed to allocate a slab for %d byte messages\n",
+           MQ_SLAB_MINSIZE << sclass);
+      return NULL;
+    }
+
+  sq_init(&slab->freelist);
+  slab->nfree  = MQ_SLAB_NMSGS;
+  slab->sclass = sclass;
+
+  next = (FAR char *)slab + MQ_SLAB_HDRSIZE;
+  for (i = 0; i < MQ_SLAB_NMSGS; i++)
+    {
+      mqmsg       = (FAR struct mqueue_msg_s *)next;
+      mqmsg->type = MQ_ALLOC_SLAB;
+      mqmsg->slab = slab;
+      sq_addlast((FAR sq_entry_t *)mqmsg, &slab->freelist);
+      next       += msgsize;
+    }
+
+  /* The new slab goes first since it has the most free messages */
+
+  flags = enter_critical_section();
+  sq_addfirst((FAR sq_entry_t *)slab, &slabclass->slabs);
+  slabclass->nempty++;
+  mqmsg = mq_slab_takemsg(slabclass, slab);
+  leave_critical_section(flags);
+
+  sinfo("New slab %p for %d byte messages\n",
+        slab, MQ_SLAB_MINSIZE << sclass);
+  return mqmsg;
+}
+
+/****************************************************************************
+ * Name: nxmq_slab_free
+ *
+ * Description:
+ *   Return a message to its slab.  If that makes the slab completely free
+ *   and the size class already has a free slab, the slab is returned to
+ *   the heap.  One free slab is kept per size class so that a queue that
+ *   repeatedly fills and drains does not hit the heap each time.
+ *
+ * Input Parameters:
+ *   mqmsg - The message to free
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxmq_slab_free(FAR struct mqueue_msg_s *mqmsg)
+{
+  FAR struct mq_slabclass_s *slabclass;
+  FAR struct mq_slab_s *release = NULL;
+  FAR struct mq_slab_s *slab;
+  irqstate_t flags;
+
+  slab      = mqmsg->slab;
+  slabclass = &g_mqslabs[slab->sclass];
+
+  flags = enter_critical_section();
+  sq_addfirst((FAR sq_entry_t *)mqmsg, &slab->freelist);
+
+  if (++slab->nfree == MQ_SLAB_NMSGS)
+    {
+      /* The slab is idle.  Keep it only if it is the only idle slab.  The
+       * heap cannot be used from an interrupt handler.
+       */
+
+      if (slabclass->nempty > 0 && !up_interrupt_context())
+        {
+          sq_rem((FAR sq_entry_t *)slab, &slabclass->slabs);
+          release = slab;
+        }
+      else
+        {
+          slabclass->nempty++;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  if (release != NULL)
+    {
+      sinfo("Release slab %p\n", release);
+      kmm_free(release);
+    }
+}
+
+#endif /* CONFIG_MQ_MSGSLAB */
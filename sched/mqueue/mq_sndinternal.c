@@ -99,31 +99,31 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.
  *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
+ *   If the message is NOT being allocated from the interrupt level, then
+ *   the message will be taken from the message slabs (if enabled), then
+ *   from the g_msgfree list.  If that fails, the message will be allocated
+ *   from the heap with just enough room for 'msglen' bytes.
  *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
+ *   If the message IS being allocated from the interrupt level, this
+ *   function will try the g_msgfree list, then the g_msgfreeirq list.  If
+ *   this is unsuccessful, the calling interrupt handler will be notified.
+ *   Messages larger than MQ_MAX_BYTES cannot be allocated at the interrupt
+ *   level.
  *
  * Input Parameters:
- *   None
+ *   msglen - The payload size of the message
  *
  * Returned Value:
- *   A reference to the allocated msg structure.  On a failure to allocate,
- *   this function PANICs.
+ *   A reference to the allocated msg structure or NULL on a failure to
+ *   allocate.  The msglen field is set to the requested payload size.
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
+FAR struct mqueue_msg_s *nxmq_alloc_msg(size_t msglen)
 {
-  FAR struct mqueue_msg_s *mqmsg;
+  FAR struct mqueue_msg_s *mqmsg = NULL;
   irqstate_t flags;
 
   /* If we were called from an interrupt handler, then try to get the message
@@ -133,6 +133,11 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
   if (up_interrupt_context())
     {
+      if (msglen > MQ_MAX_BYTES)
+        {
+          return NULL;
+        }
+
       /* Try the general free list */
 
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
@@ -148,13 +153,22 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
   else
     {
+#ifdef CONFIG_MQ_MSGSLAB
+      /* Try to get the message from a slab of the right size class */
+
+      mqmsg = nxmq_slab_alloc(msglen);
+#endif
+
       /* Try to get the message from the generally available free list.
        * Disable interrupts -- we might be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      if (mqmsg == NULL && msglen <= MQ_MAX_BYTES)
+        {
+          flags = enter_critical_section();
+          mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
+          leave_critical_section(flags);
+        }
 
       /* If we cannot a message from the free list, then we will have to
        * allocate one.
@@ -163,7 +177,7 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
       if (mqmsg == NULL)
         {
           mqmsg = (FAR struct mqueue_msg_s *)
-            kmm_malloc((sizeof (struct mqueue_msg_s)));
+            kmm_malloc(MQ_MSG_SIZE(msglen));
 
           /* Check if we allocated the message */
 
@@ -178,6 +192,13 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
         }
     }
 
+  /* Remember the payload size.  nxmq_send_buffer() checks against it. */
+
+  if (mqmsg != NULL)
+    {
+      mqmsg->msglen = msglen;
+    }
+
   return mqmsg;
 }
 
@@ -344,9 +365,14 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
   mqmsg->priority = prio;
   mqmsg->msglen   = msglen;
 
-  /* Copy the message data into the message */
+  /* Copy the message data into the message (unless the data is already
+   * there, as with nxmq_send_buffer()).
+   */
 
-  memcpy((FAR void *)mqmsg->mail, (FAR const void *)msg, msglen);
+  if (msg != mqmsg->mail)
+    {
+      memcpy((FAR void *)mqmsg->mail, (FAR const void *)msg, msglen);
+    }
 
   /* Insert the new message in the message queue */
 
@@ -375,6 +401,18 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
   /* Increment the count of messages in the queue */
 
   msgq->nmsgs++;
+  msgq->nbytes += msglen;
+
+  if (msgq->nmsgs > msgq->peakmsgs)
+    {
+      msgq->peakmsgs = msgq->nmsgs;
+    }
+
+  if (msgq->nbytes > msgq->peakbytes)
+    {
+      msgq->peakbytes = msgq->nbytes;
+    }
+
   leave_critical_section(flags);
 
   /* Check if we need to notify any tasks that are attached to the
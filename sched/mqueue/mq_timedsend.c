@@ -165,7 +165,7 @@ int nxmq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen,
 
   /* Pre-allocate a message structure */
 
-  mqmsg = nxmq_alloc_msg();
+  mqmsg = nxmq_alloc_msg(msglen);
   if (mqmsg == NULL)
     {
       /* Failed to allocate the message. nxmq_alloc_msg() does not set the
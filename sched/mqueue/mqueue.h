@@ -31,6 +31,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <limits.h>
 #include <mqueue.h>
 #include <sched.h>
@@ -45,6 +46,15 @@
 
 #define MQ_MAX_BYTES   CONFIG_MQ_MAXMSGSIZE
 #define MQ_MAX_MSGS    16
+
+/* The largest message size that a message queue may be created with */
+
+#if defined(CONFIG_MQ_MAXLARGEMSGSIZE) && \
+    CONFIG_MQ_MAXLARGEMSGSIZE > CONFIG_MQ_MAXMSGSIZE
+#  define MQ_MAX_LARGEBYTES CONFIG_MQ_MAXLARGEMSGSIZE
+#else
+#  define MQ_MAX_LARGEBYTES MQ_MAX_BYTES
+#endif
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
 /* This defines the number of messages descriptors to allocate at each
@@ -59,6 +69,17 @@
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* Messages are variable length:  MQ_MSG_SIZE is the size of a message
+ * holding 'n' bytes of payload and MQ_MSG_ALIGN rounds that up so that
+ * messages may be placed back-to-back in an array.  MQ_MSG_FIXEDSIZE is
+ * the size of each of the pre-allocated messages.
+ */
+
+#define MQ_MSG_SIZE(n)   (offsetof(struct mqueue_msg_s, mail) + (n))
+#define MQ_MSG_ALIGN(s)  (((s) + sizeof(uintptr_t) - 1) & \
+                          ~(sizeof(uintptr_t) - 1))
+#define MQ_MSG_FIXEDSIZE MQ_MSG_ALIGN(MQ_MSG_SIZE(MQ_MAX_BYTES))
+
 /********************************************************************************
  * Public Type Definitions
  ********************************************************************************/
@@ -67,9 +88,12 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_SLAB        /* Part of a message slab */
 };
 
+struct mq_slab_s;      /* Forward reference */
+
 /* This structure describes one buffered POSIX message. */
 
 struct mqueue_msg_s
@@ -77,12 +101,15 @@ struct mqueue_msg_s
   FAR struct mqueue_msg_s *next;  /* Forward link to next message */
   uint8_t type;                   /* (Used to manage allocations) */
   uint8_t priority;               /* priority of message */
-#if MQ_MAX_BYTES < 256
+#if MQ_MAX_LARGEBYTES < 256
   uint8_t msglen;                 /* Message data length */
 #else
   uint16_t msglen;                /* Message data length */
 #endif
-  char mail[MQ_MAX_BYTES];        /* Message data */
+#ifdef CONFIG_MQ_MSGSLAB
+  FAR struct mq_slab_s *slab;     /* Containing slab (MQ_ALLOC_SLAB only) */
+#endif
+  char mail[1];                   /* Message data (variable length) */
 };
 
 /********************************************************************************
@@ -144,11 +171,18 @@ ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
 int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
                      unsigned int prio);
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void);
+FAR struct mqueue_msg_s *nxmq_alloc_msg(size_t msglen);
 int nxmq_wait_send(mqd_t mqdes);
 int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
                  FAR const char *msg, size_t msglen, unsigned int prio);
 
+/* mq_msgslab.c *****************************************************************/
+
+#ifdef CONFIG_MQ_MSGSLAB
+FAR struct mqueue_msg_s *nxmq_slab_alloc(size_t msglen);
+void nxmq_slab_free(FAR struct mqueue_msg_s *mqmsg);
+#endif
+
 /* mq_release.c *****************************************************************/
 
 void nxmq_release(FAR struct task_group_s *group);
@@ -379,6 +379,25 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int  nxsched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Ready-to-run list priority index.  sched_prioindex_remove() must be
+ * called before a TCB is removed from a task list (or before its priority
+ * is changed in place) and sched_prioindex_reset() after the entire content
+ * of a task list has been moved elsewhere.
+ */
+
+#ifdef CONFIG_SCHED_PRIOINDEX
+FAR struct tcb_s *sched_prioindex_find(FAR dq_queue_t *list,
+                                       uint8_t sched_priority);
+void sched_prioindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void sched_prioindex_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void sched_prioindex_reset(FAR dq_queue_t *list);
+#else
+#  define sched_prioindex_find(list,sched_priority) (NULL)
+#  define sched_prioindex_add(tcb,list)
+#  define sched_prioindex_remove(tcb,list)
+#  define sched_prioindex_reset(list)
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
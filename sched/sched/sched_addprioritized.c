@@ -89,10 +89,22 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * If the list is indexed, the search can start at the TCB last queued
+   * at the closest priority not lower than the priority of the new TCB.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+  prev = sched_prioindex_find(list, sched_priority);
+  if (prev != NULL && sched_priority <= prev->sched_priority)
+    {
+      DEBUGASSERT(prev != tcb);
+      next = prev->flink;
+    }
+  else
+    {
+      next = (FAR struct tcb_s *)list->head;
+    }
+
+  for (; (next && sched_priority <= next->sched_priority);
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
@@ -151,5 +163,6 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  sched_prioindex_add(tcb, list);
   return ret;
 }
@@ -383,6 +383,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
             {
               /* Remove the task from the assigned task list */
 
+              sched_prioindex_remove(next, tasklist);
               dq_rem((FAR dq_entry_t *)next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
@@ -138,6 +138,10 @@ bool sched_mergepending(void)
           ptcb->task_state  = TSTATE_TASK_READYTORUN;
         }
 
+      /* ptcb is now the last TCB of its priority in the list */
+
+      sched_prioindex_add(ptcb, (FAR dq_queue_t *)&g_readytorun);
+
       /* Set up for the next time through */
 
       rtcb = ptcb;
@@ -147,6 +151,7 @@ bool sched_mergepending(void)
 
   g_pendingtasks.head = NULL;
   g_pendingtasks.tail = NULL;
+  sched_prioindex_reset((FAR dq_queue_t *)&g_pendingtasks);
 
   return ret;
 }
@@ -223,6 +228,7 @@ bool sched_mergepending(void)
         {
           /* Remove the task from the pending task list */
 
+          sched_prioindex_remove(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
           tcb = (FAR struct tcb_s *)
             dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
 
@@ -97,6 +97,7 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
    */
 
   dq_move(list1, &clone);
+  sched_prioindex_reset(list1);
 
   /* Get the TCB at the head of list1 */
 
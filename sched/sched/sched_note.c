@@ -39,11 +39,14 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
@@ -57,14 +60,36 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_SMP
+#  define NOTE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define NOTE_NCPUS 1
+#endif
+
+/* Each CPU adds notes only to its own buffer and only with its interrupts
+ * disabled, so adding a note takes no lock.  sched_note_get() is the only
+ * other user of a buffer:  The CPU only moves ni_head and the reader only
+ * moves ni_tail.  On SMP, the reader runs concurrently on another CPU and
+ * a barrier must order the note data and the index that covers it.
+ */
+
+#ifdef CONFIG_SMP
+#  define note_barrier() SP_DMB()
+#else
+#  define note_barrier()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
 struct note_info_s
 {
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
+  volatile unsigned int ni_head;  /* Moved by the CPU adding notes */
+  volatile unsigned int ni_tail;  /* Moved by the reader */
+#ifdef CONFIG_SCHED_NOTE_GET
+  unsigned int ni_overrun;        /* Notes dropped because of a full buffer */
+#endif
   uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
 };
 
@@ -82,6 +107,17 @@ struct note_startalloc_s
 #  define SIZEOF_NOTE_START(n) (sizeof(struct note_start_s))
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+struct note_eventalloc_s
+{
+  struct note_common_s nea_cmn; /* Common note parameters */
+  uint8_t nea_value[4];         /* Counter value, little endian */
+  char nea_name[NOTE_EVENT_NAMELEN + 1];
+};
+
+#  define SIZEOF_NOTE_EVENT(n) (sizeof(struct note_event_s) + (n) - 1)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -92,11 +128,7 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
-
-#ifdef CONFIG_SMP
-static volatile spinlock_t g_note_lock;
-#endif
+static struct note_info_s g_note_info[NOTE_NCPUS];
 
 /****************************************************************************
  * Private Functions
@@ -149,7 +181,11 @@ static void note_common(FAR struct tcb_s *tcb,
                         FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_HIRES
+  uint32_t systime    = up_critmon_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -158,6 +194,8 @@ static void note_common(FAR struct tcb_s *tcb,
   note->nc_priority   = tcb->sched_priority;
 #ifdef CONFIG_SMP
   note->nc_cpu        = tcb->cpu;
+#else
+  note->nc_cpu        = 0;
 #endif
   note->nc_pid[0]     = (uint8_t)(tcb->pid & 0xff);
   note->nc_pid[1]     = (uint8_t)((tcb->pid >> 8) & 0xff);
@@ -211,19 +249,16 @@ void note_spincommon(FAR struct tcb_s *tcb,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   head - The head index of the circular buffer
+ *   tail - The tail index of the circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+static inline unsigned int note_length(unsigned int head, unsigned int tail)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
-
   if (tail > head)
     {
       head += CONFIG_SCHED_NOTE_BUFSIZE;
@@ -231,6 +266,30 @@ static unsigned int note_length(void)
 
   return head - tail;
 }
+
+/****************************************************************************
+ * Name: note_copy
+ *
+ * Description:
+ *   Copy 'length' bytes out of the circular buffer, starting at index 'ndx'
+ *   and handling wraparound.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static void note_copy(FAR struct note_info_s *info, FAR uint8_t *buffer,
+                      unsigned int ndx, unsigned int length)
+{
+  unsigned int chunk = CONFIG_SCHED_NOTE_BUFSIZE - ndx;
+
+  if (chunk > length)
+    {
+      chunk = length;
+    }
+
+  memcpy(buffer, &info->ni_buffer[ndx], chunk);
+  memcpy(buffer + chunk, info->ni_buffer, length - chunk);
+}
 #endif
 
 /****************************************************************************
@@ -240,113 +299,195 @@ static unsigned int note_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are the only reader of the circular buffer.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+static void note_remove(FAR struct note_info_s *info)
 {
-  FAR struct note_common_s *note;
   unsigned int tail;
   unsigned int length;
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
-  /* Get the length of the note at the tail index */
+  /* Get the length of the note at the tail index.  nc_length is the first
+   * byte of the note.
+   */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  length = info->ni_buffer[tail];
+  DEBUGASSERT(length <= note_length(info->ni_head, tail));
 
   /* Increment the tail index to remove the entire note from the circular
    * buffer.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  info->ni_tail = note_next(tail, length);
 }
 
 /****************************************************************************
- * Name: note_add
+ * Name: note_select
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Select the buffer holding the oldest note.  The per-CPU buffers are
+ *   each in time order, so this is the buffer with the oldest note at its
+ *   tail.
  *
  * Input Parameters:
  *   None
  *
  * Returned Value:
- *   None
+ *   The selected buffer or NULL if all buffers are empty.
  *
- * Assumptions:
- *   We are within a critical section.
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static FAR struct note_info_s *note_select(void)
+{
+  FAR struct note_info_s *oldest = NULL;
+  FAR struct note_info_s *info;
+#if NOTE_NCPUS > 1
+  uint8_t systime[4];
+  uint32_t best = 0;
+  uint32_t time;
+  int cpu;
+
+  for (cpu = 0; cpu < NOTE_NCPUS; cpu++)
+    {
+      info = &g_note_info[cpu];
+      if (info->ni_head == info->ni_tail)
+        {
+          continue;
+        }
+
+      /* Do not read the note before the head index that covers it */
+
+      note_barrier();
+
+      note_copy(info, systime,
+                note_next(info->ni_tail,
+                          offsetof(struct note_common_s, nc_systime)),
+                sizeof(systime));
+
+      time = (uint32_t)systime[3] << 24 | (uint32_t)systime[2] << 16 |
+             (uint32_t)systime[1] << 8  | (uint32_t)systime[0];
+
+      /* Compare the times in a way that survives wraparound */
+
+      if (oldest == NULL || (int32_t)(time - best) < 0)
+        {
+          oldest = info;
+          best   = time;
+        }
+    }
+#else
+  info = &g_note_info[0];
+  if (info->ni_head != info->ni_tail)
+    {
+      oldest = info;
+    }
+#endif
+
+  note_barrier();
+  return oldest;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_add
+ *
+ * Description:
+ *   Add the variable length note to the head of the circular buffer of the
+ *   current CPU.  If the buffer is full, the oldest notes are overwritten.
+ *   With CONFIG_SCHED_NOTE_GET, they belong to the reader instead and the
+ *   new note is dropped.
+ *
+ * Input Parameters:
+ *   note    - The note to add
+ *   notelen - The length of the note
+ *
+ * Returned Value:
+ *   None
  *
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
+  FAR struct note_info_s *info;
+  irqstate_t flags;
   unsigned int head;
-  unsigned int next;
+  unsigned int chunk;
+  int cpu;
+
+  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
 
-  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << this_cpu())) == 0)
+  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << cpu)) == 0)
     {
       /* Not in the set of monitored CPUs.  Do not log the note. */
 
+      up_irq_restore(flags);
       return;
     }
 #endif
 
-#ifdef CONFIG_SMP
-  irqstate_t flags = up_irq_save();
-  spin_lock_wo_note(&g_note_lock);
-#endif
+  /* Get the index to the head of the circular buffer.  One byte is never
+   * used so that a full buffer can be told from an empty one.
+   */
 
-  /* Get the index to the head of the circular buffer */
+  info = &g_note_info[cpu];
+  head = info->ni_head;
 
-  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
+#ifdef CONFIG_SCHED_NOTE_GET
+  if (CONFIG_SCHED_NOTE_BUFSIZE - 1 -
+      note_length(head, info->ni_tail) < notelen)
+    {
+      info->ni_overrun++;
+      up_irq_restore(flags);
+      return;
+    }
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  /* Do not overwrite the space before the reader is done with it */
 
-  while (notelen > 0)
+  note_barrier();
+#else
+  while (CONFIG_SCHED_NOTE_BUFSIZE - 1 -
+         note_length(head, info->ni_tail) < notelen)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
-        {
-          /* Yes, then remove the note at the tail index */
+      note_remove(info);
+    }
+#endif
 
-          note_remove();
-        }
+  /* Copy the note in at most two pieces, split where the buffer wraps */
 
-      /* Save the next byte at the head index */
+  chunk = CONFIG_SCHED_NOTE_BUFSIZE - head;
+  if (chunk > notelen)
+    {
+      chunk = notelen;
+    }
 
-      g_note_info.ni_buffer[head] = *note++;
+  memcpy(&info->ni_buffer[head], note, chunk);
+  memcpy(info->ni_buffer, note + chunk, notelen - chunk);
 
-      head = next;
-      notelen--;
-    }
+  /* Hand the note to the reader only after it was copied */
 
-  g_note_info.ni_head = head;
+  note_barrier();
+  info->ni_head = note_next(head, notelen);
 
-#ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_note_lock);
   up_irq_restore(flags);
-#endif
 }
 
 /****************************************************************************
@@ -594,12 +735,53 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 }
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_event(uint8_t type, FAR const char *name, int32_t value)
+{
+  struct note_eventalloc_s note;
+  unsigned int length;
+  size_t namelen;
+
+  if (type < NOTE_USER_BEGIN || type > NOTE_USER_MARK)
+    {
+      return;
+    }
+
+  /* Copy the event name and get the length of the note */
+
+  namelen = 0;
+  if (name != NULL)
+    {
+      namelen = strnlen(name, NOTE_EVENT_NAMELEN);
+      memcpy(note.nea_name, name, namelen);
+    }
+
+  note.nea_name[namelen] = '\0';
+
+  length = SIZEOF_NOTE_EVENT(namelen + 1);
+
+  /* Finish formatting the note */
+
+  note_common(this_task(), &note.nea_cmn, length, type);
+  note.nea_value[0] = (uint8_t)((uint32_t)value         & 0xff);
+  note.nea_value[1] = (uint8_t)(((uint32_t)value >> 8)  & 0xff);
+  note.nea_value[2] = (uint8_t)(((uint32_t)value >> 16) & 0xff);
+  note.nea_value[3] = (uint8_t)(((uint32_t)value >> 24) & 0xff);
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, length);
+}
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
  * Description:
  *   Remove the next note from the tail of the circular buffer.  The note
  *   is also removed from the circular buffer to make room for further notes.
+ *   No lock is taken, so this may be called while critical sections and
+ *   spinlocks are being monitored.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -610,40 +792,35 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
  *   provided.  Zero is returned only if the circular buffer is empty.  A
  *   negated errno value is returned in the event of any failure.
  *
+ * Assumptions:
+ *   There is only one reader at a time.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int remaining;
+  FAR struct note_info_s *info;
   unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
+  unsigned int notelen;
 
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
 
-  /* Verify that the circular buffer is not empty */
+  /* Find the buffer with the oldest note.  Return zero if all of the
+   * buffers are empty.
+   */
 
-  circlen = note_length();
-  if (circlen <= 0)
+  info = note_select();
+  if (info == NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      return 0;
     }
 
-  /* Get the index to the tail of the circular buffer */
-
-  tail    = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  tail    = info->ni_tail;
+  notelen = info->ni_buffer[tail];
+  DEBUGASSERT(notelen <= note_length(info->ni_head, tail));
 
   /* Is the user buffer large enough to hold the note? */
 
@@ -651,33 +828,19 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Remove the large note so that we do not get constipated. */
 
-      note_remove();
+      note_remove(info);
 
       /* and return an error */
 
-      notelen = -EFBIG;
-      goto errout_with_csection;
+      return -EFBIG;
     }
 
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the tail index */
+  note_copy(info, buffer, tail, notelen);
 
-      *buffer++ = g_note_info.ni_buffer[tail];
+  /* Release the space only after the note was copied */
 
-      /* Adjust indices and counts */
-
-      tail = note_next(tail, 1);
-      remaining--;
-    }
-
-  g_note_info.ni_tail = tail;
-
-errout_with_csection:
-  leave_critical_section(flags);
+  note_barrier();
+  info->ni_tail = note_next(tail, notelen);
   return notelen;
 }
 #endif
@@ -700,37 +863,15 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
+  FAR struct note_info_s *info;
 
-  flags = enter_critical_section();
-
-  /* Verify that the circular buffer is not empty */
-
-  circlen = note_length();
-  if (circlen <= 0)
+  info = note_select();
+  if (info == NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      return 0;
     }
 
-  /* Get the index to the tail of the circular buffer */
-
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
-  /* Get the length of the note at the tail index */
-
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+  return info->ni_buffer[info->ni_tail];
 }
 #endif
 
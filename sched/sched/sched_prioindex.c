@@ -0,0 +1,301 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIOINDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRIOINDEX_NPRIOS  (SCHED_PRIORITY_MAX + 1)
+#define PRIOINDEX_NWORDS  ((PRIOINDEX_NPRIOS + 31) >> 5)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The index of one prioritized task list.  last[] holds the TCB most
+ * recently queued at each priority; a bit is set in bitmap[] for each
+ * non-NULL entry of last[].
+ *
+ * The index is only a hint:  Not every priority present in the list needs
+ * an entry, but every entry must refer to a TCB that is still in the list
+ * and whose priority is not lower than the priority of the entry.
+ */
+
+struct prioindex_s
+{
+  uint32_t bitmap[PRIOINDEX_NWORDS];
+  FAR struct tcb_s *last[PRIOINDEX_NPRIOS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct prioindex_s g_readytorun_index;
+static struct prioindex_s g_pendingtasks_index;
+
+#ifdef CONFIG_SMP
+static struct prioindex_s g_assignedtasks_index[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex_get
+ *
+ * Description:
+ *   Return the index associated with a task list.
+ *
+ * Input Parameters:
+ *   list - The task list
+ *
+ * Returned Value:
+ *   The index of the list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+static FAR struct prioindex_s *sched_prioindex_get(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorun_index;
+    }
+
+  if (list == (FAR dq_queue_t *)&g_pendingtasks)
+    {
+      return &g_pendingtasks_index;
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list < (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedtasks_index[list -
+                                    (FAR dq_queue_t *)g_assignedtasks];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_clear
+ *
+ * Description:
+ *   Remove the entry of one priority from an index.
+ *
+ ****************************************************************************/
+
+static inline void sched_prioindex_clear(FAR struct prioindex_s *index,
+                                         uint8_t sched_priority)
+{
+  index->last[sched_priority] = NULL;
+  index->bitmap[sched_priority >> 5] &= ~(1ul << (sched_priority & 31));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex_find
+ *
+ * Description:
+ *   Find a TCB in a prioritized task list after which a TCB of priority
+ *   'sched_priority' may be inserted.  The caller must still walk forward
+ *   over any following TCBs whose priority is not lower than
+ *   'sched_priority'.
+ *
+ * Input Parameters:
+ *   list           - The prioritized task list
+ *   sched_priority - The priority of the TCB to be inserted
+ *
+ * Returned Value:
+ *   A TCB in the list with a priority greater than or equal to
+ *   'sched_priority' or NULL if the search must start at the head of the
+ *   list.
+ *
+ * Assumptions:
+ *   The caller holds the critical section protecting the task lists.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_prioindex_find(FAR dq_queue_t *list,
+                                       uint8_t sched_priority)
+{
+  FAR struct prioindex_s *index;
+  uint32_t bits;
+  int word;
+
+  index = sched_prioindex_get(list);
+  if (index == NULL)
+    {
+      return NULL;
+    }
+
+  /* Find the lowest indexed priority that is not lower than
+   * sched_priority.  That is the entry closest to the insertion point.
+   */
+
+  word = sched_priority >> 5;
+  bits = index->bitmap[word] & (UINT32_MAX << (sched_priority & 31));
+
+  while (bits == 0)
+    {
+      if (++word >= PRIOINDEX_NWORDS)
+        {
+          return NULL;
+        }
+
+      bits = index->bitmap[word];
+    }
+
+  return index->last[(word << 5) + ffs((int)bits) - 1];
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_add
+ *
+ * Description:
+ *   Record that 'tcb' is now the last TCB of its priority in 'list'.
+ *
+ * Input Parameters:
+ *   tcb  - The TCB that was just inserted into the list
+ *   list - The prioritized task list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the critical section protecting the task lists.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = sched_prioindex_get(list);
+  uint8_t sched_priority = tcb->sched_priority;
+
+  if (index != NULL)
+    {
+      index->last[sched_priority] = tcb;
+      index->bitmap[sched_priority >> 5] |= 1ul << (sched_priority & 31);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_remove
+ *
+ * Description:
+ *   Drop any reference to 'tcb' from the index of 'list'.  This must be
+ *   called while the TCB is still in the list and before its priority is
+ *   changed.
+ *
+ * Input Parameters:
+ *   tcb  - The TCB that is about to be removed from the list
+ *   list - The prioritized task list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the critical section protecting the task lists.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = sched_prioindex_get(list);
+  FAR struct tcb_s *prev;
+  uint8_t sched_priority = tcb->sched_priority;
+
+  if (index != NULL && index->last[sched_priority] == tcb)
+    {
+      /* The preceding TCB becomes the last one of the priority if it has
+       * the same priority.
+       */
+
+      prev = (FAR struct tcb_s *)tcb->blink;
+      if (prev != NULL && prev->sched_priority == sched_priority)
+        {
+          index->last[sched_priority] = prev;
+        }
+      else
+        {
+          sched_prioindex_clear(index, sched_priority);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_reset
+ *
+ * Description:
+ *   Forget the whole index of 'list'.  This must be called when all of the
+ *   TCBs in the list have been moved to another list.
+ *
+ * Input Parameters:
+ *   list - The prioritized task list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the critical section protecting the task lists.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_reset(FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = sched_prioindex_get(list);
+  int word;
+  int bit;
+
+  if (index != NULL)
+    {
+      for (word = 0; word < PRIOINDEX_NWORDS; word++)
+        {
+          while (index->bitmap[word] != 0)
+            {
+              bit = ffs((int)index->bitmap[word]) - 1;
+              sched_prioindex_clear(index, (word << 5) + bit);
+            }
+        }
+    }
+}
+
+#endif /* CONFIG_SCHED_PRIOINDEX */
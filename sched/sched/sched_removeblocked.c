@@ -80,6 +80,7 @@ void sched_removeblocked(FAR struct tcb_s *btcb)
    * with this state
    */
 
+  sched_prioindex_remove(btcb, TLIST_BLOCKED(task_state));
   dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(task_state));
 
   /* Make sure the TCB's state corresponds to not being in
@@ -102,6 +102,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  sched_prioindex_remove(rtcb, (FAR dq_queue_t *)&g_readytorun);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -199,6 +200,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      sched_prioindex_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -238,6 +240,8 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
+          sched_prioindex_remove((FAR struct tcb_s *)g_readytorun.head,
+                                 (FAR dq_queue_t *)&g_readytorun);
           tmptcb = (FAR struct tcb_s *)
             dq_remfirst((FAR dq_queue_t *)&g_readytorun);
 
@@ -329,6 +333,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      sched_prioindex_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
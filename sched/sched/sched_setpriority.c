@@ -149,8 +149,15 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
-      /* Change the task priority */
+      /* Change the task priority.  The TCB stays where it is in the task
+       * list, so it must first be dropped from the list index.
+       */
 
+#ifdef CONFIG_SMP
+      sched_prioindex_remove(tcb, TLIST_HEAD(tcb->task_state, tcb->cpu));
+#else
+      sched_prioindex_remove(tcb, TLIST_HEAD(tcb->task_state));
+#endif
       tcb->sched_priority = (uint8_t)sched_priority;
     }
 }
@@ -283,6 +290,7 @@ static inline void nxsched_blocked_setpriority(FAR struct tcb_s *tcb,
     {
       /* Remove the TCB from the prioritized task list */
 
+      sched_prioindex_remove(tcb, tasklist);
       dq_rem((FAR dq_entry_t *)tcb, tasklist);
 
       /* Change the task priority */
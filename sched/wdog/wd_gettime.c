@@ -59,6 +59,14 @@ int wd_gettime(WDOG_ID wdog)
   flags = enter_critical_section();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* The wheel holds the absolute expiration time of the wdog */
+
+      int delay = wd_wheel_remaining(wdog) - wd_elapse();
+
+      leave_critical_section(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -78,6 +86,7 @@ int wd_gettime(WDOG_ID wdog)
               return delay;
             }
         }
+#endif
     }
 
   leave_critical_section(flags);
@@ -55,6 +55,7 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -127,6 +128,7 @@ static inline void wd_expiration(void)
         }
     }
 }
+#endif /* !CONFIG_WDOG_TIMERWHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -171,10 +173,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -239,6 +243,13 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  /* Hash the watchdog into the timing wheel.  This also records the
+   * expiration time in the watchdog structure.
+   */
+
+  wd_wheel_add(wdog, delay);
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -329,9 +340,13 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
         }
     }
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the lag into the watchdog structure */
 
   wdog->lag = delay;
+#endif
+
+  /* Mark the watchdog as active */
+
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -372,6 +387,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
  *
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
 {
@@ -480,3 +496,4 @@ void wd_timer(void)
 #endif
 }
 #endif /* CONFIG_SCHED_TICKLESS */
+#endif /* !CONFIG_WDOG_TIMERWHEEL */
@@ -0,0 +1,617 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel has WDOG_WHEEL_LEVELS levels of WDOG_WHEEL_SLOTS slots each.
+ * A slot on level n covers 2^(n * WDOG_WHEEL_BITS) ticks, so the whole
+ * wheel covers WDOG_WHEEL_SPAN ticks.  Watchdogs with a longer delay are
+ * parked in the last slot of the top level and re-hashed when that slot
+ * is cascaded.
+ *
+ * While a watchdog is in the wheel, its 'lag' field holds the absolute
+ * expiration time in wheel ticks.
+ */
+
+#define WDOG_WHEEL_BITS      5
+#define WDOG_WHEEL_SLOTS     (1 << WDOG_WHEEL_BITS)
+#define WDOG_WHEEL_MASK      (WDOG_WHEEL_SLOTS - 1)
+#define WDOG_WHEEL_LEVELS    5
+#define WDOG_WHEEL_SPAN      ((uint32_t)1 << \
+                              (WDOG_WHEEL_LEVELS * WDOG_WHEEL_BITS))
+
+/* Slot indices.  One additional list holds watchdogs that expired but
+ * whose function has not been called yet.
+ */
+
+#define WDOG_WHEEL_SLOT(l,n) ((l) * WDOG_WHEEL_SLOTS + (n))
+#define WDOG_WHEEL_EXPIRED   (WDOG_WHEEL_LEVELS * WDOG_WHEEL_SLOTS)
+#define WDOG_WHEEL_NLISTS    (WDOG_WHEEL_EXPIRED + 1)
+
+/* The wheel index of a time on a level */
+
+#define WDOG_WHEEL_INDEX(t,l) \
+  (((t) >> ((l) * WDOG_WHEEL_BITS)) & WDOG_WHEEL_MASK)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The heads of the doubly linked slot lists */
+
+static FAR struct wdog_s *g_wdslots[WDOG_WHEEL_NLISTS];
+
+/* One bit per non-empty slot on each level */
+
+static uint32_t g_wdbitmap[WDOG_WHEEL_LEVELS];
+
+/* The current wheel time and the number of active watchdogs */
+
+static uint32_t g_wdnow;
+static unsigned int g_wdnactive;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_link
+ *
+ * Description:
+ *   Put a watchdog into the slot list 'slot'.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_link(FAR struct wdog_s *wdog, int slot)
+{
+  wdog->slot = (uint8_t)slot;
+  wdog->prev = NULL;
+  wdog->next = g_wdslots[slot];
+
+  if (wdog->next != NULL)
+    {
+      wdog->next->prev = wdog;
+    }
+
+  g_wdslots[slot] = wdog;
+
+  if (slot != WDOG_WHEEL_EXPIRED)
+    {
+      g_wdbitmap[slot / WDOG_WHEEL_SLOTS] |=
+        (uint32_t)1 << (slot & WDOG_WHEEL_MASK);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_unlink
+ *
+ * Description:
+ *   Remove a watchdog from the slot list that it is in.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_unlink(FAR struct wdog_s *wdog)
+{
+  int slot = wdog->slot;
+
+  if (wdog->prev != NULL)
+    {
+      wdog->prev->next = wdog->next;
+    }
+  else
+    {
+      g_wdslots[slot] = wdog->next;
+    }
+
+  if (wdog->next != NULL)
+    {
+      wdog->next->prev = wdog->prev;
+    }
+
+  if (g_wdslots[slot] == NULL && slot != WDOG_WHEEL_EXPIRED)
+    {
+      g_wdbitmap[slot / WDOG_WHEEL_SLOTS] &=
+        ~((uint32_t)1 << (slot & WDOG_WHEEL_MASK));
+    }
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_hash
+ *
+ * Description:
+ *   Put a watchdog into the wheel slot that corresponds to its expiration
+ *   time relative to the current wheel time.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_hash(FAR struct wdog_s *wdog)
+{
+  uint32_t expire = (uint32_t)wdog->lag;
+  uint32_t delta  = expire - g_wdnow;
+  int level;
+
+  if ((int32_t)delta <= 0)
+    {
+      /* Already due.  Put it into the slot of the current tick. */
+
+      expire = g_wdnow;
+      delta  = 0;
+    }
+  else if (delta >= WDOG_WHEEL_SPAN)
+    {
+      /* Beyond the reach of the wheel.  Park it in the farthest slot. */
+
+      expire = g_wdnow + WDOG_WHEEL_SPAN - 1;
+      delta  = WDOG_WHEEL_SPAN - 1;
+    }
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS - 1; level++)
+    {
+      if ((delta >> ((level + 1) * WDOG_WHEEL_BITS)) == 0)
+        {
+          break;
+        }
+    }
+
+  wd_wheel_link(wdog,
+                WDOG_WHEEL_SLOT(level, WDOG_WHEEL_INDEX(expire, level)));
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-hash all watchdogs of the current slot on 'level' into the lower
+ *   levels.  Returns true if the next higher level must be cascaded too.
+ *
+ ****************************************************************************/
+
+static bool wd_wheel_cascade(int level)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+  int index = WDOG_WHEEL_INDEX(g_wdnow, level);
+  int slot  = WDOG_WHEEL_SLOT(level, index);
+
+  /* Detach the whole slot list first, then re-hash its watchdogs */
+
+  next            = g_wdslots[slot];
+  g_wdslots[slot] = NULL;
+  g_wdbitmap[level] &= ~((uint32_t)1 << index);
+
+  while ((wdog = next) != NULL)
+    {
+      next = wdog->next;
+      wd_wheel_hash(wdog);
+    }
+
+  return index == 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ *
+ * Description:
+ *   Advance the wheel by one tick, cascading the higher levels when their
+ *   boundary is crossed, and move the watchdogs that expire now to the
+ *   expired list.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_tick(void)
+{
+  FAR struct wdog_s *wdog;
+  int level;
+  int slot;
+
+  g_wdnow++;
+
+  /* Cascade the higher levels when level 0 wraps around.  The next level
+   * is only cascaded if this one wrapped around as well.
+   */
+
+  slot = WDOG_WHEEL_SLOT(0, WDOG_WHEEL_INDEX(g_wdnow, 0));
+  if (WDOG_WHEEL_INDEX(g_wdnow, 0) == 0)
+    {
+      for (level = 1; level < WDOG_WHEEL_LEVELS; level++)
+        {
+          if (!wd_wheel_cascade(level))
+            {
+              break;
+            }
+        }
+    }
+
+  /* Every watchdog in the current level 0 slot expires now */
+
+  while ((wdog = g_wdslots[slot]) != NULL)
+    {
+      wd_wheel_unlink(wdog);
+      DEBUGASSERT((int32_t)((uint32_t)wdog->lag - g_wdnow) <= 0);
+      wd_wheel_link(wdog, WDOG_WHEEL_EXPIRED);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expire
+ *
+ * Description:
+ *   Execute the functions of all expired watchdogs.  The list is
+ *   re-examined after each call because the watchdog function may cancel
+ *   other expired watchdogs or start new ones.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_expire(void)
+{
+  FAR struct wdog_s *wdog;
+
+  while ((wdog = g_wdslots[WDOG_WHEEL_EXPIRED]) != NULL)
+    {
+      /* Remove the watchdog from the expired list and indicate that the
+       * watchdog is no longer active.
+       */
+
+      wd_wheel_unlink(wdog);
+      g_wdnactive--;
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+
+#if CONFIG_MAX_WDOGPARMS == 0
+      wdog->func(0);
+#elif CONFIG_MAX_WDOGPARMS == 1
+      wdog->func((int)wdog->argc,
+                 wdog->parm[0]);
+#elif CONFIG_MAX_WDOGPARMS == 2
+      wdog->func((int)wdog->argc,
+                 wdog->parm[0], wdog->parm[1]);
+#elif CONFIG_MAX_WDOGPARMS == 3
+      wdog->func((int)wdog->argc,
+                 wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+#elif CONFIG_MAX_WDOGPARMS == 4
+      wdog->func((int)wdog->argc,
+                 wdog->parm[0], wdog->parm[1], wdog->parm[2],
+                 wdog->parm[3]);
+#else
+#  error Missing support
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks until the next timer event: Either the
+ *   expiration of a level 0 watchdog or the cascade of a non-empty slot on
+ *   a higher level.  Zero is returned if the wheel is empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+static unsigned int wd_wheel_next(void)
+{
+  uint32_t bitmap;
+  uint32_t delta;
+  uint32_t ret = 0;
+  int shift;
+  int level;
+  int index;
+  int dist;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (g_wdbitmap[level] == 0)
+        {
+          continue;
+        }
+
+      /* Rotate the bitmap so that bit 0 is the slot after the current one
+       * and find the nearest non-empty slot.
+       */
+
+      shift  = level * WDOG_WHEEL_BITS;
+      index  = (WDOG_WHEEL_INDEX(g_wdnow, level) + 1) & WDOG_WHEEL_MASK;
+      bitmap = (g_wdbitmap[level] >> index) |
+               (g_wdbitmap[level] << ((WDOG_WHEEL_SLOTS - index) &
+                                      WDOG_WHEEL_MASK));
+      dist   = ffsl((long)bitmap);
+
+      /* Ticks from now until the start of that slot */
+
+      delta  = (((g_wdnow >> shift) + dist) << shift) - g_wdnow;
+      if (ret == 0 || delta < ret)
+        {
+          ret = delta;
+        }
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the watchdog timing wheel.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  int i;
+
+  for (i = 0; i < WDOG_WHEEL_NLISTS; i++)
+    {
+      g_wdslots[i] = NULL;
+    }
+
+  for (i = 0; i < WDOG_WHEEL_LEVELS; i++)
+    {
+      g_wdbitmap[i] = 0;
+    }
+
+  g_wdnow     = 0;
+  g_wdnactive = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Hash a watchdog into the timing wheel so that it expires after 'delay'
+ *   ticks.
+ *
+ * Input Parameters:
+ *   wdog  - The watchdog to add.  It must not be active.
+ *   delay - Delay count in clock ticks, always greater than zero.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  if (g_wdnactive == 0)
+    {
+      /* Update clock tickbase */
+
+      g_wdtickbase = clock_systimer();
+    }
+#endif
+
+  wdog->lag = (int)(g_wdnow + (uint32_t)delay);
+  wd_wheel_hash(wdog);
+  g_wdnactive++;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to remove
+ *
+ * Returned Value:
+ *   True if the time of the next timer event changed because of the
+ *   removal, in which case the interval timer must be reassessed.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+  unsigned int next = wd_wheel_next();
+  bool expired = (wdog->slot == WDOG_WHEEL_EXPIRED);
+
+  wd_wheel_unlink(wdog);
+  g_wdnactive--;
+
+  return !expired && wd_wheel_next() != next;
+#else
+  wd_wheel_unlink(wdog);
+  g_wdnactive--;
+
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks remaining before an active watchdog expires,
+ *   measured from the last time that the wheel was advanced.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog
+ *
+ * Returned Value:
+ *   The number of remaining ticks
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  int32_t delta = (int32_t)((uint32_t)wdog->lag - g_wdnow);
+
+  return delta > 0 ? (int)delta : 0;
+}
+
+/****************************************************************************
+ * Name: wd_timer
+ *
+ * Description:
+ *   This function is called from the timer interrupt handler to determine
+ *   if it is time to execute a watchdog function.  If so, the watchdog
+ *   function will be executed in the context of the timer interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   ticks - If CONFIG_SCHED_TICKLESS is defined then the number of ticks
+ *     in the interval that just expired is provided.  Otherwise,
+ *     this function is called on each timer interrupt and a value of one
+ *     is implicit.
+ *
+ * Returned Value:
+ *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
+ *   next delay is provided (zero if no delay).  Otherwise, this function
+ *   has no returned value.
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_timer(int ticks)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+#endif
+  unsigned int ret;
+  unsigned int step;
+
+#ifdef CONFIG_SMP
+  /* In the SMP case, interrupts MAY be disabled only on the local CPU so
+   * we must follow rules for critical sections even here.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Skip directly to each timer event within the elapsed interval.  The
+   * ticks in between cannot expire a watchdog nor cascade a non-empty slot.
+   */
+
+  while (g_wdnactive > 0 && ticks > 0)
+    {
+      step = wd_wheel_next();
+      if (step == 0 || step > (unsigned int)ticks)
+        {
+          step = ticks;
+        }
+
+      g_wdnow      += step - 1;
+      wd_wheel_tick();
+
+      ticks        -= step;
+      g_wdtickbase += step;
+
+      wd_wheel_expire();
+    }
+
+  /* Update clock tickbase */
+
+  g_wdtickbase += ticks;
+
+  /* Return the delay for the next timer event */
+
+  ret = wd_wheel_next();
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  return ret;
+}
+
+#else
+void wd_timer(void)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* In the SMP case, interrupts MAY be disabled only on the local CPU so
+   * we must follow rules for critical sections even here.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Only one wheel slot needs to be examined per tick */
+
+  if (g_wdnactive > 0)
+    {
+      wd_wheel_tick();
+      wd_wheel_expire();
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+}
+#endif /* CONFIG_SCHED_TICKLESS */
+#endif /* CONFIG_WDOG_TIMERWHEEL */
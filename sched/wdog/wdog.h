@@ -73,12 +73,14 @@ extern "C"
 
 extern sq_queue_t g_wdfreelist;
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -151,6 +153,85 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the watchdog timing wheel.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+void wd_wheel_initialize(void);
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Hash a watchdog into the timing wheel so that it expires after 'delay'
+ *   ticks.
+ *
+ * Input Parameters:
+ *   wdog  - The watchdog to add.  It must not be active.
+ *   delay - Delay count in clock ticks, always greater than zero.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay);
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to remove
+ *
+ * Returned Value:
+ *   True if the time of the next timer event changed because of the
+ *   removal, in which case the interval timer must be reassessed.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks remaining before an active watchdog expires,
+ *   measured from the last time that the wheel was advanced.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog
+ *
+ * Returned Value:
+ *   The number of remaining ticks
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog);
+#endif
+
 /****************************************************************************
  * Name: wd_recover
  *
@@ -70,11 +70,12 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   DEBUGASSERT(work != NULL);
 
   /* Cancelling the work is simply a matter of removing the work structure
-   * from the work queue.  This must be done with interrupts disabled because
-   * new work is typically added to the work queue from interrupt handlers.
+   * from the work queue.  This must be done with the queue locked and
+   * interrupts disabled because new work is typically added to the work
+   * queue from interrupt handlers.
    */
 
-  flags = enter_critical_section();
+  work_lock(wqueue, flags);
   if (work->worker != NULL)
     {
       /* A little test of the integrity of the work queue */
@@ -93,10 +94,53 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  work_unlock(wqueue, flags);
   return ret;
 }
 
+/****************************************************************************
+ * Name: work_hpcancel
+ *
+ * Description:
+ *   Cancel work queued on one of the per-CPU high priority queues.
+ *
+ * Input Parameters:
+ *   work   - The previously queue work structure to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such work queued.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+static int work_hpcancel(FAR struct work_s *work)
+{
+  FAR volatile spinlock_t *lock;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(work != NULL);
+
+  /* The work lock keeps work->cpu stable.  The queue may still complete the
+   * work until we hold the queue lock, which work_qcancel() takes.
+   */
+
+  lock  = work_hplock(work);
+  flags = up_irq_save();
+  spin_lock(lock);
+
+  if (work->worker != NULL)
+    {
+      ret = work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork[work->cpu],
+                         work);
+    }
+
+  spin_unlock(lock);
+  up_irq_restore(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -129,7 +173,11 @@ int work_cancel(int qid, FAR struct work_s *work)
     {
       /* Cancel high priority work */
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      return work_hpcancel(work);
+#else
+      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork[0], work);
+#endif
     }
   else
 #endif
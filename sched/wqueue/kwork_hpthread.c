@@ -31,6 +31,7 @@
 #include <queue.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
@@ -46,7 +47,13 @@
 
 /* The state of the kernel mode, high priority work queue(s). */
 
-struct hp_wqueue_s g_hpwork;
+struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+/* Serializes queueing and cancellation of the same per-CPU work */
+
+spinlock_t g_hpwork_locks[HPWORK_NLOCKS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -76,8 +83,25 @@ struct hp_wqueue_s g_hpwork;
 
 static int work_hpthread(int argc, char *argv[])
 {
+  FAR struct hp_wqueue_s *wqueue = &g_hpwork[0];
   int wndx = 0;
-#if CONFIG_SCHED_HPNTHREADS > 1
+#if defined(CONFIG_SCHED_HPWORK_PERCPU)
+  pid_t me = getpid();
+  int cpu;
+
+  /* Find out our queue by searching the per-CPU workers in g_hpwork */
+
+  for (cpu = 0; cpu < HPWORK_NQUEUES; cpu++)
+    {
+      if (g_hpwork[cpu].worker[0].pid == me)
+        {
+          wqueue = &g_hpwork[cpu];
+          break;
+        }
+    }
+
+  DEBUGASSERT(cpu < HPWORK_NQUEUES);
+#elif CONFIG_SCHED_HPNTHREADS > 1
   pid_t me = getpid();
   int i;
 
@@ -85,7 +109,7 @@ static int work_hpthread(int argc, char *argv[])
 
   for (wndx = 0, i = 0; i < CONFIG_SCHED_HPNTHREADS; i++)
     {
-      if (g_hpwork.worker[i].pid == me)
+      if (wqueue->worker[i].pid == me)
         {
           wndx = i;
           break;
@@ -104,7 +128,7 @@ static int work_hpthread(int argc, char *argv[])
        * triggered, or delayed work expires.
        */
 
-      work_process((FAR struct kwork_wqueue_s *)&g_hpwork, wndx);
+      work_process((FAR struct kwork_wqueue_s *)wqueue, wndx);
     }
 
   return OK; /* To keep some compilers happy */
@@ -131,8 +155,14 @@ static int work_hpthread(int argc, char *argv[])
 
 int work_hpstart(void)
 {
+  FAR struct hp_wqueue_s *wqueue;
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  cpu_set_t cpuset;
+  int ret;
+#endif
   pid_t pid;
   int wndx;
+  int cpu;
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_hpwork.
@@ -140,31 +170,62 @@ int work_hpstart(void)
 
   sched_lock();
 
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  for (wndx = 0; wndx < HPWORK_NLOCKS; wndx++)
+    {
+      spin_initialize(&g_hpwork_locks[wndx], SP_UNLOCKED);
+    }
+#endif
+
   /* Start the high-priority, kernel mode worker thread(s) */
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
 
-  for (wndx = 0; wndx < CONFIG_SCHED_HPNTHREADS; wndx++)
+  for (cpu = 0; cpu < HPWORK_NQUEUES; cpu++)
     {
-      pid = kthread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
-                           CONFIG_SCHED_HPWORKSTACKSIZE,
-                           (main_t)work_hpthread,
-                           (FAR char * const *)NULL);
+      wqueue = &g_hpwork[cpu];
+
+#ifdef CONFIG_SMP
+      spin_initialize(&wqueue->lock, SP_UNLOCKED);
+#endif
 
-      DEBUGASSERT(pid > 0);
-      if (pid < 0)
+      for (wndx = 0; wndx < HPWORK_NTHREADS; wndx++)
         {
-          serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
-          sched_unlock();
-          return (int)pid;
+          pid = kthread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
+                               CONFIG_SCHED_HPWORKSTACKSIZE,
+                               (main_t)work_hpthread,
+                               (FAR char * const *)NULL);
+
+          DEBUGASSERT(pid > 0);
+          if (pid < 0)
+            {
+              serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
+              sched_unlock();
+              return (int)pid;
+            }
+
+          wqueue->worker[wndx].pid  = pid;
+          wqueue->worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+          /* Pin the worker thread to the CPU of its queue */
+
+          CPU_ZERO(&cpuset);
+          CPU_SET(cpu, &cpuset);
+
+          ret = nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+          if (ret < 0)
+            {
+              serr("ERROR: nxsched_setaffinity %d failed: %d\n", cpu, ret);
+              sched_unlock();
+              return ret;
+            }
+#endif
         }
-
-      g_hpwork.worker[wndx].pid  = pid;
-      g_hpwork.worker[wndx].busy = true;
     }
 
   sched_unlock();
-  return g_hpwork.worker[0].pid;
+  return g_hpwork[0].worker[0].pid;
 }
 
 #endif /* CONFIG_SCHED_HPWORK */
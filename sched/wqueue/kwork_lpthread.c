@@ -144,6 +144,10 @@ int work_lpstart(void)
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
 
+#ifdef CONFIG_SMP
+  spin_initialize(&g_lpwork.lock, SP_UNLOCKED);
+#endif
+
   for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++)
     {
       pid = kthread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <unistd.h>
 #include <signal.h>
 #include <assert.h>
@@ -63,6 +64,151 @@
 #  define MIN(a,b) ((a) < (b) ? (a) : (b))
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_run
+ *
+ * Description:
+ *   Perform one work item that has already been removed from its queue and
+ *   update the statistics of the worker.
+ *
+ * Input Parameters:
+ *   kworker - The worker thread performing the work
+ *   worker  - The work callback
+ *   arg     - The argument of the work callback
+ *   late    - Ticks elapsed since the work became due
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the worker thread with the work queue unlocked.
+ *
+ ****************************************************************************/
+
+static void work_run(FAR struct kworker_s *kworker, worker_t worker,
+                     FAR void *arg, clock_t late)
+{
+#ifdef CONFIG_WQUEUE_STATISTICS
+  FAR struct work_stats_s *stats = &kworker->stats;
+  clock_t start;
+  clock_t run;
+
+  start = clock_systimer();
+  worker(arg);
+  run   = clock_systimer() - start;
+
+  stats->count++;
+  stats->waittime += late;
+  stats->runtime  += run;
+
+  if (late > stats->waitmax)
+    {
+      stats->waitmax = late;
+    }
+
+  if (run > stats->runmax)
+    {
+      stats->runmax = run;
+    }
+#else
+  worker(arg);
+#endif
+}
+
+/****************************************************************************
+ * Name: work_hpsteal
+ *
+ * Description:
+ *   Look for ready work on the per-CPU high priority queues of the other
+ *   CPUs and perform the first one found.  This is how an idle per-CPU
+ *   worker helps the busy ones.  Work that is not yet due stays with the
+ *   worker of its own CPU which is the only one watching its delay.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue of the calling worker
+ *   wndx   - The worker thread index
+ *
+ * Returned Value:
+ *   True if work was taken from another queue and performed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+static bool work_hpsteal(FAR struct kwork_wqueue_s *wqueue, int wndx)
+{
+  FAR struct kwork_wqueue_s *victim;
+  FAR struct work_s *work;
+  worker_t worker;
+  irqstate_t flags;
+  FAR void *arg;
+  clock_t elapsed;
+  clock_t ctick;
+  int self;
+  int i;
+
+  /* Only the per-CPU high priority queues steal from each other */
+
+  self = (FAR struct hp_wqueue_s *)wqueue - g_hpwork;
+  if (self < 0 || self >= HPWORK_NQUEUES)
+    {
+      return false;
+    }
+
+  for (i = 1; i < HPWORK_NQUEUES; i++)
+    {
+      victim = (FAR struct kwork_wqueue_s *)
+        &g_hpwork[(self + i) % HPWORK_NQUEUES];
+
+      /* Peek without the lock first; an empty queue is the common case */
+
+      if (victim->q.head == NULL)
+        {
+          continue;
+        }
+
+      work_lock(victim, flags);
+
+      ctick   = clock_systimer();
+      elapsed = 0;
+
+      for (work = (FAR struct work_s *)victim->q.head;
+           work != NULL;
+           work = (FAR struct work_s *)work->dq.flink)
+        {
+          elapsed = ctick - work->qtime;
+          if (work->worker != NULL && elapsed >= work->delay)
+            {
+              break;
+            }
+        }
+
+      if (work != NULL)
+        {
+          dq_rem((FAR dq_entry_t *)work, &victim->q);
+
+          worker       = work->worker;
+          arg          = work->arg;
+          elapsed     -= work->delay;
+          work->worker = NULL;
+
+          work_unlock(victim, flags);
+
+          wqueue->worker[wndx].busy = true;
+          work_run(&wqueue->worker[wndx], worker, arg, elapsed);
+          return true;
+        }
+
+      work_unlock(victim, flags);
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -95,21 +241,23 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
   clock_t stick;
   clock_t ctick;
   clock_t next;
+  uint32_t seq;
 
-  /* Then process queued work.  We need to keep interrupts disabled while
-   * we process items in the work list.
+  /* Then process queued work.  We need to keep the queue locked while we
+   * process items in the work list.
    */
 
-  next  = WORK_DELAY_MAX;
-  flags = enter_critical_section();
+  next = WORK_DELAY_MAX;
+  work_lock(wqueue, flags);
 
   /* Get the time that we started processing the queue in clock ticks. */
 
   stick = clock_systimer();
 
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
+  /* And check each entry in the work queue.  Since we hold the queue lock
+   * with local interrupts disabled we know:  (1) we will not be suspended
+   * unless we do so ourselves, and (2) there will be no changes to the
+   * work queue
    */
 
   work = (FAR struct work_s *)wqueue->q.head;
@@ -141,33 +289,34 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
 
           if (worker != NULL)
             {
-              /* Extract the work argument (before re-enabling interrupts) */
+              /* Extract the work argument (before unlocking the queue) */
 
-              arg = work->arg;
+              arg      = work->arg;
+              elapsed -= work->delay;
 
               /* Mark the work as no longer being queued */
 
               work->worker = NULL;
 
-              /* Do the work.  Re-enable interrupts while the work is being
+              /* Do the work.  Unlock the queue while the work is being
                * performed... we don't have any idea how long this will take!
                */
 
-              leave_critical_section(flags);
-              worker(arg);
+              work_unlock(wqueue, flags);
+              work_run(&wqueue->worker[wndx], worker, arg, elapsed);
 
-              /* Now, unfortunately, since we re-enabled interrupts we don't
+              /* Now, unfortunately, since we unlocked the queue we don't
                * know the state of the work list and we will have to start
                * back at the head of the list.
                */
 
-              flags = enter_critical_section();
-              work  = (FAR struct work_s *)wqueue->q.head;
+              work_lock(wqueue, flags);
+              work = (FAR struct work_s *)wqueue->q.head;
             }
           else
             {
               /* Cancelled.. Just move to the next work in the list with
-               * interrupts still disabled.
+               * the queue still locked.
                */
 
               work = (FAR struct work_s *)work->dq.flink;
@@ -206,40 +355,67 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
         }
     }
 
-  /* When multiple worker threads are created for this work queue, only
-   * thread 0 (wndx = 0) will monitor the unexpired works.
-   *
-   * Other worker threads (wndx > 0) just process no-delay or expired
-   * works, then sleep. The unexpired works are left in the queue. They
-   * will be handled by thread 0 when it finishes current work and iterate
-   * over the queue again.
+  /* Nothing is ready.  Mark the worker as available while the queue is
+   * still locked, so that anyone queueing work from now on will signal it.
+   * Work queued after the queue is unlocked but before we wait for the
+   * signal is detected by the change of the sequence number.
    */
 
-  if (wndx > 0 || next == WORK_DELAY_MAX)
+  seq = wqueue->seq;
+  wqueue->worker[wndx].busy = false;
+  work_unlock(wqueue, flags);
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  /* Before going to sleep, help the other CPUs with their ready work */
+
+  if (work_hpsteal(wqueue, wndx))
     {
-      sigset_t set;
+      return;
+    }
+#endif
+
+  /* The signal cannot be delivered before we are waiting for it because
+   * nxsig_kill() must also enter the critical section.
+   */
 
-      /* Wait indefinitely until signalled with SIGWORK */
+  flags = enter_critical_section();
 
-      sigemptyset(&set);
-      sigaddset(&set, SIGWORK);
+  /* Don't sleep if new work was queued in the meantime */
 
-      wqueue->worker[wndx].busy = false;
-      DEBUGVERIFY(nxsig_waitinfo(&set, NULL));
-      wqueue->worker[wndx].busy = true;
-    }
-  else
+  if (wqueue->seq == seq)
     {
-      /* Wait a while to check the work list.  We will wait here until
-       * either the time elapses or until we are awakened by a signal.
-       * Interrupts will be re-enabled while we wait.
+      /* When multiple worker threads are created for this work queue, only
+       * thread 0 (wndx = 0) will monitor the unexpired works.
+       *
+       * Other worker threads (wndx > 0) just process no-delay or expired
+       * works, then sleep. The unexpired works are left in the queue. They
+       * will be handled by thread 0 when it finishes current work and
+       * iterate over the queue again.
        */
 
-      wqueue->worker[wndx].busy = false;
-      nxsig_usleep(next * USEC_PER_TICK);
-      wqueue->worker[wndx].busy = true;
+      if (wndx > 0 || next == WORK_DELAY_MAX)
+        {
+          sigset_t set;
+
+          /* Wait indefinitely until signalled with SIGWORK */
+
+          sigemptyset(&set);
+          sigaddset(&set, SIGWORK);
+
+          DEBUGVERIFY(nxsig_waitinfo(&set, NULL));
+        }
+      else
+        {
+          /* Wait a while to check the work list.  We will wait here until
+           * either the time elapses or until we are awakened by a signal.
+           * Interrupts will be re-enabled while we wait.
+           */
+
+          nxsig_usleep(next * USEC_PER_TICK);
+        }
     }
 
+  wqueue->worker[wndx].busy = true;
   leave_critical_section(flags);
 }
 
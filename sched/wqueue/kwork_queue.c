@@ -79,11 +79,11 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   DEBUGASSERT(work != NULL && worker != NULL);
 
-  /* Interrupts are disabled so that this logic can be called from with
-   * task logic or ifrom nterrupt handling logic.
+  /* The queue is locked with interrupts disabled so that this logic can be
+   * called from within task logic or from interrupt handling logic.
    */
 
-  flags = enter_critical_section();
+  work_lock(wqueue, flags);
 
   /* Is there already pending work? */
 
@@ -107,10 +107,86 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   work->qtime  = clock_systimer(); /* Time work queued */
 
   dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  wqueue->seq++;
 
-  leave_critical_section(flags);
+  work_unlock(wqueue, flags);
 }
 
+/****************************************************************************
+ * Name: work_hpqueue
+ *
+ * Description:
+ *   Queue work on the per-CPU high priority queue of the calling CPU.  If
+ *   the work is still pending, it is first removed from the queue that
+ *   holds it, which may be the queue of another CPU.
+ *
+ * Input Parameters:
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+static void work_hpqueue(FAR struct work_s *work, worker_t worker,
+                         FAR void *arg, clock_t delay)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR volatile spinlock_t *lock;
+  irqstate_t flags;
+  int cpu;
+
+  DEBUGASSERT(work != NULL && worker != NULL);
+
+  lock  = work_hplock(work);
+  flags = up_irq_save();
+  spin_lock(lock);
+
+  /* Is there already pending work?  work->cpu cannot change while we hold
+   * the work lock, but the worker may dequeue the work until we hold the
+   * queue lock too.
+   */
+
+  if (work->worker != NULL)
+    {
+      wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork[work->cpu];
+
+      spin_lock(&wqueue->lock);
+      if (work->worker != NULL)
+        {
+          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+        }
+
+      spin_unlock(&wqueue->lock);
+    }
+
+  /* Now put the work in the queue of this CPU */
+
+  cpu    = up_cpu_index();
+  wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork[cpu];
+
+  spin_lock(&wqueue->lock);
+
+  work->worker = worker;
+  work->arg    = arg;
+  work->delay  = delay;
+  work->cpu    = cpu;
+  work->qtime  = clock_systimer();
+
+  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  wqueue->seq++;
+
+  spin_unlock(&wqueue->lock);
+  spin_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -155,8 +231,12 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue high priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker,
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      work_hpqueue(work, worker, arg, delay);
+#else
+      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork[0], work, worker,
                   arg, delay);
+#endif
       return work_signal(HPWORK);
     }
   else
@@ -27,6 +27,7 @@
 #include <signal.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/signal.h>
 
@@ -62,10 +63,33 @@ int work_signal(int qid)
 
   /* Get the process ID of the worker thread */
 
-#ifdef CONFIG_SCHED_HPWORK
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
   if (qid == HPWORK)
     {
-      work = (FAR struct kwork_wqueue_s *)&g_hpwork;
+      int cpu = up_cpu_index();
+
+      /* Prefer the worker of this CPU.  If it is busy, wake up an idle
+       * worker of another CPU so that it can take the ready work.
+       */
+
+      for (i = 0; i < HPWORK_NQUEUES; i++)
+        {
+          work = (FAR struct kwork_wqueue_s *)
+            &g_hpwork[(cpu + i) % HPWORK_NQUEUES];
+
+          if (!work->worker[0].busy)
+            {
+              return nxsig_kill(work->worker[0].pid, SIGWORK);
+            }
+        }
+
+      return OK;
+    }
+  else
+#elif defined(CONFIG_SCHED_HPWORK)
+  if (qid == HPWORK)
+    {
+      work = (FAR struct kwork_wqueue_s *)&g_hpwork[0];
       threads = CONFIG_SCHED_HPNTHREADS;
     }
   else
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * sched/wqueue/kwork_stats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_WQUEUE_STATISTICS)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_stats
+ *
+ * Description:
+ *   Return the statistics of one kernel work queue, summed over all of its
+ *   worker threads.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID (must be HPWORK or LPWORK)
+ *   ndx   - The CPU index of the per-CPU high priority queue.  Must be zero
+ *           for all other queues.
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.  This error may be
+ *   reported:
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *   -ENOENT - There is no queue with the index ndx
+ *
+ ****************************************************************************/
+
+int work_stats(int qid, int ndx, FAR struct work_stats_s *stats)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR struct work_stats_s *wstats;
+  int threads;
+  int i;
+
+  DEBUGASSERT(stats != NULL);
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      if (ndx < 0 || ndx >= HPWORK_NQUEUES)
+        {
+          return -ENOENT;
+        }
+
+      threads = HPWORK_NTHREADS;
+      wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork[ndx];
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      if (ndx != 0)
+        {
+          return -ENOENT;
+        }
+
+      threads = CONFIG_SCHED_LPNTHREADS;
+      wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+  else
+#endif
+    {
+      return -EINVAL;
+    }
+
+  /* The counters are sampled without locking; they are only statistics */
+
+  memset(stats, 0, sizeof(struct work_stats_s));
+
+  for (i = 0; i < threads; i++)
+    {
+      wstats           = &wqueue->worker[i].stats;
+      stats->count    += wstats->count;
+      stats->waittime += wstats->waittime;
+      stats->runtime  += wstats->runtime;
+
+      if (wstats->waitmax > stats->waitmax)
+        {
+          stats->waitmax = wstats->waitmax;
+        }
+
+      if (wstats->runmax > stats->runmax)
+        {
+          stats->runmax = wstats->runmax;
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && CONFIG_WQUEUE_STATISTICS */
@@ -31,6 +31,9 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +46,56 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* With CONFIG_SCHED_HPWORK_PERCPU, there is one high priority queue with a
+ * single worker thread for each CPU.
+ */
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+#  define HPWORK_NQUEUES   CONFIG_SMP_NCPUS
+#  define HPWORK_NTHREADS  1
+#else
+#  define HPWORK_NQUEUES   1
+#  define HPWORK_NTHREADS  CONFIG_SCHED_HPNTHREADS
+#endif
+
+/* The list of a work queue is only accessed with local interrupts disabled.
+ * In the SMP case, the spinlock of the queue also keeps out the other CPUs.
+ * This replaces the global critical section so that queues served on
+ * different CPUs do not contend with each other.
+ */
+
+#ifdef CONFIG_SMP
+#  define work_lock(q,f) \
+     do \
+       { \
+         (f) = up_irq_save(); \
+         spin_lock(&(q)->lock); \
+       } \
+     while (0)
+#  define work_unlock(q,f) \
+     do \
+       { \
+         spin_unlock(&(q)->lock); \
+         up_irq_restore(f); \
+       } \
+     while (0)
+#else
+#  define work_lock(q,f)   do { (f) = up_irq_save(); } while (0)
+#  define work_unlock(q,f) up_irq_restore(f)
+#endif
+
+/* Per-CPU queued work is additionally serialized by one of a small set of
+ * spinlocks selected by the address of the work structure.  This keeps two
+ * CPUs from queueing or cancelling the same work at the same time.
+ */
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+#  define HPWORK_NLOCKS     8
+#  define work_hplock(w) \
+     (&g_hpwork_locks[((uintptr_t)(w) / sizeof(struct work_s)) % \
+                      HPWORK_NLOCKS])
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -53,6 +106,9 @@ struct kworker_s
 {
   pid_t             pid;    /* The task ID of the worker thread */
   volatile bool     busy;   /* True: Worker is not available */
+#ifdef CONFIG_WQUEUE_STATISTICS
+  struct work_stats_s stats; /* Only updated by the worker thread */
+#endif
 };
 
 /* This structure defines the state of one kernel-mode work queue */
@@ -60,6 +116,10 @@ struct kworker_s
 struct kwork_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SMP
+  spinlock_t        lock;      /* Protects the queue */
+#endif
+  volatile uint32_t seq;       /* Incremented when work is queued */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -71,10 +131,14 @@ struct kwork_wqueue_s
 struct hp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SMP
+  spinlock_t        lock;      /* Protects the queue */
+#endif
+  volatile uint32_t seq;       /* Incremented when work is queued */
 
   /* Describes each thread in the high priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_HPNTHREADS];
+  struct kworker_s  worker[HPWORK_NTHREADS];
 };
 #endif
 
@@ -86,6 +150,10 @@ struct hp_wqueue_s
 struct lp_wqueue_s
 {
   struct dq_queue_s q;      /* The queue of pending work */
+#ifdef CONFIG_SMP
+  spinlock_t        lock;   /* Protects the queue */
+#endif
+  volatile uint32_t seq;    /* Incremented when work is queued */
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -98,9 +166,17 @@ struct lp_wqueue_s
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_HPWORK
-/* The state of the kernel mode, high priority work queue. */
+/* The state of the kernel mode, high priority work queue(s).  There is
+ * one queue per CPU with CONFIG_SCHED_HPWORK_PERCPU, otherwise just one.
+ */
+
+extern struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
+#endif
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+/* Serializes queueing and cancellation of the same per-CPU work */
 
-extern struct hp_wqueue_s g_hpwork;
+extern spinlock_t g_hpwork_locks[HPWORK_NLOCKS];
 #endif
 
 #ifdef CONFIG_SCHED_LPWORK
@@ -52,6 +52,12 @@ SYSCALL_LOOKUP(sched_setaffinity,          3, STUB_sched_setaffinity)
 SYSCALL_LOOKUP(set_errno,                  1, STUB_set_errno)
 SYSCALL_LOOKUP(uname,                      1, STUB_uname)
 
+/* User-defined instrumentation notes */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+SYSCALL_LOOKUP(sched_note_event,           3, STUB_sched_note_event)
+#endif
+
 /* User identity */
 
 #ifdef CONFIG_SCHED_USER_IDENTITY
@@ -250,6 +256,7 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
 
 #if defined(CONFIG_FS_RAMMAP)
   SYSCALL_LOOKUP(munmap,                   2, STUB_munmap)
+  SYSCALL_LOOKUP(msync,                    3, STUB_msync)
 #endif
 
 #if defined(CONFIG_PSEUDOFS_SOFTLINKS)
@@ -265,6 +272,12 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(mkfifo2,                  3, STUB_mkfifo2)
 #endif
 
+#if defined(CONFIG_PIPES)
+  SYSCALL_LOOKUP(splice,                   6, STUB_splice)
+  SYSCALL_LOOKUP(tee,                      4, STUB_tee)
+  SYSCALL_LOOKUP(vmsplice,                 4, STUB_vmsplice)
+#endif
+
 #if CONFIG_NFILE_STREAMS > 0
   SYSCALL_LOOKUP(fdopen,                   3, STUB_fs_fdopen)
   SYSCALL_LOOKUP(sched_getstreams,         0, STUB_sched_getstreams)
@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -53,6 +54,7 @@
 #define MAX_HEADER_FILES 500
 #define SYMTAB_NAME      "g_symtab"
 #define NSYMBOLS_NAME    "g_nsymbols"
+#define HASH_NONE        0xffff
 
 /****************************************************************************
  * Private Types
@@ -65,13 +67,17 @@
 static const char *g_hdrfiles[MAX_HEADER_FILES];
 static int nhdrfiles;
 
+static uint32_t *g_hashes;
+static char **g_conds;
+static int g_nsyms;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 static void show_usage(const char *progname)
 {
-  fprintf(stderr, "USAGE: %s [-d] <cvs-file> <symtab-file> [<symtab-name> [<nsymbols-name>]]\n\n",
+  fprintf(stderr, "USAGE: %s [-d] [-h] <cvs-file> <symtab-file> [<symtab-name> [<nsymbols-name>]]\n\n",
           progname);
   fprintf(stderr, "Where:\n\n");
   fprintf(stderr, "  <cvs-file>      : The path to the input CSV file (required)\n");
@@ -81,6 +87,7 @@ static void show_usage(const char *progname)
   fprintf(stderr, "  <nsymbols-name> : Optional name for the symbol table variable\n");
   fprintf(stderr, "                    Default: \"%s\"\n", NSYMBOLS_NAME);
   fprintf(stderr, "  -d              : Enable debug output\n");
+  fprintf(stderr, "  -h              : Also generate a hash index named <symtab-name>_hash\n");
   exit(EXIT_FAILURE);
 }
 
@@ -117,6 +124,193 @@ static void add_hdrfile(const char *hdrfile)
     }
 }
 
+/* This must match symtab_hash() in libs/libc/symtab/symtab_hash.c */
+
+static uint32_t symbol_hash(const char *name)
+{
+  const unsigned char *ptr = (const unsigned char *)name;
+  uint32_t hash = 5381;
+
+  while (*ptr != '\0')
+    {
+      hash = (hash << 5) + hash + *ptr++;
+    }
+
+  return hash;
+}
+
+static void add_symbol(const char *name, const char *cond)
+{
+  if (g_nsyms >= HASH_NONE)
+    {
+      fprintf(stderr, "ERROR:  Too many symbols for a hash index\n");
+      exit(EXIT_FAILURE);
+    }
+
+  g_hashes = realloc(g_hashes, (g_nsyms + 1) * sizeof(uint32_t));
+  g_conds  = realloc(g_conds, (g_nsyms + 1) * sizeof(char *));
+  if (!g_hashes || !g_conds)
+    {
+      fprintf(stderr, "ERROR:  Failed to allocate the hash table\n");
+      exit(EXIT_FAILURE);
+    }
+
+  g_hashes[g_nsyms] = symbol_hash(name);
+  g_conds[g_nsyms]  = cond && strlen(cond) > 0 ? strdup(cond) : NULL;
+  g_nsyms++;
+}
+
+/* Output the table index of the first symbol in the list that is not
+ * excluded by conditional compilation, or HASH_NONE if there is none.
+ */
+
+static void output_first(FILE *outstream, const char *symtab,
+                         const uint16_t *list, const uint16_t *next)
+{
+  if (*list == HASH_NONE)
+    {
+      fprintf(outstream, "SYMTAB_HASH_NONE");
+    }
+  else if (!g_conds[*list])
+    {
+      fprintf(outstream, "%s_sym_%u", symtab, *list);
+    }
+  else
+    {
+      fprintf(outstream, "(%s_sym_%u != SYMTAB_HASH_NONE ? %s_sym_%u : ",
+              symtab, *list, symtab, *list);
+      output_first(outstream, symtab, &next[*list], next);
+      fprintf(outstream, ")");
+    }
+}
+
+/* Output a hash index for the symbol table.  Symbols that are excluded by
+ * conditional compilation are omitted from the symbol table, so the table
+ * index of a symbol is only known to the compiler:  It is generated as an
+ * enumeration under the same conditions as the symbol table, and the
+ * buckets and chains skip the symbols that are excluded.  The index layout
+ * must match symtab_hashinit() in libs/libc/symtab/symtab_hashinit.c.
+ */
+
+static void output_hash(FILE *outstream, const char *symtab)
+{
+  uint16_t *bucket;
+  uint16_t *chain;
+  uint32_t nbuckets;
+  uint32_t ndx;
+  int i;
+
+  for (nbuckets = 1; 2 * nbuckets < (uint32_t)g_nsyms; nbuckets <<= 1);
+
+  bucket = malloc(nbuckets * sizeof(uint16_t));
+  chain  = malloc((g_nsyms + 1) * sizeof(uint16_t));
+  if (!bucket || !chain)
+    {
+      fprintf(stderr, "ERROR:  Failed to allocate the hash index\n");
+      exit(EXIT_FAILURE);
+    }
+
+  for (ndx = 0; ndx < nbuckets; ndx++)
+    {
+      bucket[ndx] = HASH_NONE;
+    }
+
+  for (i = g_nsyms - 1; i >= 0; i--)
+    {
+      ndx         = g_hashes[i] & (nbuckets - 1);
+      chain[i]    = bucket[ndx];
+      bucket[ndx] = (uint16_t)i;
+    }
+
+  /* The table index of each symbol that is included */
+
+  fprintf(outstream, "enum\n{\n");
+
+  for (i = 0; i < g_nsyms; i++)
+    {
+      if (g_conds[i])
+        {
+          fprintf(outstream, "#if %s\n", g_conds[i]);
+        }
+
+      fprintf(outstream, "  %s_ndx_%d,\n", symtab, i);
+
+      if (g_conds[i])
+        {
+          fprintf(outstream, "#endif\n");
+        }
+    }
+
+  fprintf(outstream, "  %s_nndx\n};\n\n", symtab);
+
+  /* The table index of each symbol or SYMTAB_HASH_NONE if it is excluded */
+
+  for (i = 0; i < g_nsyms; i++)
+    {
+      if (g_conds[i])
+        {
+          fprintf(outstream, "#if %s\n", g_conds[i]);
+          fprintf(outstream, "#  define %s_sym_%d %s_ndx_%d\n",
+                  symtab, i, symtab, i);
+          fprintf(outstream, "#else\n");
+          fprintf(outstream, "#  define %s_sym_%d SYMTAB_HASH_NONE\n",
+                  symtab, i);
+          fprintf(outstream, "#endif\n");
+        }
+      else
+        {
+          fprintf(outstream, "#define %s_sym_%d %s_ndx_%d\n",
+                  symtab, i, symtab, i);
+        }
+    }
+
+  /* The first symbol of each bucket */
+
+  fprintf(outstream, "\nstatic const uint16_t %s_bucket[%u] =\n{\n",
+          symtab, nbuckets);
+
+  for (ndx = 0; ndx < nbuckets; ndx++)
+    {
+      fprintf(outstream, "  ");
+      output_first(outstream, symtab, &bucket[ndx], chain);
+      fprintf(outstream, ",\n");
+    }
+
+  /* The next symbol in the same bucket, for each symbol that is included.
+   * Never output an empty array.
+   */
+
+  fprintf(outstream, "};\n\nstatic const uint16_t %s_chain[] =\n{\n",
+          symtab);
+
+  for (i = 0; i < g_nsyms; i++)
+    {
+      if (g_conds[i])
+        {
+          fprintf(outstream, "#if %s\n", g_conds[i]);
+        }
+
+      fprintf(outstream, "  ");
+      output_first(outstream, symtab, &chain[i], chain);
+      fprintf(outstream, ",\n");
+
+      if (g_conds[i])
+        {
+          fprintf(outstream, "#endif\n");
+        }
+    }
+
+  fprintf(outstream, "  SYMTAB_HASH_NONE\n};\n\n");
+
+  fprintf(outstream, "const struct symtab_hash_s %s_hash =\n", symtab);
+  fprintf(outstream, "{\n");
+  fprintf(outstream, "  %u, %s_bucket, %s_chain\n", nbuckets, symtab, symtab);
+  fprintf(outstream, "};\n");
+
+  free(bucket);
+  free(chain);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -130,6 +324,7 @@ int main(int argc, char **argv, char **envp)
   char *nextterm;
   char *finalterm;
   char *ptr;
+  bool hashed;
   bool cond;
   FILE *instream;
   FILE *outstream;
@@ -141,8 +336,9 @@ int main(int argc, char **argv, char **envp)
   symtab   = SYMTAB_NAME;
   nsymbols = NSYMBOLS_NAME;
   g_debug  = false;
+  hashed   = false;
 
-  while ((ch = getopt(argc, argv, ":d")) > 0)
+  while ((ch = getopt(argc, argv, ":dh")) > 0)
     {
       switch (ch)
         {
@@ -150,6 +346,10 @@ int main(int argc, char **argv, char **envp)
             g_debug = true;
             break;
 
+          case 'h' :
+            hashed = true;
+            break;
+
           case '?' :
             fprintf(stderr, "Unrecognized option: %c\n", optopt);
             show_usage(argv[0]);
@@ -234,6 +434,15 @@ int main(int argc, char **argv, char **envp)
       /* Add the header file to the list of header files we need to include */
 
       add_hdrfile(g_parm[HEADER_INDEX]);
+
+      /* Remember the hash of the symbol name and its condition if we need a
+       * hash index
+       */
+
+      if (hashed)
+        {
+          add_symbol(g_parm[NAME_INDEX], g_parm[COND_INDEX]);
+        }
     }
 
   /* Back to the beginning */
@@ -305,6 +514,12 @@ int main(int argc, char **argv, char **envp)
   fprintf(outstream, "#define NSYMBOLS (sizeof(%s) / sizeof (struct symtab_s))\n", symtab);
   fprintf(outstream, "int %s = NSYMBOLS;\n", nsymbols);
 
+  if (hashed)
+    {
+      fprintf(outstream, "\n");
+      output_hash(outstream, symtab);
+    }
+
   /* Close the CSV and symbol table files and exit */
 
   fclose(instream);
@@ -33,738 +33,90 @@
  *
  ****************************************************************************/
 
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
 
 /****************************************************************************
- * The following is autogenerated and comes from:
- *
- *   (gdb) p &g_note_info.ni_buffer
- *   $3 = (uint8_t (*)[2048]) 0x10831004
- *   (gdb) dump binary memory noteinfo.bin 0x10831004 0x10831804
- *
- *   $ xxd -g 1 -i noteinfo.bin >noteinfo.h
- *
+ * Pre-processor Definitions
  ****************************************************************************/
 
-unsigned char noteinfo_bin[] = {
-  0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00,
-  0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00,
-  0x00, 0xc0, 0x00, 0x00, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xc0,
-  0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0b, 0x02, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00,
-  0x06, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x0b,
-  0x02, 0x00, 0x00, 0x00, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03,
-  0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00,
-  0x00, 0xc1, 0x00, 0x00, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xc1,
-  0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0b, 0x02, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x06, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x0b,
-  0x02, 0x00, 0x00, 0x00, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03,
-  0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00,
-  0x06, 0x00, 0xc1, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00,
-  0x00, 0xc1, 0x00, 0x00, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xc1,
-  0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x01, 0x00, 0x11, 0x00, 0x64, 0x00, 0x07, 0x00, 0xc1, 0x00, 0x00, 0x00,
-  0x6f, 0x73, 0x74, 0x65, 0x73, 0x74, 0x00, 0x0b, 0x06, 0x64, 0x00, 0x06,
-  0x00, 0xc1, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x04, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0b, 0x04, 0x00, 0x00, 0x00,
-  0x00, 0x40, 0x00, 0x00, 0x00, 0x02, 0x0b, 0x04, 0x00, 0x00, 0x00, 0x00,
-  0x7f, 0x00, 0x00, 0x00, 0x03, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x01, 0x00, 0x11, 0x00, 0xc0, 0x00, 0x05, 0x00, 0xbf,
-  0x00, 0x00, 0x00, 0x68, 0x70, 0x77, 0x6f, 0x72, 0x6b, 0x00, 0x0b, 0x02,
-  0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0xc0,
-  0x00, 0x05, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0xc0, 0x00, 0x05,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0xc0, 0x00, 0x05,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0xc0, 0x00, 0x05,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x07, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00,
-  0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0f, 0x00, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x69, 0x6e, 0x69, 0x74, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00,
-  0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00,
-  0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01,
-  0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01,
-  0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x03,
-  0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00,
-  0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x00, 0x00, 0x00,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00,
-  0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00,
-  0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x03,
-  0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02,
-  0x64, 0x00, 0x06, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00,
-  0x00, 0x00, 0x00, 0xbf, 0x00, 0x00, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00,
-  0x00, 0xbf, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00,
-  0xbf, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0b, 0x02, 0x64, 0x00, 0x06, 0x00, 0xbf, 0x00,
-  0x00, 0x00, 0x06, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x00,
-  0x00, 0x0b, 0x02, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x03,
-  0x0a, 0x03, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0b, 0x02,
-  0x64, 0x00, 0x06, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x06, 0x0a, 0x03, 0x00,
-  0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x0b, 0x02, 0x00, 0x00, 0x00,
-  0x00, 0xc0, 0x00, 0x00, 0x00, 0x03, 0x0a, 0x03, 0x64, 0x00, 0x06, 0x00,
-  0xc0, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0a, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0b, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x0c, 0x0d, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0c, 0x64, 0x00, 0x06, 0x00, 0xc0, 0x00,
-  0x00, 0x00, 0x01, 0x00, 0x0c, 0x0d, 0x64, 0x00
-};
-unsigned int noteinfo_bin_len = 8192;
-
-/****************************************************************************
- * This comes from:
+/* The notes are read from a capture of /dev/note, for example one made on
+ * the simulator with:
  *
- *   (gdb) p g_note_info
- *   $1 = {ni_head = 915, ni_tail = 925,
- *   ni_buffer = ...
+ *   nsh> cat /dev/note >/mnt/host/notes.bin
  *
- ****************************************************************************/
-
-unsigned int ni_head = 1866;
-unsigned int ni_tail = 1868;
+ * The file is just a sequence of notes.  Each note starts with the common
+ * header below, the first byte of which is the length of the note.
+ */
+
+#define NOTE_HDRSIZE      10      /* sizeof(struct note_common_s) */
+#define MAX_NOTESIZE      256
+#define MAX_PID           65536
+#define MAX_CPUS          256
+
+/* Note types, see enum note_type_e in include/nuttx/sched_note.h */
+
+#define NOTE_START           0
+#define NOTE_STOP            1
+#define NOTE_SUSPEND         2
+#define NOTE_RESUME          3
+#define NOTE_CPU_START       4
+#define NOTE_CPU_STARTED     5
+#define NOTE_CPU_PAUSE       6
+#define NOTE_CPU_PAUSED      7
+#define NOTE_CPU_RESUME      8
+#define NOTE_CPU_RESUMED     9
+#define NOTE_PREEMPT_LOCK    10
+#define NOTE_PREEMPT_UNLOCK  11
+#define NOTE_CSECTION_ENTER  12
+#define NOTE_CSECTION_LEAVE  13
+#define NOTE_SPINLOCK_LOCK   14
+#define NOTE_SPINLOCK_LOCKED 15
+#define NOTE_SPINLOCK_UNLOCK 16
+#define NOTE_SPINLOCK_ABORT  17
+#define NOTE_USER_BEGIN      18
+#define NOTE_USER_END        19
+#define NOTE_USER_COUNTER    20
+#define NOTE_USER_MARK       21
+#define NTYPES               22
+
+/* In the JSON trace, the CPUs are shown as threads of one process and the
+ * tasks as threads of another.
+ */
+
+#define TRACE_CPUS        0
+#define TRACE_TASKS       1
 
 /****************************************************************************
- * The following does not change
+ * Private Types
  ****************************************************************************/
 
-#define CONFIG_SMP 1
-struct note_common_s
+struct note_s
 {
-  uint8_t nc_length;           /* Length of the note */
-  uint8_t nc_type;             /* See enum note_type_e */
-  uint8_t nc_priority;         /* Thread/task priority */
-#ifdef CONFIG_SMP
-  uint8_t nc_cpu;              /* CPU thread/task running on */
-#endif
-  uint8_t nc_pid[2];           /* ID of the thread/task */
-  uint8_t nc_systime[4];       /* Time when note buffered */
+  uint8_t  length;
+  uint8_t  type;
+  uint8_t  priority;
+  uint8_t  cpu;
+  unsigned int pid;
+  uint64_t time;                 /* Timestamp, extended to 64 bits */
+  const uint8_t *data;           /* Type specific data */
+  unsigned int datalen;
 };
 
-#define NTYPES 18
-static char *noteid[NTYPES] =
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_noteid[NTYPES] =
 {
   "NOTE_START",           /* type = 0 */
   "NOTE_STOP",            /* type = 1 */
@@ -787,145 +139,462 @@ static char *noteid[NTYPES] =
   "NOTE_SPINLOCK_LOCK",   /* type = 14 */
   "NOTE_SPINLOCK_LOCKED", /* type = 15 */
   "NOTE_SPINLOCK_UNLOCK", /* type = 16 */
-  "NOTE_SPINLOCK_ABORT"   /* type = 17 */
+  "NOTE_SPINLOCK_ABORT",  /* type = 17 */
+
+  "NOTE_USER_BEGIN",      /* type = 18 */
+  "NOTE_USER_END",        /* type = 19 */
+  "NOTE_USER_COUNTER",    /* type = 20 */
+  "NOTE_USER_MARK"        /* type = 21 */
 };
 
-static unsigned int next_ndx(unsigned int ndx)
+static char *g_names[MAX_PID];     /* Task names from NOTE_START */
+static int g_running[MAX_CPUS];    /* Task running on each CPU, or -1 */
+static bool g_cpuseen[MAX_CPUS];   /* The CPU thread has been named */
+static double g_usecpertick = 10000.0;
+static bool g_first = true;
+static FILE *g_out;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
 {
-  if (++ndx >= noteinfo_bin_len)
+  fprintf(stderr, "USAGE: %s [-j] [-t <usec>] [-o <outfile>] <notefile>\n",
+          progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -j          Write Chrome trace / Perfetto JSON "
+                  "instead of text\n");
+  fprintf(stderr, "  -t <usec>   Microseconds per timestamp unit "
+                  "(default: 10000, i.e.\n");
+  fprintf(stderr, "              CONFIG_USEC_PER_TICK.  With "
+                  "CONFIG_SCHED_NOTE_HIRES, use the\n");
+  fprintf(stderr, "              period of up_critmon_gettime())\n");
+  fprintf(stderr, "  -o <outfile> Write to <outfile> instead of stdout\n");
+  exit(EXIT_FAILURE);
+}
+
+static uint32_t get32(const uint8_t *data)
+{
+  return (uint32_t)data[3] << 24 | (uint32_t)data[2] << 16 |
+         (uint32_t)data[1] << 8  | (uint32_t)data[0];
+}
+
+/* Read the next note.  The 32-bit timestamps are extended assuming that
+ * consecutive notes are less than half the timer range apart.
+ */
+
+static int read_note(FILE *stream, uint8_t *buffer, struct note_s *note)
+{
+  static uint64_t epoch;
+  static uint32_t last;
+  uint32_t systime;
+  int ch;
+
+  ch = getc(stream);
+  if (ch == EOF)
+    {
+      return 0;
+    }
+
+  if (ch < NOTE_HDRSIZE)
     {
-      ndx -= noteinfo_bin_len;
+      fprintf(stderr, "ERROR: Bad note length %d at offset %ld\n",
+              ch, ftell(stream) - 1);
+      return -1;
     }
 
-  return ndx;
+  buffer[0] = (uint8_t)ch;
+  if (fread(&buffer[1], 1, ch - 1, stream) != (size_t)(ch - 1))
+    {
+      fprintf(stderr, "ERROR: Incomplete note at end of file\n");
+      return -1;
+    }
+
+  /* A large step backwards is a wraparound.  Small ones are differences
+   * between the timers of the CPUs.
+   */
+
+  systime = get32(&buffer[6]);
+  if (systime < last && last - systime > 0x80000000u)
+    {
+      epoch += 0x100000000ull;
+    }
+
+  last           = systime;
+
+  note->length   = buffer[0];
+  note->type     = buffer[1];
+  note->priority = buffer[2];
+  note->cpu      = buffer[3];
+  note->pid      = (unsigned int)buffer[5] << 8 | buffer[4];
+  note->time     = epoch + systime;
+  note->data     = &buffer[NOTE_HDRSIZE];
+  note->datalen  = note->length - NOTE_HDRSIZE;
+  return 1;
 }
 
-int main(int argc, char **argv)
+/* Return the NUL terminated string at the end of a note */
+
+static const char *note_string(const struct note_s *note,
+                               unsigned int offset, char *buffer)
 {
-  struct note_common_s *note;
-  unsigned int size;
-  unsigned int notndx;
-  unsigned int bufndx;
-  unsigned int remainder;
-  unsigned int value;
-  char buffer[64];
-
-  notndx = ni_tail;
-  while (notndx != ni_head)
+  unsigned int len = 0;
+
+  if (note->datalen > offset)
+    {
+      len = note->datalen - offset;
+      memcpy(buffer, &note->data[offset], len);
+    }
+
+  buffer[len] = '\0';
+  return buffer;
+}
+
+/****************************************************************************
+ * Text output
+ ****************************************************************************/
+
+static void print_text(const struct note_s *note)
+{
+  char name[MAX_NOTESIZE];
+  unsigned int i;
+
+  fprintf(g_out, "CPU%-2u PID%-5u prio=%-3u: %-20s time=%llu",
+          note->cpu, note->pid, note->priority,
+          note->type < NTYPES ? g_noteid[note->type] : "Unrecognized",
+          (unsigned long long)note->time);
+
+  switch (note->type)
     {
-      printf("%5u: ", notndx);
+      case NOTE_START:
+        fprintf(g_out, " Name: %s", note_string(note, 0, name));
+        break;
+
+      case NOTE_SUSPEND:
+        if (note->datalen >= 1)
+          {
+            fprintf(g_out, " State=%u", note->data[0]);
+          }
+        break;
 
-      /* Copy the note into the buffer */
+      case NOTE_CPU_START:
+      case NOTE_CPU_PAUSE:
+      case NOTE_CPU_RESUME:
+        if (note->datalen >= 1)
+          {
+            fprintf(g_out, " Target CPU%u", note->data[0]);
+          }
+        break;
+
+      case NOTE_PREEMPT_LOCK:
+      case NOTE_PREEMPT_UNLOCK:
+      case NOTE_CSECTION_ENTER:
+      case NOTE_CSECTION_LEAVE:
+        if (note->datalen >= 2)
+          {
+            fprintf(g_out, " Count=%u",
+                    (unsigned int)note->data[1] << 8 | note->data[0]);
+          }
+        break;
 
-      size = noteinfo_bin[notndx];
-      if (size > 64)
+      case NOTE_USER_BEGIN:
+      case NOTE_USER_END:
+      case NOTE_USER_MARK:
+        fprintf(g_out, " Name: %s", note_string(note, 4, name));
+        break;
+
+      case NOTE_USER_COUNTER:
+        if (note->datalen >= 4)
+          {
+            fprintf(g_out, " Name: %s Value=%ld",
+                    note_string(note, 4, name),
+                    (long)(int32_t)get32(note->data));
+          }
+        break;
+
+      default:
+        for (i = 0; i < note->datalen; i++)
+          {
+            fprintf(g_out, " %02x", note->data[i]);
+          }
+        break;
+    }
+
+  fprintf(g_out, "\n");
+}
+
+/****************************************************************************
+ * JSON output
+ ****************************************************************************/
+
+static void json_string(const char *str)
+{
+  fputc('"', g_out);
+  for (; *str != '\0'; str++)
+    {
+      if (*str == '"' || *str == '\\')
+        {
+          fprintf(g_out, "\\%c", *str);
+        }
+      else if ((unsigned char)*str < 0x20)
+        {
+          fprintf(g_out, "\\u%04x", (unsigned char)*str);
+        }
+      else
         {
-           printf("ERROR: size to big: %u\n", size);
-           exit(1);
+          fputc(*str, g_out);
         }
+    }
+
+  fputc('"', g_out);
+}
+
+/* Start a trace event.  The caller adds any further fields and the
+ * closing brace.
+ */
+
+static void json_event(const char *name, char ph, int pid, unsigned int tid,
+                       const struct note_s *note)
+{
+  fprintf(g_out, "%s\n    {\"name\": ", g_first ? "" : ",");
+  json_string(name);
+  fprintf(g_out, ", \"ph\": \"%c\", \"pid\": %d, \"tid\": %u", ph, pid, tid);
+  if (note != NULL)
+    {
+      fprintf(g_out, ", \"ts\": %.3f", note->time * g_usecpertick);
+    }
+
+  g_first = false;
+}
+
+static void json_threadname(int pid, unsigned int tid, const char *name)
+{
+  json_event("thread_name", 'M', pid, tid, NULL);
+  fprintf(g_out, ", \"args\": {\"name\": ");
+  json_string(name);
+  fprintf(g_out, "}}");
+}
+
+static void json_instant(const char *name, int pid, unsigned int tid,
+                         const struct note_s *note)
+{
+  json_event(name, 'i', pid, tid, note);
+  fprintf(g_out, ", \"s\": \"t\"}");
+}
+
+static const char *task_name(unsigned int pid, char *buffer)
+{
+  if (g_names[pid] != NULL)
+    {
+      return g_names[pid];
+    }
 
-      for (bufndx = 0; bufndx < size;)
+  sprintf(buffer, "PID %u", pid);
+  return buffer;
+}
+
+/* Close the span of the task running on a CPU */
+
+static void json_switchout(const struct note_s *note, unsigned int cpu)
+{
+  char buffer[32];
+
+  if (g_running[cpu] >= 0)
+    {
+      json_event(task_name(g_running[cpu], buffer), 'E', TRACE_CPUS, cpu,
+                 note);
+      fprintf(g_out, "}");
+      g_running[cpu] = -1;
+    }
+}
+
+static void print_json(const struct note_s *note)
+{
+  char name[MAX_NOTESIZE];
+  char buffer[32];
+
+  if (!g_cpuseen[note->cpu])
+    {
+      sprintf(buffer, "CPU%u", note->cpu);
+      json_threadname(TRACE_CPUS, note->cpu, buffer);
+      g_cpuseen[note->cpu] = true;
+    }
+
+  switch (note->type)
+    {
+      /* A task was created.  Name its thread in the task process. */
+
+      case NOTE_START:
+        note_string(note, 0, name);
+        free(g_names[note->pid]);
+        g_names[note->pid] = strdup(name);
+        json_threadname(TRACE_TASKS, note->pid, name);
+        break;
+
+      /* Scheduling is shown as a span per running task on each CPU */
+
+      case NOTE_STOP:
+      case NOTE_SUSPEND:
+        if (g_running[note->cpu] == (int)note->pid)
+          {
+            json_switchout(note, note->cpu);
+          }
+        break;
+
+      case NOTE_RESUME:
+        json_switchout(note, note->cpu);
+        json_event(task_name(note->pid, buffer), 'B', TRACE_CPUS,
+                   note->cpu, note);
+        fprintf(g_out, ", \"args\": {\"pid\": %u, \"priority\": %u}}",
+                note->pid, note->priority);
+        g_running[note->cpu] = note->pid;
+        break;
+
+      /* User-defined events are shown on the thread of the task */
+
+      case NOTE_USER_BEGIN:
+      case NOTE_USER_END:
+        json_event(note_string(note, 4, name),
+                   note->type == NOTE_USER_BEGIN ? 'B' : 'E',
+                   TRACE_TASKS, note->pid, note);
+        fprintf(g_out, "}");
+        break;
+
+      case NOTE_USER_COUNTER:
+        json_event(note_string(note, 4, name), 'C', TRACE_TASKS,
+                   note->pid, note);
+        fprintf(g_out, ", \"args\": {\"value\": %ld}}",
+                note->datalen >= 4 ? (long)(int32_t)get32(note->data) : 0);
+        break;
+
+      case NOTE_USER_MARK:
+        json_instant(note_string(note, 4, name), TRACE_TASKS, note->pid,
+                     note);
+        break;
+
+      /* Everything else is an instant event of the task */
+
+      default:
+        json_instant(note->type < NTYPES ? g_noteid[note->type] :
+                     "Unrecognized", TRACE_TASKS, note->pid, note);
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint8_t buffer[MAX_NOTESIZE];
+  struct note_s note;
+  const char *outfile = NULL;
+  bool json = false;
+  FILE *stream;
+  char *endptr;
+  int ret;
+  int ch;
+  int i;
+
+  while ((ch = getopt(argc, argv, ":jt:o:h")) > 0)
+    {
+      switch (ch)
         {
-          buffer[bufndx] = noteinfo_bin[notndx];
+          case 'j':
+            json = true;
+            break;
+
+          case 't':
+            g_usecpertick = strtod(optarg, &endptr);
+            if (*endptr != '\0' || g_usecpertick <= 0.0)
+              {
+                fprintf(stderr, "ERROR: Bad timestamp unit: %s\n", optarg);
+                show_usage(argv[0]);
+              }
+            break;
+
+          case 'o':
+            outfile = optarg;
+            break;
+
+          case 'h':
+          default:
+            show_usage(argv[0]);
+            break;
+        }
+    }
 
-          bufndx++;
-          notndx = next_ndx(notndx);
+  if (optind != argc - 1)
+    {
+      fprintf(stderr, "Unexpected number of arguments\n");
+      show_usage(argv[0]);
+    }
 
-          if (notndx == ni_head && bufndx < size)
-            {
-               printf("Incomplete record\n");
-               exit(1);
-            }
+  stream = fopen(argv[optind], "rb");
+  if (stream == NULL)
+    {
+      fprintf(stderr, "open %s failed: %s\n", argv[optind],
+              strerror(errno));
+      return EXIT_FAILURE;
+    }
+
+  g_out = stdout;
+  if (outfile != NULL)
+    {
+      g_out = fopen(outfile, "w");
+      if (g_out == NULL)
+        {
+          fprintf(stderr, "open %s failed: %s\n", outfile, strerror(errno));
+          fclose(stream);
+          return EXIT_FAILURE;
         }
+    }
 
-      note = (struct note_common_s *)buffer;
-      printf("CPU%1u PID%-3uprio=%-3u: %-20s time=%08lx",
-             note->nc_cpu,
-             (unsigned int) note->nc_pid[1] << 8 |
-             (unsigned int) note->nc_pid[0],
-             note->nc_priority,
-             note->nc_type < NTYPES ? noteid[note->nc_type] : "Unrecognized",
-             (unsigned long)note->nc_systime[3] << 24 |
-             (unsigned long)note->nc_systime[2] << 16 |
-             (unsigned long)note->nc_systime[1] << 8 |
-             (unsigned long)note->nc_systime[0]);
-
-      bufndx    = sizeof(struct note_common_s);
-      remainder = size - bufndx;
-      if (remainder > 0)
+  if (json)
+    {
+      for (i = 0; i < MAX_CPUS; i++)
         {
-          switch(note->nc_type)
-          {
-            /* Followed by a variable length, NULL terminated name */
-
-            case 0: /* NOTE_START */
-              buffer[size - 1] = '\0';
-              printf(" Name: %s", &buffer[bufndx]);
-              bufndx    = size;
-              remainder = 0;
-              break;
-
-            /* Followed by an 8-bit task state */
-
-            case 2: /* NOTE_SUSPEND */
-              printf(" State=%u", (unsigned int)buffer[bufndx]);
-              bufndx++;
-              remainder--;
-              break;
-
-            /* Followed by an 8-bit target CPU number */
-
-            case 4: /* NOTE_CPU_START */
-            case 6: /* NOTE_CPU_PAUSE */
-            case 8: /* NOTE_CPU_RESUME */
-              printf(" Target CPU%u", (unsigned int)buffer[bufndx]);
-              bufndx++;
-              remainder--;
-              break;
-
-            /* Followed by a 16-bit count */
-
-            case 10: /* NOTE_PREEMPT_LOCK */
-            case 11: /* NOTE_PREEMPT_UNLOCK */
-            case 12: /* NOTE_CSECTION_ENTER */
-            case 13: /* NOTE_CSECTION_LEAVE */
-              if (remainder >= 2)
-                {
-                  value = (unsigned int)buffer[bufndx] << 8 |
-                          (unsigned int)buffer[bufndx+1];
-                  bufndx += 2;
-                  remainder -= 2;
-                  break;
-                }
-
-            /* Followed by an 8-bit spinlock value */
-
-            case 14: /* NOTE_SPINLOCK_LOCK */
-            case 15: /* NOTE_SPINLOCK_LOCKED */
-            case 16: /* NOTE_SPINLOCK_UNLOCK */
-            case 17: /* NOTE_SPINLOCK_ABORT */
-              printf(" Spinlock=%u", (unsigned int)buffer[bufndx]);
-              bufndx++;
-              remainder--;
-              break;
-
-            /* Nothing addition shoold follow these types */
-
-            case 1: /* NOTE_STOP */
-            case 3: /* NOTE_RESUME */
-            case 5: /* NOTE_CPU_STARTED */
-            case 7: /* NOTE_CPU_PAUSED */
-            case 9: /* NOTE_CPU_RESUMED */
-            default:
-              break;
-          }
+          g_running[i] = -1;
         }
 
-      for (; bufndx < size; bufndx++)
+      fprintf(g_out, "{\n  \"displayTimeUnit\": \"ns\",\n");
+      fprintf(g_out, "  \"traceEvents\": [");
+
+      json_event("process_name", 'M', TRACE_CPUS, 0, NULL);
+      fprintf(g_out, ", \"args\": {\"name\": \"CPUs\"}}");
+      json_event("process_name", 'M', TRACE_TASKS, 0, NULL);
+      fprintf(g_out, ", \"args\": {\"name\": \"Tasks\"}}");
+    }
+
+  while ((ret = read_note(stream, buffer, &note)) > 0)
+    {
+      if (json)
+        {
+          print_json(&note);
+        }
+      else
         {
-          printf(" %02x", buffer[bufndx]);
+          print_text(&note);
         }
+    }
 
-      printf("\n");
+  if (json)
+    {
+      fprintf(g_out, "\n  ]\n}\n");
+    }
+
+  fclose(stream);
+  if (g_out != stdout)
+    {
+      fclose(g_out);
     }
+
+  for (i = 0; i < MAX_PID; i++)
+    {
+      free(g_names[i]);
+    }
+
+  return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
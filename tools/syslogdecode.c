@@ -0,0 +1,622 @@
+/****************************************************************************
+ * tools/syslogdecode.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With CONFIG_SYSLOG_BINARY_RAW, each binary SYSLOG record is output as
+ * one line:  An ASCII RS character followed by the record in base64.  All
+ * other lines are plain text.
+ *
+ * A record holds (see drivers/syslog/syslog_binary.c):
+ *
+ *   - The priority of the message (1 byte)
+ *   - The time stamp, seconds and nanoseconds (4 bytes each)
+ *   - The address of the format string (the size of a target pointer)
+ *   - One tagged value for each argument and each '*' width or precision.
+ *     Integers and pointers are tagged with their size in bytes, doubles
+ *     with 'd' (or 'f' if the target double has 32 bits) and strings, which
+ *     are NUL terminated, with 's'.
+ *
+ * Values are in the byte order of the target.
+ */
+
+#define RECORD_MARK       0x1e
+#define LINESIZE          4096
+#define SPECSIZE          64
+
+/* ELF definitions (so that no host elf.h is needed) */
+
+#define EI_CLASS          4
+#define EI_DATA           5
+#define ELFCLASS32        1
+#define ELFCLASS64        2
+#define ELFDATA2MSB       2
+#define SHT_NOBITS        8
+#define SHF_ALLOC         2
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A loadable section of the ELF file */
+
+struct section_s
+{
+  uint64_t addr;
+  uint64_t size;
+  uint64_t offset;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t *g_elf;             /* The whole ELF file */
+static size_t g_elfsize;
+static bool g_msb;                 /* The target is big-endian */
+static unsigned int g_ptrsize;     /* 4 or 8 */
+static struct section_s *g_sections;
+static unsigned int g_nsections;
+static FILE *g_out;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+  fprintf(stderr, "USAGE: %s [-o <outfile>] <elffile> [<logfile>]\n",
+          progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  <elffile>     The nuttx ELF file that produced the "
+                  "log\n");
+  fprintf(stderr, "  <logfile>     The SYSLOG output (default: stdin)\n");
+  fprintf(stderr, "  -o <outfile>  Write to <outfile> instead of stdout\n");
+  exit(EXIT_FAILURE);
+}
+
+/* Get an unsigned value of 1 to 8 bytes in the byte order of the target */
+
+static uint64_t getval(const uint8_t *data, unsigned int size)
+{
+  uint64_t value = 0;
+  unsigned int i;
+
+  for (i = 0; i < size; i++)
+    {
+      value <<= 8;
+      value  |= g_msb ? data[i] : data[size - 1 - i];
+    }
+
+  return value;
+}
+
+/* Get a sign-extended value of 1 to 8 bytes */
+
+static int64_t getsval(const uint8_t *data, unsigned int size)
+{
+  int shift = 64 - 8 * size;
+
+  return (int64_t)(getval(data, size) << shift) >> shift;
+}
+
+/* Load the ELF file and collect its loadable sections */
+
+static int load_elf(const char *path)
+{
+  uint64_t shoff;
+  unsigned int shentsize;
+  unsigned int shnum;
+  const uint8_t *shdr;
+  FILE *stream;
+  unsigned int i;
+  long size;
+
+  stream = fopen(path, "rb");
+  if (stream == NULL)
+    {
+      fprintf(stderr, "open %s failed: %s\n", path, strerror(errno));
+      return -1;
+    }
+
+  fseek(stream, 0, SEEK_END);
+  size = ftell(stream);
+  fseek(stream, 0, SEEK_SET);
+
+  g_elf = malloc(size > 0 ? size : 1);
+  if (g_elf == NULL || size < 64 ||
+      fread(g_elf, 1, size, stream) != (size_t)size)
+    {
+      fprintf(stderr, "ERROR: Failed to read %s\n", path);
+      fclose(stream);
+      return -1;
+    }
+
+  fclose(stream);
+  g_elfsize = size;
+
+  if (memcmp(g_elf, "\177ELF", 4) != 0)
+    {
+      fprintf(stderr, "ERROR: %s is not an ELF file\n", path);
+      return -1;
+    }
+
+  g_msb = g_elf[EI_DATA] == ELFDATA2MSB;
+  if (g_elf[EI_CLASS] == ELFCLASS64)
+    {
+      g_ptrsize = 8;
+      shoff     = getval(&g_elf[0x28], 8);
+      shentsize = getval(&g_elf[0x3a], 2);
+      shnum     = getval(&g_elf[0x3c], 2);
+    }
+  else if (g_elf[EI_CLASS] == ELFCLASS32)
+    {
+      g_ptrsize = 4;
+      shoff     = getval(&g_elf[0x20], 4);
+      shentsize = getval(&g_elf[0x2e], 2);
+      shnum     = getval(&g_elf[0x30], 2);
+    }
+  else
+    {
+      fprintf(stderr, "ERROR: Unknown ELF class %d\n", g_elf[EI_CLASS]);
+      return -1;
+    }
+
+  if (shoff + (uint64_t)shentsize * shnum > g_elfsize)
+    {
+      fprintf(stderr, "ERROR: Bad section header table\n");
+      return -1;
+    }
+
+  g_sections = calloc(shnum + 1, sizeof(struct section_s));
+  if (g_sections == NULL)
+    {
+      return -1;
+    }
+
+  for (i = 0; i < shnum; i++)
+    {
+      struct section_s *section = &g_sections[g_nsections];
+      uint32_t type;
+      uint64_t flags;
+
+      shdr = &g_elf[shoff + (uint64_t)i * shentsize];
+      type = getval(&shdr[4], 4);
+
+      if (g_ptrsize == 8)
+        {
+          flags           = getval(&shdr[0x08], 8);
+          section->addr   = getval(&shdr[0x10], 8);
+          section->offset = getval(&shdr[0x18], 8);
+          section->size   = getval(&shdr[0x20], 8);
+        }
+      else
+        {
+          flags           = getval(&shdr[0x08], 4);
+          section->addr   = getval(&shdr[0x0c], 4);
+          section->offset = getval(&shdr[0x10], 4);
+          section->size   = getval(&shdr[0x14], 4);
+        }
+
+      /* Format strings are in loadable sections with contents */
+
+      if ((flags & SHF_ALLOC) != 0 && type != SHT_NOBITS &&
+          section->size > 0 &&
+          section->offset + section->size <= g_elfsize)
+        {
+          g_nsections++;
+        }
+    }
+
+  return 0;
+}
+
+/* Find the string at a target address */
+
+static const char *find_string(uint64_t addr)
+{
+  unsigned int i;
+
+  for (i = 0; i < g_nsections; i++)
+    {
+      struct section_s *section = &g_sections[i];
+
+      if (addr >= section->addr && addr < section->addr + section->size)
+        {
+          const char *str = (const char *)
+            &g_elf[section->offset + addr - section->addr];
+
+          /* The string must end within the section */
+
+          if (memchr(str, '\0', section->addr + section->size - addr))
+            {
+              return str;
+            }
+        }
+    }
+
+  return NULL;
+}
+
+/* Decode one base64 line.  Returns the number of bytes. */
+
+static size_t base64_decode(const char *src, uint8_t *dest)
+{
+  static const char table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const char *ptr;
+  uint32_t bits = 0;
+  size_t len = 0;
+  int nbits = 0;
+
+  for (; *src != '\0' && *src != '='; src++)
+    {
+      ptr = strchr(table, *src);
+      if (ptr == NULL)
+        {
+          break;
+        }
+
+      bits   = bits << 6 | (uint32_t)(ptr - table);
+      nbits += 6;
+      if (nbits >= 8)
+        {
+          nbits -= 8;
+          dest[len++] = (uint8_t)(bits >> nbits);
+        }
+    }
+
+  return len;
+}
+
+/* Print one record */
+
+static void print_record(const uint8_t *record, size_t reclen)
+{
+  const uint8_t *ptr = record;
+  const uint8_t *end = record + reclen;
+  const char *fmt;
+  uint64_t addr;
+  char spec[SPECSIZE];
+  char conv;
+  char size;
+  int len;
+  int val;
+
+  if (reclen < 9 + g_ptrsize)
+    {
+      fprintf(g_out, "[bad record]\n");
+      return;
+    }
+
+  addr = getval(&ptr[9], g_ptrsize);
+  fprintf(g_out, "[%5u.%06u] ", (unsigned int)getval(&ptr[1], 4),
+          (unsigned int)(getval(&ptr[5], 4) / 1000));
+
+  fmt = find_string(addr);
+  if (fmt == NULL)
+    {
+      fprintf(g_out, "[format string at 0x%llx not found]\n",
+              (unsigned long long)addr);
+      return;
+    }
+
+  ptr += 9 + g_ptrsize;
+  while (*fmt != '\0')
+    {
+      if (*fmt != '%')
+        {
+          fputc(*fmt++, g_out);
+          continue;
+        }
+
+      if (fmt[1] == '%')
+        {
+          fputc('%', g_out);
+          fmt += 2;
+          continue;
+        }
+
+      /* Copy the flags, width and precision, filling in the values of any
+       * '*'.
+       */
+
+      len = 0;
+      spec[len++] = *fmt++;
+
+      while (strchr("-+ #0123456789.*", *fmt) != NULL && *fmt != '\0' &&
+             len < SPECSIZE - 24)
+        {
+          if (*fmt == '*')
+            {
+              int tag = ptr < end ? *ptr : -1;
+
+              if (tag < 1 || tag > 8 || ptr + 1 + tag > end)
+                {
+                  goto mismatch;
+                }
+
+              val = (int)getsval(ptr + 1, tag);
+              ptr += 1 + tag;
+              fmt++;
+
+              /* A negative precision is taken as if it were omitted */
+
+              if (val < 0 && spec[len - 1] == '.')
+                {
+                  len--;
+                }
+              else
+                {
+                  len += sprintf(&spec[len], "%d", val);
+                }
+            }
+          else
+            {
+              spec[len++] = *fmt++;
+            }
+        }
+
+      /* The length modifier is replaced by the one the host needs */
+
+      size = 0;
+      while (*fmt == 'h' || *fmt == 'l' || *fmt == 'z')
+        {
+          size = size == 'h' && *fmt == 'h' ? 'H' : *fmt;
+          fmt++;
+        }
+
+      conv = *fmt++;
+      if (conv == '\0')
+        {
+          break;
+        }
+
+      switch (conv)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+          case 'p':
+            {
+              int tag = ptr < end ? *ptr : -1;
+              uint64_t value;
+              int shift;
+
+              if (tag < 1 || tag > 8 || ptr + 1 + tag > end)
+                {
+                  goto mismatch;
+                }
+
+              value = getval(ptr + 1, tag);
+              shift = 64 - 8 * tag;
+              ptr  += 1 + tag;
+
+              /* Apply the h and hh modifiers */
+
+              if (size == 'h' && shift < 48)
+                {
+                  shift = 48;
+                }
+              else if (size == 'H' && shift < 56)
+                {
+                  shift = 56;
+                }
+
+              if (conv == 'c')
+                {
+                  strcpy(&spec[len], "c");
+                  fprintf(g_out, spec, (int)value);
+                }
+              else if (conv == 'd' || conv == 'i')
+                {
+                  strcpy(&spec[len], "lld");
+                  fprintf(g_out, spec,
+                          (long long)((int64_t)(value << shift) >> shift));
+                }
+              else
+                {
+                  if (conv == 'p')
+                    {
+                      /* %p is the same as %#x on the target */
+
+                      memmove(&spec[2], &spec[1], len - 1);
+                      spec[1] = '#';
+                      len++;
+                      conv = 'x';
+                    }
+
+                  sprintf(&spec[len], "ll%c", conv);
+                  fprintf(g_out, spec,
+                          (unsigned long long)(value << shift >> shift));
+                }
+            }
+            break;
+
+          case 's':
+            {
+              const uint8_t *str = ptr + 1;
+
+              if (ptr >= end || *ptr != 's' ||
+                  memchr(str, '\0', end - str) == NULL)
+                {
+                  goto mismatch;
+                }
+
+              strcpy(&spec[len], "s");
+              fprintf(g_out, spec, (const char *)str);
+              ptr = str + strlen((const char *)str) + 1;
+            }
+            break;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+            {
+              uint64_t bits;
+              double value;
+
+              if (ptr < end && *ptr == 'd' && ptr + 9 <= end)
+                {
+                  bits = getval(ptr + 1, 8);
+                  memcpy(&value, &bits, 8);
+                  ptr += 9;
+                }
+              else if (ptr < end && *ptr == 'f' && ptr + 5 <= end)
+                {
+                  uint32_t bits32 = getval(ptr + 1, 4);
+                  float value32;
+
+                  memcpy(&value32, &bits32, 4);
+                  value = value32;
+                  ptr += 5;
+                }
+              else
+                {
+                  goto mismatch;
+                }
+
+              spec[len++] = conv;
+              spec[len]   = '\0';
+              fprintf(g_out, spec, value);
+            }
+            break;
+
+          default:
+            goto mismatch;
+        }
+    }
+
+  return;
+
+mismatch:
+  fprintf(g_out, "[record does not match the format string]\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  static char line[LINESIZE];
+  static uint8_t record[LINESIZE];
+  const char *outfile = NULL;
+  FILE *stream;
+  size_t reclen;
+  int ch;
+
+  while ((ch = getopt(argc, argv, ":o:h")) > 0)
+    {
+      switch (ch)
+        {
+          case 'o':
+            outfile = optarg;
+            break;
+
+          case 'h':
+          default:
+            show_usage(argv[0]);
+            break;
+        }
+    }
+
+  if (optind != argc - 1 && optind != argc - 2)
+    {
+      fprintf(stderr, "Unexpected number of arguments\n");
+      show_usage(argv[0]);
+    }
+
+  if (load_elf(argv[optind]) < 0)
+    {
+      return EXIT_FAILURE;
+    }
+
+  stream = stdin;
+  if (optind == argc - 2)
+    {
+      stream = fopen(argv[optind + 1], "rb");
+      if (stream == NULL)
+        {
+          fprintf(stderr, "open %s failed: %s\n", argv[optind + 1],
+                  strerror(errno));
+          return EXIT_FAILURE;
+        }
+    }
+
+  g_out = stdout;
+  if (outfile != NULL)
+    {
+      g_out = fopen(outfile, "w");
+      if (g_out == NULL)
+        {
+          fprintf(stderr, "open %s failed: %s\n", outfile, strerror(errno));
+          return EXIT_FAILURE;
+        }
+    }
+
+  while (fgets(line, LINESIZE, stream) != NULL)
+    {
+      if ((uint8_t)line[0] == RECORD_MARK)
+        {
+          reclen = base64_decode(&line[1], record);
+          print_record(record, reclen);
+        }
+      else
+        {
+          fputs(line, g_out);
+        }
+    }
+
+  if (stream != stdin)
+    {
+      fclose(stream);
+    }
+
+  if (g_out != stdout)
+    {
+      fclose(g_out);
+    }
+
+  free(g_sections);
+  free(g_elf);
+  return EXIT_SUCCESS;
+}